@@ -0,0 +1,526 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TemplatesBenchmark.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+
+namespace UE::TemplatesGuide::Benchmark
+{
+	// ============================================================================
+	// FBenchmarkConfig
+	// ============================================================================
+	FBenchmarkConfig FBenchmarkConfig::FromArgs(const TArray<FString>& Args)
+	{
+		FBenchmarkConfig Config;
+
+		for (const FString& Arg : Args)
+		{
+			const TCHAR* Str = *Arg;
+
+			FParse::Value(Str, TEXT("Filter="), Config.Filter);
+			FParse::Value(Str, TEXT("Iterations="), Config.Iterations);
+			FParse::Value(Str, TEXT("WorkUs="), Config.WorkMicroseconds);
+			FParse::Value(Str, TEXT("Scale="), Config.StressScale);
+			FParse::Value(Str, TEXT("Floor="), Config.FloorScale);
+
+			FString Workers;
+			if (FParse::Value(Str, TEXT("Workers="), Workers))
+			{
+				TArray<FString> Parts;
+				Workers.ParseIntoArray(Parts, TEXT(","));
+				for (const FString& Part : Parts)
+				{
+					Config.WorkerCounts.Add(FCString::Atoi(*Part));
+				}
+			}
+
+			FString Format;
+			if (FParse::Value(Str, TEXT("Format="), Format))
+			{
+				Config.bWriteCsv = Format == TEXT("csv") || Format == TEXT("both");
+				Config.bWriteJson = Format == TEXT("json") || Format == TEXT("both");
+			}
+		}
+
+		Config.Iterations = FMath::Max(1, Config.Iterations);
+		Config.WorkMicroseconds = FMath::Max(0.0, Config.WorkMicroseconds);
+		Config.StressScale = FMath::Max(0.0, Config.StressScale);
+		Config.FloorScale = FMath::Max(0.0, Config.FloorScale);
+		return Config;
+	}
+
+	// ============================================================================
+	// 合成工作负载
+	// ============================================================================
+	void SpinWork(double Microseconds)
+	{
+		if (Microseconds <= 0.0)
+		{
+			return;
+		}
+
+		const uint64 EndCycles = FPlatformTime::Cycles64() +
+			static_cast<uint64>(Microseconds / (FPlatformTime::GetSecondsPerCycle64() * 1e6));
+		while (FPlatformTime::Cycles64() < EndCycles)
+		{
+			FPlatformMisc::MemoryBarrier();
+		}
+	}
+
+	// ============================================================================
+	// FLatencyRecorder
+	// ============================================================================
+	FLatencyRecorder::FLatencyRecorder(int32 Capacity)
+	{
+		Samples.SetNumUninitialized(FMath::Max(1, Capacity));
+	}
+
+	int32 FLatencyRecorder::Num() const
+	{
+		return FMath::Min(Count.load(std::memory_order_relaxed), Samples.Num());
+	}
+
+	int32 FLatencyRecorder::GetNumDropped() const
+	{
+		return FMath::Max(0, Count.load(std::memory_order_relaxed) - Samples.Num());
+	}
+
+	double FLatencyRecorder::GetPercentileMicroseconds(double Percentile) const
+	{
+		const int32 NumSamples = Num();
+		if (NumSamples == 0)
+		{
+			return 0.0;
+		}
+
+		TArray<uint64> Sorted(Samples.GetData(), NumSamples);
+		Sorted.Sort();
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile / 100.0 * NumSamples) - 1, 0, NumSamples - 1);
+		return FPlatformTime::ToSeconds64(Sorted[Index]) * 1e6;
+	}
+
+	// ============================================================================
+	// FPeakMemoryScope
+	// ============================================================================
+	FPeakMemoryScope::FPeakMemoryScope()
+		: BaselineBytes(GetUsedBytes())
+	{
+	}
+
+	void FPeakMemoryScope::Sample()
+	{
+		PeakBytes = FMath::Max(PeakBytes, GetUsedBytes() - BaselineBytes);
+	}
+
+	int64 FPeakMemoryScope::GetUsedBytes()
+	{
+		return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	// ============================================================================
+	// FBenchmarkContext
+	// ============================================================================
+	FBenchmarkContext::FBenchmarkContext(const FBenchmarkConfig& InConfig, const TCHAR* InSuite, int32 InWorkers, UWorld* InWorld)
+		: Config(InConfig)
+		, Suite(InSuite)
+		, Workers(InWorkers)
+		, World(InWorld)
+	{
+	}
+
+	FBenchmarkResult& FBenchmarkContext::Report(const TCHAR* CaseName, int64 NumTasks, double Seconds, const FLatencyRecorder* Latency)
+	{
+		FBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+		Result.Suite = Suite;
+		Result.Case = CaseName;
+		Result.Workers = Workers;
+		Result.Iterations = Config.Iterations;
+		Result.NumTasks = NumTasks;
+		Result.TotalSeconds = Seconds;
+		Result.TasksPerSecond = Seconds > 0.0 ? NumTasks / Seconds : 0.0;
+
+		if (Latency)
+		{
+			Result.P50Microseconds = Latency->GetPercentileMicroseconds(50.0);
+			Result.P99Microseconds = Latency->GetPercentileMicroseconds(99.0);
+		}
+
+		return Result;
+	}
+
+	bool FBenchmarkContext::Expect(FBenchmarkResult& Result, bool bCondition, const FString& Message) const
+	{
+		if (!bCondition)
+		{
+			Result.Failures.Add(Message);
+		}
+		return bCondition;
+	}
+
+	bool FBenchmarkContext::ExpectThroughput(FBenchmarkResult& Result, double MinTasksPerSecond) const
+	{
+		const double Floor = MinTasksPerSecond * Config.FloorScale;
+		Result.Metrics.Emplace(TEXT("ThroughputFloor"), Floor);
+
+		return Expect(Result, Result.TasksPerSecond >= Floor,
+			FString::Printf(TEXT("throughput %.0f/s below floor %.0f/s"), Result.TasksPerSecond, Floor));
+	}
+
+	bool FBenchmarkContext::ExpectPeakMemory(FBenchmarkResult& Result, const FPeakMemoryScope& Memory, int64 MaxBytes) const
+	{
+		const double PeakMB = Memory.GetPeakBytes() / (1024.0 * 1024.0);
+		Result.Metrics.Emplace(TEXT("PeakMemoryMB"), PeakMB);
+
+		return Expect(Result, Memory.GetPeakBytes() <= MaxBytes,
+			FString::Printf(TEXT("peak memory %.1f MB above limit %.1f MB"), PeakMB, MaxBytes / (1024.0 * 1024.0)));
+	}
+
+	// ============================================================================
+	// FBenchmarkRegistry
+	// ============================================================================
+	FBenchmarkRegistry& FBenchmarkRegistry::Get()
+	{
+		static FBenchmarkRegistry Registry;
+		return Registry;
+	}
+
+	void FBenchmarkRegistry::Register(const TCHAR* Suite, const TCHAR* Name, EBenchmarkFlags Flags, FBenchmarkFunction Function)
+	{
+		Entries.Add(FEntry{Suite, Name, Flags, Function});
+	}
+
+	TArray<FBenchmarkResult> FBenchmarkRegistry::Run(const FBenchmarkConfig& Config, UWorld* World) const
+	{
+		const int32 NumWorkers = GetNumWorkers();
+
+		TArray<int32> WorkerCounts = Config.WorkerCounts;
+		if (WorkerCounts.IsEmpty())
+		{
+			for (int32 Count = 1; Count < NumWorkers; Count *= 2)
+			{
+				WorkerCounts.Add(Count);
+			}
+			WorkerCounts.Add(NumWorkers);
+		}
+
+		TArray<FBenchmarkResult> AllResults;
+
+		for (const FEntry& Entry : Entries)
+		{
+			const FString FullName = FString::Printf(TEXT("%s.%s"), Entry.Suite, Entry.Name);
+			if (Config.bExactFilter ? FullName != Config.Filter : !Config.Filter.IsEmpty() && !FullName.Contains(Config.Filter))
+			{
+				continue;
+			}
+
+			if (EnumHasAnyFlags(Entry.Flags, EBenchmarkFlags::Stress) != Config.bStress)
+			{
+				continue;
+			}
+
+			TArray<int32> RunWorkerCounts;
+			if (EnumHasAnyFlags(Entry.Flags, EBenchmarkFlags::ScalesWithWorkers) && !Config.bStress)
+			{
+				RunWorkerCounts = WorkerCounts;
+			}
+			else
+			{
+				RunWorkerCounts.Add(NumWorkers);
+			}
+
+			for (int32 Workers : RunWorkerCounts)
+			{
+				Workers = FMath::Clamp(Workers, 1, NumWorkers);
+
+				FWorkerOccupancyScope Occupancy(NumWorkers - Workers);
+				FBenchmarkContext Context(Config, Entry.Suite, Workers, World);
+
+				UE_LOG(LogTemp, Log, TEXT("[Benchmark] Running %s (Workers=%d, Occupied=%d)"),
+					*FullName, Workers, Occupancy.GetNumOccupied());
+
+				Entry.Function(Context);
+
+				for (const FBenchmarkResult& Result : Context.GetResults())
+				{
+					UE_LOG(LogTemp, Log, TEXT("  %s.%s W=%d: %lld tasks in %.3f ms, %.0f tasks/s, p50=%.2f us, p99=%.2f us"),
+						*Result.Suite, *Result.Case, Result.Workers, Result.NumTasks, Result.TotalSeconds * 1000.0,
+						Result.TasksPerSecond, Result.P50Microseconds, Result.P99Microseconds);
+					for (const TPair<FString, double>& Metric : Result.Metrics)
+					{
+						UE_LOG(LogTemp, Log, TEXT("    %s = %.3f"), *Metric.Key, Metric.Value);
+					}
+					for (const FString& Failure : Result.Failures)
+					{
+						UE_LOG(LogTemp, Warning, TEXT("    FAILED: %s"), *Failure);
+					}
+				}
+
+				AllResults.Append(MoveTemp(Context.GetResults()));
+			}
+		}
+
+		return AllResults;
+	}
+
+	TArray<FString> FBenchmarkRegistry::GetCaseNames(EBenchmarkFlags Flags) const
+	{
+		TArray<FString> Names;
+		for (const FEntry& Entry : Entries)
+		{
+			if (EnumHasAnyFlags(Entry.Flags, Flags))
+			{
+				Names.Add(FString::Printf(TEXT("%s.%s"), Entry.Suite, Entry.Name));
+			}
+		}
+		return Names;
+	}
+
+	// ============================================================================
+	// FWorkerOccupancyScope
+	// ============================================================================
+	FWorkerOccupancyScope::FWorkerOccupancyScope(int32 NumToOccupy)
+	{
+		if (NumToOccupy <= 0)
+		{
+			return;
+		}
+
+		Blockers.Reserve(NumToOccupy);
+		for (int32 i = 0; i < NumToOccupy; ++i)
+		{
+			Blockers.Add(UE::Tasks::Launch(TEXT("BenchmarkWorkerBlocker"), [this]
+				{
+					NumOccupied.fetch_add(1);
+					while (!bRelease.load(std::memory_order_relaxed))
+					{
+						FPlatformProcess::Yield();
+					}
+				},
+				LowLevelTasks::ETaskPriority::High,
+				UE::Tasks::EExtendedTaskPriority::None,
+				UE::Tasks::ETaskFlags::DoNotRunInsideBusyWait));
+		}
+
+		// 等待占位任务全部开始执行 (最多1秒, 工作线程可能正在执行其他长任务)
+		const double EndTime = FPlatformTime::Seconds() + 1.0;
+		while (NumOccupied.load() < NumToOccupy && FPlatformTime::Seconds() < EndTime)
+		{
+			FPlatformProcess::Yield();
+		}
+	}
+
+	FWorkerOccupancyScope::~FWorkerOccupancyScope()
+	{
+		bRelease = true;
+		UE::Tasks::Wait(Blockers);
+	}
+
+	int32 GetNumWorkers()
+	{
+		return FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	}
+
+	// ============================================================================
+	// 结果输出
+	// ============================================================================
+	static FString GetOutputPath(const FString& BaseName, const TCHAR* Extension)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), BaseName + Extension);
+	}
+
+	FString WriteCsv(const TArray<FBenchmarkResult>& Results, const FString& BaseName)
+	{
+		const FString EngineVersion = FEngineVersion::Current().ToString();
+
+		FString Csv = TEXT("EngineVersion,Suite,Case,Workers,Iterations,NumTasks,TotalSeconds,TasksPerSecond,P50Us,P99Us,Metrics\n");
+		for (const FBenchmarkResult& Result : Results)
+		{
+			FString Metrics;
+			for (const TPair<FString, double>& Metric : Result.Metrics)
+			{
+				Metrics += FString::Printf(TEXT("%s%s=%f"), Metrics.IsEmpty() ? TEXT("") : TEXT(";"), *Metric.Key, Metric.Value);
+			}
+
+			Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%lld,%f,%f,%f,%f,%s\n"),
+				*EngineVersion, *Result.Suite, *Result.Case, Result.Workers, Result.Iterations, Result.NumTasks,
+				Result.TotalSeconds, Result.TasksPerSecond, Result.P50Microseconds, Result.P99Microseconds, *Metrics);
+		}
+
+		const FString Path = GetOutputPath(BaseName, TEXT(".csv"));
+		FFileHelper::SaveStringToFile(Csv, *Path);
+		return Path;
+	}
+
+	FString WriteJson(const TArray<FBenchmarkResult>& Results, const FBenchmarkConfig& Config, const FString& BaseName)
+	{
+		FString Json = TEXT("{\n");
+		Json += FString::Printf(TEXT("  \"engineVersion\": \"%s\",\n"), *FEngineVersion::Current().ToString());
+		Json += FString::Printf(TEXT("  \"numWorkers\": %d,\n"), GetNumWorkers());
+		Json += FString::Printf(TEXT("  \"iterations\": %d,\n"), Config.Iterations);
+		Json += FString::Printf(TEXT("  \"workMicroseconds\": %f,\n"), Config.WorkMicroseconds);
+		Json += TEXT("  \"results\": [\n");
+
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			const FBenchmarkResult& Result = Results[Index];
+
+			FString Metrics;
+			for (const TPair<FString, double>& Metric : Result.Metrics)
+			{
+				Metrics += FString::Printf(TEXT("%s\"%s\": %f"), Metrics.IsEmpty() ? TEXT("") : TEXT(", "), *Metric.Key, Metric.Value);
+			}
+
+			Json += FString::Printf(
+				TEXT("    { \"suite\": \"%s\", \"case\": \"%s\", \"workers\": %d, \"numTasks\": %lld, \"totalSeconds\": %f, ")
+				TEXT("\"tasksPerSecond\": %f, \"p50Us\": %f, \"p99Us\": %f, \"metrics\": { %s } }%s\n"),
+				*Result.Suite, *Result.Case, Result.Workers, Result.NumTasks, Result.TotalSeconds,
+				Result.TasksPerSecond, Result.P50Microseconds, Result.P99Microseconds, *Metrics,
+				Index + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+		}
+
+		Json += TEXT("  ]\n}\n");
+
+		const FString Path = GetOutputPath(BaseName, TEXT(".json"));
+		FFileHelper::SaveStringToFile(Json, *Path);
+		return Path;
+	}
+
+	// ============================================================================
+	// 控制台命令
+	// ============================================================================
+	static void RunBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		const FBenchmarkConfig Config = FBenchmarkConfig::FromArgs(Args);
+
+		UE_LOG(LogTemp, Warning, TEXT("========== TemplatesGuide Benchmark Start (Iterations=%d, WorkUs=%.1f, Filter=\"%s\") =========="),
+			Config.Iterations, Config.WorkMicroseconds, *Config.Filter);
+
+		const TArray<FBenchmarkResult> Results = FBenchmarkRegistry::Get().Run(Config, World);
+
+		const FString BaseName = FString::Printf(TEXT("TemplatesGuide-%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+		if (Config.bWriteCsv)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Benchmark] CSV written to %s"), *WriteCsv(Results, BaseName));
+		}
+		if (Config.bWriteJson)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Benchmark] JSON written to %s"), *WriteJson(Results, Config, BaseName));
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("========== TemplatesGuide Benchmark End (%d results) =========="), Results.Num());
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("TemplatesGuide.Benchmark"),
+		TEXT("Runs the template example benchmarks. Args: Filter=<substr> Iterations=<N> WorkUs=<us> Workers=<1,2,4> Format=<csv|json|both>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmarkCommand));
+
+	static void RunStressCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		FBenchmarkConfig Config = FBenchmarkConfig::FromArgs(Args);
+		Config.bStress = true;
+
+		bool bExitOnFinish = false;
+		for (const FString& Arg : Args)
+		{
+			FParse::Bool(*Arg, TEXT("ExitOnFinish="), bExitOnFinish);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("========== TemplatesGuide Stress Start (Scale=%.2f, Floor=%.2f, Filter=\"%s\") =========="),
+			Config.StressScale, Config.FloorScale, *Config.Filter);
+
+		const TArray<FBenchmarkResult> Results = FBenchmarkRegistry::Get().Run(Config, World);
+
+		const FString BaseName = FString::Printf(TEXT("TemplatesGuide-Stress-%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+		if (Config.bWriteCsv)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Stress] CSV written to %s"), *WriteCsv(Results, BaseName));
+		}
+		if (Config.bWriteJson)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[Stress] JSON written to %s"), *WriteJson(Results, Config, BaseName));
+		}
+
+		int32 NumFailed = 0;
+		for (const FBenchmarkResult& Result : Results)
+		{
+			for (const FString& Failure : Result.Failures)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[Stress] %s.%s: %s"), *Result.Suite, *Result.Case, *Failure);
+			}
+			NumFailed += Result.Failures.IsEmpty() ? 0 : 1;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("========== TemplatesGuide Stress End (%d results, %d failed) =========="), Results.Num(), NumFailed);
+
+		if (bExitOnFinish)
+		{
+			// 命令行运行时以返回码报告结果
+			FPlatformMisc::RequestExitWithStatus(false, NumFailed > 0 ? 1 : 0);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StressCommand(
+		TEXT("TemplatesGuide.Stress"),
+		TEXT("Runs the template example stress tests with throughput floors (also registered as TemplatesGuide.Stress automation tests). Args: Filter=<substr> Scale=<x> Floor=<x> Format=<csv|json|both> ExitOnFinish=<0|1>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunStressCommand));
+}
+
+// ============================================================================
+// 自动化测试: 每个压力用例一个 TemplatesGuide.Stress.<Suite>.<Name>
+// ============================================================================
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FTemplatesGuideStressTest, "TemplatesGuide.Stress",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+void FTemplatesGuideStressTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	using namespace UE::TemplatesGuide::Benchmark;
+
+	for (const FString& Name : FBenchmarkRegistry::Get().GetCaseNames(EBenchmarkFlags::Stress))
+	{
+		OutBeautifiedNames.Add(Name);
+		OutTestCommands.Add(Name);
+	}
+}
+
+bool FTemplatesGuideStressTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::TemplatesGuide::Benchmark;
+
+	FBenchmarkConfig Config;
+	Config.bStress = true;
+	Config.bExactFilter = true;
+	Config.Filter = Parameters;
+
+	// 自动化测试没有控制台参数, 规模与下限倍数从命令行读取 (较慢的 CI 机器可以调低下限)
+	FParse::Value(FCommandLine::Get(), TEXT("TemplatesGuideStressScale="), Config.StressScale);
+	FParse::Value(FCommandLine::Get(), TEXT("TemplatesGuideStressFloor="), Config.FloorScale);
+
+	const TArray<FBenchmarkResult> Results = FBenchmarkRegistry::Get().Run(Config, nullptr);
+	if (Results.IsEmpty())
+	{
+		AddError(FString::Printf(TEXT("%s reported no results"), *Parameters));
+		return false;
+	}
+
+	for (const FBenchmarkResult& Result : Results)
+	{
+		AddInfo(FString::Printf(TEXT("%s: %lld tasks in %.3f ms, %.0f tasks/s"),
+			*Result.Case, Result.NumTasks, Result.TotalSeconds * 1000.0, Result.TasksPerSecond));
+		for (const FString& Failure : Result.Failures)
+		{
+			AddError(FString::Printf(TEXT("%s: %s"), *Result.Case, *Failure));
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,364 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+class UWorld;
+
+/**
+ * UnrealTemplatesGuide 基准测试框架
+ *
+ * 示例 Actor 在 BeginPlay 中只把每个模式运行一次并用 UE_LOG 验证正确性,
+ * 这里提供一个可重复运行的"基准模式":
+ *
+ *   控制台命令:
+ *     TemplatesGuide.Benchmark [Filter=Tasks] [Iterations=1000] [WorkUs=5] [Workers=1,2,4,8] [Format=csv|json|both]
+ *
+ *   - Filter:     只运行 "Suite.Name" 中包含该子串的用例
+ *   - Iterations: 每个用例重复运行模式的次数
+ *   - WorkUs:     合成工作负载(微秒), 替代示例中的 FPlatformProcess::Sleep 占位
+ *   - Workers:    逐一模拟的可用工作线程数 (默认 1, 2, 4 ... 全部)
+ *   - Format:     结果文件格式, 写入 Saved/Benchmarks/
+ *
+ * 工作线程数的模拟 (FWorkerOccupancyScope):
+ *   调度器的工作线程数在引擎启动时确定, 运行中重启调度器并不安全,
+ *   因此用 "占位任务" 占住 (NumWorkers - Workers) 个工作线程,
+ *   被测模式只能使用剩余的 Workers 个线程
+ *   占位任务带 ETaskFlags::DoNotRunInsideBusyWait, 不会被其他线程的忙等待拾取
+ *
+ * 新增用例 (与 IMPLEMENT_SIMPLE_AUTOMATION_TEST 的自动注册方式相同):
+ *
+ *   UE_TEMPLATESGUIDE_BENCHMARK(Tasks, BasicLaunch, EBenchmarkFlags::ScalesWithWorkers)
+ *   {
+ *       FLatencyRecorder Latency(Context.GetIterations());
+ *       FBenchmarkTimer Timer;
+ *       ...
+ *       Context.Report(TEXT("BasicLaunch"), NumTasks, Timer.GetSeconds(), &Latency);
+ *   }
+ *
+ * 压力模式 (EBenchmarkFlags::Stress):
+ *
+ *   自动化测试 (WITH_DEV_AUTOMATION_TESTS, StressFilter), 每个压力用例一个 "TemplatesGuide.Stress.<Suite>.<Name>":
+ *     Automation RunTests TemplatesGuide.Stress
+ *     UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests TemplatesGuide.Stress; Quit" -unattended -nullrhi -nosplash
+ *       [-TemplatesGuideStressScale=1.0] [-TemplatesGuideStressFloor=1.0]
+ *
+ *   控制台命令 (同样的用例, 另外写出 CSV / JSON 结果文件):
+ *     TemplatesGuide.Stress [Filter=TasksStress] [Scale=1.0] [Floor=1.0] [Format=csv|json|both] [ExitOnFinish=1]
+ *
+ *   - 压力用例只由自动化测试与 TemplatesGuide.Stress 运行, 在全部工作线程下运行一次
+ *   - 规模用 Context.Scaled(N) 计算 (Scale 倍), 吞吐量下限乘以 Floor (较慢的机器可以调低)
+ *   - 用例用 ExpectThroughput / ExpectPeakMemory / Expect 记录失败,
+ *     自动化测试中逐条 AddError, 命令结束时汇总为 Error 日志
+ *   - ExitOnFinish=1 时运行完毕后退出进程, 有失败时返回码为 1
+ */
+namespace UE::TemplatesGuide::Benchmark
+{
+	/** 基准测试配置 (由控制台命令参数解析) */
+	struct FBenchmarkConfig
+	{
+		/** 只运行名称中包含该子串的用例, 为空表示全部 */
+		FString Filter;
+
+		/** Filter 为完整的 "Suite.Name", 只运行该用例 (自动化测试逐个运行压力用例) */
+		bool bExactFilter = false;
+
+		/** 每个用例重复运行模式的次数 */
+		int32 Iterations = 100;
+
+		/** 合成工作负载时长 (微秒) */
+		double WorkMicroseconds = 10.0;
+
+		/** 要模拟的工作线程数, 为空时使用 1, 2, 4 ... NumWorkers */
+		TArray<int32> WorkerCounts;
+
+		bool bWriteCsv = true;
+		bool bWriteJson = true;
+
+		/** 运行压力用例 (TemplatesGuide.Stress 自动化测试与命令), 否则运行普通基准用例 */
+		bool bStress = false;
+
+		/** 压力用例的规模倍数 */
+		double StressScale = 1.0;
+
+		/** 压力用例吞吐量下限的倍数 */
+		double FloorScale = 1.0;
+
+		/** 从 "Key=Value" 形式的控制台参数解析配置 */
+		UNREALTEMPLATESGUIDE_API static FBenchmarkConfig FromArgs(const TArray<FString>& Args);
+	};
+
+	enum class EBenchmarkFlags : uint8
+	{
+		None = 0,
+
+		/** 按 FBenchmarkConfig::WorkerCounts 逐一运行, 否则只在全部工作线程下运行一次 */
+		ScalesWithWorkers = 1 << 0,
+
+		/** 压力用例: 只由 TemplatesGuide.Stress 自动化测试与同名命令运行, 检查吞吐量下限与峰值内存 */
+		Stress = 1 << 1,
+	};
+	ENUM_CLASS_FLAGS(EBenchmarkFlags);
+
+	/**
+	 * 合成工作负载: 在当前线程忙等指定的微秒数
+	 *
+	 * 与 FPlatformProcess::Sleep 不同, 忙等会真正占用工作线程,
+	 * 更接近热路径上的计算型任务
+	 */
+	UNREALTEMPLATESGUIDE_API void SpinWork(double Microseconds);
+
+	/** 简单计时器, 构造时开始计时 */
+	class FBenchmarkTimer
+	{
+	public:
+		FBenchmarkTimer()
+			: StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		double GetSeconds() const
+		{
+			return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		}
+
+	private:
+		uint64 StartCycles;
+	};
+
+	/**
+	 * 线程安全的延迟样本记录器
+	 *
+	 * 样本缓冲区在构造时预分配, Record 只做一次原子自增和一次写入,
+	 * 可以在任务体中直接调用而不影响被测模式本身
+	 * 超出容量的样本会被丢弃 (计入 GetNumDropped)
+	 */
+	class UNREALTEMPLATESGUIDE_API FLatencyRecorder
+	{
+	public:
+		explicit FLatencyRecorder(int32 Capacity);
+
+		/** 当前时间戳, 在 Launch 前获取并捕获到任务体中 */
+		static uint64 Now()
+		{
+			return FPlatformTime::Cycles64();
+		}
+
+		/** 记录从 StartCycles 到现在的延迟 */
+		void RecordSince(uint64 StartCycles)
+		{
+			Record(FPlatformTime::Cycles64() - StartCycles);
+		}
+
+		void Record(uint64 Cycles)
+		{
+			const int32 Index = Count.fetch_add(1, std::memory_order_relaxed);
+			if (Index < Samples.Num())
+			{
+				Samples[Index] = Cycles;
+			}
+		}
+
+		int32 Num() const;
+		int32 GetNumDropped() const;
+
+		/** 百分位延迟 (微秒), Percentile 取值 [0, 100] */
+		double GetPercentileMicroseconds(double Percentile) const;
+
+		void Reset()
+		{
+			Count.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		TArray<uint64> Samples;
+		std::atomic<int32> Count{0};
+	};
+
+	/**
+	 * 峰值内存记录器
+	 *
+	 * 构造时记录进程已用物理内存作为基线, Sample 记录当前值与基线之差的最大值
+	 * 在预期的峰值位置调用 Sample (如全部任务启动之后、等待之前), 不使用后台采样线程;
+	 * 分配器缓存的内存不一定归还系统, 结果是被测模式实际占用的上界
+	 */
+	class UNREALTEMPLATESGUIDE_API FPeakMemoryScope
+	{
+	public:
+		FPeakMemoryScope();
+
+		void Sample();
+
+		/** 相对基线的峰值 (字节), 至少为 0 */
+		int64 GetPeakBytes() const
+		{
+			return PeakBytes;
+		}
+
+	private:
+		static int64 GetUsedBytes();
+
+		int64 BaselineBytes = 0;
+		int64 PeakBytes = 0;
+	};
+
+	/** 单个用例在某个工作线程数下的结果 */
+	struct FBenchmarkResult
+	{
+		FString Suite;
+		FString Case;
+		int32 Workers = 0;
+		int32 Iterations = 0;
+		int64 NumTasks = 0;
+		double TotalSeconds = 0.0;
+		double TasksPerSecond = 0.0;
+		double P50Microseconds = 0.0;
+		double P99Microseconds = 0.0;
+
+		/** 用例自定义的附加指标 (如 "CopiesPerChain", "HeapAllocs") */
+		TArray<TPair<FString, double>> Metrics;
+
+		/** 压力用例中未满足的预期, 为空表示通过 */
+		TArray<FString> Failures;
+	};
+
+	/** 传给每个用例的运行上下文 */
+	class UNREALTEMPLATESGUIDE_API FBenchmarkContext
+	{
+	public:
+		FBenchmarkContext(const FBenchmarkConfig& InConfig, const TCHAR* InSuite, int32 InWorkers, UWorld* InWorld);
+
+		const FBenchmarkConfig& GetConfig() const { return Config; }
+		int32 GetIterations() const { return Config.Iterations; }
+
+		/** 本次运行可用的工作线程数 */
+		int32 GetWorkers() const { return Workers; }
+
+		/** 执行控制台命令的世界, 可能为空 (需要生成 Actor 的用例应检查) */
+		UWorld* GetWorld() const { return World; }
+
+		/** 执行一次配置的合成工作负载 */
+		void Work() const
+		{
+			SpinWork(Config.WorkMicroseconds);
+		}
+
+		/**
+		 * 报告一个结果
+		 *
+		 * @param CaseName  用例内的子项名称 (一个用例可以报告多个子项, 如 "Naive" / "Batched")
+		 * @param NumTasks  该子项启动的任务(或处理的条目)总数, 用于计算吞吐量
+		 * @param Seconds   总耗时
+		 * @param Latency   可选的启动到开始执行的延迟样本
+		 * @return 结果引用, 可继续追加 Metrics
+		 */
+		FBenchmarkResult& Report(const TCHAR* CaseName, int64 NumTasks, double Seconds, const FLatencyRecorder* Latency = nullptr);
+
+		TArray<FBenchmarkResult>& GetResults() { return Results; }
+
+		/** 压力用例的规模: N * StressScale, 至少为 1 */
+		int64 Scaled(int64 Num) const
+		{
+			return FMath::Max<int64>(1, static_cast<int64>(Num * Config.StressScale));
+		}
+
+		/** bCondition 为 false 时把 Message 记为 Result 的失败, 返回 bCondition */
+		bool Expect(FBenchmarkResult& Result, bool bCondition, const FString& Message) const;
+
+		/** 吞吐量不低于 MinTasksPerSecond * FloorScale, 下限计入 Metrics ("ThroughputFloor") */
+		bool ExpectThroughput(FBenchmarkResult& Result, double MinTasksPerSecond) const;
+
+		/** 峰值内存不超过 MaxBytes, 峰值计入 Metrics ("PeakMemoryMB") */
+		bool ExpectPeakMemory(FBenchmarkResult& Result, const FPeakMemoryScope& Memory, int64 MaxBytes) const;
+
+	private:
+		const FBenchmarkConfig& Config;
+		FString Suite;
+		int32 Workers;
+		UWorld* World;
+		TArray<FBenchmarkResult> Results;
+	};
+
+	using FBenchmarkFunction = void (*)(FBenchmarkContext& Context);
+
+	/** 用例注册表, 通过 UE_TEMPLATESGUIDE_BENCHMARK 静态注册 */
+	class UNREALTEMPLATESGUIDE_API FBenchmarkRegistry
+	{
+	public:
+		static FBenchmarkRegistry& Get();
+
+		void Register(const TCHAR* Suite, const TCHAR* Name, EBenchmarkFlags Flags, FBenchmarkFunction Function);
+
+		/** 运行所有匹配的用例并返回结果 */
+		TArray<FBenchmarkResult> Run(const FBenchmarkConfig& Config, UWorld* World) const;
+
+		/** 带有 Flags 中任一标志的用例的 "Suite.Name" */
+		TArray<FString> GetCaseNames(EBenchmarkFlags Flags) const;
+
+	private:
+		struct FEntry
+		{
+			const TCHAR* Suite;
+			const TCHAR* Name;
+			EBenchmarkFlags Flags;
+			FBenchmarkFunction Function;
+		};
+
+		TArray<FEntry> Entries;
+	};
+
+	/** 静态注册辅助对象 */
+	struct FAutoRegisterBenchmark
+	{
+		FAutoRegisterBenchmark(const TCHAR* Suite, const TCHAR* Name, EBenchmarkFlags Flags, FBenchmarkFunction Function)
+		{
+			FBenchmarkRegistry::Get().Register(Suite, Name, Flags, Function);
+		}
+	};
+
+	/**
+	 * 占住指定数量的工作线程, 用于模拟较少的可用工作线程
+	 *
+	 * 占位任务以 High 优先级启动并自旋, 直到作用域结束
+	 */
+	class UNREALTEMPLATESGUIDE_API FWorkerOccupancyScope
+	{
+	public:
+		explicit FWorkerOccupancyScope(int32 NumToOccupy);
+		~FWorkerOccupancyScope();
+
+		UE_NONCOPYABLE(FWorkerOccupancyScope);
+
+		/** 实际被占住的工作线程数 (可能少于请求数, 如工作线程正忙) */
+		int32 GetNumOccupied() const
+		{
+			return NumOccupied.load();
+		}
+
+	private:
+		std::atomic<bool> bRelease{false};
+		std::atomic<int32> NumOccupied{0};
+		TArray<UE::Tasks::FTask> Blockers;
+	};
+
+	/** 调度器中前台工作线程的数量 */
+	UNREALTEMPLATESGUIDE_API int32 GetNumWorkers();
+
+	/** 将结果写为 CSV / JSON, 返回写入的文件路径 */
+	UNREALTEMPLATESGUIDE_API FString WriteCsv(const TArray<FBenchmarkResult>& Results, const FString& BaseName);
+	UNREALTEMPLATESGUIDE_API FString WriteJson(const TArray<FBenchmarkResult>& Results, const FBenchmarkConfig& Config, const FString& BaseName);
+}
+
+/**
+ * 定义并自动注册一个基准用例
+ *
+ * 用例函数体内可用 Context (FBenchmarkContext&)
+ */
+#define UE_TEMPLATESGUIDE_BENCHMARK(Suite, Name, Flags) \
+	static void TemplatesGuideBenchmark_##Suite##_##Name(UE::TemplatesGuide::Benchmark::FBenchmarkContext& Context); \
+	static UE::TemplatesGuide::Benchmark::FAutoRegisterBenchmark GTemplatesGuideBenchmark_##Suite##_##Name( \
+		TEXT(#Suite), TEXT(#Name), Flags, &TemplatesGuideBenchmark_##Suite##_##Name); \
+	static void TemplatesGuideBenchmark_##Suite##_##Name(UE::TemplatesGuide::Benchmark::FBenchmarkContext& Context)
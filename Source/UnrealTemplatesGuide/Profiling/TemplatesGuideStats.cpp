@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TemplatesGuideStats.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_TemplatesGuide_TaskLaunch);
+DEFINE_STAT(STAT_TemplatesGuide_TaskRetract);
+DEFINE_STAT(STAT_TemplatesGuide_TaskBlockingWait);
+DEFINE_STAT(STAT_TemplatesGuide_TasksLaunched);
+DEFINE_STAT(STAT_TemplatesGuide_TaskWaits);
+DEFINE_STAT(STAT_TemplatesGuide_TaskBlockingWaits);
+
+DEFINE_STAT(STAT_TemplatesGuide_ContinuationRun);
+DEFINE_STAT(STAT_TemplatesGuide_PromisesCreated);
+DEFINE_STAT(STAT_TemplatesGuide_PromiseBlocksAllocated);
+DEFINE_STAT(STAT_TemplatesGuide_ContinuationsRun);
+DEFINE_STAT(STAT_TemplatesGuide_PromisePoolBlocks);
+DEFINE_STAT(STAT_TemplatesGuide_PromisePoolMemory);
+
+DEFINE_STAT(STAT_TemplatesGuide_PimplTick);
+DEFINE_STAT(STAT_TemplatesGuide_PimplBatchTick);
+DEFINE_STAT(STAT_TemplatesGuide_PimplsCreated);
+DEFINE_STAT(STAT_TemplatesGuide_LivePimpls);
+DEFINE_STAT(STAT_TemplatesGuide_PimplMemory);
+DEFINE_STAT(STAT_TemplatesGuide_PimplPoolMemory);
+
+CSV_DEFINE_CATEGORY_MODULE(UNREALTEMPLATESGUIDE_API, TemplatesGuide, true);
+
+namespace UE::TemplatesGuide::Stats
+{
+	namespace StatsPrivate
+	{
+		static std::atomic<int64> GGauges[int32(EGauge::Num)];
+
+#if CSV_PROFILER
+		/** GameThread, 每帧末: 把持续值写入 CSV */
+		static void PublishGaugesToCsv()
+		{
+			CSV_CUSTOM_STAT(TemplatesGuide, PromisePoolBlocks, int32(GetGauge(EGauge::PromisePoolBlocks)), ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(TemplatesGuide, PromisePoolMemoryKB, float(GetGauge(EGauge::PromisePoolMemory) / 1024.0), ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(TemplatesGuide, LivePimpls, int32(GetGauge(EGauge::LivePimpls)), ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(TemplatesGuide, PimplMemoryKB, float(GetGauge(EGauge::PimplMemory) / 1024.0), ECsvCustomStatOp::Set);
+			CSV_CUSTOM_STAT(TemplatesGuide, PimplPoolMemoryKB, float(GetGauge(EGauge::PimplPoolMemory) / 1024.0), ECsvCustomStatOp::Set);
+		}
+
+		// 静态初始化时委托系统可能尚未就绪, 推迟到引擎初始化完成后注册
+		static FDelayedAutoRegisterHelper GRegisterCsvGauges(EDelayedRegisterRunPhase::EndOfEngineInit, []
+		{
+			FCoreDelegates::OnEndFrame.AddStatic(&PublishGaugesToCsv);
+		});
+#endif
+	}
+
+/** stat 消息只接受非负的增量, 按符号选择 INC / DEC */
+#define UE_TEMPLATESGUIDE_ADD_TO_STAT(Kind, Stat, Delta) \
+	if (Delta >= 0) { INC_##Kind##_STAT_BY(Stat, Delta); } else { DEC_##Kind##_STAT_BY(Stat, -Delta); }
+
+	void AddToGauge(EGauge Gauge, int64 Delta)
+	{
+		check(Gauge < EGauge::Num);
+		StatsPrivate::GGauges[int32(Gauge)].fetch_add(Delta, std::memory_order_relaxed);
+
+		switch (Gauge)
+		{
+		case EGauge::PromisePoolBlocks:
+			UE_TEMPLATESGUIDE_ADD_TO_STAT(DWORD, STAT_TemplatesGuide_PromisePoolBlocks, Delta);
+			break;
+		case EGauge::PromisePoolMemory:
+			UE_TEMPLATESGUIDE_ADD_TO_STAT(MEMORY, STAT_TemplatesGuide_PromisePoolMemory, Delta);
+			break;
+		case EGauge::LivePimpls:
+			UE_TEMPLATESGUIDE_ADD_TO_STAT(DWORD, STAT_TemplatesGuide_LivePimpls, Delta);
+			break;
+		case EGauge::PimplMemory:
+			UE_TEMPLATESGUIDE_ADD_TO_STAT(MEMORY, STAT_TemplatesGuide_PimplMemory, Delta);
+			break;
+		case EGauge::PimplPoolMemory:
+			UE_TEMPLATESGUIDE_ADD_TO_STAT(MEMORY, STAT_TemplatesGuide_PimplPoolMemory, Delta);
+			break;
+		default:
+			break;
+		}
+	}
+
+#undef UE_TEMPLATESGUIDE_ADD_TO_STAT
+
+	int64 GetGauge(EGauge Gauge)
+	{
+		check(Gauge < EGauge::Num);
+		return StatsPrivate::GGauges[int32(Gauge)].load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * UnrealTemplatesGuide 的性能计数器
+ *
+ * 一个 stat 组 (STATGROUP_TemplatesGuide) 与一个 CSV 分类 (TemplatesGuide), 覆盖三个示例目录:
+ *
+ *   Tasks_System      TaskLaunch / TaskRetract / TaskBlockingWait (周期)
+ *                     TasksLaunched / TaskWaits / TaskBlockingWaits (每帧计数)
+ *   TFuture_TPromise  ContinuationRun (周期), PromisesCreated / PromiseBlocksAllocated / ContinuationsRun (每帧计数)
+ *                     PromisePoolBlocks / PromisePoolMemory (持续值)
+ *   TPimplPtr         PimplTick / PimplBatchTick (周期), PimplsCreated (每帧计数)
+ *                     LivePimpls / PimplMemory / PimplPoolMemory (持续值)
+ *
+ * 查看:
+ *   stat TemplatesGuide                          运行时显示 (Development / Debug, 需要 STATS)
+ *   csvprofile start / stop  或  -csvCaptureFrames=N   CSV 中的 TemplatesGuide/* 列 (Test 配置也可用)
+ *
+ * 用法:
+ *   UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);      // 周期统计 + CSV 计时
+ *   UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, NumTasks); // 每帧计数, CSV 中逐帧累加
+ *   Stats::AddToGauge(Stats::EGauge::LivePimpls, 1);        // 持续值, CSV 每帧末写入当前值
+ *
+ * 只在每次操作一次的位置计数 (启动 / 等待 / 分配 / Tick), 不放在访问器等热路径上
+ * 没有 STATS 与 CSV_PROFILER 的配置 (Shipping) 中宏为空, 持续值只剩一次原子加法
+ */
+DECLARE_STATS_GROUP(TEXT("TemplatesGuide"), STATGROUP_TemplatesGuide, STATCAT_Advanced);
+
+// ============================================================================
+// Tasks_System
+// ============================================================================
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Task Launch"), STAT_TemplatesGuide_TaskLaunch, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Task Retract"), STAT_TemplatesGuide_TaskRetract, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Task Blocking Wait"), STAT_TemplatesGuide_TaskBlockingWait, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tasks Launched"), STAT_TemplatesGuide_TasksLaunched, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Task Waits"), STAT_TemplatesGuide_TaskWaits, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Task Blocking Waits"), STAT_TemplatesGuide_TaskBlockingWaits, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+
+// ============================================================================
+// TFuture_TPromise
+// ============================================================================
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Continuation Run"), STAT_TemplatesGuide_ContinuationRun, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Promises Created"), STAT_TemplatesGuide_PromisesCreated, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Promise Blocks Allocated"), STAT_TemplatesGuide_PromiseBlocksAllocated, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Continuations Run"), STAT_TemplatesGuide_ContinuationsRun, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Promise Pool Blocks"), STAT_TemplatesGuide_PromisePoolBlocks, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Promise Pool Memory"), STAT_TemplatesGuide_PromisePoolMemory, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+
+// ============================================================================
+// TPimplPtr
+// ============================================================================
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pimpl Tick"), STAT_TemplatesGuide_PimplTick, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pimpl Batch Tick"), STAT_TemplatesGuide_PimplBatchTick, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pimpls Created"), STAT_TemplatesGuide_PimplsCreated, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Pimpls"), STAT_TemplatesGuide_LivePimpls, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pimpl Memory"), STAT_TemplatesGuide_PimplMemory, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pimpl Pool Memory"), STAT_TemplatesGuide_PimplPoolMemory, STATGROUP_TemplatesGuide, UNREALTEMPLATESGUIDE_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(UNREALTEMPLATESGUIDE_API, TemplatesGuide);
+
+/** 周期统计 STAT_TemplatesGuide_<Name> 与同名 CSV 计时, 作用到当前作用域结束 */
+#define UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_TemplatesGuide_##Name); \
+	CSV_SCOPED_TIMING_STAT(TemplatesGuide, Name)
+
+/** 每帧计数 STAT_TemplatesGuide_<Name> 加 Amount, CSV 中同名列逐帧累加; 任意线程 */
+#define UE_TEMPLATESGUIDE_INC_COUNTER(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_TemplatesGuide_##Name, Amount); \
+		CSV_CUSTOM_STAT(TemplatesGuide, Name, int32(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+
+namespace UE::TemplatesGuide::Stats
+{
+	/**
+	 * 跨帧持续的数值 (存活数 / 字节数)
+	 *
+	 * stat 系统中是 accumulator / memory 统计, 本身不随帧清零;
+	 * CSV 没有持续值, 每帧末 (FCoreDelegates::OnEndFrame) 把当前值写为 Set
+	 */
+	enum class EGauge : uint8
+	{
+		PromisePoolBlocks,
+		PromisePoolMemory,
+		LivePimpls,
+		PimplMemory,
+		PimplPoolMemory,
+
+		Num
+	};
+
+	/** 任意线程 */
+	UNREALTEMPLATESGUIDE_API void AddToGauge(EGauge Gauge, int64 Delta);
+
+	UNREALTEMPLATESGUIDE_API int64 GetGauge(EGauge Gauge);
+}
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TemplatesGuideTrace.h"
+
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(TemplatesGuideChannel)
+
+UE_TRACE_EVENT_BEGIN(TemplatesGuide, TaskLaunched)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, TaskId)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, DebugName)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TemplatesGuide, TaskEdge)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, FromId)
+	UE_TRACE_EVENT_FIELD(uint64, ToId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TemplatesGuide, TaskStarted)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, TaskId)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TemplatesGuide, TaskCompleted)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, TaskId)
+UE_TRACE_EVENT_END()
+
+namespace UE::TemplatesGuide::Trace
+{
+	static std::atomic<FTaskId> GNextTaskId{1};
+
+	FTaskId OutputLaunched(const TCHAR* DebugName, TConstArrayView<FTaskId> PrerequisiteIds)
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(TemplatesGuideChannel))
+		{
+			return 0;
+		}
+
+		const FTaskId Id = GNextTaskId.fetch_add(1, std::memory_order_relaxed);
+		const uint64 Cycle = FPlatformTime::Cycles64();
+
+		UE_TRACE_LOG(TemplatesGuide, TaskLaunched, TemplatesGuideChannel)
+			<< TaskLaunched.Cycle(Cycle)
+			<< TaskLaunched.TaskId(Id)
+			<< TaskLaunched.ThreadId(FPlatformTLS::GetCurrentThreadId())
+			<< TaskLaunched.DebugName(DebugName ? DebugName : TEXT("Unnamed"));
+
+		for (const FTaskId PrerequisiteId : PrerequisiteIds)
+		{
+			// 先决条件在通道开启前启动时没有 Id
+			if (PrerequisiteId != 0)
+			{
+				UE_TRACE_LOG(TemplatesGuide, TaskEdge, TemplatesGuideChannel)
+					<< TaskEdge.Cycle(Cycle)
+					<< TaskEdge.FromId(PrerequisiteId)
+					<< TaskEdge.ToId(Id);
+			}
+		}
+
+		return Id;
+	}
+
+	void OutputEdge(FTaskId FromId, FTaskId ToId)
+	{
+		if (FromId == 0 || ToId == 0)
+		{
+			return;
+		}
+
+		UE_TRACE_LOG(TemplatesGuide, TaskEdge, TemplatesGuideChannel)
+			<< TaskEdge.Cycle(FPlatformTime::Cycles64())
+			<< TaskEdge.FromId(FromId)
+			<< TaskEdge.ToId(ToId);
+	}
+
+	void OutputStarted(FTaskId Id)
+	{
+		UE_TRACE_LOG(TemplatesGuide, TaskStarted, TemplatesGuideChannel)
+			<< TaskStarted.Cycle(FPlatformTime::Cycles64())
+			<< TaskStarted.TaskId(Id)
+			<< TaskStarted.ThreadId(FPlatformTLS::GetCurrentThreadId());
+	}
+
+	void OutputCompleted(FTaskId Id)
+	{
+		UE_TRACE_LOG(TemplatesGuide, TaskCompleted, TemplatesGuideChannel)
+			<< TaskCompleted.Cycle(FPlatformTime::Cycles64())
+			<< TaskCompleted.TaskId(Id);
+	}
+}
+
+#endif // UE_TEMPLATESGUIDE_TRACE_ENABLED
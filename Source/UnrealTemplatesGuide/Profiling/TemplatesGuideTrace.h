@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <initializer_list>
+
+/**
+ * UnrealTemplatesGuide 的 Unreal Insights 追踪
+ *
+ * 独立的 "TemplatesGuide" 通道, 在 Insights 中可单独开关:
+ *   -trace=cpu,TemplatesGuide      或运行时   Trace.Enable TemplatesGuide
+ *
+ * 输出两类数据:
+ *   1. CPU 事件范围 (Timing 视图): 启动 / 执行 / 等待 / 管道入队
+ *        UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Launch")
+ *   2. 任务关系事件 (TemplatesGuide.TaskLaunched / TaskEdge / TaskStarted / TaskCompleted):
+ *        使用本模块自己分配的任务 Id, 记录先决条件边, 可据此重建关键路径
+ *        (如示例3 中 TaskA → TaskB → TaskC 的链)
+ *
+ *   FTracedTask TaskA = LaunchTraced(TEXT("TaskA"), [] { ... });
+ *   FTracedTask TaskB = LaunchTraced(TEXT("TaskB"), [] { ... }, TracedPrerequisites(TaskA));
+ *   → TaskLaunched(A), TaskLaunched(B), TaskEdge(A → B), TaskStarted/Completed(A), TaskStarted/Completed(B)
+ *
+ * 开销:
+ *   - 通道关闭时: 每次启动一次通道检查, 不分配 Id, 不输出事件
+ *   - UE_TEMPLATESGUIDE_TRACE_ENABLED == 0 时: 宏为空, LaunchTraced 等价于 Launch
+ *   默认跟随 CPUPROFILERTRACE_ENABLED, Test 配置中保持开启, 可在 Build.cs 中定义为 0 彻底编译掉
+ */
+#ifndef UE_TEMPLATESGUIDE_TRACE_ENABLED
+	#define UE_TEMPLATESGUIDE_TRACE_ENABLED (UE_TRACE_ENABLED && CPUPROFILERTRACE_ENABLED)
+#endif
+
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(TemplatesGuideChannel, UNREALTEMPLATESGUIDE_API);
+
+/** 在 TemplatesGuide 通道上的 CPU 事件范围, Name 为字符串字面量 */
+#define UE_TEMPLATESGUIDE_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, TemplatesGuideChannel)
+
+/** 同上, Name 为运行时字符串 (如任务的 DebugName) */
+#define UE_TEMPLATESGUIDE_TRACE_SCOPE_TEXT(Name) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Name, TemplatesGuideChannel)
+
+/** 任务体执行范围: CPU 事件 + TaskStarted / TaskCompleted (TraceId 为 0 时只有 CPU 事件) */
+#define UE_TEMPLATESGUIDE_TRACE_EXECUTE_SCOPE(TraceId) \
+	UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Execute"); \
+	UE::TemplatesGuide::Trace::FTaskExecuteScope PREPROCESSOR_JOIN(TemplatesGuideExecuteScope, __LINE__)(TraceId)
+
+#else
+
+#define UE_TEMPLATESGUIDE_TRACE_SCOPE(Name)
+#define UE_TEMPLATESGUIDE_TRACE_SCOPE_TEXT(Name)
+#define UE_TEMPLATESGUIDE_TRACE_EXECUTE_SCOPE(TraceId)
+
+#endif
+
+namespace UE::TemplatesGuide
+{
+	namespace Trace
+	{
+		/** 本模块分配的任务追踪 Id, 0 表示未追踪 */
+		using FTaskId = uint64;
+
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+		/** 通道开启时分配 Id 并输出 TaskLaunched 与每条先决条件边, 否则返回 0 */
+		UNREALTEMPLATESGUIDE_API FTaskId OutputLaunched(const TCHAR* DebugName, TConstArrayView<FTaskId> PrerequisiteIds = {});
+
+		/** 额外的依赖边 (如管道中前一个任务 → 后一个任务) */
+		UNREALTEMPLATESGUIDE_API void OutputEdge(FTaskId FromId, FTaskId ToId);
+
+		UNREALTEMPLATESGUIDE_API void OutputStarted(FTaskId Id);
+		UNREALTEMPLATESGUIDE_API void OutputCompleted(FTaskId Id);
+#else
+		inline FTaskId OutputLaunched(const TCHAR*, TConstArrayView<FTaskId> = {}) { return 0; }
+		inline void OutputEdge(FTaskId, FTaskId) {}
+		inline void OutputStarted(FTaskId) {}
+		inline void OutputCompleted(FTaskId) {}
+#endif
+
+		/** 任务体执行期间的 TaskStarted / TaskCompleted */
+		class FTaskExecuteScope
+		{
+		public:
+			explicit FTaskExecuteScope(FTaskId InId)
+				: Id(InId)
+			{
+				if (Id != 0)
+				{
+					OutputStarted(Id);
+				}
+			}
+
+			~FTaskExecuteScope()
+			{
+				if (Id != 0)
+				{
+					OutputCompleted(Id);
+				}
+			}
+
+			UE_NONCOPYABLE(FTaskExecuteScope);
+
+		private:
+			FTaskId Id;
+		};
+	}
+
+	/**
+	 * 带追踪 Id 的任务句柄
+	 *
+	 * 继承 TTask, 可以直接 Wait / GetResult / 用作 Prerequisites
+	 */
+	template<typename ResultType>
+	class TTracedTask : public UE::Tasks::TTask<ResultType>
+	{
+	public:
+		TTracedTask() = default;
+
+		TTracedTask(UE::Tasks::TTask<ResultType>&& InTask, Trace::FTaskId InTraceId)
+			: UE::Tasks::TTask<ResultType>(MoveTemp(InTask))
+			, TraceId(InTraceId)
+		{
+		}
+
+		Trace::FTaskId GetTraceId() const
+		{
+			return TraceId;
+		}
+
+	private:
+		Trace::FTaskId TraceId = 0;
+	};
+
+	using FTracedTask = TTracedTask<void>;
+
+	/** 先决条件集合: 任务句柄 (传给 Launch) + 追踪 Id (输出依赖边) */
+	struct FTracedPrerequisites
+	{
+		TArray<UE::Tasks::FTask, TInlineAllocator<4>> Tasks;
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+		TArray<Trace::FTaskId, TInlineAllocator<4>> TraceIds;
+#endif
+
+		TConstArrayView<Trace::FTaskId> GetTraceIds() const
+		{
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+			return TraceIds;
+#else
+			return {};
+#endif
+		}
+	};
+
+	/** 与 UE::Tasks::Prerequisites 相同, 接受 TTracedTask */
+	template<typename... TaskTypes>
+	FTracedPrerequisites TracedPrerequisites(const TaskTypes&... InTasks)
+	{
+		FTracedPrerequisites Result;
+		(Result.Tasks.Add(InTasks), ...);
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+		(Result.TraceIds.Add(InTasks.GetTraceId()), ...);
+#endif
+		return Result;
+	}
+
+	namespace Private
+	{
+		template<typename BodyType>
+		auto MakeTracedBody(Trace::FTaskId TraceId, BodyType&& Body)
+		{
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+			return [TraceId, Body = std::decay_t<BodyType>(Forward<BodyType>(Body))]() mutable -> decltype(auto)
+			{
+				UE_TEMPLATESGUIDE_TRACE_EXECUTE_SCOPE(TraceId);
+				return Invoke(Body);
+			};
+#else
+			return std::decay_t<BodyType>(Forward<BodyType>(Body));
+#endif
+		}
+	}
+
+	/** UE::Tasks::Launch + 启动 / 执行追踪 */
+	template<typename BodyType>
+	auto LaunchTraced(const TCHAR* DebugName, BodyType&& Body,
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal,
+		UE::Tasks::EExtendedTaskPriority ExtendedPriority = UE::Tasks::EExtendedTaskPriority::None)
+	{
+		using ResultType = TInvokeResult_T<std::decay_t<BodyType>>;
+
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Launch");
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+		const Trace::FTaskId TraceId = Trace::OutputLaunched(DebugName);
+		return TTracedTask<ResultType>(
+			UE::Tasks::Launch(DebugName, Private::MakeTracedBody(TraceId, Forward<BodyType>(Body)), Priority, ExtendedPriority),
+			TraceId);
+	}
+
+	/** 带先决条件的 LaunchTraced, 每个先决条件输出一条 TaskEdge */
+	template<typename BodyType>
+	auto LaunchTraced(const TCHAR* DebugName, BodyType&& Body, const FTracedPrerequisites& Prerequisites,
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal,
+		UE::Tasks::EExtendedTaskPriority ExtendedPriority = UE::Tasks::EExtendedTaskPriority::None)
+	{
+		using ResultType = TInvokeResult_T<std::decay_t<BodyType>>;
+
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Launch");
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+		const Trace::FTaskId TraceId = Trace::OutputLaunched(DebugName, Prerequisites.GetTraceIds());
+		return TTracedTask<ResultType>(
+			UE::Tasks::Launch(DebugName, Private::MakeTracedBody(TraceId, Forward<BodyType>(Body)), Prerequisites.Tasks, Priority, ExtendedPriority),
+			TraceId);
+	}
+
+	/** FPipe::Launch + 管道入队 / 执行追踪 */
+	template<typename BodyType>
+	auto LaunchTraced(UE::Tasks::FPipe& Pipe, const TCHAR* DebugName, BodyType&& Body,
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal)
+	{
+		using ResultType = TInvokeResult_T<std::decay_t<BodyType>>;
+
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::PipeEnqueue");
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+		const Trace::FTaskId TraceId = Trace::OutputLaunched(DebugName);
+		return TTracedTask<ResultType>(
+			Pipe.Launch(DebugName, Private::MakeTracedBody(TraceId, Forward<BodyType>(Body)), Priority),
+			TraceId);
+	}
+
+	/** 带等待追踪的 Wait; Task.Wait 内部的撤回与阻塞合计为一次 TaskBlockingWait */
+	template<typename TaskType>
+	bool WaitTraced(const TaskType& Task, FTimespan Timeout = FTimespan::MaxValue())
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskBlockingWait);
+		UE_TEMPLATESGUIDE_INC_COUNTER(TaskWaits, 1);
+		return Task.Wait(Timeout);
+	}
+}
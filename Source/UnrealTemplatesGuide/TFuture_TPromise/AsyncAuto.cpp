@@ -0,0 +1,124 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AsyncAuto.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	static float GAsyncAutoInlineCostFactor = 1.0f;
+	static FAutoConsoleVariableRef CVarAsyncAutoInlineCostFactor(
+		TEXT("TemplatesGuide.AsyncAuto.InlineCostFactor"),
+		GAsyncAutoInlineCostFactor,
+		TEXT("AsyncAuto runs non-blocking work inline when its expected duration is at most this many times the measured UE::Tasks dispatch latency. 0 disables inline execution."),
+		ECVF_Default);
+
+	static float GAsyncAutoDedicatedThreadMs = 100.0f;
+	static FAutoConsoleVariableRef CVarAsyncAutoDedicatedThreadMs(
+		TEXT("TemplatesGuide.AsyncAuto.DedicatedThreadMs"),
+		GAsyncAutoDedicatedThreadMs,
+		TEXT("Blocking work expected to take at least this long (ms) gets a dedicated thread instead of a thread pool slot."),
+		ECVF_Default);
+
+	namespace AsyncAutoPrivate
+	{
+		/** 尚无测量时假定的 UE::Tasks 派发延迟 (微秒) */
+		static constexpr double DefaultTasksDispatchMicroseconds = 5.0;
+
+		static constexpr double SmoothingFactor = 0.125;
+
+		struct FBackendCounters
+		{
+			std::atomic<int64> NumDispatched{0};
+			std::atomic<double> DispatchMicroseconds{0.0};
+		};
+
+		static FBackendCounters GCounters[int32(EAsyncAutoBackend::Num)];
+	}
+
+	const TCHAR* LexToString(EAsyncAutoBackend Backend)
+	{
+		switch (Backend)
+		{
+		case EAsyncAutoBackend::Inline: return TEXT("Inline");
+		case EAsyncAutoBackend::Tasks: return TEXT("Tasks");
+		case EAsyncAutoBackend::TaskGraph: return TEXT("TaskGraph");
+		case EAsyncAutoBackend::ThreadPool: return TEXT("ThreadPool");
+		case EAsyncAutoBackend::Thread: return TEXT("Thread");
+		case EAsyncAutoBackend::TaskGraphMainThread: return TEXT("TaskGraphMainThread");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	EAsyncAutoBackend SelectAsyncBackend(const FAsyncWorkHint& Hint)
+	{
+		using namespace AsyncAutoPrivate;
+
+		if (Hint.bGameThread)
+		{
+			return EAsyncAutoBackend::TaskGraphMainThread;
+		}
+
+		if (Hint.bMayBlock)
+		{
+			return Hint.ExpectedMicroseconds >= GAsyncAutoDedicatedThreadMs * 1000.0
+				? EAsyncAutoBackend::Thread
+				: EAsyncAutoBackend::ThreadPool;
+		}
+
+		const double Measured = GCounters[int32(EAsyncAutoBackend::Tasks)].DispatchMicroseconds.load(std::memory_order_relaxed);
+		const double TasksDispatchMicroseconds = Measured > 0.0 ? Measured : DefaultTasksDispatchMicroseconds;
+		// 未给出预计耗时时不内联: 默认构造的 Hint 仍然是异步的
+		if (Hint.ExpectedMicroseconds > 0.0 && Hint.ExpectedMicroseconds <= GAsyncAutoInlineCostFactor * TasksDispatchMicroseconds)
+		{
+			return EAsyncAutoBackend::Inline;
+		}
+
+		return EAsyncAutoBackend::Tasks;
+	}
+
+	FAsyncAutoStats GetAsyncAutoStats()
+	{
+		using namespace AsyncAutoPrivate;
+
+		FAsyncAutoStats Stats;
+		for (int32 Index = 0; Index < int32(EAsyncAutoBackend::Num); ++Index)
+		{
+			Stats.NumDispatched[Index] = GCounters[Index].NumDispatched.load(std::memory_order_relaxed);
+			Stats.DispatchMicroseconds[Index] = GCounters[Index].DispatchMicroseconds.load(std::memory_order_relaxed);
+		}
+		return Stats;
+	}
+
+	void ResetAsyncAutoStats()
+	{
+		using namespace AsyncAutoPrivate;
+
+		for (FBackendCounters& Counters : GCounters)
+		{
+			Counters.NumDispatched.store(0, std::memory_order_relaxed);
+			Counters.DispatchMicroseconds.store(0.0, std::memory_order_relaxed);
+		}
+	}
+
+	namespace Private
+	{
+		void RecordAsyncDispatch(EAsyncAutoBackend Backend, uint64 LaunchCycles)
+		{
+			using namespace AsyncAutoPrivate;
+
+			FBackendCounters& Counters = GCounters[int32(Backend)];
+			Counters.NumDispatched.fetch_add(1, std::memory_order_relaxed);
+
+			if (Backend == EAsyncAutoBackend::Inline)
+			{
+				return;
+			}
+
+			// 并发更新可能丢失个别样本, 对估计值没有影响, 因此不加锁 (与 FBatchCostModel 相同)
+			const double Sample = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - LaunchCycles) * 1000.0;
+			const double Old = Counters.DispatchMicroseconds.load(std::memory_order_relaxed);
+			Counters.DispatchMicroseconds.store(Old <= 0.0 ? Sample : Old + SmoothingFactor * (Sample - Old), std::memory_order_relaxed);
+		}
+	}
+}
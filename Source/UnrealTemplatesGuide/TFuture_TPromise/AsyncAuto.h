@@ -0,0 +1,147 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+/**
+ * 按工作量与是否阻塞自动选择 Async() 的执行后端
+ *
+ * 示例7 列出了 EAsyncExecution 的各个选项, 但它们的派发成本相差几个数量级:
+ *   Thread               每次调用新建一个系统线程 (示例8 的写法), 最贵
+ *   ThreadPool           GThreadPool 的排队线程, 适合会阻塞的工作 (文件 / 网络 / 锁)
+ *   TaskGraph            旧任务图, 与 UE::Tasks 共用工作线程, 包装层更多
+ *   TaskGraphMainThread  排到 GameThread, 延迟取决于帧
+ *   UE::Tasks            TFuture 之外最轻的工作线程派发 (由 AsyncOn(Tasks) 包装为 TFuture)
+ *
+ * SelectAsyncBackend(Hint):
+ *   bGameThread                                    → TaskGraphMainThread
+ *   !bMayBlock 且 0 < Expected <= InlineCostFactor × 测得的 UE::Tasks 派发延迟 → Inline (派发比工作本身还贵)
+ *   bMayBlock 且 Expected >= DedicatedThreadMs     → Thread (长时间阻塞, 不占线程池)
+ *   bMayBlock                                      → ThreadPool (不阻塞任务系统的工作线程)
+ *   其余 (含未给出预计耗时)                        → Tasks
+ *
+ * 预计耗时为 0 (默认) 表示未知: 只有调用方明确说明工作极小时才内联, AsyncAuto({}, ...) 不会在调用线程上同步执行
+ *
+ * 派发延迟 (调用到任务体开始执行) 由 AsyncOn 在每次派发时测量, 按后端做指数滑动平均
+ *
+ *   TFuture<FMeshData> Mesh = AsyncAuto({ .ExpectedMicroseconds = 800.0 }, [] { return BuildMesh(); });
+ *   TFuture<TArray<uint8>> File = AsyncAuto({ .ExpectedMicroseconds = 5000.0, .bMayBlock = true }, [] { return Load(); });
+ */
+namespace UE::TemplatesGuide
+{
+	enum class EAsyncAutoBackend : uint8
+	{
+		/** 在调用线程上立即执行 */
+		Inline,
+
+		/** UE::Tasks::Launch */
+		Tasks,
+
+		/** EAsyncExecution::TaskGraph (SelectAsyncBackend 不会选择, 用于对比) */
+		TaskGraph,
+
+		/** EAsyncExecution::ThreadPool */
+		ThreadPool,
+
+		/** EAsyncExecution::Thread */
+		Thread,
+
+		/** EAsyncExecution::TaskGraphMainThread */
+		TaskGraphMainThread,
+
+		Num,
+	};
+
+	UNREALTEMPLATESGUIDE_API const TCHAR* LexToString(EAsyncAutoBackend Backend);
+
+	/** 调用方对工作的描述 */
+	struct FAsyncWorkHint
+	{
+		/** 预计耗时 (微秒), 0 或负数表示未知 (不会选择 Inline) */
+		double ExpectedMicroseconds = 0.0;
+
+		/** 工作会阻塞 (等待 IO / 锁 / 其他线程) */
+		bool bMayBlock = false;
+
+		/** 工作必须在 GameThread 上执行 */
+		bool bGameThread = false;
+	};
+
+	struct FAsyncAutoStats
+	{
+		int64 NumDispatched[int32(EAsyncAutoBackend::Num)] = {};
+
+		/** 派发延迟的指数滑动平均 (微秒), 0 表示尚未测量 */
+		double DispatchMicroseconds[int32(EAsyncAutoBackend::Num)] = {};
+	};
+
+	UNREALTEMPLATESGUIDE_API EAsyncAutoBackend SelectAsyncBackend(const FAsyncWorkHint& Hint);
+
+	UNREALTEMPLATESGUIDE_API FAsyncAutoStats GetAsyncAutoStats();
+	UNREALTEMPLATESGUIDE_API void ResetAsyncAutoStats();
+
+	namespace Private
+	{
+		/** 记录一次派发: 次数与 LaunchCycles 到现在的延迟 */
+		UNREALTEMPLATESGUIDE_API void RecordAsyncDispatch(EAsyncAutoBackend Backend, uint64 LaunchCycles);
+	}
+
+	/** 在指定后端上执行 Callable, 返回 TFuture; 记录派发次数与延迟 */
+	template<typename CallableType>
+	auto AsyncOn(EAsyncAutoBackend Backend, CallableType&& Callable) -> TFuture<decltype(Forward<CallableType>(Callable)())>
+	{
+		using ResultType = decltype(Forward<CallableType>(Callable)());
+
+		const uint64 LaunchCycles = FPlatformTime::Cycles64();
+		auto Body = [Backend, LaunchCycles, Callable = std::decay_t<CallableType>(Forward<CallableType>(Callable))]() mutable -> ResultType
+		{
+			Private::RecordAsyncDispatch(Backend, LaunchCycles);
+			return Callable();
+		};
+
+		switch (Backend)
+		{
+		case EAsyncAutoBackend::Inline:
+		{
+			TPromise<ResultType> Promise;
+			TFuture<ResultType> Future = Promise.GetFuture();
+			UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+			SetPromise(Promise, Body);
+			return Future;
+		}
+		case EAsyncAutoBackend::Tasks:
+		{
+			TPromise<ResultType> Promise;
+			TFuture<ResultType> Future = Promise.GetFuture();
+			UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+			UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+			UE::Tasks::Launch(TEXT("TemplatesGuide::AsyncAuto"), [Promise = MoveTemp(Promise), Body = MoveTemp(Body)]() mutable
+			{
+				SetPromise(Promise, Body);
+			});
+			return Future;
+		}
+		case EAsyncAutoBackend::TaskGraph:
+			return Async(EAsyncExecution::TaskGraph, MoveTemp(Body));
+		case EAsyncAutoBackend::ThreadPool:
+			return Async(EAsyncExecution::ThreadPool, MoveTemp(Body));
+		case EAsyncAutoBackend::Thread:
+			return Async(EAsyncExecution::Thread, MoveTemp(Body));
+		case EAsyncAutoBackend::TaskGraphMainThread:
+		default:
+			checkSlow(Backend == EAsyncAutoBackend::TaskGraphMainThread);
+			return Async(EAsyncExecution::TaskGraphMainThread, MoveTemp(Body));
+		}
+	}
+
+	/** 按 SelectAsyncBackend(Hint) 选择后端执行 Callable */
+	template<typename CallableType>
+	auto AsyncAuto(const FAsyncWorkHint& Hint, CallableType&& Callable) -> TFuture<decltype(Forward<CallableType>(Callable)())>
+	{
+		return AsyncOn(SelectAsyncBackend(Hint), Forward<CallableType>(Callable));
+	}
+}
@@ -0,0 +1,328 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Tasks/Task.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+/**
+ * TFuture 的组合: WhenAll / WhenAny, 以及 TFuture 与 UE::Tasks::TTask 之间的桥接
+ *
+ * 示例3 / 示例4 只能线性地 Then / Next; UE::Tasks 有 Wait(Tasks) / WaitAny / Any (Tasks_System 示例7),
+ * TFuture 没有对应的组合。常见的替代写法是启动一个任务依次 Get() 每个 Future, 等待期间占住一个线程
+ *
+ * 这里的组合都不阻塞任何线程, 也不加锁:
+ *   WhenAll(Futures)  每个输入 Then 一个续接, 结果写入预分配输出数组的对应槽位,
+ *                     一个原子倒计数归零的续接把整个数组移入输出 Promise
+ *   WhenAny(Futures)  第一个完成的续接通过原子交换认领, 写入结果并完成输出 Promise
+ *   ToTask(Future)    Future 完成时触发事件, 以事件为先决条件的 Inline 任务移出结果
+ *   ToFuture(Task)    以任务为先决条件的 Inline 任务把结果写入 Promise
+ *
+ * 续接在完成输入的线程上执行 (与 Then 相同), 组合本身不会额外启动线程或非内联任务
+ */
+namespace UE::TemplatesGuide
+{
+	/** WhenAny 的结果: 第一个完成的输入下标与它的结果 */
+	template<typename ResultType>
+	struct TWhenAnyResult
+	{
+		int32 Index = INDEX_NONE;
+		ResultType Value;
+	};
+
+	template<>
+	struct TWhenAnyResult<void>
+	{
+		int32 Index = INDEX_NONE;
+	};
+
+	namespace Private
+	{
+		/**
+		 * WhenAll 的结果槽位
+		 *
+		 * 默认可构造的结果直接写入输出数组 (SetNum 预分配), 完成时整个数组移入 Promise, 不再复制一遍;
+		 * 不可默认构造的结果先放进 TOptional 槽位, 完成时再移入输出数组; void 不需要槽位
+		 */
+		template<typename ResultType, bool bDefaultConstructible = std::is_default_constructible_v<ResultType>>
+		struct TWhenAllSlots
+		{
+			void Init(int32 Num)
+			{
+				Values.SetNum(Num);
+			}
+
+			void Set(int32 Index, ResultType&& Value)
+			{
+				Values[Index] = MoveTemp(Value);
+			}
+
+			TArray<ResultType> Take()
+			{
+				return MoveTemp(Values);
+			}
+
+			TArray<ResultType> Values;
+		};
+
+		template<typename ResultType>
+		struct TWhenAllSlots<ResultType, false>
+		{
+			void Init(int32 Num)
+			{
+				Values.SetNum(Num);
+			}
+
+			void Set(int32 Index, ResultType&& Value)
+			{
+				Values[Index].Emplace(MoveTemp(Value));
+			}
+
+			TArray<ResultType> Take()
+			{
+				TArray<ResultType> Output;
+				Output.Reserve(Values.Num());
+				for (TOptional<ResultType>& Value : Values)
+				{
+					Output.Add(MoveTemp(Value.GetValue()));
+				}
+				Values.Empty();
+				return Output;
+			}
+
+			TArray<TOptional<ResultType>> Values;
+		};
+
+		template<>
+		struct TWhenAllSlots<void, false>
+		{
+			void Init(int32 Num)
+			{
+			}
+		};
+
+		template<typename ResultType>
+		struct TWhenAllState
+		{
+			explicit TWhenAllState(int32 Num)
+				: Remaining(Num)
+			{
+				Results.Init(Num);
+			}
+
+			/** 每个输入完成时调用一次; 最后一个完成的输入负责完成输出 */
+			void Arrive()
+			{
+				if (Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					return;
+				}
+
+				if constexpr (std::is_void_v<ResultType>)
+				{
+					Promise.SetValue();
+				}
+				else
+				{
+					Promise.SetValue(Results.Take());
+				}
+			}
+
+			using FOutputType = std::conditional_t<std::is_void_v<ResultType>, void, TArray<ResultType>>;
+
+			TPromise<FOutputType> Promise;
+
+			/** 每个输入只写自己的槽位, 不需要锁; 倒计数的 acq_rel 保证最后一个续接看到全部写入 */
+			TWhenAllSlots<ResultType> Results;
+			std::atomic<int32> Remaining;
+		};
+
+		template<typename ResultType>
+		struct TWhenAnyState
+		{
+			TPromise<TWhenAnyResult<ResultType>> Promise;
+			std::atomic<bool> bClaimed{false};
+		};
+
+		template<typename ResultType>
+		struct TToTaskState
+		{
+			UE::Tasks::FTaskEvent Event{TEXT("TemplatesGuide::FutureToTask")};
+			TOptional<ResultType> Value;
+		};
+
+		template<>
+		struct TToTaskState<void>
+		{
+			UE::Tasks::FTaskEvent Event{TEXT("TemplatesGuide::FutureToTask")};
+		};
+	}
+
+	/**
+	 * 全部输入完成后完成, 结果按输入顺序排列
+	 *
+	 * 输入为空时返回已完成的 Future; 结果从各输入 Consume 移出, 不复制
+	 */
+	template<typename ResultType>
+	auto WhenAll(TArray<TFuture<ResultType>>&& Futures) -> TFuture<typename Private::TWhenAllState<ResultType>::FOutputType>
+	{
+		using FState = Private::TWhenAllState<ResultType>;
+
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>(Futures.Num());
+		auto Output = State->Promise.GetFuture();
+		UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+
+		if (Futures.IsEmpty())
+		{
+			if constexpr (std::is_void_v<ResultType>)
+			{
+				State->Promise.SetValue();
+			}
+			else
+			{
+				State->Promise.SetValue(TArray<ResultType>());
+			}
+			return Output;
+		}
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			check(Futures[Index].IsValid());
+
+			Futures[Index].Then([State, Index](TFuture<ResultType> Completed)
+			{
+				UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(ContinuationRun);
+				UE_TEMPLATESGUIDE_INC_COUNTER(ContinuationsRun, 1);
+
+				if constexpr (!std::is_void_v<ResultType>)
+				{
+					State->Results.Set(Index, Completed.Consume());
+				}
+				State->Arrive();
+			});
+		}
+
+		return Output;
+	}
+
+	/**
+	 * 第一个完成的输入决定结果, 其余输入完成时被忽略
+	 *
+	 * 输入不能为空
+	 */
+	template<typename ResultType>
+	TFuture<TWhenAnyResult<ResultType>> WhenAny(TArray<TFuture<ResultType>>&& Futures)
+	{
+		check(!Futures.IsEmpty());
+
+		using FState = Private::TWhenAnyState<ResultType>;
+
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>();
+		TFuture<TWhenAnyResult<ResultType>> Output = State->Promise.GetFuture();
+		UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+
+		for (int32 Index = 0; Index < Futures.Num(); ++Index)
+		{
+			check(Futures[Index].IsValid());
+
+			Futures[Index].Then([State, Index](TFuture<ResultType> Completed)
+			{
+				UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(ContinuationRun);
+				UE_TEMPLATESGUIDE_INC_COUNTER(ContinuationsRun, 1);
+
+				if (State->bClaimed.exchange(true, std::memory_order_acq_rel))
+				{
+					return;
+				}
+
+				if constexpr (std::is_void_v<ResultType>)
+				{
+					State->Promise.SetValue(TWhenAnyResult<void>{Index});
+				}
+				else
+				{
+					State->Promise.SetValue(TWhenAnyResult<ResultType>{Index, Completed.Consume()});
+				}
+			});
+		}
+
+		return Output;
+	}
+
+	/**
+	 * TFuture → TTask: Future 完成时任务完成, 可以作为其他任务的先决条件
+	 *
+	 * 结果任务是 Inline 的, 在完成 Future 的线程上执行, 不占用额外的工作线程
+	 */
+	template<typename ResultType>
+	UE::Tasks::TTask<ResultType> ToTask(const TCHAR* DebugName, TFuture<ResultType>&& Future)
+	{
+		check(Future.IsValid());
+
+		using FState = Private::TToTaskState<ResultType>;
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>();
+
+		// 先创建结果任务: Future 已就绪时 Then 会立即执行并触发事件
+		UE::Tasks::TTask<ResultType> Task = UE::Tasks::Launch(DebugName,
+			[State]
+			{
+				if constexpr (!std::is_void_v<ResultType>)
+				{
+					return MoveTemp(State->Value.GetValue());
+				}
+			},
+			UE::Tasks::Prerequisites(State->Event),
+			LowLevelTasks::ETaskPriority::Normal,
+			UE::Tasks::EExtendedTaskPriority::Inline);
+
+		Future.Then([State](TFuture<ResultType> Completed)
+		{
+			UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(ContinuationRun);
+			UE_TEMPLATESGUIDE_INC_COUNTER(ContinuationsRun, 1);
+
+			if constexpr (!std::is_void_v<ResultType>)
+			{
+				State->Value.Emplace(Completed.Consume());
+			}
+			State->Event.Trigger();
+		});
+
+		return Task;
+	}
+
+	/**
+	 * TTask → TFuture: 任务完成时 Future 就绪
+	 *
+	 * 结果从任务中移出 (不复制): 转换之后不要再通过其他句柄读取该任务的 GetResult()
+	 */
+	template<typename ResultType>
+	TFuture<ResultType> ToFuture(const TCHAR* DebugName, const UE::Tasks::TTask<ResultType>& Task)
+	{
+		check(Task.IsValid());
+
+		TPromise<ResultType> Promise;
+		TFuture<ResultType> Future = Promise.GetFuture();
+		UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+
+		UE::Tasks::Launch(DebugName,
+			[Promise = MoveTemp(Promise), Task]() mutable
+			{
+				if constexpr (std::is_void_v<ResultType>)
+				{
+					Promise.SetValue();
+				}
+				else
+				{
+					Promise.SetValue(MoveTemp(Task.GetResult()));
+				}
+			},
+			UE::Tasks::Prerequisites(Task),
+			LowLevelTasks::ETaskPriority::Normal,
+			UE::Tasks::EExtendedTaskPriority::Inline);
+
+		return Future;
+	}
+}
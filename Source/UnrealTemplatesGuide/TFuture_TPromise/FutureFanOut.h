@@ -0,0 +1,175 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Tasks/Task.h"
+#include "Tasks_System/ParallelBatch.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+/**
+ * 一个结果广播给多个订阅者, 结果只保存一份
+ *
+ * 示例5 的 TSharedFuture 允许多个消费者 Get(), 但每个消费者若要异步处理结果,
+ * 通常写成 "每个订阅者一个 Then / Async + 按值捕获结果", 一个结果被复制订阅者个次数, 还要每个订阅者一个任务
+ *
+ * TFanOut<T>:
+ *   - 结果从 TFuture 中移出 (Consume), 放进不可变的引用计数缓冲 TSharedRef<const T>, 不复制
+ *   - 订阅者收到 const T& 视图 (或 GetView() 持有的共享引用)
+ *   - 结果就绪时, 已登记的订阅者按块 (SubscribersPerChunk) 分给少量任务执行 (LaunchBatchedRange),
+ *     而不是每个订阅者一个任务
+ *
+ *   TFuture<T> ──Then──► [Consume] ──► TSharedRef<const T>
+ *                                          │
+ *   Subscribe(A) Subscribe(B) ...          ▼
+ *   [A B C D E F G H][I J K ...] ──► 少量任务动态领取块, 块内依次调用
+ *
+ * 结果就绪之后才登记的订阅者各自启动一个任务 (不计入 GetDispatchTask)
+ * TFanOut 是可复制的句柄, 复制共享同一份状态
+ */
+namespace UE::TemplatesGuide
+{
+	struct FFanOutParams
+	{
+		/** 每个任务处理的订阅者数 */
+		int32 SubscribersPerChunk = 8;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	template<typename T>
+	class TFanOut
+	{
+	public:
+		using FSubscriber = TUniqueFunction<void(const T&)>;
+		using FView = TSharedRef<const T, ESPMode::ThreadSafe>;
+
+		explicit TFanOut(TFuture<T>&& Future, const FFanOutParams& Params = FFanOutParams())
+			: State(MakeShared<FState, ESPMode::ThreadSafe>(Params))
+		{
+			check(Future.IsValid());
+
+			Future.Then([State = State](TFuture<T> Completed)
+			{
+				State->Complete(Completed.Consume());
+			});
+		}
+
+		/** 登记订阅者; 结果已就绪时立即启动一个任务执行它 */
+		void Subscribe(FSubscriber&& Subscriber) const
+		{
+			check(Subscriber);
+			State->Subscribe(MoveTemp(Subscriber));
+		}
+
+		bool IsReady() const
+		{
+			return State->GetView().IsValid();
+		}
+
+		/** 结果的共享只读视图, 就绪之前为空 */
+		TSharedPtr<const T, ESPMode::ThreadSafe> GetView() const
+		{
+			return State->GetView();
+		}
+
+		/** 就绪之前登记的订阅者全部执行完后完成 */
+		UE::Tasks::FTask GetDispatchTask() const
+		{
+			return State->DispatchEvent;
+		}
+
+		int32 GetNumSubscribers() const
+		{
+			return State->NumSubscribers.load(std::memory_order_relaxed);
+		}
+
+		/** 就绪时登记的订阅者被分成的块数; 启动的任务数不超过块数与工作线程数的较小者 */
+		int32 GetNumDispatchChunks() const
+		{
+			return State->NumDispatchChunks.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct FState
+		{
+			explicit FState(const FFanOutParams& InParams)
+				: Params(InParams)
+			{
+			}
+
+			void Subscribe(FSubscriber&& Subscriber)
+			{
+				NumSubscribers.fetch_add(1, std::memory_order_relaxed);
+
+				TSharedPtr<const T, ESPMode::ThreadSafe> Ready;
+				{
+					FScopeLock Lock(&Mutex);
+					if (!Value.IsValid())
+					{
+						Pending.Add(MoveTemp(Subscriber));
+						return;
+					}
+					Ready = Value;
+				}
+
+				UE::Tasks::Launch(TEXT("TemplatesGuide::FanOutLate"),
+					[Subscriber = MoveTemp(Subscriber), View = Ready.ToSharedRef()] { Subscriber(*View); },
+					Params.Priority);
+			}
+
+			void Complete(T&& Result)
+			{
+				FView View = MakeShared<T, ESPMode::ThreadSafe>(MoveTemp(Result));
+
+				TArray<FSubscriber> Subscribers;
+				{
+					FScopeLock Lock(&Mutex);
+					Value = View;
+					Subscribers = MoveTemp(Pending);
+				}
+
+				const int32 Num = Subscribers.Num();
+				if (Num > 0)
+				{
+					FBatchLaunchParams BatchParams;
+					BatchParams.InitialChunkSize = FMath::Max(1, Params.SubscribersPerChunk);
+					BatchParams.MinChunksPerTask = 1;
+					BatchParams.Priority = Params.Priority;
+					BatchParams.bInlineSingleChunk = false;
+
+					NumDispatchChunks.store(FMath::DivideAndRoundUp(Num, BatchParams.InitialChunkSize), std::memory_order_relaxed);
+
+					DispatchEvent.AddPrerequisites(LaunchBatchedRange(TEXT("TemplatesGuide::FanOut"), Num,
+						[Subscribers = MoveTemp(Subscribers), View](int32 Begin, int32 End)
+						{
+							for (int32 Index = Begin; Index < End; ++Index)
+							{
+								Subscribers[Index](*View);
+							}
+						},
+						BatchParams));
+				}
+				DispatchEvent.Trigger();
+			}
+
+			TSharedPtr<const T, ESPMode::ThreadSafe> GetView() const
+			{
+				FScopeLock Lock(&Mutex);
+				return Value;
+			}
+
+			const FFanOutParams Params;
+			mutable FCriticalSection Mutex;
+			TArray<FSubscriber> Pending;
+			TSharedPtr<const T, ESPMode::ThreadSafe> Value;
+			UE::Tasks::FTaskEvent DispatchEvent{TEXT("TemplatesGuide::FanOutDispatched")};
+			std::atomic<int32> NumSubscribers{0};
+			std::atomic<int32> NumDispatchChunks{0};
+		};
+
+		TSharedRef<FState, ESPMode::ThreadSafe> State;
+	};
+}
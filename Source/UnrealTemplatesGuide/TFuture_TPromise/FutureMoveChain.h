@@ -0,0 +1,172 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include <atomic>
+
+/**
+ * 只移动的 TFuture 链
+ *
+ * TFuture 本身在链中传递结果时不复制:
+ *   - Then:  SetPromiseValue → Promise.SetValue(Continuation(MoveTemp(Future)))   结果移动进下一个 Promise
+ *   - Next:  Continuation(Self.Consume())                                         Consume 移动出结果
+ * 复制来自写法:
+ *   - Then 中用 Future.Get() 取值 (返回 const&, 再按值使用就是一次复制)
+ *   - 回调返回 const T& 或捕获的成员 (返回值从引用复制构造)
+ *   - TSharedFuture (多个消费者只能 Get)
+ *
+ * 这里的辅助:
+ *   MoveNext(MoveTemp(Future), Step)              Step 以 T&& 接收上一阶段结果, 检查返回值不是引用
+ *   MoveChain(MoveTemp(Future), Step1, Step2 ...) 多阶段链
+ *   TMoveOnly<T>                                  删除复制构造的包装, 任何意外复制都变成编译错误
+ *   FCopyCountingPayload                          统计复制 / 移动次数的负载, 用于示例10 与基准 Future.MoveChain
+ *
+ *   TFuture<TMoveOnly<TArray<uint8>>> Result = MoveChain(Promise.GetFuture(),
+ *       [](TMoveOnly<TArray<uint8>>&& Data) { Data->Add(1); return MoveTemp(Data); },
+ *       [](TMoveOnly<TArray<uint8>>&& Data) { Compress(*Data); return MoveTemp(Data); });
+ */
+namespace UE::TemplatesGuide
+{
+	/**
+	 * 只可移动的值包装
+	 *
+	 * 对 TArray / FString 这类可复制的类型, 编译器不会阻止 "少写一个 MoveTemp" 导致的复制;
+	 * 包装后这些位置直接编译失败
+	 */
+	template<typename T>
+	class TMoveOnly
+	{
+	public:
+		TMoveOnly() = default;
+
+		explicit TMoveOnly(T&& InValue)
+			: Value(MoveTemp(InValue))
+		{
+		}
+
+		template<typename... ArgTypes>
+		explicit TMoveOnly(EInPlace, ArgTypes&&... Args)
+			: Value(Forward<ArgTypes>(Args)...)
+		{
+		}
+
+		TMoveOnly(TMoveOnly&&) = default;
+		TMoveOnly& operator=(TMoveOnly&&) = default;
+		TMoveOnly(const TMoveOnly&) = delete;
+		TMoveOnly& operator=(const TMoveOnly&) = delete;
+
+		T& Get() { return Value; }
+		const T& Get() const { return Value; }
+
+		T& operator*() { return Value; }
+		const T& operator*() const { return Value; }
+		T* operator->() { return &Value; }
+		const T* operator->() const { return &Value; }
+
+		/** 移出值, 包装之后处于被移动状态 */
+		T Release() { return MoveTemp(Value); }
+
+	private:
+		T Value;
+	};
+
+	/**
+	 * Future.Next 的只移动版本
+	 *
+	 * Step(ResultType&&) 接管上一阶段的结果; 返回值必须是值类型 (返回引用会在写入下一个 Promise 时复制)
+	 */
+	template<typename ResultType, typename StepType>
+	auto MoveNext(TFuture<ResultType>&& Future, StepType&& Step)
+	{
+		static_assert(!std::is_void_v<ResultType>, "MoveNext requires a value; use Future.Next for void futures");
+		static_assert(std::is_invocable_v<std::decay_t<StepType>&, ResultType&&>, "Step must accept ResultType&&");
+
+		using StepResultType = std::invoke_result_t<std::decay_t<StepType>&, ResultType&&>;
+		static_assert(!std::is_reference_v<StepResultType>, "Step must return by value, a returned reference is copied into the next promise");
+
+		return Future.Next([Step = Forward<StepType>(Step)](ResultType&& Value) mutable -> StepResultType
+		{
+			return Invoke(Step, MoveTemp(Value));
+		});
+	}
+
+	template<typename ResultType>
+	TFuture<ResultType> MoveChain(TFuture<ResultType>&& Future)
+	{
+		return MoveTemp(Future);
+	}
+
+	/** 依次对 Future 应用 MoveNext, 返回最后一个阶段的 Future */
+	template<typename ResultType, typename StepType, typename... OtherStepTypes>
+	auto MoveChain(TFuture<ResultType>&& Future, StepType&& Step, OtherStepTypes&&... OtherSteps)
+	{
+		return MoveChain(MoveNext(MoveTemp(Future), Forward<StepType>(Step)), Forward<OtherStepTypes>(OtherSteps)...);
+	}
+
+	/**
+	 * 统计复制与移动次数的负载
+	 *
+	 * 计数为全局值, 测量前调用 ResetCounters; 只用于示例与基准
+	 */
+	struct FCopyCountingPayload
+	{
+		TArray<uint8> Bytes;
+
+		FCopyCountingPayload() = default;
+
+		explicit FCopyCountingPayload(int32 NumBytes)
+		{
+			Bytes.SetNumZeroed(NumBytes);
+		}
+
+		FCopyCountingPayload(const FCopyCountingPayload& Other)
+			: Bytes(Other.Bytes)
+		{
+			RecordCopy();
+		}
+
+		FCopyCountingPayload(FCopyCountingPayload&& Other)
+			: Bytes(MoveTemp(Other.Bytes))
+		{
+			NumMoves.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		FCopyCountingPayload& operator=(const FCopyCountingPayload& Other)
+		{
+			Bytes = Other.Bytes;
+			RecordCopy();
+			return *this;
+		}
+
+		FCopyCountingPayload& operator=(FCopyCountingPayload&& Other)
+		{
+			Bytes = MoveTemp(Other.Bytes);
+			NumMoves.fetch_add(1, std::memory_order_relaxed);
+			return *this;
+		}
+
+		static void ResetCounters()
+		{
+			NumCopies.store(0, std::memory_order_relaxed);
+			NumMoves.store(0, std::memory_order_relaxed);
+			NumBytesCopied.store(0, std::memory_order_relaxed);
+		}
+
+		static int64 GetNumCopies() { return NumCopies.load(std::memory_order_relaxed); }
+		static int64 GetNumMoves() { return NumMoves.load(std::memory_order_relaxed); }
+		static int64 GetNumBytesCopied() { return NumBytesCopied.load(std::memory_order_relaxed); }
+
+	private:
+		void RecordCopy() const
+		{
+			NumCopies.fetch_add(1, std::memory_order_relaxed);
+			NumBytesCopied.fetch_add(Bytes.Num(), std::memory_order_relaxed);
+		}
+
+		static inline std::atomic<int64> NumCopies{0};
+		static inline std::atomic<int64> NumMoves{0};
+		static inline std::atomic<int64> NumBytesCopied{0};
+	};
+}
@@ -0,0 +1,170 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameThreadCompletionSink.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/Async.h"
+#include "Stats/Stats.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace UE::TemplatesGuide
+{
+	static float GCompletionSinkBudgetUs = 1000.0f;
+	static FAutoConsoleVariableRef CVarCompletionSinkBudgetUs(
+		TEXT("TemplatesGuide.CompletionSink.BudgetUs"),
+		GCompletionSinkBudgetUs,
+		TEXT("Per-frame game thread time budget for FGameThreadCompletionSink, in microseconds. <= 0 drains everything each frame."),
+		ECVF_Default);
+
+	/** 只由 GameThread 上的 Startup / Shutdown 写入, 任意线程读取 */
+	static std::atomic<FGameThreadCompletionSink*> GCompletionSinkInstance{nullptr};
+
+	void FGameThreadCompletionSink::Startup()
+	{
+		check(IsInGameThread());
+		check(GCompletionSinkInstance.load(std::memory_order_relaxed) == nullptr);
+
+		GCompletionSinkInstance.store(new FGameThreadCompletionSink(), std::memory_order_release);
+	}
+
+	void FGameThreadCompletionSink::Shutdown()
+	{
+		check(IsInGameThread());
+
+		// 调用方保证此后不再有工作线程 Post (模块卸载时工作已经停止)
+		delete GCompletionSinkInstance.exchange(nullptr, std::memory_order_acq_rel);
+	}
+
+	FGameThreadCompletionSink& FGameThreadCompletionSink::Get()
+	{
+		FGameThreadCompletionSink* Instance = TryGet();
+		checkf(Instance, TEXT("FGameThreadCompletionSink used before StartupModule or after ShutdownModule"));
+		return *Instance;
+	}
+
+	FGameThreadCompletionSink* FGameThreadCompletionSink::TryGet()
+	{
+		return GCompletionSinkInstance.load(std::memory_order_acquire);
+	}
+
+	void FGameThreadCompletionSink::PostToGameThread(FCompletion&& Completion)
+	{
+		if (FGameThreadCompletionSink* Instance = TryGet())
+		{
+			Instance->Post(MoveTemp(Completion));
+			return;
+		}
+
+		ensureMsgf(false, TEXT("FGameThreadCompletionSink is not running; falling back to AsyncTask on the game thread"));
+		if (FTaskGraphInterface::IsRunning())
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Completion));
+		}
+	}
+
+	FGameThreadCompletionSink::FGameThreadCompletionSink()
+	{
+		check(IsInGameThread());
+	}
+
+	FGameThreadCompletionSink::~FGameThreadCompletionSink()
+	{
+		// 退出时丢弃积压的回调: 它们捕获的对象此时可能已经销毁
+		Queue.Empty();
+	}
+
+	void FGameThreadCompletionSink::Post(FCompletion&& Completion)
+	{
+		check(Completion);
+
+		Queue.Enqueue(MoveTemp(Completion));
+		NumPosted.fetch_add(1, std::memory_order_release);
+	}
+
+	int32 FGameThreadCompletionSink::Flush()
+	{
+		check(IsInGameThread());
+		return Dispatch(0);
+	}
+
+	FCompletionSinkStats FGameThreadCompletionSink::GetStats() const
+	{
+		FCompletionSinkStats Stats;
+		Stats.NumDispatched = NumDispatched.load(std::memory_order_relaxed);
+		Stats.NumPosted = NumPosted.load(std::memory_order_acquire);
+		Stats.BacklogDepth = FMath::Max<int64>(0, Stats.NumPosted - Stats.NumDispatched);
+		Stats.PeakBacklogDepth = PeakBacklogDepth.load(std::memory_order_relaxed);
+		Stats.NumFramesOverBudget = NumFramesOverBudget.load(std::memory_order_relaxed);
+		Stats.LastFrameDispatched = LastFrameDispatched.load(std::memory_order_relaxed);
+		Stats.LastFrameMicroseconds = LastFrameMicroseconds.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	void FGameThreadCompletionSink::ResetStats()
+	{
+		check(IsInGameThread());
+
+		// NumPosted / NumDispatched 决定积压深度, 一起减去已执行的部分
+		const int64 Dispatched = NumDispatched.exchange(0, std::memory_order_relaxed);
+		NumPosted.fetch_sub(Dispatched, std::memory_order_relaxed);
+		PeakBacklogDepth.store(0, std::memory_order_relaxed);
+		NumFramesOverBudget.store(0, std::memory_order_relaxed);
+	}
+
+	void FGameThreadCompletionSink::Tick(float DeltaTime)
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::CompletionDrain");
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const uint64 BudgetCycles = GCompletionSinkBudgetUs > 0.0f
+			? FMath::Max<uint64>(1, uint64(GCompletionSinkBudgetUs / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0)))
+			: 0;
+
+		const int32 Dispatched = Dispatch(BudgetCycles);
+
+		// 投递计数在入队之后才增加, 积压深度只是近似值
+		const int64 Backlog = FMath::Max<int64>(0, NumPosted.load(std::memory_order_acquire) - NumDispatched.load(std::memory_order_relaxed));
+		if (BudgetCycles != 0 && !Queue.IsEmpty())
+		{
+			NumFramesOverBudget.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (Backlog > PeakBacklogDepth.load(std::memory_order_relaxed))
+		{
+			PeakBacklogDepth.store(Backlog, std::memory_order_relaxed);
+		}
+
+		LastFrameDispatched.store(Dispatched, std::memory_order_relaxed);
+		LastFrameMicroseconds.store(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0, std::memory_order_relaxed);
+	}
+
+	TStatId FGameThreadCompletionSink::GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FGameThreadCompletionSink, STATGROUP_Tickables);
+	}
+
+	int32 FGameThreadCompletionSink::Dispatch(uint64 BudgetCycles)
+	{
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(ContinuationRun);
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		int32 Dispatched = 0;
+		FCompletion Completion;
+		while (Queue.Dequeue(Completion))
+		{
+			Completion();
+			Completion.Reset();
+			++Dispatched;
+			NumDispatched.fetch_add(1, std::memory_order_relaxed);
+
+			// 先执行再检查: 每帧至少处理一个回调
+			if (BudgetCycles != 0 && FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+			{
+				break;
+			}
+		}
+
+		UE_TEMPLATESGUIDE_INC_COUNTER(ContinuationsRun, Dispatched);
+		return Dispatched;
+	}
+}
@@ -0,0 +1,131 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Containers/Queue.h"
+#include "Async/Future.h"
+#include <atomic>
+
+/**
+ * 按帧时间预算分发的 GameThread 完成回调
+ *
+ * 示例8 中每个结果都用一次 AsyncTask(ENamedThreads::GameThread, ...) 回到 GameThread:
+ *   - 每个结果一个任务, 结果密集时 GameThread 的任务队列被淹没
+ *   - GameThread 在处理命名线程任务时没有时间上限, 一次性全部执行 → 帧尖峰
+ *
+ * FGameThreadCompletionSink 的做法:
+ *   - 工作线程把完成回调写入无锁 MPSC 队列 (TQueue<..., EQueueMode::Mpsc>), 不创建任务
+ *   - GameThread 在 Tick 中按预算 (TemplatesGuide.CompletionSink.BudgetUs) 排空队列
+ *   - 超出预算的回调留在队列中, 下一帧继续 (FIFO 顺序不变)
+ *   - GetStats 返回积压深度 / 峰值 / 超预算帧数
+ *
+ *   Worker 0 ─┐                         ┌──── GameThread Tick ────┐
+ *   Worker 1 ─┼─ Post(Callback) ─► [Q] ─┤ Callback × N, 直到队列空 │
+ *   Worker N ─┘                         │ 或用完本帧预算          │
+ *                                       └─────────────────────────┘
+ *                                         剩余 → 下一帧
+ *
+ * 每次 Post 至少会在某一帧被执行; 每帧至少执行一个回调, 保证预算很小时也能前进
+ *
+ * 生命周期: 全局实例由模块的 StartupModule / ShutdownModule 在 GameThread 上创建与销毁,
+ * Get 不会创建实例 (工作线程上首次使用时构造会违反 FTickableGameObject 的线程要求,
+ * 静态析构又晚于引擎与控制台变量的销毁)
+ */
+namespace UE::TemplatesGuide
+{
+	/** FGameThreadCompletionSink 统计快照 */
+	struct FCompletionSinkStats
+	{
+		int64 NumPosted = 0;
+		int64 NumDispatched = 0;
+
+		/** 当前积压 (已 Post, 尚未执行) */
+		int64 BacklogDepth = 0;
+
+		/** 帧末积压的峰值 */
+		int64 PeakBacklogDepth = 0;
+
+		/** 因预算耗尽而把回调留到下一帧的帧数 */
+		int64 NumFramesOverBudget = 0;
+
+		/** 最近一帧 */
+		int32 LastFrameDispatched = 0;
+		double LastFrameMicroseconds = 0.0;
+	};
+
+	class UNREALTEMPLATESGUIDE_API FGameThreadCompletionSink : public FTickableGameObject
+	{
+	public:
+		using FCompletion = TUniqueFunction<void()>;
+
+		/** GameThread: 创建全局实例, 由 FUnrealTemplatesGuideModule::StartupModule 调用 */
+		static void Startup();
+
+		/** GameThread: 销毁全局实例并丢弃积压, 由 FUnrealTemplatesGuideModule::ShutdownModule 调用, 可重复调用 */
+		static void Shutdown();
+
+		/** 全局实例; StartupModule 之前或 ShutdownModule 之后调用会断言 */
+		static FGameThreadCompletionSink& Get();
+
+		/** 全局实例, 不存在时返回空 */
+		static FGameThreadCompletionSink* TryGet();
+
+		/** 任意线程: 全局实例存在时 Post, 否则 ensure 并退回 AsyncTask(ENamedThreads::GameThread, ...) */
+		static void PostToGameThread(FCompletion&& Completion);
+
+		virtual ~FGameThreadCompletionSink() override;
+
+		UE_NONCOPYABLE(FGameThreadCompletionSink);
+
+		/** 任意线程: 投递一个在 GameThread 上执行的回调 */
+		void Post(FCompletion&& Completion);
+
+		/** Future 完成后把结果交给 GameThread 上的 Callback (替代 Next + AsyncTask) */
+		template<typename ResultType, typename CallbackType>
+		void NextOnGameThread(TFuture<ResultType>&& Future, CallbackType&& Callback)
+		{
+			Future.Next([this, Callback = Forward<CallbackType>(Callback)](ResultType Result) mutable
+			{
+				Post([Callback = MoveTemp(Callback), Result = MoveTemp(Result)]() mutable
+				{
+					Invoke(Callback, MoveTemp(Result));
+				});
+			});
+		}
+
+		/** GameThread: 忽略预算执行所有积压的回调, 返回执行数量 */
+		int32 Flush();
+
+		FCompletionSinkStats GetStats() const;
+
+		/** 清空累计统计 (不影响积压) */
+		void ResetStats();
+
+		//~ Begin FTickableGameObject Interface
+		virtual void Tick(float DeltaTime) override;
+		virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+		virtual bool IsTickableWhenPaused() const override { return true; }
+		virtual bool IsTickableInEditor() const override { return true; }
+		virtual TStatId GetStatId() const override;
+		//~ End FTickableGameObject Interface
+
+	private:
+		FGameThreadCompletionSink();
+
+		/** 执行回调直到队列为空或超出 BudgetCycles (0 表示不限), 返回执行数量 */
+		int32 Dispatch(uint64 BudgetCycles);
+
+		TQueue<FCompletion, EQueueMode::Mpsc> Queue;
+
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int64> NumPosted{0};
+
+		// 以下只由 GameThread 写入
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int64> NumDispatched{0};
+		std::atomic<int64> PeakBacklogDepth{0};
+		std::atomic<int64> NumFramesOverBudget{0};
+		std::atomic<int32> LastFrameDispatched{0};
+		std::atomic<double> LastFrameMicroseconds{0.0};
+	};
+}
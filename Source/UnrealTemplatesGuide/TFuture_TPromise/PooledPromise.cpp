@@ -0,0 +1,136 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PooledPromise.h"
+#include "HAL/PlatformProcess.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace UE::TemplatesGuide
+{
+	namespace PooledPromisePrivate
+	{
+		/** 阻塞之前的自旋次数, 每次之间让出时间片 */
+		static constexpr int32 MaxSpins = 64;
+
+		struct FCounters
+		{
+			std::atomic<int64> NumAcquired{0};
+			std::atomic<int64> NumBlocksAllocated{0};
+			std::atomic<int64> NumEventsCreated{0};
+			std::atomic<int64> NumSpinWaits{0};
+			std::atomic<int64> NumBlockingWaits{0};
+		};
+
+		static FCounters GCounters;
+	}
+
+	FPooledPromiseStats GetPooledPromiseStats()
+	{
+		using namespace PooledPromisePrivate;
+
+		FPooledPromiseStats Stats;
+		Stats.NumAcquired = GCounters.NumAcquired.load(std::memory_order_relaxed);
+		Stats.NumBlocksAllocated = GCounters.NumBlocksAllocated.load(std::memory_order_relaxed);
+		Stats.NumEventsCreated = GCounters.NumEventsCreated.load(std::memory_order_relaxed);
+		Stats.NumSpinWaits = GCounters.NumSpinWaits.load(std::memory_order_relaxed);
+		Stats.NumBlockingWaits = GCounters.NumBlockingWaits.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	void ResetPooledPromiseStats()
+	{
+		using namespace PooledPromisePrivate;
+
+		GCounters.NumAcquired.store(0, std::memory_order_relaxed);
+		GCounters.NumBlocksAllocated.store(0, std::memory_order_relaxed);
+		GCounters.NumEventsCreated.store(0, std::memory_order_relaxed);
+		GCounters.NumSpinWaits.store(0, std::memory_order_relaxed);
+		GCounters.NumBlockingWaits.store(0, std::memory_order_relaxed);
+	}
+
+	namespace Private
+	{
+		void FPooledStateBase::MarkReady()
+		{
+			const uint32 OldFlags = Flags.fetch_or(ReadyFlag, std::memory_order_acq_rel);
+			check((OldFlags & ReadyFlag) == 0);
+
+			if (OldFlags & WaitingFlag)
+			{
+				Event->Trigger();
+			}
+		}
+
+		bool FPooledStateBase::Wait(FTimespan Timeout)
+		{
+			using namespace PooledPromisePrivate;
+
+			for (int32 Spin = 0; Spin < MaxSpins; ++Spin)
+			{
+				if (IsReady())
+				{
+					GCounters.NumSpinWaits.fetch_add(1, std::memory_order_relaxed);
+					return true;
+				}
+				FPlatformProcess::Yield();
+			}
+
+			if (Event == nullptr)
+			{
+				// 手动重置: 超时后再次等待, 或 Trigger 之后的多次 Wait 都能立即返回
+				Event = FPlatformProcess::GetSynchEventFromPool(true);
+				GCounters.NumEventsCreated.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// 与 MarkReady 的 fetch_or 配对: 两者之中后执行的一方看到对方的标志
+			const uint32 OldFlags = Flags.fetch_or(WaitingFlag, std::memory_order_acq_rel);
+			if (OldFlags & ReadyFlag)
+			{
+				GCounters.NumSpinWaits.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			GCounters.NumBlockingWaits.fetch_add(1, std::memory_order_relaxed);
+			if (Timeout == FTimespan::MaxValue())
+			{
+				Event->Wait();
+				return true;
+			}
+
+			Event->Wait(Timeout);
+			return IsReady();
+		}
+
+		void FPooledStateBase::ResetForReuse()
+		{
+			Flags.store(0, std::memory_order_relaxed);
+			if (Event)
+			{
+				Event->Reset();
+			}
+		}
+
+		void FPooledStateBase::RecordAcquire(bool bAllocated, SIZE_T BlockSize)
+		{
+			using namespace PooledPromisePrivate;
+
+			GCounters.NumAcquired.fetch_add(1, std::memory_order_relaxed);
+			UE_TEMPLATESGUIDE_INC_COUNTER(PromisesCreated, 1);
+			if (bAllocated)
+			{
+				GCounters.NumBlocksAllocated.fetch_add(1, std::memory_order_relaxed);
+				UE_TEMPLATESGUIDE_INC_COUNTER(PromiseBlocksAllocated, 1);
+				Stats::AddToGauge(Stats::EGauge::PromisePoolBlocks, 1);
+				Stats::AddToGauge(Stats::EGauge::PromisePoolMemory, int64(BlockSize));
+			}
+		}
+
+		void FPooledStateBase::RecordBlocksFreed(int32 NumBlocks, SIZE_T BlockSize)
+		{
+			if (NumBlocks > 0)
+			{
+				Stats::AddToGauge(Stats::EGauge::PromisePoolBlocks, -NumBlocks);
+				Stats::AddToGauge(Stats::EGauge::PromisePoolMemory, -int64(NumBlocks * BlockSize));
+			}
+		}
+	}
+}
@@ -0,0 +1,342 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LockFreeList.h"
+#include "HAL/Event.h"
+#include <atomic>
+
+/**
+ * 池化的 Promise / Future
+ *
+ * 每个 TPromise<T> 会在堆上分配共享状态 (TFutureState), 状态构造时还会取一个 FEvent (FEventRef);
+ * 请求 / 响应式的 RPC 每分钟创建上百万个 Promise 时, 这些分配与事件的创建 / 归还成为热点
+ *
+ * TPooledPromise<T> / TPooledFuture<T>:
+ *   - 共享状态块从每个 T 一个的无锁空闲链表 (TLockFreePointerListUnordered) 取出, 双方都释放后归还
+ *   - 等待先自旋 (多数 RPC 的响应在微秒内到达), 仍未就绪才阻塞;
+ *     阻塞用的 FEvent 只在第一次需要时从事件池取出, 之后随状态块一起复用, 没有等待者时 SetValue 不触发事件
+ *   - 语义与 TPromise / TFuture 相同: GetFuture 只能调用一次, SetValue 只能调用一次,
+ *     Get 返回 const&, Consume 移出结果并使 Future 失效
+ *
+ *   Producer                         Consumer
+ *   SetValue ─► 写入结果           Wait: 自旋 ─► Flags |= Waiting ─► Event->Wait
+ *            ─► Flags |= Ready      
+ *            ─► 之前有 Waiting? ─► Event->Trigger
+ *
+ * 状态块在进程生命周期内不释放 (与 TLockFreeFixedSizeAllocator 相同), TrimPool() 可以主动释放空闲块
+ * GetPooledPromiseStats() 返回取出 / 新分配的块数、创建的事件数与两种等待的次数
+ * 同样的数据也进入 stat TemplatesGuide (PromisesCreated / PromiseBlocksAllocated / PromisePoolBlocks / PromisePoolMemory)
+ */
+namespace UE::TemplatesGuide
+{
+	struct FPooledPromiseStats
+	{
+		/** 取出的状态块 (每个 Promise 一次) */
+		int64 NumAcquired = 0;
+
+		/** 其中空闲链表为空、从堆上新分配的块 */
+		int64 NumBlocksAllocated = 0;
+
+		/** 从事件池取出的事件 (每个状态块最多一次) */
+		int64 NumEventsCreated = 0;
+
+		/** 自旋期间就绪的等待 */
+		int64 NumSpinWaits = 0;
+
+		/** 进入事件等待的等待 */
+		int64 NumBlockingWaits = 0;
+	};
+
+	UNREALTEMPLATESGUIDE_API FPooledPromiseStats GetPooledPromiseStats();
+	UNREALTEMPLATESGUIDE_API void ResetPooledPromiseStats();
+
+	namespace Private
+	{
+		/** 与结果类型无关的部分: 引用计数、就绪标志与等待 */
+		struct FPooledStateBase
+		{
+			static constexpr uint32 ReadyFlag = 1 << 0;
+			static constexpr uint32 WaitingFlag = 1 << 1;
+
+			/** Promise 与 Future 各持有一个引用 */
+			std::atomic<int32> RefCount{0};
+			std::atomic<uint32> Flags{0};
+
+			/** 只由等待方创建; 标记 WaitingFlag 之后生产方才会读取 */
+			FEvent* Event = nullptr;
+
+			bool IsReady() const
+			{
+				return (Flags.load(std::memory_order_acquire) & ReadyFlag) != 0;
+			}
+
+			/** 结果写入之后调用 */
+			UNREALTEMPLATESGUIDE_API void MarkReady();
+
+			/** 自旋后阻塞等待, 超时返回 false */
+			UNREALTEMPLATESGUIDE_API bool Wait(FTimespan Timeout);
+
+			/** 归还空闲链表之前调用 */
+			UNREALTEMPLATESGUIDE_API void ResetForReuse();
+
+			UNREALTEMPLATESGUIDE_API static void RecordAcquire(bool bAllocated, SIZE_T BlockSize);
+
+			/** TrimPooledPromisePool 释放了 NumBlocks 个块 */
+			UNREALTEMPLATESGUIDE_API static void RecordBlocksFreed(int32 NumBlocks, SIZE_T BlockSize);
+		};
+
+		template<typename T>
+		struct TPooledState : FPooledStateBase
+		{
+			using FValueType = std::conditional_t<std::is_void_v<T>, bool, T>;
+
+			TOptional<FValueType> Value;
+
+			static TLockFreePointerListUnordered<TPooledState, PLATFORM_CACHE_LINE_SIZE>& GetPool()
+			{
+				static TLockFreePointerListUnordered<TPooledState, PLATFORM_CACHE_LINE_SIZE> Pool;
+				return Pool;
+			}
+
+			static TPooledState* Acquire()
+			{
+				TPooledState* State = GetPool().Pop();
+				RecordAcquire(State == nullptr, sizeof(TPooledState));
+				if (State == nullptr)
+				{
+					State = new TPooledState();
+				}
+
+				State->RefCount.store(2, std::memory_order_relaxed);
+				return State;
+			}
+
+			void Release()
+			{
+				if (RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					Value.Reset();
+					ResetForReuse();
+					GetPool().Push(this);
+				}
+			}
+		};
+	}
+
+	template<typename T>
+	class TPooledPromise;
+
+	template<typename T>
+	class TPooledFuture
+	{
+	public:
+		/** void 结果在状态块中存为 bool, 使下面带 requires 的成员对 void 也是合法的声明 */
+		using FValueType = typename Private::TPooledState<T>::FValueType;
+
+		TPooledFuture() = default;
+
+		TPooledFuture(TPooledFuture&& Other)
+			: State(Other.State)
+		{
+			Other.State = nullptr;
+		}
+
+		TPooledFuture& operator=(TPooledFuture&& Other)
+		{
+			if (this != &Other)
+			{
+				Reset();
+				State = Other.State;
+				Other.State = nullptr;
+			}
+			return *this;
+		}
+
+		TPooledFuture(const TPooledFuture&) = delete;
+		TPooledFuture& operator=(const TPooledFuture&) = delete;
+
+		~TPooledFuture()
+		{
+			Reset();
+		}
+
+		bool IsValid() const
+		{
+			return State != nullptr;
+		}
+
+		bool IsReady() const
+		{
+			return State != nullptr && State->IsReady();
+		}
+
+		void Wait() const
+		{
+			check(IsValid());
+			State->Wait(FTimespan::MaxValue());
+		}
+
+		/** @return 超时之前就绪时返回 true */
+		bool WaitFor(FTimespan Timeout) const
+		{
+			check(IsValid());
+			return State->Wait(Timeout);
+		}
+
+		/** 等待并返回结果的只读引用, Future 保持有效 */
+		const FValueType& Get() const requires(!std::is_void_v<T>)
+		{
+			Wait();
+			return State->Value.GetValue();
+		}
+
+		void Get() const requires(std::is_void_v<T>)
+		{
+			Wait();
+		}
+
+		/** 等待并移出结果, 之后 Future 失效 (状态块归还空闲链表) */
+		FValueType Consume() requires(!std::is_void_v<T>)
+		{
+			Wait();
+			FValueType Result = MoveTemp(State->Value.GetValue());
+			Reset();
+			return Result;
+		}
+
+		void Consume() requires(std::is_void_v<T>)
+		{
+			Wait();
+			Reset();
+		}
+
+		void Reset()
+		{
+			if (State)
+			{
+				State->Release();
+				State = nullptr;
+			}
+		}
+
+	private:
+		friend class TPooledPromise<T>;
+
+		explicit TPooledFuture(Private::TPooledState<T>* InState)
+			: State(InState)
+		{
+		}
+
+		Private::TPooledState<T>* State = nullptr;
+	};
+
+	template<typename T>
+	class TPooledPromise
+	{
+	public:
+		using FValueType = typename Private::TPooledState<T>::FValueType;
+
+		TPooledPromise()
+			: State(Private::TPooledState<T>::Acquire())
+		{
+		}
+
+		TPooledPromise(TPooledPromise&& Other)
+			: State(Other.State)
+			, bFutureRetrieved(Other.bFutureRetrieved)
+		{
+			Other.State = nullptr;
+		}
+
+		TPooledPromise& operator=(TPooledPromise&& Other)
+		{
+			if (this != &Other)
+			{
+				Reset();
+				State = Other.State;
+				bFutureRetrieved = Other.bFutureRetrieved;
+				Other.State = nullptr;
+			}
+			return *this;
+		}
+
+		TPooledPromise(const TPooledPromise&) = delete;
+		TPooledPromise& operator=(const TPooledPromise&) = delete;
+
+		~TPooledPromise()
+		{
+			Reset();
+		}
+
+		/** 只能调用一次 */
+		TPooledFuture<T> GetFuture()
+		{
+			check(State && !bFutureRetrieved);
+			bFutureRetrieved = true;
+			return TPooledFuture<T>(State);
+		}
+
+		template<typename... ArgTypes>
+		void EmplaceValue(ArgTypes&&... Args)
+		{
+			check(State && !State->IsReady());
+			State->Value.Emplace(Forward<ArgTypes>(Args)...);
+			State->MarkReady();
+		}
+
+		void SetValue(const FValueType& Value) requires(!std::is_void_v<T>)
+		{
+			EmplaceValue(Value);
+		}
+
+		void SetValue(FValueType&& Value) requires(!std::is_void_v<T>)
+		{
+			EmplaceValue(MoveTemp(Value));
+		}
+
+		void SetValue() requires(std::is_void_v<T>)
+		{
+			EmplaceValue(true);
+		}
+
+	private:
+		void Reset()
+		{
+			if (State)
+			{
+				// 与 TPromise 相同: 销毁前必须设置结果, 否则等待方永远等不到
+				checkf(State->IsReady(), TEXT("TPooledPromise destroyed without a value"));
+				if (!bFutureRetrieved)
+				{
+					// Future 从未取出, 替它释放引用
+					State->Release();
+				}
+				State->Release();
+				State = nullptr;
+			}
+		}
+
+		Private::TPooledState<T>* State = nullptr;
+		bool bFutureRetrieved = false;
+	};
+
+	/** 释放 T 的空闲状态块 (含其事件), 返回释放的块数 */
+	template<typename T>
+	int32 TrimPooledPromisePool()
+	{
+		int32 NumFreed = 0;
+		while (Private::TPooledState<T>* State = Private::TPooledState<T>::GetPool().Pop())
+		{
+			if (State->Event)
+			{
+				FPlatformProcess::ReturnSynchEventToPool(State->Event);
+			}
+			delete State;
+			++NumFreed;
+		}
+		Private::FPooledStateBase::RecordBlocksFreed(NumFreed, sizeof(Private::TPooledState<T>));
+		return NumFreed;
+	}
+}
@@ -0,0 +1,442 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// TFuture_TPromise 基准用例
+//
+// 运行: TemplatesGuide.Benchmark Filter=Future. Iterations=100
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "FutureMoveChain.h"
+#include "FutureFanOut.h"
+#include "AsyncAuto.h"
+#include "PooledPromise.h"
+#include "FutureCombinators.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Tasks/Task.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+
+namespace FutureBenchmark
+{
+	constexpr int32 PayloadBytes = 1024 * 1024;
+	constexpr int32 NumStages = 8;
+
+	using UE::TemplatesGuide::FCopyCountingPayload;
+
+	static FCopyCountingPayload ThenGetStage(TFuture<FCopyCountingPayload> Future)
+	{
+		FCopyCountingPayload Payload = Future.Get();
+		++Payload.Bytes[0];
+		return Payload;
+	}
+
+	static FCopyCountingPayload NextByValueStage(FCopyCountingPayload Payload)
+	{
+		++Payload.Bytes[0];
+		return Payload;
+	}
+
+	static FCopyCountingPayload MoveStage(FCopyCountingPayload&& Payload)
+	{
+		++Payload.Bytes[0];
+		return MoveTemp(Payload);
+	}
+
+	/** 运行 Chains 条 8 阶段链; BuildChain(TFuture) 返回最后一个阶段的 Future */
+	template<typename BuildChainType>
+	void RunChains(FBenchmarkContext& Context, const TCHAR* CaseName, int32 Chains, BuildChainType&& BuildChain)
+	{
+		FCopyCountingPayload::ResetCounters();
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Chains; ++i)
+		{
+			TPromise<FCopyCountingPayload> Promise;
+			TFuture<FCopyCountingPayload> Future = BuildChain(Promise.GetFuture());
+
+			Promise.SetValue(FCopyCountingPayload(PayloadBytes));
+			const FCopyCountingPayload Result = Future.Consume();
+			check(Result.Bytes[0] == NumStages);
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		FBenchmarkResult& Result = Context.Report(CaseName, int64(Chains) * NumStages, Seconds);
+		Result.Metrics.Emplace(TEXT("CopiesPerChain"), double(FCopyCountingPayload::GetNumCopies()) / Chains);
+		Result.Metrics.Emplace(TEXT("MovesPerChain"), double(FCopyCountingPayload::GetNumMoves()) / Chains);
+		Result.Metrics.Emplace(TEXT("MBCopiedPerChain"), double(FCopyCountingPayload::GetNumBytesCopied()) / Chains / (1024.0 * 1024.0));
+	}
+}
+
+// 示例10: 1MB 负载经过 8 阶段链, 对比 Then + Get / Next 按值 / MoveChain 的复制次数
+//   三者都在 SetValue 的线程上同步执行续接, 差异只来自复制
+UE_TEMPLATESGUIDE_BENCHMARK(Future, MoveChain, EBenchmarkFlags::None)
+{
+	using namespace FutureBenchmark;
+	using UE::TemplatesGuide::MoveChain;
+
+	// 每条链 8MB 的潜在复制, 限制链数避免复制变体运行过久
+	const int32 Chains = FMath::Clamp(Context.GetIterations(), 1, 256);
+
+	RunChains(Context, TEXT("ThenGet"), Chains, [](TFuture<FCopyCountingPayload>&& Future)
+	{
+		return Future.Then(&ThenGetStage).Then(&ThenGetStage).Then(&ThenGetStage).Then(&ThenGetStage)
+			.Then(&ThenGetStage).Then(&ThenGetStage).Then(&ThenGetStage).Then(&ThenGetStage);
+	});
+
+	RunChains(Context, TEXT("NextByValue"), Chains, [](TFuture<FCopyCountingPayload>&& Future)
+	{
+		return Future.Next(&NextByValueStage).Next(&NextByValueStage).Next(&NextByValueStage).Next(&NextByValueStage)
+			.Next(&NextByValueStage).Next(&NextByValueStage).Next(&NextByValueStage).Next(&NextByValueStage);
+	});
+
+	RunChains(Context, TEXT("MoveChain"), Chains, [](TFuture<FCopyCountingPayload>&& Future)
+	{
+		return MoveChain(MoveTemp(Future),
+			&MoveStage, &MoveStage, &MoveStage, &MoveStage, &MoveStage, &MoveStage, &MoveStage, &MoveStage);
+	});
+}
+
+namespace FutureBenchmark
+{
+	constexpr int32 FanOutPayloadBytes = 64 * 1024;
+
+	/** 订阅者读取结果的工作: 触碰首尾字节 */
+	static void ReadPayload(const FCopyCountingPayload& Payload, std::atomic<int64>& Checksum)
+	{
+		Checksum.fetch_add(Payload.Bytes[0] + Payload.Bytes.Last(), std::memory_order_relaxed);
+	}
+
+	/** 常见写法: TSharedFuture + 每个订阅者一个任务, 任务内按值取结果 */
+	static void RunPerSubscriberCopy(FBenchmarkContext& Context, int32 NumSubscribers, int32 Results)
+	{
+		std::atomic<int64> Checksum{0};
+		FCopyCountingPayload::ResetCounters();
+		FLatencyRecorder Latency(Results);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Results; ++i)
+		{
+			TPromise<FCopyCountingPayload> Promise;
+			TSharedFuture<FCopyCountingPayload> Shared = Promise.GetFuture().Share();
+
+			TArray<UE::Tasks::FTask> Subscribers;
+			Subscribers.Reserve(NumSubscribers);
+			for (int32 Subscriber = 0; Subscriber < NumSubscribers; ++Subscriber)
+			{
+				Subscribers.Add(UE::Tasks::Launch(TEXT("PerSubscriber"), [Shared, &Checksum]
+				{
+					const FCopyCountingPayload Local = Shared.Get();
+					ReadPayload(Local, Checksum);
+				}));
+			}
+
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			Promise.SetValue(FCopyCountingPayload(FanOutPayloadBytes));
+			UE::Tasks::Wait(Subscribers);
+			Latency.RecordSince(StartCycles);
+		}
+
+		FBenchmarkResult& Result = Context.Report(*FString::Printf(TEXT("PerSubscriberCopy/%d"), NumSubscribers),
+			int64(Results) * NumSubscribers, Timer.GetSeconds(), &Latency);
+		Result.Metrics.Emplace(TEXT("CopiesPerResult"), double(FCopyCountingPayload::GetNumCopies()) / Results);
+		Result.Metrics.Emplace(TEXT("TasksPerResult"), double(NumSubscribers));
+	}
+
+	static void RunFanOut(FBenchmarkContext& Context, int32 NumSubscribers, int32 Results)
+	{
+		using UE::TemplatesGuide::TFanOut;
+
+		std::atomic<int64> Checksum{0};
+		int64 NumChunks = 0;
+		FCopyCountingPayload::ResetCounters();
+		FLatencyRecorder Latency(Results);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Results; ++i)
+		{
+			TPromise<FCopyCountingPayload> Promise;
+			TFanOut<FCopyCountingPayload> FanOut(Promise.GetFuture());
+
+			for (int32 Subscriber = 0; Subscriber < NumSubscribers; ++Subscriber)
+			{
+				FanOut.Subscribe([&Checksum](const FCopyCountingPayload& Payload) { ReadPayload(Payload, Checksum); });
+			}
+
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			Promise.SetValue(FCopyCountingPayload(FanOutPayloadBytes));
+			FanOut.GetDispatchTask().Wait();
+			Latency.RecordSince(StartCycles);
+
+			NumChunks += FanOut.GetNumDispatchChunks();
+		}
+
+		FBenchmarkResult& Result = Context.Report(*FString::Printf(TEXT("FanOut/%d"), NumSubscribers),
+			int64(Results) * NumSubscribers, Timer.GetSeconds(), &Latency);
+		Result.Metrics.Emplace(TEXT("CopiesPerResult"), double(FCopyCountingPayload::GetNumCopies()) / Results);
+		Result.Metrics.Emplace(TEXT("ChunksPerResult"), double(NumChunks) / Results);
+	}
+}
+
+// 示例11: 一个 64KB 结果广播给 4 / 16 / 64 个订阅者
+//   P50/P99 为 SetValue 到全部订阅者执行完的时间; PerSubscriberCopy 每个订阅者复制一次并占一个任务
+UE_TEMPLATESGUIDE_BENCHMARK(Future, FanOut, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace FutureBenchmark;
+
+	const int32 Results = FMath::Clamp(Context.GetIterations(), 1, 1000);
+	for (const int32 NumSubscribers : {4, 16, 64})
+	{
+		RunPerSubscriberCopy(Context, NumSubscribers, Results);
+		RunFanOut(Context, NumSubscribers, Results);
+	}
+}
+
+namespace FutureBenchmark
+{
+	using UE::TemplatesGuide::EAsyncAutoBackend;
+
+	/** GameThread 上等待 TaskGraphMainThread 的 Future 会死锁, 改为边等边处理 GameThread 任务 */
+	template<typename ResultType>
+	static void WaitPumpingGameThread(const TFuture<ResultType>& Future)
+	{
+		while (!Future.IsReady())
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		}
+	}
+
+	template<typename ResultType>
+	static void WaitForResult(const TFuture<ResultType>& Future, bool bPumpGameThread)
+	{
+		if (bPumpGameThread)
+		{
+			WaitPumpingGameThread(Future);
+		}
+		else
+		{
+			Future.Wait();
+		}
+	}
+
+	/**
+	 * RoundTrip: 逐个派发并等待, P50/P99 为调用到任务体开始执行的延迟
+	 * Burst:     一次派发全部再等待, 吞吐量为每秒完成的 Future 数
+	 */
+	static void RunAsyncDispatch(FBenchmarkContext& Context, EAsyncAutoBackend Backend, int32 Calls)
+	{
+		using UE::TemplatesGuide::AsyncOn;
+		using UE::TemplatesGuide::LexToString;
+
+		const bool bPump = Backend == EAsyncAutoBackend::TaskGraphMainThread;
+
+		{
+			FLatencyRecorder Latency(Calls);
+			FBenchmarkTimer Timer;
+			for (int32 i = 0; i < Calls; ++i)
+			{
+				const uint64 LaunchCycles = FLatencyRecorder::Now();
+				TFuture<void> Future = AsyncOn(Backend, [&Context, &Latency, LaunchCycles]
+				{
+					Latency.RecordSince(LaunchCycles);
+					Context.Work();
+				});
+				WaitForResult(Future, bPump);
+			}
+			Context.Report(*FString::Printf(TEXT("RoundTrip/%s"), LexToString(Backend)), Calls, Timer.GetSeconds(), &Latency);
+		}
+
+		{
+			TArray<TFuture<void>> Futures;
+			Futures.Reserve(Calls);
+
+			FBenchmarkTimer Timer;
+			for (int32 i = 0; i < Calls; ++i)
+			{
+				Futures.Add(AsyncOn(Backend, [&Context] { Context.Work(); }));
+			}
+			for (const TFuture<void>& Future : Futures)
+			{
+				WaitForResult(Future, bPump);
+			}
+			Context.Report(*FString::Printf(TEXT("Burst/%s"), LexToString(Backend)), Calls, Timer.GetSeconds());
+		}
+	}
+}
+
+// 示例12: 各 EAsyncExecution 后端与 UE::Tasks 的派发延迟与吞吐量
+//   Thread 每次调用新建系统线程, 调用数限制在 64 以内; Inline 为不派发的基线
+UE_TEMPLATESGUIDE_BENCHMARK(Future, AsyncDispatch, EBenchmarkFlags::None)
+{
+	using namespace FutureBenchmark;
+
+	check(IsInGameThread());
+
+	const int32 Calls = FMath::Max(1, Context.GetIterations());
+	RunAsyncDispatch(Context, EAsyncAutoBackend::Inline, Calls);
+	RunAsyncDispatch(Context, EAsyncAutoBackend::Tasks, Calls);
+	RunAsyncDispatch(Context, EAsyncAutoBackend::TaskGraph, Calls);
+	RunAsyncDispatch(Context, EAsyncAutoBackend::ThreadPool, Calls);
+	RunAsyncDispatch(Context, EAsyncAutoBackend::TaskGraphMainThread, Calls);
+	RunAsyncDispatch(Context, EAsyncAutoBackend::Thread, FMath::Min(Calls, 64));
+}
+
+namespace FutureBenchmark
+{
+	/** 同一线程上 SetValue 后立即 Get: 只剩状态分配与事件的开销 */
+	template<template<typename> class PromiseType>
+	static FBenchmarkResult& RunPromiseSameThread(FBenchmarkContext& Context, const TCHAR* CaseName, int32 Calls)
+	{
+		int64 Sum = 0;
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Calls; ++i)
+		{
+			PromiseType<int32> Promise;
+			auto Future = Promise.GetFuture();
+			Promise.SetValue(i);
+			Sum += Future.Get();
+		}
+		check(Sum == int64(Calls) * (Calls - 1) / 2);
+		return Context.Report(CaseName, Calls, Timer.GetSeconds());
+	}
+
+	/** 请求 / 响应: 工作线程上 SetValue, 调用线程等待; P50/P99 为整个往返 */
+	template<template<typename> class PromiseType>
+	static FBenchmarkResult& RunPromiseCrossThread(FBenchmarkContext& Context, const TCHAR* CaseName, int32 Calls)
+	{
+		FLatencyRecorder Latency(Calls);
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Calls; ++i)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+
+			PromiseType<int32> Promise;
+			auto Future = Promise.GetFuture();
+			UE::Tasks::Launch(TEXT("PromiseResponder"), [&Context, Promise = MoveTemp(Promise), i]() mutable
+			{
+				Context.Work();
+				Promise.SetValue(i);
+			});
+			const int32 Response = Future.Get();
+			check(Response == i);
+
+			Latency.RecordSince(StartCycles);
+		}
+		return Context.Report(CaseName, Calls, Timer.GetSeconds(), &Latency);
+	}
+
+	static void AddPooledMetrics(FBenchmarkResult& Result, const UE::TemplatesGuide::FPooledPromiseStats& Stats, int32 Calls)
+	{
+		Result.Metrics.Emplace(TEXT("BlocksAllocated"), double(Stats.NumBlocksAllocated));
+		Result.Metrics.Emplace(TEXT("EventsCreated"), double(Stats.NumEventsCreated));
+		Result.Metrics.Emplace(TEXT("BlockingWaitRate"), double(Stats.NumBlockingWaits) / FMath::Max(1, Calls));
+	}
+}
+
+// 示例13: 池化 Promise 与 TPromise 对比 (每次调用一个 Promise / Future)
+//   Stock 每次分配 TFutureState 并取一个事件; Pooled 的 BlocksAllocated 在预热后不再增长
+UE_TEMPLATESGUIDE_BENCHMARK(Future, PooledPromise, EBenchmarkFlags::None)
+{
+	using namespace FutureBenchmark;
+	using namespace UE::TemplatesGuide;
+
+	const int32 Calls = FMath::Max(1, Context.GetIterations()) * 10;
+
+	RunPromiseSameThread<TPromise>(Context, TEXT("Stock/SameThread"), Calls);
+
+	ResetPooledPromiseStats();
+	FBenchmarkResult& SameThread = RunPromiseSameThread<TPooledPromise>(Context, TEXT("Pooled/SameThread"), Calls);
+	AddPooledMetrics(SameThread, GetPooledPromiseStats(), Calls);
+
+	RunPromiseCrossThread<TPromise>(Context, TEXT("Stock/CrossThread"), Calls);
+
+	ResetPooledPromiseStats();
+	FBenchmarkResult& CrossThread = RunPromiseCrossThread<TPooledPromise>(Context, TEXT("Pooled/CrossThread"), Calls);
+	AddPooledMetrics(CrossThread, GetPooledPromiseStats(), Calls);
+}
+
+namespace FutureBenchmark
+{
+	constexpr int32 NumJoinedFutures = 32;
+
+	/**
+	 * 每个 Future 由一个 UE::Tasks 任务完成
+	 * 生产者按值捕获工作量而不是 Context: WhenAny 返回后剩余的生产者仍在运行
+	 */
+	static TArray<TFuture<int32>> LaunchProducers(FBenchmarkContext& Context)
+	{
+		const double WorkMicroseconds = Context.GetConfig().WorkMicroseconds;
+
+		TArray<TFuture<int32>> Futures;
+		Futures.Reserve(NumJoinedFutures);
+		for (int32 Index = 0; Index < NumJoinedFutures; ++Index)
+		{
+			TPromise<int32> Promise;
+			Futures.Add(Promise.GetFuture());
+			UE::Tasks::Launch(TEXT("JoinProducer"), [WorkMicroseconds, Promise = MoveTemp(Promise), Index]() mutable
+			{
+				SpinWork(WorkMicroseconds);
+				Promise.SetValue(Index);
+			});
+		}
+		return Futures;
+	}
+}
+
+// 示例14: 32 个 Future 的汇合, P50/P99 为全部生产者启动到汇合结果就绪的时间
+//   BlockingJoin 在线程池线程上依次 Consume (等待期间占住该线程); WhenAll / WhenAny 不占线程
+UE_TEMPLATESGUIDE_BENCHMARK(Future, WhenAll, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace FutureBenchmark;
+	using namespace UE::TemplatesGuide;
+
+	const int32 Iterations = FMath::Max(1, Context.GetIterations());
+
+	{
+		FLatencyRecorder Latency(Iterations);
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			TFuture<TArray<int32>> Joined = Async(EAsyncExecution::ThreadPool, [Futures = LaunchProducers(Context)]() mutable
+			{
+				TArray<int32> Results;
+				Results.Reserve(Futures.Num());
+				for (TFuture<int32>& Future : Futures)
+				{
+					Results.Add(Future.Consume());
+				}
+				return Results;
+			});
+			check(Joined.Get().Num() == NumJoinedFutures);
+			Latency.RecordSince(StartCycles);
+		}
+		Context.Report(TEXT("BlockingJoin"), int64(Iterations) * NumJoinedFutures, Timer.GetSeconds(), &Latency);
+	}
+
+	{
+		FLatencyRecorder Latency(Iterations);
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			TFuture<TArray<int32>> Joined = WhenAll(LaunchProducers(Context));
+			check(Joined.Get().Num() == NumJoinedFutures);
+			Latency.RecordSince(StartCycles);
+		}
+		Context.Report(TEXT("WhenAll"), int64(Iterations) * NumJoinedFutures, Timer.GetSeconds(), &Latency);
+	}
+
+	{
+		FLatencyRecorder Latency(Iterations);
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			TFuture<TWhenAnyResult<int32>> First = WhenAny(LaunchProducers(Context));
+			check(First.Get().Index != INDEX_NONE);
+			Latency.RecordSince(StartCycles);
+		}
+		Context.Report(TEXT("WhenAny"), int64(Iterations) * NumJoinedFutures, Timer.GetSeconds(), &Latency);
+	}
+}
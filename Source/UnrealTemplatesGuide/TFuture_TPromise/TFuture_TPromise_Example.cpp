@@ -2,6 +2,14 @@
 
 #include "TFuture_TPromise_Example.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "GameThreadCompletionSink.h"
+#include "FutureMoveChain.h"
+#include "FutureFanOut.h"
+#include "AsyncAuto.h"
+#include "PooledPromise.h"
+#include "FutureCombinators.h"
+#include "Profiling/TemplatesGuideTrace.h"
 
 ATFuture_TPromise_Example::ATFuture_TPromise_Example()
 {
@@ -24,12 +32,34 @@ void ATFuture_TPromise_Example::BeginPlay()
 	Example_WithAsync();
 	Example_NonBlockingCallback();
 	
+	UE_LOG(LogTemp, Warning, TEXT("========== Extensions =========="));
+	Example_CompletionSinkBudget();
+	Example_MoveOnlyChaining();
+	Example_FanOutBroadcast();
+	Example_AsyncAutoPolicy();
+	Example_PooledPromise();
+	Example_WhenAllWhenAny();
+	
 	UE_LOG(LogTemp, Warning, TEXT("========== TFuture Examples End =========="));
 }
 
 void ATFuture_TPromise_Example::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+	
+	// 示例9: 积压排空后输出一次统计
+	if (CompletionSinkTarget > 0)
+	{
+		++CompletionSinkFrames;
+		
+		const UE::TemplatesGuide::FCompletionSinkStats Stats = UE::TemplatesGuide::FGameThreadCompletionSink::Get().GetStats();
+		if (Stats.NumDispatched >= CompletionSinkTarget)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  [Example 9] Drained %lld completions over %d frames (peak backlog %lld, %lld frames over budget)"),
+				Stats.NumDispatched, CompletionSinkFrames, Stats.PeakBacklogDepth, Stats.NumFramesOverBudget);
+			CompletionSinkTarget = 0;
+		}
+	}
 }
 
 // ============================================================================
@@ -297,6 +327,7 @@ void ATFuture_TPromise_Example::Example_ThenChaining()
 		// 第一个Then: int32 -> FString
 		.Then([](TFuture<int32> IntFuture) -> FString
 		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Then");
 			int32 Value = IntFuture.Consume();
 			FString Result = FString::Printf(TEXT("Number: %d"), Value);
 			UE_LOG(LogTemp, Log, TEXT("  [Then 1] %d -> \"%s\""), Value, *Result);
@@ -305,6 +336,7 @@ void ATFuture_TPromise_Example::Example_ThenChaining()
 		// 第二个Then: FString -> int32
 		.Then([](TFuture<FString> StrFuture) -> int32
 		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Then");
 			FString Str = StrFuture.Consume();
 			int32 Len = Str.Len();
 			UE_LOG(LogTemp, Log, TEXT("  [Then 2] \"%s\" -> %d"), *Str, Len);
@@ -315,7 +347,11 @@ void ATFuture_TPromise_Example::Example_ThenChaining()
 	Promise.SetValue(12345);
 	
 	// 获取最终结果
-	int32 FinalResult = FinalFuture.Get();
+	int32 FinalResult = 0;
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+		FinalResult = FinalFuture.Get();
+	}
 	UE_LOG(LogTemp, Log, TEXT("  Final result: %d"), FinalResult);
 }
 
@@ -589,11 +625,13 @@ void ATFuture_TPromise_Example::Example_NextChaining()
 	TFuture<FString> ResultFuture = Promise.GetFuture()
 		.Next([](int32 Value) -> int32
 		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Next");
 			UE_LOG(LogTemp, Log, TEXT("  [Next 1] Received: %d"), Value);
 			return Value * 2;  // 加倍
 		})
 		.Next([](int32 Value) -> FString
 		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Next");
 			UE_LOG(LogTemp, Log, TEXT("  [Next 2] Doubled: %d"), Value);
 			return FString::Printf(TEXT("Result=%d"), Value);
 		});
@@ -601,7 +639,11 @@ void ATFuture_TPromise_Example::Example_NextChaining()
 	// 设置值触发执行
 	Promise.SetValue(21);
 	
-	FString FinalStr = ResultFuture.Consume();
+	FString FinalStr;
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+		FinalStr = ResultFuture.Consume();
+	}
 	UE_LOG(LogTemp, Log, TEXT("  Final: %s"), *FinalStr);
 }
 
@@ -719,6 +761,8 @@ void ATFuture_TPromise_Example::Example_WithAsync()
 	// Async直接返回TFuture,内部自动创建Promise
 	TFuture<int32> Future = Async(EAsyncExecution::ThreadPool, []() -> int32
 	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Execute");
+		
 		// 在线程池中执行计算
 		int32 Sum = 0;
 		for (int32 i = 1; i <= 100; ++i)
@@ -732,6 +776,7 @@ void ATFuture_TPromise_Example::Example_WithAsync()
 	// 链式处理结果
 	Future.Next([](int32 Result)
 	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Next");
 		UE_LOG(LogTemp, Log, TEXT("  [Callback] Received result: %d"), Result);
 	});
 	
@@ -761,12 +806,15 @@ void ATFuture_TPromise_Example::Example_NonBlockingCallback()
 	 *   - 如果设置回调时Future已完成: 在调用者线程立即执行
 	 *   - 如果设置回调时Future未完成: 在调用SetValue的线程执行
 	 * 
-	 * 如需回到GameThread,使用AsyncTask:
+	 * 如需回到GameThread:
 	 *   Future.Next([](ResultType Result) {
 	 *       AsyncTask(ENamedThreads::GameThread, [Result]() {
 	 *           // 在GameThread处理
 	 *       });
 	 *   });
+	 * 
+	 * 每个结果一个 AsyncTask 在结果密集时会淹没GameThread队列,
+	 * 这里改用 FGameThreadCompletionSink (见示例9): 回调进入无锁队列, 在帧预算内批量执行
 	 */
 	
 	TPromise<FString> Promise;
@@ -775,11 +823,13 @@ void ATFuture_TPromise_Example::Example_NonBlockingCallback()
 	// 设置非阻塞回调
 	Future.Next([](FString Result)
 	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Future::Next");
+		
 		// 注意: 这个回调可能在任意线程执行!
 		UE_LOG(LogTemp, Log, TEXT("  [Callback] Result received: %s"), *Result);
 		
-		// 如果需要在GameThread处理UI等操作:
-		AsyncTask(ENamedThreads::GameThread, [Result]()
+		// 如果需要在GameThread处理UI等操作 (工作线程上用静态入口, 实例不存在时退回 AsyncTask):
+		UE::TemplatesGuide::FGameThreadCompletionSink::PostToGameThread([Result]()
 		{
 			UE_LOG(LogTemp, Log, TEXT("  [GameThread] Processing: %s"), *Result);
 		});
@@ -796,4 +846,425 @@ void ATFuture_TPromise_Example::Example_NonBlockingCallback()
 	UE_LOG(LogTemp, Log, TEXT("  [Main] Continuing without blocking..."));
 }
 
+// ============================================================================
+// 示例9: 按帧预算批量回到GameThread
+// ============================================================================
+void ATFuture_TPromise_Example::Example_CompletionSinkBudget()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 9] Frame-Budgeted GameThread Completion Sink"));
+	
+	/*
+	 * FGameThreadCompletionSink (GameThreadCompletionSink.h):
+	 * 
+	 *   AsyncTask 方式:   每个结果 → 一个 GameThread 任务 → 同一帧内全部执行
+	 *   Sink 方式:        每个结果 → 一次无锁入队
+	 *                     GameThread Tick 中执行, 每帧最多 TemplatesGuide.CompletionSink.BudgetUs 微秒
+	 *                     未执行完的留到下一帧
+	 * 
+	 * 控制台:
+	 *   TemplatesGuide.CompletionSink.BudgetUs 200    // 每帧 0.2ms
+	 *   TemplatesGuide.CompletionSink.BudgetUs 0      // 不限 (每帧全部排空)
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	FGameThreadCompletionSink& Sink = FGameThreadCompletionSink::Get();
+	Sink.Flush();
+	Sink.ResetStats();
+	
+	// 模拟大量工作线程结果, 每个结果在GameThread上有约 20us 的处理 (更新UI, 生成Actor ...)
+	constexpr int32 NumResults = 2000;
+	ParallelFor(NumResults, [&Sink](int32 Index)
+	{
+		Sink.Post([Index]()
+		{
+			check(IsInGameThread());
+			
+			const double EndTime = FPlatformTime::Seconds() + 20e-6;
+			while (FPlatformTime::Seconds() < EndTime)
+			{
+			}
+		});
+	}, EParallelForFlags::BackgroundPriority);
+	
+	FCompletionSinkStats Stats = Sink.GetStats();
+	check(Stats.NumPosted >= NumResults);
+	UE_LOG(LogTemp, Log, TEXT("  Posted %lld completions, backlog %lld (none executed yet)"), Stats.NumPosted, Stats.BacklogDepth);
+	
+	// Future 版本: 替代 Next + AsyncTask
+	TPromise<int32> Promise;
+	Sink.NextOnGameThread(Promise.GetFuture(), [](int32 Value)
+	{
+		check(IsInGameThread());
+		UE_LOG(LogTemp, Log, TEXT("  [GameThread] NextOnGameThread received %d"), Value);
+	});
+	
+	Async(EAsyncExecution::Thread, [Promise = MoveTemp(Promise)]() mutable
+	{
+		Promise.SetValue(42);
+	});
+	
+	// 2000 × 20us = 40ms, 默认预算 1ms/帧 → 约 40 帧排空, 每帧最多增加 ~1ms
+	CompletionSinkTarget = NumResults + 1;
+	CompletionSinkFrames = 0;
+}
+
+// ============================================================================
+// 示例10: 只移动的多阶段链
+// ============================================================================
+void ATFuture_TPromise_Example::Example_MoveOnlyChaining()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 10] Move-Only Multi-Stage Chaining"));
+	
+	/*
+	 * 示例3 / 4 传递的是 int32 / FString, 按值传递看不出代价
+	 * 对 1MB 的 TArray, 每个阶段的一次复制就是一次 1MB 分配 + memcpy
+	 * 
+	 * 复制来源 (FutureMoveChain.h):
+	 *   .Then([](TFuture<T> F) { T Value = F.Get(); ... })    Get 返回 const&, 这里复制
+	 *   .Then([](TFuture<T> F) { T Value = F.Consume(); ... }) Consume 移动, 不复制
+	 *   .Next([](T Value) { ...; return Value; })              参数从 Consume 的结果移动构造, 返回值隐式移动
+	 * 
+	 * MoveNext / MoveChain 要求每个阶段以 T&& 接收并按值返回
+	 * TMoveOnly<T> 把 "忘记 MoveTemp" 变成编译错误
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	constexpr int32 PayloadBytes = 1024 * 1024;
+	
+	const auto AddStage = [](FCopyCountingPayload&& Payload)
+	{
+		++Payload.Bytes[0];
+		return MoveTemp(Payload);
+	};
+	
+	// --- 对照: Then + Get, 每个阶段复制一次 ---
+	{
+		FCopyCountingPayload::ResetCounters();
+		
+		TPromise<FCopyCountingPayload> Promise;
+		TFuture<FCopyCountingPayload> Future = Promise.GetFuture()
+			.Then([](TFuture<FCopyCountingPayload> F) { FCopyCountingPayload Payload = F.Get(); ++Payload.Bytes[0]; return Payload; })
+			.Then([](TFuture<FCopyCountingPayload> F) { FCopyCountingPayload Payload = F.Get(); ++Payload.Bytes[0]; return Payload; });
+		
+		Promise.SetValue(FCopyCountingPayload(PayloadBytes));
+		const FCopyCountingPayload Result = Future.Consume();
+		
+		check(Result.Bytes[0] == 2);
+		check(FCopyCountingPayload::GetNumCopies() == 2);
+		UE_LOG(LogTemp, Log, TEXT("  Then + Get: %lld copies, %lld bytes copied"),
+			FCopyCountingPayload::GetNumCopies(), FCopyCountingPayload::GetNumBytesCopied());
+	}
+	
+	// --- MoveChain: 8 个阶段, 0 次复制 ---
+	{
+		FCopyCountingPayload::ResetCounters();
+		
+		TPromise<FCopyCountingPayload> Promise;
+		TFuture<FCopyCountingPayload> Future = MoveChain(Promise.GetFuture(),
+			AddStage, AddStage, AddStage, AddStage, AddStage, AddStage, AddStage, AddStage);
+		
+		// 在其他线程完成: 续接在 SetValue 的线程上依次执行
+		Async(EAsyncExecution::ThreadPool, [Promise = MoveTemp(Promise)]() mutable
+		{
+			Promise.SetValue(FCopyCountingPayload(PayloadBytes));
+		});
+		
+		const FCopyCountingPayload Result = Future.Consume();
+		
+		check(Result.Bytes.Num() == PayloadBytes);
+		check(Result.Bytes[0] == 8);
+		check(FCopyCountingPayload::GetNumCopies() == 0);
+		UE_LOG(LogTemp, Log, TEXT("  MoveChain x8: %lld copies, %lld moves"),
+			FCopyCountingPayload::GetNumCopies(), FCopyCountingPayload::GetNumMoves());
+	}
+	
+	// --- TMoveOnly: 复制在编译期被拒绝 ---
+	{
+		using FBuffer = TMoveOnly<TArray<uint8>>;
+		
+		TPromise<FBuffer> Promise;
+		TFuture<FBuffer> Future = MoveChain(Promise.GetFuture(),
+			[](FBuffer&& Buffer) { Buffer->Add(1); return MoveTemp(Buffer); },
+			[](FBuffer&& Buffer) { Buffer->Add(2); return MoveTemp(Buffer); });
+		
+		// 以下写法都无法编译:
+		//   [](FBuffer&& Buffer) { FBuffer Copy = Buffer; return Copy; }
+		//   Future.Get() 之后按值使用
+		
+		FBuffer Initial;
+		Initial->SetNumZeroed(PayloadBytes);
+		Promise.SetValue(MoveTemp(Initial));
+		TArray<uint8> Result = Future.Consume().Release();
+		
+		check(Result.Num() == PayloadBytes + 2);
+		check(Result.Last() == 2);
+		UE_LOG(LogTemp, Log, TEXT("  TMoveOnly chain: %d bytes"), Result.Num());
+	}
+}
 
+// ============================================================================
+// 示例11: TFanOut 结果广播
+// ============================================================================
+void ATFuture_TPromise_Example::Example_FanOutBroadcast()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 11] Fan-Out Broadcast"));
+	
+	/*
+	 * 示例5 的 TSharedFuture 让多个消费者 Get() 同一个结果;
+	 * 若每个消费者再各自启动任务并按值捕获结果, 一个结果会被复制 N 次, 并产生 N 个任务
+	 * 
+	 * TFanOut<T>:
+	 *   TFuture ──Consume──► TSharedRef<const T> (只有一份)
+	 *   订阅者收到 const T&, 就绪时按块 (SubscribersPerChunk) 分给少量任务执行
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	constexpr int32 PayloadBytes = 64 * 1024;
+	constexpr int32 NumSubscribers = 32;
+	
+	FCopyCountingPayload::ResetCounters();
+	
+	TPromise<FCopyCountingPayload> Promise;
+	TFanOut<FCopyCountingPayload> FanOut(Promise.GetFuture());
+	
+	std::atomic<int32> NumNotified{0};
+	for (int32 i = 0; i < NumSubscribers; ++i)
+	{
+		FanOut.Subscribe([&NumNotified](const FCopyCountingPayload& Decoded)
+		{
+			check(Decoded.Bytes.Num() == PayloadBytes);
+			++NumNotified;
+		});
+	}
+	
+	Async(EAsyncExecution::ThreadPool, [Promise = MoveTemp(Promise)]() mutable
+	{
+		Promise.SetValue(FCopyCountingPayload(PayloadBytes));
+	});
+	
+	FanOut.GetDispatchTask().Wait();
+	check(NumNotified == NumSubscribers);
+	
+	// 就绪之后的订阅者也拿到同一份结果; GetView() 持有共享引用, 可以在 FanOut 之外保留
+	TSharedPtr<const FCopyCountingPayload, ESPMode::ThreadSafe> View = FanOut.GetView();
+	check(View.IsValid());
+	
+	UE::Tasks::FTaskEvent LateDone{UE_SOURCE_LOCATION};
+	FanOut.Subscribe([LateDone, Expected = View.Get()](const FCopyCountingPayload& Decoded) mutable
+	{
+		check(&Decoded == Expected);
+		LateDone.Trigger();
+	});
+	LateDone.Wait();
+	
+	check(FCopyCountingPayload::GetNumCopies() == 0);
+	UE_LOG(LogTemp, Log, TEXT("  %d subscribers notified in %d chunks, %lld copies"),
+		FanOut.GetNumSubscribers(), FanOut.GetNumDispatchChunks(), FCopyCountingPayload::GetNumCopies());
+}
+
+// ============================================================================
+// 示例12: AsyncAuto 执行后端选择
+// ============================================================================
+void ATFuture_TPromise_Example::Example_AsyncAutoPolicy()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 12] AsyncAuto Execution Policy"));
+	
+	/*
+	 * 示例7 / 示例8 直接写 EAsyncExecution; 各后端的派发成本 (基准 Future.AsyncDispatch):
+	 *   Inline < Tasks ≈ TaskGraph < ThreadPool << Thread (每次新建系统线程)
+	 *   TaskGraphMainThread 取决于 GameThread 何时处理任务
+	 * 
+	 * AsyncAuto(Hint, Callable) 按预计耗时与是否阻塞选择:
+	 *   极小的工作       → Inline (派发比工作本身还贵)
+	 *   计算型工作       → UE::Tasks
+	 *   会阻塞的工作     → ThreadPool, 超过 DedicatedThreadMs → Thread
+	 *   需要 GameThread → TaskGraphMainThread
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	FAsyncWorkHint Tiny;
+	Tiny.ExpectedMicroseconds = 0.5;
+	
+	FAsyncWorkHint Compute;
+	Compute.ExpectedMicroseconds = 500.0;
+	
+	FAsyncWorkHint FileRead;
+	FileRead.ExpectedMicroseconds = 2000.0;
+	FileRead.bMayBlock = true;
+	
+	FAsyncWorkHint LongPoll;
+	LongPoll.ExpectedMicroseconds = 1000.0 * 1000.0;
+	LongPoll.bMayBlock = true;
+	
+	// 未给出预计耗时: 按未知处理, 不会内联
+	check(SelectAsyncBackend(FAsyncWorkHint()) == EAsyncAutoBackend::Tasks);
+	check(SelectAsyncBackend(Compute) == EAsyncAutoBackend::Tasks);
+	check(SelectAsyncBackend(FileRead) == EAsyncAutoBackend::ThreadPool);
+	check(SelectAsyncBackend(LongPoll) == EAsyncAutoBackend::Thread);
+	
+	UE_LOG(LogTemp, Log, TEXT("  Tiny -> %s, Compute -> %s, FileRead -> %s, LongPoll -> %s"),
+		LexToString(SelectAsyncBackend(Tiny)), LexToString(SelectAsyncBackend(Compute)),
+		LexToString(SelectAsyncBackend(FileRead)), LexToString(SelectAsyncBackend(LongPoll)));
+	
+	// 返回值与 Async() 一样是 TFuture
+	TFuture<int32> Sum = AsyncAuto(Compute, []
+	{
+		int32 Result = 0;
+		for (int32 i = 1; i <= 100; ++i)
+		{
+			Result += i;
+		}
+		return Result;
+	});
+	
+	TFuture<void> Read = AsyncAuto(FileRead, []
+	{
+		FPlatformProcess::Sleep(0.002f);
+	});
+	
+	check(Sum.Get() == 5050);
+	Read.Wait();
+	
+	const FAsyncAutoStats Stats = GetAsyncAutoStats();
+	UE_LOG(LogTemp, Log, TEXT("  Measured dispatch latency: Tasks %.1fus, ThreadPool %.1fus"),
+		Stats.DispatchMicroseconds[int32(EAsyncAutoBackend::Tasks)],
+		Stats.DispatchMicroseconds[int32(EAsyncAutoBackend::ThreadPool)]);
+}
+
+// ============================================================================
+// 示例13: TPooledPromise 池化共享状态
+// ============================================================================
+void ATFuture_TPromise_Example::Example_PooledPromise()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 13] Pooled Promise / Future"));
+	
+	/*
+	 * 示例1 / 示例2 的每个 TPromise 都在堆上分配共享状态并取一个事件
+	 * 
+	 * TPooledPromise<T> / TPooledFuture<T>:
+	 *   - 共享状态块从无锁空闲链表取出, Promise 与 Future 都释放后归还
+	 *   - Wait 先自旋, 仍未就绪才在事件上阻塞; 事件随状态块复用
+	 *   - GetFuture / SetValue / Get / Consume 与 TPromise / TFuture 语义相同
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	ResetPooledPromiseStats();
+	
+	// 请求 / 响应: 一次一个 Promise, 状态块在往返之间复用
+	constexpr int32 NumRequests = 100;
+	for (int32 i = 0; i < NumRequests; ++i)
+	{
+		TPooledPromise<int32> Promise;
+		TPooledFuture<int32> Future = Promise.GetFuture();
+		
+		Async(EAsyncExecution::ThreadPool, [Promise = MoveTemp(Promise), i]() mutable
+		{
+			Promise.SetValue(i * 2);
+		});
+		
+		const int32 Response = Future.Get();
+		check(Response == i * 2);
+	}
+	
+	// Consume 移出结果, 之后 Future 失效
+	{
+		TPooledPromise<FString> Promise;
+		TPooledFuture<FString> Future = Promise.GetFuture();
+		Promise.SetValue(TEXT("Pooled"));
+		
+		const FString Value = Future.Consume();
+		check(Value == TEXT("Pooled"));
+		check(!Future.IsValid());
+	}
+	
+	// void 结果
+	{
+		TPooledPromise<void> Promise;
+		TPooledFuture<void> Future = Promise.GetFuture();
+		check(!Future.WaitFor(FTimespan::FromMilliseconds(1)));
+		Promise.SetValue();
+		check(Future.IsReady());
+	}
+	
+	const FPooledPromiseStats Stats = GetPooledPromiseStats();
+	
+	// 响应者线程可能还没释放上一个 Promise, 所以会多分配几个块, 但远少于请求数
+	check(Stats.NumBlocksAllocated < Stats.NumAcquired);
+	UE_LOG(LogTemp, Log, TEXT("  %lld promises, %lld blocks allocated, %lld events, spin waits %lld / blocking waits %lld"),
+		Stats.NumAcquired, Stats.NumBlocksAllocated, Stats.NumEventsCreated, Stats.NumSpinWaits, Stats.NumBlockingWaits);
+}
+
+// ============================================================================
+// 示例14: WhenAll / WhenAny 与 TTask 桥接
+// ============================================================================
+void ATFuture_TPromise_Example::Example_WhenAllWhenAny()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 14] WhenAll / WhenAny"));
+	
+	/*
+	 * 示例3 / 示例4 只能线性组合; 多个 Future 汇合时不要启动任务依次 Get():
+	 * 
+	 *   WhenAll(Futures)  → TFuture<TArray<T>>   原子倒计数, 结果直接写入预分配的输出数组
+	 *   WhenAny(Futures)  → TFuture<TWhenAnyResult<T>>  第一个完成的输入认领结果
+	 *   ToTask / ToFuture   TFuture 与 UE::Tasks::TTask 互相转换 (Inline 任务, 不阻塞)
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	// --- WhenAll: 结果按输入顺序排列, 与完成顺序无关 ---
+	{
+		TArray<TFuture<int32>> Futures;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			Futures.Add(Async(EAsyncExecution::ThreadPool, [i]
+			{
+				FPlatformProcess::Sleep(0.001f * (4 - i));
+				return i * 10;
+			}));
+		}
+		
+		TFuture<TArray<int32>> All = WhenAll(MoveTemp(Futures));
+		const TArray<int32>& Results = All.Get();
+		check(Results.Num() == 4);
+		check(Results[0] == 0 && Results[3] == 30);
+		UE_LOG(LogTemp, Log, TEXT("  WhenAll: [%d, %d, %d, %d]"), Results[0], Results[1], Results[2], Results[3]);
+	}
+	
+	// --- WhenAny: 快的一方胜出 ---
+	{
+		TPromise<FString> Slow;
+		TArray<TFuture<FString>> Futures;
+		Futures.Add(Slow.GetFuture());
+		Futures.Add(Async(EAsyncExecution::ThreadPool, [] { return FString(TEXT("Fast")); }));
+		
+		TFuture<TWhenAnyResult<FString>> Any = WhenAny(MoveTemp(Futures));
+		const TWhenAnyResult<FString>& First = Any.Get();
+		check(First.Index == 1 && First.Value == TEXT("Fast"));
+		UE_LOG(LogTemp, Log, TEXT("  WhenAny: input %d won with \"%s\""), First.Index, *First.Value);
+		
+		// 落败的输入稍后完成时被忽略
+		Slow.SetValue(TEXT("Slow"));
+	}
+	
+	// --- 桥接: Future 作为任务的先决条件, 任务结果作为 Future ---
+	{
+		TPromise<int32> Promise;
+		UE::Tasks::TTask<int32> FromFuture = ToTask(UE_SOURCE_LOCATION, Promise.GetFuture());
+		
+		UE::Tasks::TTask<int32> Doubled = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[FromFuture]() mutable { return FromFuture.GetResult() * 2; },
+			UE::Tasks::Prerequisites(FromFuture));
+		
+		TFuture<int32> BackToFuture = ToFuture(UE_SOURCE_LOCATION, Doubled);
+		
+		Promise.SetValue(21);
+		const int32 Result = BackToFuture.Get();
+		check(Result == 42);
+		UE_LOG(LogTemp, Log, TEXT("  TFuture -> TTask -> TFuture: %d"), Result);
+	}
+}
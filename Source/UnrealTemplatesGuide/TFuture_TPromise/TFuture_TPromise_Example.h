@@ -50,8 +50,34 @@ private:
 	/** 示例8: 非阻塞完成回调 */
 	void Example_NonBlockingCallback();
 
+	// ========================================================================
+	// 工程化扩展 (示例 9+)
+	// ========================================================================
+
+	/** 示例9: 按帧预算批量回到GameThread */
+	void Example_CompletionSinkBudget();
+
+	/** 示例10: 只移动的多阶段链 */
+	void Example_MoveOnlyChaining();
+
+	/** 示例11: 一个结果广播给多个订阅者, 不复制 */
+	void Example_FanOutBroadcast();
+
+	/** 示例12: 按工作量与是否阻塞自动选择Async后端 */
+	void Example_AsyncAutoPolicy();
+
+	/** 示例13: 池化Promise复用共享状态 */
+	void Example_PooledPromise();
+
+	/** 示例14: WhenAll / WhenAny 与 TTask 桥接 */
+	void Example_WhenAllWhenAny();
+
 private:
 	// 用于演示的Future成员
 	TFuture<int32> PendingFuture;
 	TSharedFuture<FString> SharedResult;
+
+	// 示例9: 在 Tick 中观察积压被逐帧排空
+	int64 CompletionSinkTarget = 0;
+	int32 CompletionSinkFrames = 0;
 };
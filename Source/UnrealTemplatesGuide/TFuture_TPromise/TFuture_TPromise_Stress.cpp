@@ -0,0 +1,168 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// TFuture_TPromise 压力用例
+//
+// 在工作线程上完成、在其他线程上读取的大量 Promise:
+//   - PromiseStorm: 20 万个同时在途的 TPromise + Then, 以及按窗口复用的 TPooledPromise
+//   - WhenAllFanIn: 每轮 1 万个输入的 WhenAll
+//
+// 运行: Automation RunTests TemplatesGuide.Stress.FutureStress
+//       或 TemplatesGuide.Stress Filter=FutureStress. [Scale=1.0] [Floor=1.0]
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "PooledPromise.h"
+#include "FutureCombinators.h"
+#include "Tasks_System/ParallelBatch.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include "Async/Future.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+
+// Promise 风暴
+UE_TEMPLATESGUIDE_BENCHMARK(FutureStress, PromiseStorm, EBenchmarkFlags::Stress)
+{
+	const int64 NumPromises = Context.Scaled(200'000);
+	const int64 ExpectedSum = NumPromises * (NumPromises - 1) / 2;
+
+	// TPromise: 全部同时在途, 工作线程上 SetValue, 续接在设置结果的线程上执行
+	{
+		std::atomic<int64> Sum{0};
+		std::atomic<int64> NumRun{0};
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		TArray<TPromise<int32>> Promises;
+		Promises.SetNum(static_cast<int32>(NumPromises));
+		for (TPromise<int32>& Promise : Promises)
+		{
+			Promise.GetFuture().Then([&Sum, &NumRun](TFuture<int32> Completed)
+			{
+				Sum.fetch_add(Completed.Get(), std::memory_order_relaxed);
+				NumRun.fetch_add(1, std::memory_order_release);
+			});
+		}
+		Memory.Sample();
+
+		UE::TemplatesGuide::LaunchBatchedRange(UE_SOURCE_LOCATION, Promises.Num(), [&Promises](int32 Begin, int32 End)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Promises[Index].SetValue(Index);
+			}
+		}).Wait();
+
+		FBenchmarkResult& Result = Context.Report(TEXT("TPromise_Then"), NumPromises, Timer.GetSeconds());
+		Context.Expect(Result, NumRun.load(std::memory_order_acquire) == NumPromises && Sum.load() == ExpectedSum,
+			FString::Printf(TEXT("%lld of %lld continuations ran, sum %lld (expected %lld)"),
+				NumRun.load(), NumPromises, Sum.load(), ExpectedSum));
+		Context.ExpectThroughput(Result, 100'000.0);
+		Context.ExpectPeakMemory(Result, Memory, NumPromises * 512);
+	}
+
+	// TPooledPromise: 每个窗口在工作线程上设置结果, 在调用线程 (不是工作线程, 阻塞等待不会占住调度器) 上取出;
+	// 状态块跨线程归还后被下一个窗口复用, 池的块数应停留在窗口大小附近
+	{
+		using UE::TemplatesGuide::Stats::EGauge;
+		constexpr int32 WindowSize = 1024;
+
+		const int64 BlocksBefore = UE::TemplatesGuide::Stats::GetGauge(EGauge::PromisePoolBlocks);
+		int64 Sum = 0;
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		TArray<UE::TemplatesGuide::TPooledPromise<int32>> Promises;
+		TArray<UE::TemplatesGuide::TPooledFuture<int32>> Futures;
+		for (int64 WindowBegin = 0; WindowBegin < NumPromises; WindowBegin += WindowSize)
+		{
+			const int32 Num = static_cast<int32>(FMath::Min<int64>(WindowSize, NumPromises - WindowBegin));
+
+			Promises.Reset();
+			Futures.Reset();
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Futures.Add(Promises.AddDefaulted_GetRef().GetFuture());
+			}
+
+			UE::Tasks::FTask Fulfil = UE::TemplatesGuide::LaunchBatchedRange(UE_SOURCE_LOCATION, Num,
+				[&Promises, WindowBegin](int32 Begin, int32 End)
+				{
+					for (int32 Index = Begin; Index < End; ++Index)
+					{
+						Promises[Index].SetValue(static_cast<int32>(WindowBegin + Index));
+					}
+				});
+
+			for (UE::TemplatesGuide::TPooledFuture<int32>& Future : Futures)
+			{
+				Sum += Future.Consume();
+			}
+			Memory.Sample();
+
+			// 取出全部结果后 Promise 也都已设置, 先等任务退出再销毁本窗口的 Promise
+			Fulfil.Wait();
+		}
+		Promises.Empty();
+		Futures.Empty();
+
+		const int64 BlocksGrowth = UE::TemplatesGuide::Stats::GetGauge(EGauge::PromisePoolBlocks) - BlocksBefore;
+
+		FBenchmarkResult& Result = Context.Report(TEXT("PooledPromise_Windowed"), NumPromises, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("PoolBlocksGrowth"), static_cast<double>(BlocksGrowth));
+		Context.Expect(Result, Sum == ExpectedSum,
+			FString::Printf(TEXT("sum %lld (expected %lld)"), Sum, ExpectedSum));
+		// 计数不可用的配置中 (BlocksGrowth 始终为 0) 该检查自然通过
+		Context.Expect(Result, BlocksGrowth <= 2 * WindowSize,
+			FString::Printf(TEXT("pool grew by %lld blocks for a window of %d"), BlocksGrowth, WindowSize));
+		Context.ExpectThroughput(Result, 100'000.0);
+		Context.ExpectPeakMemory(Result, Memory, 64 * 1024 * 1024);
+	}
+}
+
+// WhenAll 扇入: 每轮 1 万个输入, 在工作线程上完成
+UE_TEMPLATESGUIDE_BENCHMARK(FutureStress, WhenAllFanIn, EBenchmarkFlags::Stress)
+{
+	constexpr int32 FanIn = 10'000;
+	const int64 NumRounds = Context.Scaled(20);
+
+	int64 NumMismatched = 0;
+	FPeakMemoryScope Memory;
+
+	FBenchmarkTimer Timer;
+	for (int64 Round = 0; Round < NumRounds; ++Round)
+	{
+		TArray<TPromise<int32>> Promises;
+		Promises.SetNum(FanIn);
+
+		TArray<TFuture<int32>> Futures;
+		Futures.Reserve(FanIn);
+		for (TPromise<int32>& Promise : Promises)
+		{
+			Futures.Add(Promise.GetFuture());
+		}
+
+		TFuture<TArray<int32>> All = UE::TemplatesGuide::WhenAll(MoveTemp(Futures));
+		Memory.Sample();
+
+		UE::TemplatesGuide::LaunchBatchedRange(UE_SOURCE_LOCATION, FanIn, [&Promises](int32 Begin, int32 End)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Promises[Index].SetValue(Index);
+			}
+		}).Wait();
+
+		const TArray<int32> Values = All.Consume();
+		for (int32 Index = 0; Index < FanIn; ++Index)
+		{
+			NumMismatched += Values.IsValidIndex(Index) && Values[Index] == Index ? 0 : 1;
+		}
+	}
+
+	FBenchmarkResult& Result = Context.Report(TEXT("WhenAll_10k"), NumRounds * FanIn, Timer.GetSeconds());
+	Context.Expect(Result, NumMismatched == 0,
+		FString::Printf(TEXT("%lld results out of order or missing"), NumMismatched));
+	Context.ExpectThroughput(Result, 200'000.0);
+	Context.ExpectPeakMemory(Result, Memory, FanIn * 1024);
+}
@@ -0,0 +1,97 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TBoundedHistory - 定容环形历史记录
+ *
+ * 替代 "TArray 只增不减 + Reset 时 Empty()" 的历史记录:
+ *   - 容量在构造时确定, 只分配一次; 写满后覆盖最旧的条目, 长时间运行内存不再增长
+ *   - Reset 只清零计数, 保留分配, 重置后的写入不会重新分配
+ *   - GetTotalAdded 是自上次 Reset 以来写入的总数 (不受覆盖影响), 需要 "已记录多少次" 的逻辑用它而不是 Num
+ *
+ *   Storage: [ 4 ][ 5 ][ 1 ][ 2 ][ 3 ]     Capacity = 5, 已写入 1..5 后再写 4, 5... 以此类推
+ *                       ^ Head (最旧)
+ *   逻辑下标 0 = 最旧, Num() - 1 = 最新; GetViews 返回两段连续内存 (按时间顺序), 无拷贝
+ */
+template<typename T>
+class TBoundedHistory
+{
+public:
+	explicit TBoundedHistory(int32 InCapacity)
+	{
+		check(InCapacity > 0);
+		Storage.SetNumZeroed(InCapacity);
+	}
+
+	/** 写入一条; 已满时覆盖最旧的一条 */
+	void Add(const T& Value)
+	{
+		const int32 Capacity = Storage.Num();
+		if (Count < Capacity)
+		{
+			Storage[(Head + Count) % Capacity] = Value;
+			++Count;
+		}
+		else
+		{
+			Storage[Head] = Value;
+			Head = (Head + 1) % Capacity;
+		}
+		++TotalAdded;
+	}
+
+	/** 清空记录, 保留分配 */
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+		TotalAdded = 0;
+	}
+
+	/** 当前保留的条目数, 不超过 GetCapacity() */
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	int32 GetCapacity() const
+	{
+		return Storage.Num();
+	}
+
+	/** 自上次 Reset 以来写入的总条数, 包括已被覆盖的 */
+	int64 GetTotalAdded() const
+	{
+		return TotalAdded;
+	}
+
+	/** 按逻辑下标访问, 0 为最旧 */
+	const T& operator[](int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		return Storage[(Head + Index) % Storage.Num()];
+	}
+
+	/** 按时间顺序的两段连续视图 (First 在前), 不拷贝; 未回绕时 Second 为空 */
+	void GetViews(TArrayView<const T>& OutFirst, TArrayView<const T>& OutSecond) const
+	{
+		const int32 FirstNum = FMath::Min(Count, Storage.Num() - Head);
+		OutFirst = TArrayView<const T>(Storage.GetData() + Head, FirstNum);
+		OutSecond = TArrayView<const T>(Storage.GetData(), Count - FirstNum);
+	}
+
+	/** 分配的字节数, 构造后不变 */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Storage.GetAllocatedSize();
+	}
+
+private:
+	TArray<T> Storage;
+	int32 Head = 0;
+	int32 Count = 0;
+	int64 TotalAdded = 0;
+};
@@ -0,0 +1,211 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * TCowPimplPtr - 写时复制 (copy-on-write) 的 Pimpl 指针
+ *
+ * TPimplPtr 的两种模式: NoCopy 不能拷贝, DeepCopy 每次拷贝都完整复制 FImpl (含 StateHistory 等缓冲)
+ * 从模板成批克隆、而多数克隆从不修改实现时, DeepCopy 的复制大多是浪费
+ * TCowPimplPtr 的拷贝只增加引用计数, 所有副本共享同一个实现对象,
+ * 第一次经由非 const 访问 (operator-> / operator* / Get / GetMutable) 时若仍被共享才复制出独占的一份:
+ *
+ *   Template ──┐
+ *   Clone1   ──┼──▶ [RefCount=3 | FImpl]
+ *   Clone2   ──┘
+ *
+ *   Clone2->IncrementCounter()  (非 const 访问, RefCount > 1 → 分离)
+ *
+ *   Template ──┐
+ *   Clone1   ──┴──▶ [RefCount=2 | FImpl]
+ *   Clone2   ─────▶ [RefCount=1 | FImpl 副本]
+ *
+ * 与 TPimplPtr 相同, 头文件中只需要 FImpl 的前向声明:
+ * 控制块记录了由 MakeCowPimpl (T 完整) 生成的销毁 / 复制函数, 拷贝、析构与分离都经由它们进行
+ *
+ * 线程安全性与 TSharedPtr 相同: 引用计数是原子的, 同一个 TCowPimplPtr 实例不能被多线程同时访问;
+ * 分离前的只读共享对象可以被多个线程同时读取
+ *
+ * 注意: 非 const 的 operator-> 即视为写入。只读的访问器应声明为 const 成员函数, 否则会无谓地分离
+ */
+namespace CowPimplPrivate
+{
+	struct FControlBlock
+	{
+		using FDestroyFunction = void (*)(FControlBlock*);
+		using FCloneFunction = FControlBlock* (*)(const FControlBlock*);
+
+		std::atomic<int32> RefCount{1};
+		FDestroyFunction Destroy;
+		FCloneFunction Clone;
+
+		/** 指向 TControlBlock<T>::Value, TCowPimplPtr 经由它访问实现对象而不需要 T 的完整定义 */
+		void* Object;
+	};
+
+	template<typename T>
+	struct TControlBlock : FControlBlock
+	{
+		T Value;
+
+		template<typename... ArgTypes>
+		explicit TControlBlock(ArgTypes&&... Args)
+			: Value(Forward<ArgTypes>(Args)...)
+		{
+			Destroy = &DestroyBlock;
+			Clone = &CloneBlock;
+			Object = &Value;
+		}
+
+		static void DestroyBlock(FControlBlock* Block)
+		{
+			delete static_cast<TControlBlock*>(Block);
+		}
+
+		static FControlBlock* CloneBlock(const FControlBlock* Block)
+		{
+			return new TControlBlock(static_cast<const TControlBlock*>(Block)->Value);
+		}
+	};
+}
+
+template<typename T>
+class TCowPimplPtr
+{
+public:
+	/** 空指针, 不需要 T 的完整定义 */
+	TCowPimplPtr() = default;
+	TCowPimplPtr(TYPE_OF_NULLPTR) {}
+
+	~TCowPimplPtr()
+	{
+		Release();
+	}
+
+	/** 共享: 只增加引用计数, 不复制 T */
+	TCowPimplPtr(const TCowPimplPtr& Other)
+		: Block(Other.Block)
+	{
+		if (Block)
+		{
+			Block->RefCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	TCowPimplPtr(TCowPimplPtr&& Other)
+		: Block(Other.Block)
+	{
+		Other.Block = nullptr;
+	}
+
+	TCowPimplPtr& operator=(const TCowPimplPtr& Other)
+	{
+		if (Block != Other.Block)
+		{
+			TCowPimplPtr Copy(Other);
+			Swap(Block, Copy.Block);
+		}
+		return *this;
+	}
+
+	TCowPimplPtr& operator=(TCowPimplPtr&& Other)
+	{
+		if (this != &Other)
+		{
+			Release();
+			Block = Other.Block;
+			Other.Block = nullptr;
+		}
+		return *this;
+	}
+
+	TCowPimplPtr& operator=(TYPE_OF_NULLPTR)
+	{
+		Reset();
+		return *this;
+	}
+
+	void Reset()
+	{
+		Release();
+	}
+
+	bool IsValid() const { return Block != nullptr; }
+	explicit operator bool() const { return Block != nullptr; }
+
+	/** 与其他 TCowPimplPtr 共享同一个实现对象 */
+	bool IsShared() const
+	{
+		return Block && Block->RefCount.load(std::memory_order_acquire) > 1;
+	}
+
+	/** 共享同一实现对象的指针数, 空指针为 0 */
+	int32 GetSharedReferenceCount() const
+	{
+		return Block ? Block->RefCount.load(std::memory_order_relaxed) : 0;
+	}
+
+	// 只读访问: 不分离
+	const T* Get() const { return Block ? static_cast<const T*>(Block->Object) : nullptr; }
+	const T* operator->() const { checkSlow(Block); return static_cast<const T*>(Block->Object); }
+	const T& operator*() const { checkSlow(Block); return *static_cast<const T*>(Block->Object); }
+
+	// 可写访问: 仍被共享时先复制出独占的一份
+	T* Get() { return Block ? &GetMutable() : nullptr; }
+	T* operator->() { return &GetMutable(); }
+	T& operator*() { return GetMutable(); }
+
+	/** 确保独占后返回可写引用 */
+	T& GetMutable()
+	{
+		checkSlow(Block);
+		Detach();
+		return *static_cast<T*>(Block->Object);
+	}
+
+private:
+	template<typename U, typename... ArgTypes>
+	friend TCowPimplPtr<U> MakeCowPimpl(ArgTypes&&... Args);
+
+	explicit TCowPimplPtr(CowPimplPrivate::FControlBlock* InBlock)
+		: Block(InBlock)
+	{
+	}
+
+	void Detach()
+	{
+		// 计数为 1 时只有本指针持有; 其他持有者只会减少计数, 不会重新共享给本指针, 因此无需加锁
+		if (Block->RefCount.load(std::memory_order_acquire) > 1)
+		{
+			CowPimplPrivate::FControlBlock* Unique = Block->Clone(Block);
+			Release();
+			Block = Unique;
+		}
+	}
+
+	void Release()
+	{
+		if (Block)
+		{
+			CowPimplPrivate::FControlBlock* LocalBlock = Block;
+			Block = nullptr;
+			if (LocalBlock->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				LocalBlock->Destroy(LocalBlock);
+			}
+		}
+	}
+
+	CowPimplPrivate::FControlBlock* Block = nullptr;
+};
+
+/** 对应 MakePimpl: 控制块与 T 一次分配; 必须在 T 完整的 cpp 中调用 */
+template<typename T, typename... ArgTypes>
+TCowPimplPtr<T> MakeCowPimpl(ArgTypes&&... Args)
+{
+	static_assert(std::is_copy_constructible_v<T>, "TCowPimplPtr requires T to be copy constructible to detach shared copies");
+	return TCowPimplPtr<T>(new CowPimplPrivate::TControlBlock<T>(Forward<ArgTypes>(Args)...));
+}
@@ -0,0 +1,228 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CowPimpl_Example.h"
+#include "PimplExampleImpl.h"
+#include "PimplLog.h"
+#include "Engine/World.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+// =====================================================
+// FImpl - 与 ATPimplPtr_Example 共用的实现
+// =====================================================
+
+struct ACowPimpl_Example::FImpl : FPimplExampleImpl
+{
+	using FPimplExampleImpl::FPimplExampleImpl;
+};
+
+// =====================================================
+// FTickState - 每个 Actor 独占的逐帧状态
+// =====================================================
+
+/**
+ * 与 FPimplExampleImpl::LocalHot (以及批量 Tick 的 SoA 字段) 相同, 每帧写入的字段按所有者存放;
+ * 共享的 FImpl 中的同名字段只在 IncrementCounter / ResetState 等修改接口分离后才会用到
+ */
+struct ACowPimpl_Example::FTickState
+{
+	float AccumulatedTime = 0.0f;
+	float LastCalculationResult = 0.0f;
+	
+	/** 本 Actor 的逐秒历史; FImpl::StateHistory 是模板生成克隆时的快照, 克隆之间共享 */
+	TBoundedHistory<float> StateHistory;
+	
+	explicit FTickState(int32 HistoryCapacity)
+		: StateHistory(HistoryCapacity)
+	{
+		StateHistory.Add(0.0f);
+	}
+	
+	/** 与 FPimplExampleImpl::Update 相同的更新 */
+	void Update(float DeltaTime)
+	{
+		AccumulatedTime += DeltaTime;
+		if (FMath::FloorToInt(AccumulatedTime) > StateHistory.GetTotalAdded())
+		{
+			StateHistory.Add(LastCalculationResult);
+		}
+	}
+	
+	void Reset()
+	{
+		AccumulatedTime = 0.0f;
+		LastCalculationResult = 0.0f;
+		StateHistory.Reset();
+		StateHistory.Add(0.0f);
+	}
+};
+
+// =====================================================
+// ACowPimpl_Example 实现
+// =====================================================
+
+ACowPimpl_Example::ACowPimpl_Example()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	
+	// 与 MakePimpl 相同; 克隆在 SpawnClone 中改为共享模板的实现
+	Impl = MakeCowPimpl<FImpl>(TEXT("CowPimplExampleActor"), 0);
+	TickState = MakePimpl<FTickState>(FPimplExampleImpl::DefaultHistoryCapacity);
+	
+	UE_LOG(LogTemp, Log, TEXT("[TCowPimplPtr] ACowPimpl_Example 构造完成"));
+}
+
+ACowPimpl_Example::~ACowPimpl_Example()
+{
+	// 最后一个共享者析构时才销毁 FImpl
+	UE_LOG(LogTemp, Log, TEXT("[TCowPimplPtr] ACowPimpl_Example 析构"));
+}
+
+void ACowPimpl_Example::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	// 共享模板实现的克隆已经初始化过, 先经由 const 访问判断, 避免无谓的分离
+	if (Impl.IsValid() && !AsConst(Impl)->bIsInitialized)
+	{
+		Impl->Initialize();
+	}
+	
+	PrintDebugInfo();
+}
+
+void ACowPimpl_Example::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	// 只写本 Actor 的逐帧状态, 共享中的克隆 Tick 后仍然共享
+	if (TickState)
+	{
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(PimplTick);
+		TickState->Update(DeltaTime);
+	}
+}
+
+// =====================================================
+// 公共接口实现 - 委托给FImpl
+// =====================================================
+
+void ACowPimpl_Example::SetActorDisplayName(const FString& NewName)
+{
+	if (Impl)
+	{
+		Impl->DisplayName = NewName;
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TCowPimplPtr] 设置名称: %s"), *NewName);
+	}
+}
+
+FString ACowPimpl_Example::GetActorDisplayName() const
+{
+	if (const FImpl* RawPtr = Impl.Get())
+	{
+		return RawPtr->DisplayName;
+	}
+	return TEXT("Invalid");
+}
+
+void ACowPimpl_Example::IncrementCounter()
+{
+	if (Impl)
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TCowPimplPtr] 计数器增加到: %d"), Impl->GetCounter());
+	}
+}
+
+int32 ACowPimpl_Example::GetCounter() const
+{
+	return Impl.IsValid() ? Impl->GetCounter() : -1;
+}
+
+void ACowPimpl_Example::ResetState()
+{
+	if (Impl)
+	{
+		Impl->Reset();
+	}
+	if (TickState)
+	{
+		TickState->Reset();
+	}
+}
+
+float ACowPimpl_Example::PerformCalculation(float InputValue)
+{
+	// 计数器只读 (经由 const 访问, 不分离), 累积时间与结果在本 Actor 的逐帧状态中
+	if (Impl && TickState)
+	{
+		const float Result = FPimplExampleImpl::CalculateResult(InputValue, AsConst(Impl)->GetCounter(), TickState->AccumulatedTime);
+		TickState->LastCalculationResult = Result;
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TCowPimplPtr] 计算结果: Input=%.2f, Output=%.4f"), InputValue, Result);
+		return Result;
+	}
+	return 0.0f;
+}
+
+bool ACowPimpl_Example::IsImplValid() const
+{
+	return Impl.IsValid();
+}
+
+void ACowPimpl_Example::PrintDebugInfo() const
+{
+	if (Impl)
+	{
+		Impl->PrintDebug();
+		if (TickState)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  [Per-Actor] AccumulatedTime: %.2f, LastCalculation: %.4f, StateHistory: %d / %d"),
+				TickState->AccumulatedTime, TickState->LastCalculationResult, TickState->StateHistory.Num(), TickState->StateHistory.GetCapacity());
+		}
+		UE_LOG(LogTemp, Warning, TEXT("  [TCowPimplPtr] Shared: %s"), IsImplShared() ? TEXT("Yes") : TEXT("No"));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[TCowPimplPtr] Impl 无效!"));
+	}
+}
+
+// =====================================================
+// 写时复制
+// =====================================================
+
+ACowPimpl_Example* ACowPimpl_Example::SpawnClone(const ACowPimpl_Example* Template, const FTransform& Transform, bool bShareImpl)
+{
+	UWorld* World = Template ? Template->GetWorld() : nullptr;
+	if (!World)
+	{
+		return nullptr;
+	}
+	
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.bDeferConstruction = true;
+	
+	ACowPimpl_Example* Clone = World->SpawnActor<ACowPimpl_Example>(ACowPimpl_Example::StaticClass(), Transform, SpawnParams);
+	if (!Clone)
+	{
+		return nullptr;
+	}
+	
+	// 在 BeginPlay 之前替换构造函数创建的实现
+	if (bShareImpl)
+	{
+		Clone->Impl = Template->Impl;
+	}
+	else if (Template->Impl.IsValid())
+	{
+		Clone->Impl = MakeCowPimpl<FImpl>(*Template->Impl);
+	}
+	
+	Clone->FinishSpawning(Transform);
+	return Clone;
+}
+
+bool ACowPimpl_Example::IsImplShared() const
+{
+	return Impl.IsShared();
+}
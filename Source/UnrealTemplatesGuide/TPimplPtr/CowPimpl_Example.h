@@ -0,0 +1,106 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Templates/PimplPtr.h"
+#include "CowPimpl.h"
+#include "CowPimpl_Example.generated.h"
+
+/**
+ * ACowPimpl_Example - 与 ATPimplPtr_Example 相同的接口与实现, FImpl 写时复制
+ * 
+ * SpawnClone 从一个模板 Actor 克隆:
+ * 1. bShareImpl = true: 克隆与模板共享同一个 FImpl (只增加引用计数), 第一次修改时才复制
+ * 2. bShareImpl = false: 立即深拷贝 FImpl (等同于 TPimplPtr 的 DeepCopy 模式), 用于对比
+ * 
+ * 只读的接口都是 const 成员函数, 经由 const 的 Impl 访问, 不会触发复制
+ * 
+ * 每帧写入的状态 (累积时间 / 上次计算结果 / 逐秒历史) 不放在共享的 FImpl 中, 而是每个 Actor 一份 FTickState;
+ * 否则每个克隆 (以及模板) 都会在第一次 Tick 时分离, 写时复制形同虚设
+ */
+UCLASS()
+class UNREALTEMPLATESGUIDE_API ACowPimpl_Example : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ACowPimpl_Example();
+	
+	// 与 TPimplPtr 相同, 析构函数在cpp中定义
+	virtual ~ACowPimpl_Example();
+
+protected:
+	virtual void BeginPlay() override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	// =====================================================
+	// 公共接口 - 与 ATPimplPtr_Example 相同
+	// =====================================================
+	
+	/** 设置Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void SetActorDisplayName(const FString& NewName);
+	
+	/** 获取Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	FString GetActorDisplayName() const;
+	
+	/** 增加计数器 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void IncrementCounter();
+	
+	/** 获取当前计数 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	int32 GetCounter() const;
+	
+	/** 重置状态 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void ResetState();
+	
+	/** 执行内部计算 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	float PerformCalculation(float InputValue);
+	
+	/** 检查实现是否有效 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	bool IsImplValid() const;
+	
+	/** 打印调试信息 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void PrintDebugInfo() const;
+
+	// =====================================================
+	// 写时复制
+	// =====================================================
+	
+	/**
+	 * 在模板所在的世界中生成一个克隆
+	 * 
+	 * @param bShareImpl  true 时共享模板的 FImpl 直到任一方修改; false 时立即深拷贝
+	 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample|Clone")
+	static ACowPimpl_Example* SpawnClone(const ACowPimpl_Example* Template, const FTransform& Transform, bool bShareImpl = true);
+	
+	/** FImpl 是否仍与其他 Actor 共享 */
+	UFUNCTION(BlueprintPure, Category = "PimplExample|Clone")
+	bool IsImplShared() const;
+
+private:
+	struct FImpl;
+	
+	/**
+	 * TCowPimplPtr<FImpl> - 可拷贝, 拷贝时共享实现, 非 const 访问时才分离
+	 * 
+	 * 只有名称、计数器和模板历史这些不随帧变化的数据; 修改它们的接口 (IncrementCounter 等) 才会分离
+	 */
+	TCowPimplPtr<FImpl> Impl;
+	
+	struct FTickState;
+	
+	/** 每个 Actor 独占的逐帧状态, 克隆时不共享也不复制 */
+	TPimplPtr<FTickState> TickState;
+};
@@ -0,0 +1,135 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <cstddef>
+#include <new>
+
+/**
+ * TInlinePimpl - 内联存储的 Pimpl ("fast pimpl")
+ *
+ * TPimplPtr 把实现对象放在堆上: 每个所有者一次堆分配, 每次访问一次指针跳转 (所有者 → 堆块),
+ * 成千上万个 Actor 逐个 Tick 时这一跳就是一次缓存未命中。
+ * TInlinePimpl 在所有者内部预留固定大小、对齐的存储, 实现对象就地构造:
+ *
+ *   头文件:  struct FImpl;                               // 仍然只有前向声明
+ *            TInlinePimpl<FImpl, 64, 16> Impl;            // 大小与对齐写在头文件中
+ *   cpp:     struct AMyActor::FImpl { ... };
+ *            static_assert(sizeof(FImpl) <= 64 && alignof(FImpl) <= 16);
+ *            Impl.Emplace(...);                           // 构造函数中
+ *
+ * 保留的: FImpl 的成员与依赖仍然只在 cpp 中, 修改它们不会让包含头文件的文件重新编译
+ * 放弃的: 布局防火墙的一半 - FImpl 超出预留大小时必须修改头文件中的 Size (编译期 static_assert 报错, 不会静默越界)
+ *
+ * 析构通过构造时记录的函数指针进行 (与 TPimplPtr 的类型擦除删除器相同),
+ * 因此所有者的析构函数 / UHT 生成的构造函数不需要 FImpl 的完整定义
+ * 不可拷贝也不可移动 (移动需要 FImpl 的完整定义; UObject 本身也不移动)
+ */
+template<typename T, SIZE_T InSize, SIZE_T InAlignment = alignof(std::max_align_t)>
+class TInlinePimpl
+{
+public:
+	static constexpr SIZE_T Size = InSize;
+	static constexpr SIZE_T Alignment = InAlignment;
+
+	/** 空状态, 不需要 T 的完整定义 */
+	TInlinePimpl() = default;
+
+	~TInlinePimpl()
+	{
+		Reset();
+	}
+
+	UE_NONCOPYABLE(TInlinePimpl);
+
+	/** 就地构造实现对象; 必须在 T 完整的 cpp 中调用 */
+	template<typename... ArgTypes>
+	T& Emplace(ArgTypes&&... Args)
+	{
+		static_assert(sizeof(T) <= InSize, "TInlinePimpl storage is too small for T, increase Size in the owner's header");
+		static_assert(alignof(T) <= InAlignment, "TInlinePimpl storage is under-aligned for T, increase Alignment in the owner's header");
+
+		Reset();
+		T* Object = new (Storage) T(Forward<ArgTypes>(Args)...);
+		Destructor = &DestroyObject<T>;
+		return *Object;
+	}
+
+	/** 销毁实现对象, 回到空状态 */
+	void Reset()
+	{
+		if (Destructor)
+		{
+			FDestructor LocalDestructor = Destructor;
+			Destructor = nullptr;
+			LocalDestructor(Storage);
+		}
+	}
+
+	bool IsValid() const
+	{
+		return Destructor != nullptr;
+	}
+
+	explicit operator bool() const
+	{
+		return IsValid();
+	}
+
+	T* Get()
+	{
+		return IsValid() ? GetUnchecked() : nullptr;
+	}
+
+	const T* Get() const
+	{
+		return IsValid() ? GetUnchecked() : nullptr;
+	}
+
+	T* operator->()
+	{
+		checkSlow(IsValid());
+		return GetUnchecked();
+	}
+
+	const T* operator->() const
+	{
+		checkSlow(IsValid());
+		return GetUnchecked();
+	}
+
+	T& operator*()
+	{
+		checkSlow(IsValid());
+		return *GetUnchecked();
+	}
+
+	const T& operator*() const
+	{
+		checkSlow(IsValid());
+		return *GetUnchecked();
+	}
+
+private:
+	using FDestructor = void (*)(void*);
+
+	template<typename ObjectType>
+	static void DestroyObject(void* Object)
+	{
+		static_cast<ObjectType*>(Object)->~ObjectType();
+	}
+
+	T* GetUnchecked()
+	{
+		return std::launder(reinterpret_cast<T*>(Storage));
+	}
+
+	const T* GetUnchecked() const
+	{
+		return std::launder(reinterpret_cast<const T*>(Storage));
+	}
+
+	alignas(InAlignment) uint8 Storage[InSize];
+	FDestructor Destructor = nullptr;
+};
@@ -0,0 +1,136 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InlinePimpl_Example.h"
+#include "PimplExampleImpl.h"
+#include "PimplLog.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+// =====================================================
+// FImpl - 与 ATPimplPtr_Example 共用的实现
+// =====================================================
+
+struct AInlinePimpl_Example::FImpl : FPimplExampleImpl
+{
+	using FPimplExampleImpl::FPimplExampleImpl;
+};
+
+// =====================================================
+// AInlinePimpl_Example 实现
+// =====================================================
+
+AInlinePimpl_Example::AInlinePimpl_Example()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	
+	// 头文件中的上限在这里校验 (FImpl 为私有类型, 放在成员函数中): 修改 FImpl 后超出上限会在此处编译失败
+	// 64 位平台上 FImpl 约 80 字节 (FString 16 + 环形历史 32 + 热字段 12 + 槽位 4 + 批量指针 8 + bool, 填充到 8 的倍数)
+	static_assert(sizeof(FImpl) <= ImplSize, "AInlinePimpl_Example::FImpl does not fit ImplSize, increase it in InlinePimpl_Example.h");
+	static_assert(alignof(FImpl) <= ImplAlignment, "AInlinePimpl_Example::FImpl needs a larger ImplAlignment in InlinePimpl_Example.h");
+	
+	// 就地构造, 没有堆分配
+	Impl.Emplace(TEXT("InlinePimplExampleActor"), 0);
+	
+	UE_LOG(LogTemp, Log, TEXT("[TInlinePimpl] AInlinePimpl_Example 构造完成"));
+}
+
+AInlinePimpl_Example::~AInlinePimpl_Example()
+{
+	// TInlinePimpl 析构时通过构造时记录的函数指针销毁 FImpl
+	UE_LOG(LogTemp, Log, TEXT("[TInlinePimpl] AInlinePimpl_Example 析构"));
+}
+
+void AInlinePimpl_Example::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	if (Impl.IsValid())
+	{
+		Impl->Initialize();
+	}
+	
+	PrintDebugInfo();
+}
+
+void AInlinePimpl_Example::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	// 与 TPimplPtr 写法相同, 但 Impl-> 只是 this 加常量偏移
+	if (Impl)
+	{
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(PimplTick);
+		Impl->Update(DeltaTime);
+	}
+}
+
+// =====================================================
+// 公共接口实现 - 委托给FImpl
+// =====================================================
+
+void AInlinePimpl_Example::SetActorDisplayName(const FString& NewName)
+{
+	if (Impl)
+	{
+		Impl->DisplayName = NewName;
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TInlinePimpl] 设置名称: %s"), *NewName);
+	}
+}
+
+FString AInlinePimpl_Example::GetActorDisplayName() const
+{
+	if (const FImpl* RawPtr = Impl.Get())
+	{
+		return RawPtr->DisplayName;
+	}
+	return TEXT("Invalid");
+}
+
+void AInlinePimpl_Example::IncrementCounter()
+{
+	if (Impl)
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TInlinePimpl] 计数器增加到: %d"), Impl->GetCounter());
+	}
+}
+
+int32 AInlinePimpl_Example::GetCounter() const
+{
+	return Impl.IsValid() ? Impl->GetCounter() : -1;
+}
+
+void AInlinePimpl_Example::ResetState()
+{
+	if (Impl)
+	{
+		Impl->Reset();
+	}
+}
+
+float AInlinePimpl_Example::PerformCalculation(float InputValue)
+{
+	if (Impl)
+	{
+		const float Result = Impl->Calculate(InputValue);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TInlinePimpl] 计算结果: Input=%.2f, Output=%.4f"), InputValue, Result);
+		return Result;
+	}
+	return 0.0f;
+}
+
+bool AInlinePimpl_Example::IsImplValid() const
+{
+	return Impl.IsValid();
+}
+
+void AInlinePimpl_Example::PrintDebugInfo() const
+{
+	if (Impl)
+	{
+		Impl->PrintDebug();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[TInlinePimpl] Impl 无效!"));
+	}
+}
@@ -0,0 +1,84 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "InlinePimpl.h"
+#include "InlinePimpl_Example.generated.h"
+
+/**
+ * AInlinePimpl_Example - 与 ATPimplPtr_Example 相同的接口与实现, FImpl 放在 Actor 内部
+ * 
+ * 对比 ATPimplPtr_Example:
+ * 1. 没有 MakePimpl 的堆分配, FImpl 与 Actor 在同一块内存中
+ * 2. Tick / BlueprintCallable 访问器不再经过指针跳转
+ * 3. FImpl 仍然只前向声明, 大小与对齐上限写在这里, 在 cpp 中用 static_assert 校验
+ */
+UCLASS()
+class UNREALTEMPLATESGUIDE_API AInlinePimpl_Example : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AInlinePimpl_Example();
+	
+	// 与 TPimplPtr 相同, 析构函数在cpp中定义
+	virtual ~AInlinePimpl_Example();
+
+protected:
+	virtual void BeginPlay() override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	// =====================================================
+	// 公共接口 - 与 ATPimplPtr_Example 相同
+	// =====================================================
+	
+	/** 设置Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void SetActorDisplayName(const FString& NewName);
+	
+	/** 获取Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	FString GetActorDisplayName() const;
+	
+	/** 增加计数器 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void IncrementCounter();
+	
+	/** 获取当前计数 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	int32 GetCounter() const;
+	
+	/** 重置状态 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void ResetState();
+	
+	/** 执行内部计算 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	float PerformCalculation(float InputValue);
+	
+	/** 检查实现是否有效 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	bool IsImplValid() const;
+	
+	/** 打印调试信息 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void PrintDebugInfo() const;
+
+	/** FImpl 的内联存储上限 (留有余量), cpp 中 static_assert 校验 */
+	static constexpr SIZE_T ImplSize = 96;
+	static constexpr SIZE_T ImplAlignment = 16;
+
+private:
+	struct FImpl;
+	
+	/**
+	 * TInlinePimpl<FImpl, Size, Alignment> - 实现对象就地存放在 Actor 中
+	 * 
+	 * FImpl 超出 ImplSize 时编译失败, 需要同时修改这里的上限 (会触发包含者重新编译)
+	 */
+	TInlinePimpl<FImpl, ImplSize, ImplAlignment> Impl;
+};
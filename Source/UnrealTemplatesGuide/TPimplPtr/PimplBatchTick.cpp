@@ -0,0 +1,143 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PimplBatchTick.h"
+#include "PimplExampleImpl.h"
+#include "HAL/IConsoleManager.h"
+#include "Tasks_System/ParallelBatch.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+static TAutoConsoleVariable<bool> CVarPimplBatchTickParallel(
+	TEXT("TemplatesGuide.PimplBatchTick.Parallel"),
+	true,
+	TEXT("Update batched pimpl instances in parallel chunks when there are enough of them"));
+
+FPimplBatchTickData::~FPimplBatchTickData()
+{
+	RemoveAll();
+}
+
+void FPimplBatchTickData::Add(FPimplExampleImpl& Impl)
+{
+	check(Impl.Batch == nullptr);
+
+	const FPimplHotFields& Hot = Impl.LocalHot;
+	const int32 Slot = Owners.Add(&Impl);
+	AccumulatedTime.Add(Hot.AccumulatedTime);
+	Counter.Add(Hot.Counter);
+	LastCalculationResult.Add(Hot.LastCalculationResult);
+	NextHistoryTime.Add(0.0f);
+	HistoryDue.Add(0);
+
+	Impl.Batch = this;
+	Impl.BatchSlot = Slot;
+	OnHistoryChanged(Slot, Impl.StateHistory.GetTotalAdded());
+}
+
+void FPimplBatchTickData::Remove(FPimplExampleImpl& Impl)
+{
+	check(Impl.Batch == this);
+
+	const int32 Slot = Impl.BatchSlot;
+	Impl.LocalHot.AccumulatedTime = AccumulatedTime[Slot];
+	Impl.LocalHot.Counter = Counter[Slot];
+	Impl.LocalHot.LastCalculationResult = LastCalculationResult[Slot];
+	Impl.Batch = nullptr;
+	Impl.BatchSlot = INDEX_NONE;
+
+	Owners.RemoveAtSwap(Slot, EAllowShrinking::No);
+	AccumulatedTime.RemoveAtSwap(Slot, EAllowShrinking::No);
+	Counter.RemoveAtSwap(Slot, EAllowShrinking::No);
+	LastCalculationResult.RemoveAtSwap(Slot, EAllowShrinking::No);
+	NextHistoryTime.RemoveAtSwap(Slot, EAllowShrinking::No);
+	HistoryDue.RemoveAtSwap(Slot, EAllowShrinking::No);
+
+	// 原末尾元素移到了 Slot
+	if (Owners.IsValidIndex(Slot))
+	{
+		Owners[Slot]->BatchSlot = Slot;
+	}
+}
+
+void FPimplBatchTickData::RemoveAll()
+{
+	// 从末尾移除, 不需要交换
+	while (Owners.Num() > 0)
+	{
+		Remove(*Owners.Last());
+	}
+}
+
+void FPimplBatchTickData::OnHistoryChanged(int32 Slot, int64 HistoryTotal)
+{
+	// 与 FPimplExampleImpl::Update 的条件一致: FloorToInt(t) > HistoryTotal, 即 t >= HistoryTotal + 1
+	NextHistoryTime[Slot] = float(HistoryTotal + 1);
+}
+
+int32 FPimplBatchTickData::UpdateRange(int32 Begin, int32 End, float DeltaTime)
+{
+	float* RESTRICT Times = AccumulatedTime.GetData();
+	const float* RESTRICT NextTimes = NextHistoryTime.GetData();
+	uint8* RESTRICT Due = HistoryDue.GetData();
+
+	// 无分支: 编译器可以把这个循环向量化
+	int32 NumDue = 0;
+	for (int32 i = Begin; i < End; ++i)
+	{
+		const float Time = Times[i] + DeltaTime;
+		Times[i] = Time;
+
+		const uint8 bDue = Time >= NextTimes[i] ? 1 : 0;
+		Due[i] = bDue;
+		NumDue += bDue;
+	}
+	return NumDue;
+}
+
+void FPimplBatchTickData::Tick(float DeltaTime, bool bAllowParallel)
+{
+	const int32 NumInstances = Owners.Num();
+	if (NumInstances == 0)
+	{
+		return;
+	}
+
+	UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(PimplBatchTick);
+
+	int32 NumDue = 0;
+	if (bAllowParallel && CVarPimplBatchTickParallel.GetValueOnAnyThread() && NumInstances >= MinParallelInstances)
+	{
+		std::atomic<int32> SharedNumDue{0};
+
+		constexpr int32 FloatsPerCacheLine = PLATFORM_CACHE_LINE_SIZE / sizeof(float);
+		const int32 Lead = int32((FloatsPerCacheLine - (UPTRINT(AccumulatedTime.GetData()) / sizeof(float)) % FloatsPerCacheLine) % FloatsPerCacheLine);
+
+		UE::TemplatesGuide::LaunchBatchedRange(TEXT("PimplBatchTick"), NumInstances,
+			[this, DeltaTime, &SharedNumDue](int32 Begin, int32 End)
+			{
+				if (const int32 ChunkDue = UpdateRange(Begin, End, DeltaTime))
+				{
+					SharedNumDue.fetch_add(ChunkDue, std::memory_order_relaxed);
+				}
+			},
+			UE::TemplatesGuide::FBatchLaunchParams(), FloatsPerCacheLine, Lead).Wait();
+
+		NumDue = SharedNumDue.load(std::memory_order_relaxed);
+	}
+	else
+	{
+		NumDue = UpdateRange(0, NumInstances, DeltaTime);
+	}
+
+	// 冷路径: 大多数帧没有实例跨过整秒, 直接跳过
+	for (int32 Slot = 0; NumDue > 0 && Slot < NumInstances; ++Slot)
+	{
+		if (HistoryDue[Slot])
+		{
+			FPimplExampleImpl& Impl = *Owners[Slot];
+			Impl.StateHistory.Add(LastCalculationResult[Slot]);
+			OnHistoryChanged(Slot, Impl.StateHistory.GetTotalAdded());
+			--NumDue;
+		}
+	}
+}
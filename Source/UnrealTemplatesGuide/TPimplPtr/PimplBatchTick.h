@@ -0,0 +1,82 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPimplExampleImpl;
+
+/**
+ * FPimplExampleImpl 的热字段
+ *
+ * 未加入批量 Tick 时存放在 FImpl 内部; 加入后改由 FPimplBatchTickData 的 SoA 数组持有,
+ * FImpl 的访问器 (GetCounter / SetCounter ...) 透明地转到数组中的对应槽位
+ */
+struct FPimplHotFields
+{
+	float AccumulatedTime = 0.0f;
+	int32 Counter = 0;
+	float LastCalculationResult = 0.0f;
+};
+
+/**
+ * FPimplBatchTickData - 以 SoA 方式批量 Tick 多个 FPimplExampleImpl
+ *
+ * 逐个 Tick: 虚函数 AActor::Tick → 指针跳转到 FImpl → 几次标量运算, 每个实例都是一次缓存未命中
+ * 批量 Tick: 热字段按字段连续存放, 一次循环更新所有实例
+ *
+ *   AccumulatedTime:  [t0][t1][t2] ...          ← 每帧 t += DeltaTime, 可向量化
+ *   NextHistoryTime:  [n0][n1][n2] ...          ← t >= n 时需要记录历史 (稀少, 冷路径)
+ *   Counter / LastCalculationResult             ← 只由访问器读写
+ *   Owners:           [FImpl*] ...              ← 冷路径与移除时使用
+ *
+ * 实例数不少于 MinParallelInstances 时经由 LaunchBatchedRange 分块并行更新, 块边界按缓存行对齐
+ * 记录历史 (StateHistory.Add) 需要访问 FImpl, 在所有块完成后于调用线程串行处理
+ *
+ * 只能在一个线程上使用 (通常为游戏线程, 见 UPimplBatchTickSubsystem); 析构时把热字段写回各 FImpl
+ */
+class UNREALTEMPLATESGUIDE_API FPimplBatchTickData
+{
+public:
+	FPimplBatchTickData() = default;
+	~FPimplBatchTickData();
+
+	UE_NONCOPYABLE(FPimplBatchTickData);
+
+	/** 把 Impl 的热字段移入数组, 此后 Impl.Update 不再需要调用 */
+	void Add(FPimplExampleImpl& Impl);
+
+	/** 把热字段写回 Impl 并移出数组 (与末尾交换) */
+	void Remove(FPimplExampleImpl& Impl);
+
+	/** 移出所有实例 */
+	void RemoveAll();
+
+	/** 更新所有实例; bAllowParallel 为 false 或实例数不足 MinParallelInstances 时在调用线程执行 */
+	void Tick(float DeltaTime, bool bAllowParallel = true);
+
+	/** StateHistory 写入总数变化后 (如 Reset) 重新计算下一次记录时间 */
+	void OnHistoryChanged(int32 Slot, int64 HistoryTotal);
+
+	int32 Num() const
+	{
+		return Owners.Num();
+	}
+
+	/** 少于此数时并行调度的开销大于收益 */
+	static constexpr int32 MinParallelInstances = 4096;
+
+	TArray<float> AccumulatedTime;
+	TArray<float> NextHistoryTime;
+	TArray<int32> Counter;
+	TArray<float> LastCalculationResult;
+
+private:
+	/** 单块的 SoA 更新, 返回需要记录历史的实例数 */
+	int32 UpdateRange(int32 Begin, int32 End, float DeltaTime);
+
+	TArray<FPimplExampleImpl*> Owners;
+
+	/** UpdateRange 标记的需要记录历史的实例 (每个槽位只由一个块写入) */
+	TArray<uint8> HistoryDue;
+};
@@ -0,0 +1,32 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PimplBatchTickSubsystem.h"
+#include "PimplExampleImpl.h"
+
+void UPimplBatchTickSubsystem::Register(FPimplExampleImpl& Impl)
+{
+	Data.Add(Impl);
+}
+
+void UPimplBatchTickSubsystem::Unregister(FPimplExampleImpl& Impl)
+{
+	Data.Remove(Impl);
+}
+
+void UPimplBatchTickSubsystem::Deinitialize()
+{
+	// 世界拆除时仍注册的实例 (未经 EndPlay) 回到逐个 Tick 的状态, 不留悬空指针
+	Data.RemoveAll();
+	Super::Deinitialize();
+}
+
+void UPimplBatchTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	Data.Tick(DeltaTime);
+}
+
+TStatId UPimplBatchTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPimplBatchTickSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,40 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PimplBatchTick.h"
+#include "PimplBatchTickSubsystem.generated.h"
+
+/**
+ * UPimplBatchTickSubsystem - 每个世界一个的批量 Tick 管理器 (可选加入)
+ *
+ * ATPimplPtr_Example 勾选 bUseBatchedTick 后在 BeginPlay 中把 FImpl 注册到这里并关闭自身的 Tick,
+ * 之后由本子系统每帧一次性更新所有注册实例 (见 FPimplBatchTickData)
+ * GetCounter / PerformCalculation 等接口不受影响: FImpl 的访问器会转到 SoA 数组中的槽位
+ */
+UCLASS()
+class UNREALTEMPLATESGUIDE_API UPimplBatchTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 加入批量 Tick; 调用方负责关闭逐个 Tick */
+	void Register(FPimplExampleImpl& Impl);
+
+	/** 移出批量 Tick, 热字段写回 FImpl */
+	void Unregister(FPimplExampleImpl& Impl);
+
+	int32 GetNumRegistered() const
+	{
+		return Data.Num();
+	}
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	FPimplBatchTickData Data;
+};
@@ -0,0 +1,214 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+// 只由 TPimplPtr_Example.cpp / InlinePimpl_Example.cpp / 基准包含, 不要在公共头文件中包含
+#include "CoreMinimal.h"
+#include "PimplBatchTick.h"
+#include "BoundedHistory.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+// =====================================================
+// 示例 Actor 共用的实现
+// =====================================================
+
+/**
+ * FPimplExampleImpl - 包含所有私有实现细节
+ *
+ * ATPimplPtr_Example (TPimplPtr, 堆上) 与 AInlinePimpl_Example (TInlinePimpl, 内联存储)
+ * 共用同一份实现, 两者的差别只在实现对象放在哪里, 基准对比的就是这一点
+ * 
+ * 优势：
+ * 1. 所有依赖都隐藏在cpp中
+ * 2. 可以自由添加/删除成员而不影响ABI
+ * 3. 头文件保持简洁
+ */
+struct FPimplExampleImpl
+{
+	// =====================================================
+	// 成员变量 - 这些在头文件中完全不可见
+	// =====================================================
+	
+	/** Actor的显示名称 */
+	FString DisplayName;
+	
+	/** 默认保留最近 100 秒的状态 */
+	static constexpr int32 DefaultHistoryCapacity = 100;
+	
+	/** 内部状态历史 (每秒一条), 定容环形缓冲, 写满后覆盖最旧的一条 */
+	TBoundedHistory<float> StateHistory;
+	
+	/**
+	 * 热字段 (累积时间 / 计数器 / 上次计算结果)
+	 * 
+	 * 加入批量 Tick 后由 FPimplBatchTickData 持有, 这里的值在移出时才写回,
+	 * 因此一律经由下面的访问器读写
+	 */
+	FPimplHotFields LocalHot;
+	
+	/** 所在的批量 Tick 槽位, INDEX_NONE 表示逐个 Tick */
+	int32 BatchSlot = INDEX_NONE;
+	
+	/** 所在的批量 Tick, 为空表示逐个 Tick */
+	FPimplBatchTickData* Batch = nullptr;
+	
+	/** 是否已初始化 */
+	bool bIsInitialized;
+	
+	// =====================================================
+	// 热字段访问器
+	// =====================================================
+	
+	bool IsBatched() const { return Batch != nullptr; }
+	
+	int32 GetCounter() const { return Batch ? Batch->Counter[BatchSlot] : LocalHot.Counter; }
+	void SetCounter(int32 Value) { (Batch ? Batch->Counter[BatchSlot] : LocalHot.Counter) = Value; }
+	
+	float GetAccumulatedTime() const { return Batch ? Batch->AccumulatedTime[BatchSlot] : LocalHot.AccumulatedTime; }
+	void SetAccumulatedTime(float Value) { (Batch ? Batch->AccumulatedTime[BatchSlot] : LocalHot.AccumulatedTime) = Value; }
+	
+	float GetLastCalculationResult() const { return Batch ? Batch->LastCalculationResult[BatchSlot] : LocalHot.LastCalculationResult; }
+	void SetLastCalculationResult(float Value) { (Batch ? Batch->LastCalculationResult[BatchSlot] : LocalHot.LastCalculationResult) = Value; }
+	
+	// =====================================================
+	// 构造函数
+	// =====================================================
+	
+	/** 默认构造 */
+	FPimplExampleImpl()
+		: DisplayName(TEXT("DefaultPimplActor"))
+		, StateHistory(DefaultHistoryCapacity)
+		, bIsInitialized(false)
+	{
+		RecordLifetime(1);
+		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 默认构造完成"));
+	}
+	
+	/** 带参数构造 */
+	FPimplExampleImpl(const FString& InName, int32 InInitialCounter, int32 InHistoryCapacity = DefaultHistoryCapacity)
+		: DisplayName(InName)
+		, StateHistory(InHistoryCapacity)
+		, bIsInitialized(false)
+	{
+		LocalHot.Counter = InInitialCounter;
+		RecordLifetime(1);
+		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 参数构造: Name=%s, Counter=%d"), *InName, InInitialCounter);
+	}
+	
+	/** 析构函数 */
+	~FPimplExampleImpl()
+	{
+		// 所有者未移出批量 Tick 就被销毁 (如未经 EndPlay), 不能在数组中留下悬空指针
+		if (Batch)
+		{
+			Batch->Remove(*this);
+		}
+		RecordLifetime(-1);
+		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 析构: Name=%s, FinalCounter=%d"), *DisplayName, LocalHot.Counter);
+	}
+	
+	/**
+	 * 拷贝构造 (TPimplPtr 的 DeepCopy 模式 / TCowPimplPtr 分离时使用)
+	 * 
+	 * 热字段经由访问器读取, 副本总是逐个 Tick: 批量 Tick 的槽位属于原对象
+	 */
+	FPimplExampleImpl(const FPimplExampleImpl& Other)
+		: DisplayName(Other.DisplayName)
+		, StateHistory(Other.StateHistory)
+		, bIsInitialized(Other.bIsInitialized)
+	{
+		LocalHot.AccumulatedTime = Other.GetAccumulatedTime();
+		LocalHot.Counter = Other.GetCounter();
+		LocalHot.LastCalculationResult = Other.GetLastCalculationResult();
+		RecordLifetime(1);
+		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 拷贝构造: Name=%s"), *DisplayName);
+	}
+	
+	FPimplExampleImpl& operator=(const FPimplExampleImpl&) = delete;
+	
+	/** stat TemplatesGuide: 存活数与内存 (对象本身 + 历史缓冲, 缓冲容量构造后不变), 构造时 +1, 析构时 -1 */
+	void RecordLifetime(int32 Delta) const
+	{
+		using namespace UE::TemplatesGuide::Stats;
+		
+		if (Delta > 0)
+		{
+			UE_TEMPLATESGUIDE_INC_COUNTER(PimplsCreated, Delta);
+		}
+		AddToGauge(EGauge::LivePimpls, Delta);
+		AddToGauge(EGauge::PimplMemory, Delta * int64(sizeof(FPimplExampleImpl) + StateHistory.GetAllocatedSize()));
+	}
+	
+	// =====================================================
+	// 内部方法
+	// =====================================================
+	
+	/** 初始化 */
+	void Initialize()
+	{
+		if (!bIsInitialized)
+		{
+			bIsInitialized = true;
+			StateHistory.Add(0.0f);
+			UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 初始化完成"));
+		}
+	}
+	
+	/** 更新状态 (逐个 Tick); 批量 Tick 中的实例由 FPimplBatchTickData::Tick 完成同样的更新 */
+	void Update(float DeltaTime)
+	{
+		checkSlow(!IsBatched());
+		LocalHot.AccumulatedTime += DeltaTime;
+		
+		// 每秒记录一次状态
+		// 用写入总数而不是 Num: 写满后 Num 不再增长
+		if (FMath::FloorToInt(LocalHot.AccumulatedTime) > StateHistory.GetTotalAdded())
+		{
+			StateHistory.Add(LocalHot.LastCalculationResult);
+		}
+	}
+	
+	/** 示例计算：结合计数器和累积时间 (ACowPimpl_Example 的累积时间不在 FImpl 中, 直接调用) */
+	static float CalculateResult(float Input, int32 Counter, float AccumulatedTime)
+	{
+		return Input * (Counter + 1) + FMath::Sin(AccumulatedTime);
+	}
+	
+	/** 执行计算 */
+	float Calculate(float Input)
+	{
+		const float Result = CalculateResult(Input, GetCounter(), GetAccumulatedTime());
+		SetLastCalculationResult(Result);
+		return Result;
+	}
+	
+	/** 重置 */
+	void Reset()
+	{
+		SetCounter(0);
+		SetAccumulatedTime(0.0f);
+		SetLastCalculationResult(0.0f);
+		// 保留分配, 不是 Empty()
+		StateHistory.Reset();
+		StateHistory.Add(0.0f);
+		if (Batch)
+		{
+			Batch->OnHistoryChanged(BatchSlot, StateHistory.GetTotalAdded());
+		}
+		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 状态已重置"));
+	}
+	
+	/** 打印调试信息 */
+	void PrintDebug() const
+	{
+		UE_LOG(LogTemp, Warning, TEXT("========== TPimplPtr Debug Info =========="));
+		UE_LOG(LogTemp, Warning, TEXT("  DisplayName: %s"), *DisplayName);
+		UE_LOG(LogTemp, Warning, TEXT("  Counter: %d"), GetCounter());
+		UE_LOG(LogTemp, Warning, TEXT("  AccumulatedTime: %.2f"), GetAccumulatedTime());
+		UE_LOG(LogTemp, Warning, TEXT("  LastCalculation: %.4f"), GetLastCalculationResult());
+		UE_LOG(LogTemp, Warning, TEXT("  BatchedTick: %s"), IsBatched() ? TEXT("Yes") : TEXT("No"));
+		UE_LOG(LogTemp, Warning, TEXT("  IsInitialized: %s"), bIsInitialized ? TEXT("Yes") : TEXT("No"));
+		UE_LOG(LogTemp, Warning, TEXT("  StateHistory Count: %d / %d (Total %lld)"), StateHistory.Num(), StateHistory.GetCapacity(), StateHistory.GetTotalAdded());
+		UE_LOG(LogTemp, Warning, TEXT("=========================================="));
+	}
+};
@@ -0,0 +1,19 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PimplLog.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogTemplatesGuidePimpl);
+
+namespace UE::TemplatesGuide::PimplLog
+{
+	static TAutoConsoleVariable<int32> CVarSampleEvery(
+		TEXT("TemplatesGuide.PimplLog.SampleEvery"),
+		64,
+		TEXT("Per-call pimpl accessor logs are emitted once every N calls per call site (1 = every call, 0 = off)"));
+
+	int32 GetSampleEvery()
+	{
+		return CVarSampleEvery.GetValueOnAnyThread();
+	}
+}
@@ -0,0 +1,69 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Pimpl 示例的日志类别与按调用点采样的日志
+ *
+ * IncrementCounter / SetActorDisplayName / PerformCalculation 可能被蓝图每帧调用,
+ * 每次调用都 UE_LOG 时, 格式化与输出设备的开销远大于访问器本身的工作
+ *
+ * 三层控制, 开销依次增加:
+ *   1. 编译期: LogTemplatesGuidePimpl 的编译期级别 (UE_TEMPLATESGUIDE_PIMPL_LOG_COMPILE_VERBOSITY,
+ *      Shipping 默认 Warning), 高于该级别的日志连同参数求值一起被编译掉
+ *   2. 运行期: 类别被压制 (log LogTemplatesGuidePimpl Warning) 时只剩一次级别比较
+ *   3. 采样: 逐调用的日志用 UE_TEMPLATESGUIDE_LOG_SAMPLED, 每个调用点每 N 次输出一次
+ *      (TemplatesGuide.PimplLog.SampleEvery, 1 = 每次, 0 = 关闭逐调用日志)
+ *
+ *   UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("计数器增加到: %d"), Counter);
+ */
+#ifndef UE_TEMPLATESGUIDE_PIMPL_LOG_COMPILE_VERBOSITY
+	#if UE_BUILD_SHIPPING
+		#define UE_TEMPLATESGUIDE_PIMPL_LOG_COMPILE_VERBOSITY Warning
+	#else
+		#define UE_TEMPLATESGUIDE_PIMPL_LOG_COMPILE_VERBOSITY All
+	#endif
+#endif
+
+UNREALTEMPLATESGUIDE_API DECLARE_LOG_CATEGORY_EXTERN(LogTemplatesGuidePimpl, Log, UE_TEMPLATESGUIDE_PIMPL_LOG_COMPILE_VERBOSITY);
+
+namespace UE::TemplatesGuide::PimplLog
+{
+	/** TemplatesGuide.PimplLog.SampleEvery 的当前值 */
+	UNREALTEMPLATESGUIDE_API int32 GetSampleEvery();
+
+	/** 调用点计数器递增; 返回本次调用是否应当输出 (每 SampleEvery 次一次, 首次调用总是输出) */
+	inline bool ShouldSample(std::atomic<uint32>& CallSiteCounter, int32 SampleEvery)
+	{
+		if (SampleEvery <= 0)
+		{
+			return false;
+		}
+		return CallSiteCounter.fetch_add(1, std::memory_order_relaxed) % uint32(SampleEvery) == 0;
+	}
+}
+
+/**
+ * 按调用点采样的 UE_LOG
+ *
+ * 顺序与 UE_LOG 一致: 编译期级别 → 运行期压制 → (新增) 采样 → 格式化
+ * 前两步不通过时既不格式化也不碰计数器
+ */
+#define UE_TEMPLATESGUIDE_LOG_SAMPLED(CategoryName, Verbosity, Format, ...) \
+	do \
+	{ \
+		if constexpr (((uint8)ELogVerbosity::Verbosity & (uint8)ELogVerbosity::VerbosityMask) <= (uint8)FLogCategory##CategoryName::CompileTimeVerbosity) \
+		{ \
+			if (!CategoryName.IsSuppressed(ELogVerbosity::Verbosity)) \
+			{ \
+				static std::atomic<uint32> TemplatesGuideLogCallSiteCounter{0}; \
+				if (UE::TemplatesGuide::PimplLog::ShouldSample(TemplatesGuideLogCallSiteCounter, UE::TemplatesGuide::PimplLog::GetSampleEvery())) \
+				{ \
+					UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+				} \
+			} \
+		} \
+	} while (0)
@@ -0,0 +1,172 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PooledPimpl.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace PooledPimplPrivate
+{
+	/** 池注册表; 池与注册表都不销毁 */
+	struct FRegistry
+	{
+		FCriticalSection Mutex;
+		TArray<const FPimplBlockPool*> Pools;
+	};
+
+	static FRegistry& GetRegistry()
+	{
+		static FRegistry* Registry = new FRegistry();
+		return *Registry;
+	}
+
+	static void DumpPools()
+	{
+		for (const FPimplPoolStats& Stats : GetAllPimplPoolStats())
+		{
+			UE_LOG(LogTemp, Display, TEXT("[PimplPool] %s: Block=%llu B, Chunks=%d x %d, Live=%d (Peak %d), Allocs=%lld, Frees=%lld, Reused=%lld, Slack=%llu B"),
+				*Stats.Name, uint64(Stats.BlockSize), Stats.NumChunks, Stats.BlocksPerChunk, Stats.NumLive, Stats.PeakLive,
+				Stats.NumAllocations, Stats.NumFrees, Stats.NumReused, uint64(Stats.GetSlackBytes()));
+		}
+	}
+
+	static FAutoConsoleCommand DumpPoolsCommand(
+		TEXT("TemplatesGuide.PimplPools"),
+		TEXT("Dump allocation stats of every TPimplPool"),
+		FConsoleCommandDelegate::CreateStatic(&DumpPools));
+}
+
+// ============================================================================
+// FPimplBlockPool
+// ============================================================================
+FPimplBlockPool::FPimplBlockPool(const TCHAR* InName, SIZE_T InBlockSize, SIZE_T InBlockAlignment, int32 InBlocksPerChunk, FDestroyFunction InDestroy)
+	: Name(InName)
+	// 空闲块中存放链表指针, 块至少要放得下一个指针
+	, BlockSize(Align(FMath::Max(InBlockSize, sizeof(FFreeBlock)), FMath::Max(InBlockAlignment, alignof(FFreeBlock))))
+	, BlockAlignment(FMath::Max(InBlockAlignment, alignof(FFreeBlock)))
+	, BlocksPerChunk(InBlocksPerChunk)
+	, Destroy(InDestroy)
+{
+	check(BlocksPerChunk > 0);
+
+	PooledPimplPrivate::FRegistry& Registry = PooledPimplPrivate::GetRegistry();
+	FScopeLock Lock(&Registry.Mutex);
+	Registry.Pools.Add(this);
+}
+
+FPimplBlockPool::~FPimplBlockPool()
+{
+	{
+		PooledPimplPrivate::FRegistry& Registry = PooledPimplPrivate::GetRegistry();
+		FScopeLock Lock(&Registry.Mutex);
+		Registry.Pools.Remove(this);
+	}
+
+	// 仍有存活对象时保留 Chunk: 它们稍后归还时不能访问已释放的内存
+	if (!Trim())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PimplPool] %s destroyed with %d live objects, leaking %d chunks"), *Name, NumLive, Chunks.Num());
+	}
+}
+
+void* FPimplBlockPool::Allocate()
+{
+	FScopeLock Lock(&Mutex);
+
+	++NumAllocations;
+	PeakLive = FMath::Max(PeakLive, ++NumLive);
+
+	if (FFreeBlock* Block = FreeList)
+	{
+		FreeList = Block->Next;
+		++NumReused;
+		return Block;
+	}
+
+	if (NumUncarvedInLastChunk == 0)
+	{
+		Chunks.Add(static_cast<uint8*>(FMemory::Malloc(BlockSize * BlocksPerChunk, BlockAlignment)));
+		UE::TemplatesGuide::Stats::AddToGauge(UE::TemplatesGuide::Stats::EGauge::PimplPoolMemory, int64(BlockSize * BlocksPerChunk));
+		NumUncarvedInLastChunk = BlocksPerChunk;
+	}
+
+	// 新 Chunk 按地址顺序切出, 连续生成的对象彼此相邻
+	const int32 BlockIndex = BlocksPerChunk - NumUncarvedInLastChunk--;
+	return Chunks.Last() + SIZE_T(BlockIndex) * BlockSize;
+}
+
+void FPimplBlockPool::Free(void* Block)
+{
+	check(Block);
+
+	FScopeLock Lock(&Mutex);
+
+	checkSlow(NumLive > 0);
+	--NumLive;
+	++NumFrees;
+
+	FFreeBlock* FreeBlock = static_cast<FFreeBlock*>(Block);
+	FreeBlock->Next = FreeList;
+	FreeList = FreeBlock;
+}
+
+bool FPimplBlockPool::Trim()
+{
+	FScopeLock Lock(&Mutex);
+
+	if (NumLive > 0)
+	{
+		return false;
+	}
+
+	for (uint8* Chunk : Chunks)
+	{
+		FMemory::Free(Chunk);
+	}
+	UE::TemplatesGuide::Stats::AddToGauge(UE::TemplatesGuide::Stats::EGauge::PimplPoolMemory, -int64(BlockSize * BlocksPerChunk * Chunks.Num()));
+	Chunks.Empty();
+	FreeList = nullptr;
+	NumUncarvedInLastChunk = 0;
+	return true;
+}
+
+FPimplPoolStats FPimplBlockPool::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+
+	FPimplPoolStats Stats;
+	Stats.Name = Name;
+	Stats.BlockSize = BlockSize;
+	Stats.BlocksPerChunk = BlocksPerChunk;
+	Stats.NumChunks = Chunks.Num();
+	Stats.NumLive = NumLive;
+	Stats.PeakLive = PeakLive;
+	Stats.NumAllocations = NumAllocations;
+	Stats.NumFrees = NumFrees;
+	Stats.NumReused = NumReused;
+	return Stats;
+}
+
+void FPimplBlockPool::ResetCounters()
+{
+	FScopeLock Lock(&Mutex);
+
+	PeakLive = NumLive;
+	NumAllocations = 0;
+	NumFrees = 0;
+	NumReused = 0;
+}
+
+TArray<FPimplPoolStats> GetAllPimplPoolStats()
+{
+	PooledPimplPrivate::FRegistry& Registry = PooledPimplPrivate::GetRegistry();
+	FScopeLock Lock(&Registry.Mutex);
+
+	TArray<FPimplPoolStats> Result;
+	Result.Reserve(Registry.Pools.Num());
+	for (const FPimplBlockPool* Pool : Registry.Pools)
+	{
+		Result.Add(Pool->GetStats());
+	}
+	return Result;
+}
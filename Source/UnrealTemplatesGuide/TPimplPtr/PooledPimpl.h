@@ -0,0 +1,232 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TPooledPimplPtr - 从类型专属的块池分配实现对象的 Pimpl 指针
+ *
+ * TPimplPtr 总是经由 MakePimpl 在通用分配器上 new 出实现对象, 删除器固定为 delete,
+ * 成批生成 / 销毁 Actor 时每个 FImpl 都是一次通用分配器的分配与释放, 且各个 FImpl 在内存中彼此分散
+ * 池化后:
+ *   - 块按 Chunk 成片分配 (一个 Chunk 容纳 BlocksPerChunk 个 FImpl), 同一波生成的 FImpl 彼此相邻
+ *   - 释放的块进入空闲链表 (LIFO), 下一波生成直接复用, 不再触碰通用分配器
+ *   - 池记录分配统计 (见 FPimplPoolStats / GetAllPimplPoolStats, 控制台 TemplatesGuide.PimplPools)
+ *
+ * 用法 (与 TPimplPtr 相同, FImpl 在头文件中只有前向声明):
+ *
+ *   头文件:  struct FImpl;
+ *            TPooledPimplPtr<FImpl> Impl;
+ *            static TPimplPool<FImpl>& GetImplPool();      // FImpl 为私有类型, 池的访问函数也作为成员
+ *   cpp:     struct AMyActor::FImpl { ... };
+ *            TPimplPool<AMyActor::FImpl>& AMyActor::GetImplPool()
+ *            {
+ *                static TPimplPool<FImpl>* Pool = new TPimplPool<FImpl>(TEXT("AMyActor::FImpl"), 256);
+ *                return *Pool;
+ *            }
+ *            Impl = MakePooledPimpl(GetImplPool(), ...);   // 构造函数中
+ *
+ * 池对象有意不销毁: CDO 等对象可能在静态析构之后才释放实现对象, 届时池必须仍然有效
+ *
+ * 指针只保存对象地址与所属池 (池记录了 T 的析构函数), 所有者的析构函数与 UHT 生成的构造函数
+ * 都不需要 FImpl 的完整定义。只支持移动, 对应 TPimplPtr 的 NoCopy 模式
+ */
+
+/** 单个池的分配统计 */
+struct FPimplPoolStats
+{
+	FString Name;
+
+	/** 每块字节数 (sizeof(T) 按对齐向上取整) */
+	SIZE_T BlockSize = 0;
+	int32 BlocksPerChunk = 0;
+
+	/** 向通用分配器申请的 Chunk 数, 也是池对通用分配器的全部分配次数 */
+	int32 NumChunks = 0;
+
+	/** 当前 / 历史最多存活的对象数 */
+	int32 NumLive = 0;
+	int32 PeakLive = 0;
+
+	int64 NumAllocations = 0;
+	int64 NumFrees = 0;
+
+	/** 分配中从空闲链表复用的次数 */
+	int64 NumReused = 0;
+
+	/** 已申请但未被占用的字节 */
+	SIZE_T GetSlackBytes() const
+	{
+		return (SIZE_T(NumChunks) * BlocksPerChunk - NumLive) * BlockSize;
+	}
+};
+
+/**
+ * 与类型无关的定长块池, 线程安全 (UObject 也会在异步加载线程上构造)
+ *
+ * 块大小与对齐在构造时确定, 由 TPimplPool<T> 按 T 填写
+ */
+class UNREALTEMPLATESGUIDE_API FPimplBlockPool
+{
+public:
+	using FDestroyFunction = void (*)(void*);
+
+	FPimplBlockPool(const TCHAR* InName, SIZE_T InBlockSize, SIZE_T InBlockAlignment, int32 InBlocksPerChunk, FDestroyFunction InDestroy);
+	~FPimplBlockPool();
+
+	UE_NONCOPYABLE(FPimplBlockPool);
+
+	/** 取一块未初始化的内存 */
+	void* Allocate();
+
+	/** 归还 Allocate 返回的内存 (对象须已析构) */
+	void Free(void* Block);
+
+	/** 析构对象并归还内存 - TPooledPimplPtr 以此代替 delete */
+	void DestroyAndFree(void* Object)
+	{
+		Destroy(Object);
+		Free(Object);
+	}
+
+	/** 没有存活对象时把全部 Chunk 还给通用分配器, 返回是否释放了 */
+	bool Trim();
+
+	FPimplPoolStats GetStats() const;
+	void ResetCounters();
+
+private:
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	const FString Name;
+	const SIZE_T BlockSize;
+	const SIZE_T BlockAlignment;
+	const int32 BlocksPerChunk;
+	const FDestroyFunction Destroy;
+
+	mutable FCriticalSection Mutex;
+	TArray<uint8*> Chunks;
+	FFreeBlock* FreeList = nullptr;
+
+	/** 最新 Chunk 中尚未切出的块数 */
+	int32 NumUncarvedInLastChunk = 0;
+
+	int32 NumLive = 0;
+	int32 PeakLive = 0;
+	int64 NumAllocations = 0;
+	int64 NumFrees = 0;
+	int64 NumReused = 0;
+};
+
+/** T 专属的块池, 必须在 T 完整的 cpp 中实例化 */
+template<typename T>
+class TPimplPool : public FPimplBlockPool
+{
+public:
+	explicit TPimplPool(const TCHAR* InName, int32 InBlocksPerChunk = 64)
+		: FPimplBlockPool(InName, sizeof(T), alignof(T), InBlocksPerChunk, &DestroyObject)
+	{
+	}
+
+private:
+	static void DestroyObject(void* Object)
+	{
+		static_cast<T*>(Object)->~T();
+	}
+};
+
+template<typename T>
+class TPooledPimplPtr
+{
+public:
+	/** 空指针, 不需要 T 的完整定义 */
+	TPooledPimplPtr() = default;
+	TPooledPimplPtr(TYPE_OF_NULLPTR) {}
+
+	~TPooledPimplPtr()
+	{
+		Reset();
+	}
+
+	UE_NONCOPYABLE(TPooledPimplPtr);
+
+	TPooledPimplPtr(TPooledPimplPtr&& Other)
+		: Ptr(Other.Ptr)
+		, Pool(Other.Pool)
+	{
+		Other.Ptr = nullptr;
+		Other.Pool = nullptr;
+	}
+
+	TPooledPimplPtr& operator=(TPooledPimplPtr&& Other)
+	{
+		if (this != &Other)
+		{
+			Reset();
+			Ptr = Other.Ptr;
+			Pool = Other.Pool;
+			Other.Ptr = nullptr;
+			Other.Pool = nullptr;
+		}
+		return *this;
+	}
+
+	TPooledPimplPtr& operator=(TYPE_OF_NULLPTR)
+	{
+		Reset();
+		return *this;
+	}
+
+	/** 析构对象并把内存还给所属池 */
+	void Reset()
+	{
+		if (Ptr)
+		{
+			T* LocalPtr = Ptr;
+			FPimplBlockPool* LocalPool = Pool;
+			Ptr = nullptr;
+			Pool = nullptr;
+			LocalPool->DestroyAndFree(LocalPtr);
+		}
+	}
+
+	bool IsValid() const { return Ptr != nullptr; }
+	explicit operator bool() const { return Ptr != nullptr; }
+
+	T* Get() { return Ptr; }
+	const T* Get() const { return Ptr; }
+
+	T* operator->() { checkSlow(Ptr); return Ptr; }
+	const T* operator->() const { checkSlow(Ptr); return Ptr; }
+	T& operator*() { checkSlow(Ptr); return *Ptr; }
+	const T& operator*() const { checkSlow(Ptr); return *Ptr; }
+
+private:
+	template<typename U, typename... ArgTypes>
+	friend TPooledPimplPtr<U> MakePooledPimpl(TPimplPool<U>& Pool, ArgTypes&&... Args);
+
+	TPooledPimplPtr(T* InPtr, FPimplBlockPool* InPool)
+		: Ptr(InPtr)
+		, Pool(InPool)
+	{
+	}
+
+	T* Ptr = nullptr;
+	FPimplBlockPool* Pool = nullptr;
+};
+
+/** 对应 MakePimpl: 在 Pool 中就地构造 T */
+template<typename T, typename... ArgTypes>
+TPooledPimplPtr<T> MakePooledPimpl(TPimplPool<T>& Pool, ArgTypes&&... Args)
+{
+	void* Block = Pool.Allocate();
+	T* Object = new (Block) T(Forward<ArgTypes>(Args)...);
+	return TPooledPimplPtr<T>(Object, &Pool);
+}
+
+/** 所有已创建池的统计 */
+UNREALTEMPLATESGUIDE_API TArray<FPimplPoolStats> GetAllPimplPoolStats();
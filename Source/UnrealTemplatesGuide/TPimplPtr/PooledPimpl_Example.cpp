@@ -0,0 +1,138 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PooledPimpl_Example.h"
+#include "PimplExampleImpl.h"
+#include "PimplLog.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+// =====================================================
+// FImpl - 与 ATPimplPtr_Example 共用的实现
+// =====================================================
+
+struct APooledPimpl_Example::FImpl : FPimplExampleImpl
+{
+	using FPimplExampleImpl::FPimplExampleImpl;
+};
+
+// 池对象有意不销毁: CDO 的 FImpl 可能在静态析构之后才释放
+// 每个 Chunk 256 个 FImpl, 一波生成的 Actor 只需要少数几次通用分配
+TPimplPool<APooledPimpl_Example::FImpl>& APooledPimpl_Example::GetImplPool()
+{
+	static TPimplPool<FImpl>* Pool = new TPimplPool<FImpl>(TEXT("APooledPimpl_Example::FImpl"), 256);
+	return *Pool;
+}
+
+// =====================================================
+// APooledPimpl_Example 实现
+// =====================================================
+
+APooledPimpl_Example::APooledPimpl_Example()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	
+	// 与 MakePimpl 相同, 只是内存来自池
+	Impl = MakePooledPimpl(GetImplPool(), TEXT("PooledPimplExampleActor"), 0);
+	
+	UE_LOG(LogTemp, Log, TEXT("[TPooledPimplPtr] APooledPimpl_Example 构造完成"));
+}
+
+APooledPimpl_Example::~APooledPimpl_Example()
+{
+	// TPooledPimplPtr 析构时销毁 FImpl 并把内存还给池
+	UE_LOG(LogTemp, Log, TEXT("[TPooledPimplPtr] APooledPimpl_Example 析构"));
+}
+
+void APooledPimpl_Example::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	if (Impl.IsValid())
+	{
+		Impl->Initialize();
+	}
+	
+	PrintDebugInfo();
+}
+
+void APooledPimpl_Example::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	if (Impl)
+	{
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(PimplTick);
+		Impl->Update(DeltaTime);
+	}
+}
+
+// =====================================================
+// 公共接口实现 - 委托给FImpl
+// =====================================================
+
+void APooledPimpl_Example::SetActorDisplayName(const FString& NewName)
+{
+	if (Impl)
+	{
+		Impl->DisplayName = NewName;
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPooledPimplPtr] 设置名称: %s"), *NewName);
+	}
+}
+
+FString APooledPimpl_Example::GetActorDisplayName() const
+{
+	if (const FImpl* RawPtr = Impl.Get())
+	{
+		return RawPtr->DisplayName;
+	}
+	return TEXT("Invalid");
+}
+
+void APooledPimpl_Example::IncrementCounter()
+{
+	if (Impl)
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPooledPimplPtr] 计数器增加到: %d"), Impl->GetCounter());
+	}
+}
+
+int32 APooledPimpl_Example::GetCounter() const
+{
+	return Impl.IsValid() ? Impl->GetCounter() : -1;
+}
+
+void APooledPimpl_Example::ResetState()
+{
+	if (Impl)
+	{
+		Impl->Reset();
+	}
+}
+
+float APooledPimpl_Example::PerformCalculation(float InputValue)
+{
+	if (Impl)
+	{
+		const float Result = Impl->Calculate(InputValue);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPooledPimplPtr] 计算结果: Input=%.2f, Output=%.4f"), InputValue, Result);
+		return Result;
+	}
+	return 0.0f;
+}
+
+bool APooledPimpl_Example::IsImplValid() const
+{
+	return Impl.IsValid();
+}
+
+void APooledPimpl_Example::PrintDebugInfo() const
+{
+	if (Impl)
+	{
+		Impl->PrintDebug();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[TPooledPimplPtr] Impl 无效!"));
+	}
+}
@@ -0,0 +1,83 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "PooledPimpl.h"
+#include "PooledPimpl_Example.generated.h"
+
+/**
+ * APooledPimpl_Example - 与 ATPimplPtr_Example 相同的接口与实现, FImpl 从类型专属的块池分配
+ * 
+ * 对比 ATPimplPtr_Example:
+ * 1. 成批生成 / 销毁时 FImpl 的内存在池中复用, 不再逐个经过通用分配器
+ * 2. 同一波生成的 FImpl 在 Chunk 中相邻, 逐个 Tick 时访问更连续
+ * 3. 仍有一次指针跳转; 完全去掉跳转见 AInlinePimpl_Example
+ */
+UCLASS()
+class UNREALTEMPLATESGUIDE_API APooledPimpl_Example : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APooledPimpl_Example();
+	
+	// 与 TPimplPtr 相同, 析构函数在cpp中定义
+	virtual ~APooledPimpl_Example();
+
+protected:
+	virtual void BeginPlay() override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	// =====================================================
+	// 公共接口 - 与 ATPimplPtr_Example 相同
+	// =====================================================
+	
+	/** 设置Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void SetActorDisplayName(const FString& NewName);
+	
+	/** 获取Actor的名称 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	FString GetActorDisplayName() const;
+	
+	/** 增加计数器 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void IncrementCounter();
+	
+	/** 获取当前计数 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	int32 GetCounter() const;
+	
+	/** 重置状态 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void ResetState();
+	
+	/** 执行内部计算 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	float PerformCalculation(float InputValue);
+	
+	/** 检查实现是否有效 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	bool IsImplValid() const;
+	
+	/** 打印调试信息 */
+	UFUNCTION(BlueprintCallable, Category = "PimplExample")
+	void PrintDebugInfo() const;
+
+private:
+	struct FImpl;
+	
+	/**
+	 * TPooledPimplPtr<FImpl> - 与 TPimplPtr<FImpl> 用法相同, 内存来自 cpp 中的 TPimplPool<FImpl>
+	 * 
+	 * 释放时把内存还给所属池而不是 delete
+	 */
+	TPooledPimplPtr<FImpl> Impl;
+
+	/** 所有实例共用的 FImpl 池, 在cpp中定义 */
+	static TPimplPool<FImpl>& GetImplPool();
+};
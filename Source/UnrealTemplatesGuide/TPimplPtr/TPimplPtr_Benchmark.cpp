@@ -0,0 +1,496 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// TPimplPtr 基准用例
+//
+// 同一份实现 (FPimplExampleImpl) 分别放在堆上 (ATPimplPtr_Example, TPimplPtr)、
+// 块池中 (APooledPimpl_Example, TPooledPimplPtr) 与 Actor 内部 (AInlinePimpl_Example, TInlinePimpl):
+//   - HeapVsInline  各生成 NumActors 个并逐个调用
+//       Tick/*      Actor->Tick → Impl->Update, 模拟每帧逐个 Tick
+//       Accessor/*  GetCounter, 最薄的一层转发, 差别几乎全是那一次指针跳转
+//     三种 Actor 交替生成, 堆上的 FImpl 与 Actor 不相邻, 接近真实关卡中的内存分布
+//     需要世界 (在 PIE / 游戏中执行)
+//   - SpawnWaves    成波创建 / 销毁 FImpl, 对比通用分配器与块池的分配次数
+//   - BatchedTick   逐个 Impl->Update 与 FPimplBatchTickData 的 SoA 批量更新 (串行 / 并行)
+//   - LogCost       IncrementCounter 式访问器在每次调用都记日志 / 运行期压制 / 采样 / 编译期去除时的单次开销
+//   - CowClones     从一个模板克隆: DeepCopy 的 TPimplPtr 与写时复制的 TCowPimplPtr (及克隆 Actor)
+//
+// 运行: TemplatesGuide.Benchmark Filter=Pimpl. Iterations=100
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include "TPimplPtr_Example.h"
+#include "InlinePimpl_Example.h"
+#include "PooledPimpl_Example.h"
+#include "CowPimpl_Example.h"
+#include "PimplExampleImpl.h"
+#include "PimplBatchTick.h"
+#include "PimplLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Templates/PimplPtr.h"
+#include "Engine/World.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+
+// 编译期级别为 Warning: 其上的 Log 级别 UE_LOG 连同参数求值一起被编译掉
+DECLARE_LOG_CATEGORY_STATIC(LogPimplBenchmarkStripped, Log, Warning);
+
+namespace PimplBenchmark
+{
+	constexpr int32 NumActors = 10000;
+
+	/** 生成 / 销毁期间压低 LogTemp, 两种 Actor 的构造与 BeginPlay (PrintDebug 为 Warning) 都会输出日志 */
+	struct FQuietLogScope
+	{
+		ELogVerbosity::Type SavedVerbosity;
+
+		FQuietLogScope()
+			: SavedVerbosity(LogTemp.GetVerbosity())
+		{
+			LogTemp.SetVerbosity(ELogVerbosity::Error);
+		}
+
+		~FQuietLogScope()
+		{
+			LogTemp.SetVerbosity(SavedVerbosity);
+		}
+	};
+
+	struct FActors
+	{
+		TArray<ATPimplPtr_Example*> Heap;
+		TArray<APooledPimpl_Example*> Pooled;
+		TArray<AInlinePimpl_Example*> Inline;
+	};
+
+	static FActors SpawnActors(UWorld& World)
+	{
+		FQuietLogScope QuietLog;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		FActors Actors;
+		Actors.Heap.Reserve(NumActors);
+		Actors.Pooled.Reserve(NumActors);
+		Actors.Inline.Reserve(NumActors);
+		for (int32 i = 0; i < NumActors; ++i)
+		{
+			Actors.Heap.Add(World.SpawnActor<ATPimplPtr_Example>(SpawnParams));
+			Actors.Pooled.Add(World.SpawnActor<APooledPimpl_Example>(SpawnParams));
+			Actors.Inline.Add(World.SpawnActor<AInlinePimpl_Example>(SpawnParams));
+		}
+		return Actors;
+	}
+
+	static void DestroyActors(FActors& Actors)
+	{
+		FQuietLogScope QuietLog;
+
+		for (ATPimplPtr_Example* Actor : Actors.Heap)
+		{
+			Actor->Destroy();
+		}
+		for (APooledPimpl_Example* Actor : Actors.Pooled)
+		{
+			Actor->Destroy();
+		}
+		for (AInlinePimpl_Example* Actor : Actors.Inline)
+		{
+			Actor->Destroy();
+		}
+	}
+
+	/** 每帧逐个 Tick 所有 Actor */
+	template<typename ActorType>
+	static void RunTick(FBenchmarkContext& Context, const TCHAR* CaseName, const TArray<ActorType*>& Actors)
+	{
+		const int32 NumFrames = Context.GetIterations();
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		FBenchmarkTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (ActorType* Actor : Actors)
+			{
+				Actor->Tick(DeltaTime);
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		FBenchmarkResult& Result = Context.Report(CaseName, int64(NumFrames) * Actors.Num(), Seconds);
+		Result.Metrics.Emplace(TEXT("MsPerFrame"), Seconds * 1000.0 / NumFrames);
+	}
+
+	/** 只读访问器, 校验和防止被优化掉 */
+	template<typename ActorType>
+	static void RunAccessor(FBenchmarkContext& Context, const TCHAR* CaseName, const TArray<ActorType*>& Actors)
+	{
+		const int32 NumFrames = Context.GetIterations();
+
+		int64 Checksum = 0;
+		FBenchmarkTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const ActorType* Actor : Actors)
+			{
+				Checksum += Actor->GetCounter();
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+		check(Checksum == 0);
+
+		Context.Report(CaseName, int64(NumFrames) * Actors.Num(), Seconds);
+	}
+
+	/** 基准专用的池; FPimplExampleImpl 不是私有类型, 可以直接池化 */
+	static TPimplPool<FPimplExampleImpl>& GetWavePool()
+	{
+		static TPimplPool<FPimplExampleImpl>* Pool = new TPimplPool<FPimplExampleImpl>(TEXT("PimplBenchmark::Wave"), 256);
+		return *Pool;
+	}
+
+	/** 每波创建 WaveSize 个实现对象再全部销毁; Make(i) 返回一个指针 */
+	template<typename PtrType, typename MakeType>
+	static double RunWaves(int32 NumWaves, int32 WaveSize, MakeType&& Make)
+	{
+		FQuietLogScope QuietLog;
+
+		TArray<PtrType> Wave;
+		Wave.Reserve(WaveSize);
+
+		FBenchmarkTimer Timer;
+		for (int32 WaveIndex = 0; WaveIndex < NumWaves; ++WaveIndex)
+		{
+			for (int32 i = 0; i < WaveSize; ++i)
+			{
+				Wave.Add(Make(i));
+			}
+			Wave.Reset();
+		}
+		return Timer.GetSeconds();
+	}
+}
+
+// TPimplPtr (堆) 与 TInlinePimpl (内联) 逐个 Tick / 访问 10k 个 Actor
+UE_TEMPLATESGUIDE_BENCHMARK(Pimpl, HeapVsInline, EBenchmarkFlags::None)
+{
+	using namespace PimplBenchmark;
+
+	UWorld* World = Context.GetWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Benchmark] Pimpl.HeapVsInline 需要世界, 跳过"));
+		return;
+	}
+
+	FActors Actors = SpawnActors(*World);
+
+	RunTick(Context, TEXT("Tick/Heap"), Actors.Heap);
+	RunTick(Context, TEXT("Tick/Pooled"), Actors.Pooled);
+	RunTick(Context, TEXT("Tick/Inline"), Actors.Inline);
+	RunAccessor(Context, TEXT("Accessor/Heap"), Actors.Heap);
+	RunAccessor(Context, TEXT("Accessor/Pooled"), Actors.Pooled);
+	RunAccessor(Context, TEXT("Accessor/Inline"), Actors.Inline);
+
+	DestroyActors(Actors);
+}
+
+// MakePimpl 与 MakePooledPimpl 成波创建 / 销毁 FImpl (模拟一波 Actor 生成后消失)
+// 两者的 FImpl 构造中都有一次 StateHistory 环形缓冲的堆分配, 差别只在 FImpl 本身的那一次
+UE_TEMPLATESGUIDE_BENCHMARK(Pimpl, SpawnWaves, EBenchmarkFlags::None)
+{
+	using namespace PimplBenchmark;
+
+	const int32 NumWaves = Context.GetIterations();
+	constexpr int32 WaveSize = 1000;
+
+	const double HeapSeconds = RunWaves<TPimplPtr<FPimplExampleImpl>>(NumWaves, WaveSize, [](int32 i)
+	{
+		return MakePimpl<FPimplExampleImpl>(TEXT("Wave"), i);
+	});
+	FBenchmarkResult& HeapResult = Context.Report(TEXT("Waves/Heap"), int64(NumWaves) * WaveSize, HeapSeconds);
+	HeapResult.Metrics.Emplace(TEXT("ImplAllocatorCallsPerWave"), double(WaveSize));
+
+	TPimplPool<FPimplExampleImpl>& Pool = GetWavePool();
+	Pool.ResetCounters();
+	const int32 ChunksBefore = Pool.GetStats().NumChunks;
+
+	const double PooledSeconds = RunWaves<TPooledPimplPtr<FPimplExampleImpl>>(NumWaves, WaveSize, [&Pool](int32 i)
+	{
+		return MakePooledPimpl(Pool, TEXT("Wave"), i);
+	});
+
+	const FPimplPoolStats Stats = Pool.GetStats();
+	check(Stats.NumLive == 0);
+
+	FBenchmarkResult& PooledResult = Context.Report(TEXT("Waves/Pooled"), int64(NumWaves) * WaveSize, PooledSeconds);
+	PooledResult.Metrics.Emplace(TEXT("ImplAllocatorCallsPerWave"), double(Stats.NumChunks - ChunksBefore) / FMath::Max(1, NumWaves));
+	PooledResult.Metrics.Emplace(TEXT("ReuseRate"), Stats.NumAllocations > 0 ? double(Stats.NumReused) / Stats.NumAllocations : 0.0);
+	PooledResult.Metrics.Emplace(TEXT("Chunks"), double(Stats.NumChunks));
+}
+
+// 逐个 Update 与 SoA 批量 Tick; 逐个 Tick 在 Actor 上的额外虚调用开销见 HeapVsInline 的 Tick/Heap
+UE_TEMPLATESGUIDE_BENCHMARK(Pimpl, BatchedTick, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace PimplBenchmark;
+
+	const int32 NumFrames = Context.GetIterations();
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	TArray<TPimplPtr<FPimplExampleImpl>> Impls;
+	{
+		FQuietLogScope QuietLog;
+		Impls.Reserve(NumActors);
+		for (int32 i = 0; i < NumActors; ++i)
+		{
+			Impls.Add(MakePimpl<FPimplExampleImpl>(TEXT("Batched"), i));
+		}
+	}
+
+	{
+		FBenchmarkTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (TPimplPtr<FPimplExampleImpl>& Impl : Impls)
+			{
+				Impl->Update(DeltaTime);
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+		Context.Report(TEXT("PerInstance"), int64(NumFrames) * NumActors, Seconds)
+			.Metrics.Emplace(TEXT("MsPerFrame"), Seconds * 1000.0 / NumFrames);
+	}
+
+	const auto RunBatched = [&Context, &Impls, NumFrames, DeltaTime](const TCHAR* CaseName, bool bAllowParallel)
+	{
+		FPimplBatchTickData Batch;
+		for (TPimplPtr<FPimplExampleImpl>& Impl : Impls)
+		{
+			Batch.Add(*Impl);
+		}
+
+		FBenchmarkTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Batch.Tick(DeltaTime, bAllowParallel);
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		// 热字段写回后, 访问器回到本地字段
+		Batch.RemoveAll();
+		check(!Impls[0]->IsBatched() && Impls[1]->GetCounter() == 1);
+
+		Context.Report(CaseName, int64(NumFrames) * NumActors, Seconds)
+			.Metrics.Emplace(TEXT("MsPerFrame"), Seconds * 1000.0 / NumFrames);
+	};
+
+	RunBatched(TEXT("Batched/Serial"), false);
+	RunBatched(TEXT("Batched/Parallel"), true);
+
+	FQuietLogScope QuietLog;
+	Impls.Empty();
+}
+
+// IncrementCounter 的日志开销: 工作本身只是一次读写, 差别全在日志
+UE_TEMPLATESGUIDE_BENCHMARK(Pimpl, LogCost, EBenchmarkFlags::None)
+{
+	using namespace PimplBenchmark;
+
+	// "每次都记日志" 的子项会真正输出, 调用次数不宜过多
+	const int32 NumCalls = Context.GetIterations() * 10;
+
+	FPimplExampleImpl* Impl;
+	{
+		FQuietLogScope QuietLog;
+		Impl = new FPimplExampleImpl(TEXT("LogCost"), 0);
+	}
+
+	const auto RunCalls = [&Context, Impl, NumCalls](const TCHAR* CaseName, auto&& Call)
+	{
+		Impl->SetCounter(0);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumCalls; ++i)
+		{
+			Call();
+		}
+		const double Seconds = Timer.GetSeconds();
+		check(Impl->GetCounter() == NumCalls);
+
+		Context.Report(CaseName, NumCalls, Seconds)
+			.Metrics.Emplace(TEXT("NsPerCall"), Seconds * 1e9 / NumCalls);
+	};
+
+	RunCalls(TEXT("NoLog"), [Impl]
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+	});
+
+	const ELogVerbosity::Type SavedVerbosity = LogTemplatesGuidePimpl.GetVerbosity();
+	LogTemplatesGuidePimpl.SetVerbosity(ELogVerbosity::Log);
+
+	RunCalls(TEXT("EveryCall"), [Impl]
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_LOG(LogTemplatesGuidePimpl, Log, TEXT("[Benchmark] 计数器增加到: %d"), Impl->GetCounter());
+	});
+
+	IConsoleVariable* SampleEveryCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("TemplatesGuide.PimplLog.SampleEvery"));
+	const int32 SavedSampleEvery = SampleEveryCVar->GetInt();
+	SampleEveryCVar->Set(64, ECVF_SetByCode);
+
+	RunCalls(TEXT("Sampled/64"), [Impl]
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[Benchmark] 计数器增加到: %d"), Impl->GetCounter());
+	});
+
+	SampleEveryCVar->Set(SavedSampleEvery, ECVF_SetByCode);
+
+	LogTemplatesGuidePimpl.SetVerbosity(ELogVerbosity::Warning);
+
+	RunCalls(TEXT("RuntimeSuppressed"), [Impl]
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_LOG(LogTemplatesGuidePimpl, Log, TEXT("[Benchmark] 计数器增加到: %d"), Impl->GetCounter());
+	});
+
+	LogTemplatesGuidePimpl.SetVerbosity(SavedVerbosity);
+
+	RunCalls(TEXT("CompiledOut"), [Impl]
+	{
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_LOG(LogPimplBenchmarkStripped, Log, TEXT("[Benchmark] 计数器增加到: %d"), Impl->GetCounter());
+	});
+
+	FQuietLogScope QuietLog;
+	delete Impl;
+}
+
+// 从模板克隆 NumClones 份, 其中 MutatePercent% 的克隆随后修改一次
+UE_TEMPLATESGUIDE_BENCHMARK(Pimpl, CowClones, EBenchmarkFlags::None)
+{
+	using namespace PimplBenchmark;
+
+	constexpr int32 NumClones = 10000;
+	FQuietLogScope QuietLog;
+
+	// 历史写满的模板, 深拷贝时要复制整个环形缓冲
+	FPimplExampleImpl TemplateImpl(TEXT("Template"), 0);
+	TemplateImpl.Initialize();
+	for (int32 i = 0; i < TemplateImpl.StateHistory.GetCapacity(); ++i)
+	{
+		TemplateImpl.StateHistory.Add(float(i));
+	}
+
+	const auto RunDeepCopy = [&Context, &TemplateImpl](const TCHAR* CaseName, int32 MutatePercent)
+	{
+		const TPimplPtr<FPimplExampleImpl, EPimplPtrMode::DeepCopy> Template = MakePimpl<FPimplExampleImpl, EPimplPtrMode::DeepCopy>(TemplateImpl);
+
+		TArray<TPimplPtr<FPimplExampleImpl, EPimplPtrMode::DeepCopy>> Clones;
+		Clones.Reserve(NumClones);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumClones; ++i)
+		{
+			Clones.Add(Template);
+			if (i % 100 < MutatePercent)
+			{
+				Clones.Last()->SetCounter(i);
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		Context.Report(CaseName, NumClones, Seconds)
+			.Metrics.Emplace(TEXT("ImplCopies"), double(NumClones));
+	};
+
+	const auto RunCow = [&Context, &TemplateImpl](const TCHAR* CaseName, int32 MutatePercent)
+	{
+		const TCowPimplPtr<FPimplExampleImpl> Template = MakeCowPimpl<FPimplExampleImpl>(TemplateImpl);
+
+		TArray<TCowPimplPtr<FPimplExampleImpl>> Clones;
+		Clones.Reserve(NumClones);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumClones; ++i)
+		{
+			Clones.Add(Template);
+			if (i % 100 < MutatePercent)
+			{
+				Clones.Last()->SetCounter(i);
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		// 未修改的克隆仍与模板共享
+		const int32 NumDetached = NumClones + 1 - Template.GetSharedReferenceCount();
+		check(NumDetached == NumClones / 100 * MutatePercent);
+
+		Context.Report(CaseName, NumClones, Seconds)
+			.Metrics.Emplace(TEXT("ImplCopies"), double(NumDetached));
+	};
+
+	RunDeepCopy(TEXT("DeepCopy/ReadOnly"), 0);
+	RunCow(TEXT("Cow/ReadOnly"), 0);
+	RunDeepCopy(TEXT("DeepCopy/Mutate10"), 10);
+	RunCow(TEXT("Cow/Mutate10"), 10);
+
+	// 克隆 Actor: 含生成 Actor 本身的开销, 差别在 FImpl 的复制
+	UWorld* World = Context.GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ACowPimpl_Example* TemplateActor = World->SpawnActor<ACowPimpl_Example>(SpawnParams);
+
+	// 共享数只在稳定状态下有意义: 先 Tick 若干帧 (与 RunTick 相同的直接调用), 再统计共享数与实现占用的内存
+	const int32 NumFrames = Context.GetIterations();
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	for (const bool bShareImpl : {false, true})
+	{
+		using UE::TemplatesGuide::Stats::EGauge;
+		const int64 ImplMemoryBefore = UE::TemplatesGuide::Stats::GetGauge(EGauge::PimplMemory);
+
+		TArray<ACowPimpl_Example*> Actors;
+		Actors.Reserve(NumActors);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumActors; ++i)
+		{
+			Actors.Add(ACowPimpl_Example::SpawnClone(TemplateActor, FTransform::Identity, bShareImpl));
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (ACowPimpl_Example* Actor : Actors)
+			{
+				Actor->Tick(DeltaTime);
+			}
+		}
+
+		// FImpl 的存活字节数 (对象 + 历史缓冲); 每个 Actor 独占的 FTickState 两种方式相同, 不计入
+		const int64 ImplMemory = UE::TemplatesGuide::Stats::GetGauge(EGauge::PimplMemory) - ImplMemoryBefore;
+
+		int32 NumShared = 0;
+		for (ACowPimpl_Example* Actor : Actors)
+		{
+			NumShared += Actor->IsImplShared() ? 1 : 0;
+			Actor->Destroy();
+		}
+
+		FBenchmarkResult& Result = Context.Report(bShareImpl ? TEXT("Actors/Cow") : TEXT("Actors/DeepCopy"), NumActors, Seconds);
+		Result.Metrics.Emplace(TEXT("TickedFrames"), double(NumFrames));
+		Result.Metrics.Emplace(TEXT("SharedClonesAfterTick"), double(NumShared));
+		Result.Metrics.Emplace(TEXT("ImplMemoryKB"), ImplMemory / 1024.0);
+	}
+
+	TemplateActor->Destroy();
+}
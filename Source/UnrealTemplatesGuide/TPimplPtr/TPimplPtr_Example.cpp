@@ -1,6 +1,9 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "TPimplPtr_Example.h"
+#include "PimplBatchTickSubsystem.h"
+#include "Engine/World.h"
+#include "Profiling/TemplatesGuideStats.h"
 
 // =====================================================
 // FImpl - 内部实现的完整定义
@@ -8,6 +11,8 @@
 // 这些头文件只在cpp中包含，修改不会影响包含.h的文件
 // #include "SomeHeavyDependency.h"  // 示例：重量级依赖
 // #include "ComplexSystem.h"        // 示例：复杂系统
+#include "PimplExampleImpl.h"
+#include "PimplLog.h"
 
 /**
  * FImpl结构体 - 包含所有私有实现细节
@@ -16,123 +21,12 @@
  * 1. 所有依赖都隐藏在cpp中
  * 2. 可以自由添加/删除成员而不影响ABI
  * 3. 头文件保持简洁
+ * 
+ * 成员与方法定义在 PimplExampleImpl.h 中, 与 AInlinePimpl_Example 共用
  */
-struct ATPimplPtr_Example::FImpl
+struct ATPimplPtr_Example::FImpl : FPimplExampleImpl
 {
-	// =====================================================
-	// 成员变量 - 这些在头文件中完全不可见
-	// =====================================================
-	
-	/** Actor的显示名称 */
-	FString DisplayName;
-	
-	/** 计数器 */
-	int32 Counter;
-	
-	/** 累积时间 */
-	float AccumulatedTime;
-	
-	/** 上次计算结果 */
-	float LastCalculationResult;
-	
-	/** 是否已初始化 */
-	bool bIsInitialized;
-	
-	/** 内部状态数组 */
-	TArray<float> StateHistory;
-	
-	// =====================================================
-	// 构造函数
-	// =====================================================
-	
-	/** 默认构造 */
-	FImpl()
-		: DisplayName(TEXT("DefaultPimplActor"))
-		, Counter(0)
-		, AccumulatedTime(0.0f)
-		, LastCalculationResult(0.0f)
-		, bIsInitialized(false)
-	{
-		StateHistory.Reserve(100);
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 默认构造完成"));
-	}
-	
-	/** 带参数构造 */
-	FImpl(const FString& InName, int32 InInitialCounter)
-		: DisplayName(InName)
-		, Counter(InInitialCounter)
-		, AccumulatedTime(0.0f)
-		, LastCalculationResult(0.0f)
-		, bIsInitialized(false)
-	{
-		StateHistory.Reserve(100);
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 参数构造: Name=%s, Counter=%d"), *InName, InInitialCounter);
-	}
-	
-	/** 析构函数 */
-	~FImpl()
-	{
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 析构: Name=%s, FinalCounter=%d"), *DisplayName, Counter);
-	}
-	
-	// =====================================================
-	// 内部方法
-	// =====================================================
-	
-	/** 初始化 */
-	void Initialize()
-	{
-		if (!bIsInitialized)
-		{
-			bIsInitialized = true;
-			StateHistory.Add(0.0f);
-			UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 初始化完成"));
-		}
-	}
-	
-	/** 更新状态 */
-	void Update(float DeltaTime)
-	{
-		AccumulatedTime += DeltaTime;
-		
-		// 每秒记录一次状态
-		if (FMath::FloorToInt(AccumulatedTime) > StateHistory.Num())
-		{
-			StateHistory.Add(LastCalculationResult);
-		}
-	}
-	
-	/** 执行计算 */
-	float Calculate(float Input)
-	{
-		// 示例计算：结合计数器和累积时间
-		LastCalculationResult = Input * (Counter + 1) + FMath::Sin(AccumulatedTime);
-		return LastCalculationResult;
-	}
-	
-	/** 重置 */
-	void Reset()
-	{
-		Counter = 0;
-		AccumulatedTime = 0.0f;
-		LastCalculationResult = 0.0f;
-		StateHistory.Empty();
-		StateHistory.Add(0.0f);
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] FImpl 状态已重置"));
-	}
-	
-	/** 打印调试信息 */
-	void PrintDebug() const
-	{
-		UE_LOG(LogTemp, Warning, TEXT("========== TPimplPtr Debug Info =========="));
-		UE_LOG(LogTemp, Warning, TEXT("  DisplayName: %s"), *DisplayName);
-		UE_LOG(LogTemp, Warning, TEXT("  Counter: %d"), Counter);
-		UE_LOG(LogTemp, Warning, TEXT("  AccumulatedTime: %.2f"), AccumulatedTime);
-		UE_LOG(LogTemp, Warning, TEXT("  LastCalculation: %.4f"), LastCalculationResult);
-		UE_LOG(LogTemp, Warning, TEXT("  IsInitialized: %s"), bIsInitialized ? TEXT("Yes") : TEXT("No"));
-		UE_LOG(LogTemp, Warning, TEXT("  StateHistory Count: %d"), StateHistory.Num());
-		UE_LOG(LogTemp, Warning, TEXT("=========================================="));
-	}
+	using FPimplExampleImpl::FPimplExampleImpl;
 };
 
 // =====================================================
@@ -169,10 +63,33 @@ void ATPimplPtr_Example::BeginPlay()
 		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] BeginPlay - 实现已初始化"));
 	}
 	
+	// 可选: 交给批量 Tick 管理器, 关闭逐个 Tick
+	if (bUseBatchedTick && Impl.IsValid())
+	{
+		if (UPimplBatchTickSubsystem* BatchTick = GetWorld()->GetSubsystem<UPimplBatchTickSubsystem>())
+		{
+			BatchTick->Register(*Impl);
+			SetActorTickEnabled(false);
+		}
+	}
+	
 	// 演示基本使用
 	PrintDebugInfo();
 }
 
+void ATPimplPtr_Example::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Impl.IsValid() && Impl->IsBatched())
+	{
+		if (UPimplBatchTickSubsystem* BatchTick = GetWorld()->GetSubsystem<UPimplBatchTickSubsystem>())
+		{
+			BatchTick->Unregister(*Impl);
+		}
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATPimplPtr_Example::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -180,6 +97,7 @@ void ATPimplPtr_Example::Tick(float DeltaTime)
 	// 通过指针访问内部更新
 	if (Impl)  // operator bool() 检查有效性
 	{
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(PimplTick);
 		Impl->Update(DeltaTime);
 	}
 }
@@ -193,7 +111,7 @@ void ATPimplPtr_Example::SetActorDisplayName(const FString& NewName)
 	if (Impl.IsValid())
 	{
 		Impl->DisplayName = NewName;
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] 设置名称: %s"), *NewName);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPimplPtr] 设置名称: %s"), *NewName);
 	}
 }
 
@@ -211,14 +129,14 @@ void ATPimplPtr_Example::IncrementCounter()
 {
 	if (Impl)
 	{
-		Impl->Counter++;
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] 计数器增加到: %d"), Impl->Counter);
+		Impl->SetCounter(Impl->GetCounter() + 1);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPimplPtr] 计数器增加到: %d"), Impl->GetCounter());
 	}
 }
 
 int32 ATPimplPtr_Example::GetCounter() const
 {
-	return Impl.IsValid() ? Impl->Counter : -1;
+	return Impl.IsValid() ? Impl->GetCounter() : -1;
 }
 
 void ATPimplPtr_Example::ResetState()
@@ -234,7 +152,7 @@ float ATPimplPtr_Example::PerformCalculation(float InputValue)
 	if (Impl)
 	{
 		float Result = Impl->Calculate(InputValue);
-		UE_LOG(LogTemp, Log, TEXT("[TPimplPtr] 计算结果: Input=%.2f, Output=%.4f"), InputValue, Result);
+		UE_TEMPLATESGUIDE_LOG_SAMPLED(LogTemplatesGuidePimpl, Log, TEXT("[TPimplPtr] 计算结果: Input=%.2f, Output=%.4f"), InputValue, Result);
 		return Result;
 	}
 	return 0.0f;
@@ -262,3 +180,39 @@ void ATPimplPtr_Example::PrintDebugInfo() const
 		UE_LOG(LogTemp, Warning, TEXT("[TPimplPtr] Impl 无效!"));
 	}
 }
+
+// =====================================================
+// 状态历史 - 直接读取 FImpl 中的环形缓冲
+// =====================================================
+
+int32 ATPimplPtr_Example::GetStateHistoryNum() const
+{
+	return Impl.IsValid() ? Impl->StateHistory.Num() : 0;
+}
+
+int32 ATPimplPtr_Example::GetStateHistoryCapacity() const
+{
+	return Impl.IsValid() ? Impl->StateHistory.GetCapacity() : 0;
+}
+
+float ATPimplPtr_Example::GetStateHistoryAt(int32 Index) const
+{
+	if (Impl.IsValid() && Index >= 0 && Index < Impl->StateHistory.Num())
+	{
+		return Impl->StateHistory[Index];
+	}
+	return 0.0f;
+}
+
+void ATPimplPtr_Example::GetStateHistoryViews(TArrayView<const float>& OutFirst, TArrayView<const float>& OutSecond) const
+{
+	if (Impl.IsValid())
+	{
+		Impl->StateHistory.GetViews(OutFirst, OutSecond);
+	}
+	else
+	{
+		OutFirst = TArrayView<const float>();
+		OutSecond = TArrayView<const float>();
+	}
+}
@@ -28,6 +28,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -68,6 +69,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PimplExample")
 	void PrintDebugInfo() const;
 
+	// =====================================================
+	// 状态历史 - 零拷贝视图
+	// =====================================================
+	
+	/** 当前保留的历史条数 (不超过容量) */
+	UFUNCTION(BlueprintPure, Category = "PimplExample|History")
+	int32 GetStateHistoryNum() const;
+	
+	/** 历史容量, 构造时确定 */
+	UFUNCTION(BlueprintPure, Category = "PimplExample|History")
+	int32 GetStateHistoryCapacity() const;
+	
+	/** 按下标读取一条历史 (0 为最旧), 直接读环形缓冲, 不拷贝整个数组; 越界返回 0 */
+	UFUNCTION(BlueprintPure, Category = "PimplExample|History")
+	float GetStateHistoryAt(int32 Index) const;
+	
+	/** C++ 侧的零拷贝视图: 按时间顺序的两段连续内存, 在下一次 Tick / ResetState 之前有效 */
+	void GetStateHistoryViews(TArrayView<const float>& OutFirst, TArrayView<const float>& OutSecond) const;
+
+	/**
+	 * 由 UPimplBatchTickSubsystem 批量更新, 关闭逐个 Tick
+	 * 
+	 * 在 BeginPlay 时生效; 大量同类 Actor 时, 热字段以 SoA 方式连续存放, 一次循环更新全部实例
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PimplExample")
+	bool bUseBatchedTick = false;
+
 private:
 	// =====================================================
 	// Pimpl核心 - 前向声明 + TPimplPtr
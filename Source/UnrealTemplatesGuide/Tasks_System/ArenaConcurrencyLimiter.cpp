@@ -0,0 +1,311 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ArenaConcurrencyLimiter.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace UE::TemplatesGuide
+{
+	// ============================================================================
+	// FScratchArena
+	// ============================================================================
+	FScratchArena::~FScratchArena()
+	{
+		Reset();
+		FMemory::Free(Memory);
+	}
+
+	void FScratchArena::Initialize(SIZE_T InCapacity)
+	{
+		check(Memory == nullptr);
+
+		Capacity = Align(InCapacity, PLATFORM_CACHE_LINE_SIZE);
+		Memory = static_cast<uint8*>(FMemory::Malloc(Capacity, PLATFORM_CACHE_LINE_SIZE));
+	}
+
+	void* FScratchArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+	{
+		const SIZE_T Offset = Align(Used, Alignment);
+		if (Offset + Size <= Capacity)
+		{
+			Used = Offset + Size;
+			return Memory + Offset;
+		}
+
+		++NumOverflows;
+		void* Overflow = FMemory::Malloc(Size, Alignment);
+		OverflowAllocations.Add(Overflow);
+		return Overflow;
+	}
+
+	void FScratchArena::Reset()
+	{
+		HighWater = FMath::Max(HighWater, Used);
+		Used = 0;
+
+		for (void* Overflow : OverflowAllocations)
+		{
+			FMemory::Free(Overflow);
+		}
+		OverflowAllocations.Reset();
+	}
+
+	// ============================================================================
+	// FArenaConcurrencyLimiterStats
+	// ============================================================================
+	FString FArenaConcurrencyLimiterStats::HistogramToString() const
+	{
+		FString Result;
+		for (int32 Bucket = 0; Bucket < NumWaitBuckets; ++Bucket)
+		{
+			if (WaitHistogram[Bucket] == 0)
+			{
+				continue;
+			}
+
+			if (Bucket == 0)
+			{
+				Result += FString::Printf(TEXT("[<1us]=%lld "), WaitHistogram[Bucket]);
+			}
+			else if (Bucket == NumWaitBuckets - 1)
+			{
+				Result += FString::Printf(TEXT("[>=%lldus]=%lld "), int64(1) << (Bucket - 1), WaitHistogram[Bucket]);
+			}
+			else
+			{
+				Result += FString::Printf(TEXT("[%lld-%lldus]=%lld "), int64(1) << (Bucket - 1), int64(1) << Bucket, WaitHistogram[Bucket]);
+			}
+		}
+		return Result.TrimEnd();
+	}
+
+	// ============================================================================
+	// FArenaConcurrencyLimiter
+	// ============================================================================
+	FArenaConcurrencyLimiter::FArenaConcurrencyLimiter(const FArenaConcurrencyLimiterParams& InParams)
+		: Params(InParams)
+	{
+		check(Params.MaxConcurrency > 0);
+		check(Params.MinConcurrency > 0 && Params.MinConcurrency <= Params.MaxConcurrency);
+
+		Slots = MakeUnique<FSlot[]>(Params.MaxConcurrency);
+		FreeSlots.Reserve(Params.MaxConcurrency);
+		for (int32 Slot = Params.MaxConcurrency - 1; Slot >= 0; --Slot)
+		{
+			Slots[Slot].Arena.Initialize(Params.ArenaBytesPerSlot);
+			FreeSlots.Add(Slot);
+		}
+
+		CurrentConcurrency = Params.InitialConcurrency > 0
+			? FMath::Clamp(Params.InitialConcurrency, Params.MinConcurrency, Params.MaxConcurrency)
+			: Params.MaxConcurrency;
+
+		StatsStartCycles = FPlatformTime::Cycles64();
+		IdleEvent->Trigger();
+	}
+
+	FArenaConcurrencyLimiter::~FArenaConcurrencyLimiter()
+	{
+		Wait();
+	}
+
+	void FArenaConcurrencyLimiter::Push(const TCHAR* DebugName, FTaskFunction&& TaskFunction)
+	{
+		int32 Slot = INDEX_NONE;
+		{
+			FScopeLock Lock(&Mutex);
+
+			Queue.Enqueue(FItem{DebugName, FPlatformTime::Cycles64(), MoveTemp(TaskFunction)});
+			++NumQueued;
+
+			if (NumOutstanding++ == 0)
+			{
+				IdleEvent->Reset();
+			}
+
+			Slot = TryAcquireSlotLocked();
+		}
+
+		// 在锁外启动, 避免新任务立即与推入线程竞争锁
+		if (Slot != INDEX_NONE)
+		{
+			LaunchRunner(Slot, DebugName);
+		}
+	}
+
+	bool FArenaConcurrencyLimiter::Wait(FTimespan Timeout)
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+
+		if (!IdleEvent->Wait(Timeout))
+		{
+			return false;
+		}
+
+		// 空闲事件在最后一个退出的 Runner 持锁时触发, 加锁与它的解锁同步, 调用方之后可以安全地销毁限制器
+		FScopeLock Lock(&Mutex);
+		return true;
+	}
+
+	uint32 FArenaConcurrencyLimiter::GetCurrentConcurrency() const
+	{
+		FScopeLock Lock(&Mutex);
+		return CurrentConcurrency;
+	}
+
+	FArenaConcurrencyLimiterStats FArenaConcurrencyLimiter::GetStats() const
+	{
+		FArenaConcurrencyLimiterStats Stats;
+
+		uint64 StartCycles;
+		{
+			FScopeLock Lock(&Mutex);
+			Stats.CurrentConcurrency = CurrentConcurrency;
+			Stats.NumCompleted = NumCompleted;
+			Stats.NumConcurrencyIncreases = NumIncreases;
+			Stats.NumConcurrencyDecreases = NumDecreases;
+			Stats.QueueWaitEmaMicroseconds = QueueWaitEma;
+			FMemory::Memcpy(Stats.WaitHistogram, WaitHistogram, sizeof(WaitHistogram));
+			StartCycles = StatsStartCycles;
+		}
+
+		const double ElapsedCycles = FMath::Max<double>(1.0, double(FPlatformTime::Cycles64() - StartCycles));
+		for (uint32 Slot = 0; Slot < Params.MaxConcurrency; ++Slot)
+		{
+			Stats.SlotUtilization.Add(double(Slots[Slot].BusyCycles.load(std::memory_order_relaxed)) / ElapsedCycles);
+			Stats.SlotTasks.Add(Slots[Slot].NumTasks.load(std::memory_order_relaxed));
+
+			// 暂存内存的计数只由占用槽位的任务写入, 这里的读取只用于展示
+			Stats.ArenaHighWaterBytes = FMath::Max(Stats.ArenaHighWaterBytes, Slots[Slot].Arena.GetHighWater());
+			Stats.ArenaOverflows += Slots[Slot].Arena.GetNumOverflows();
+		}
+
+		return Stats;
+	}
+
+	void FArenaConcurrencyLimiter::ResetStats()
+	{
+		FScopeLock Lock(&Mutex);
+
+		NumCompleted = 0;
+		NumIncreases = 0;
+		NumDecreases = 0;
+		FMemory::Memzero(WaitHistogram, sizeof(WaitHistogram));
+		for (uint32 Slot = 0; Slot < Params.MaxConcurrency; ++Slot)
+		{
+			Slots[Slot].BusyCycles.store(0, std::memory_order_relaxed);
+			Slots[Slot].NumTasks.store(0, std::memory_order_relaxed);
+		}
+		StatsStartCycles = FPlatformTime::Cycles64();
+	}
+
+	int32 FArenaConcurrencyLimiter::TryAcquireSlotLocked()
+	{
+		// 已启动但尚未出队的 Runner 会处理排队任务, 排队任务多于它们时才需要新的 Runner
+		if (NumActive >= CurrentConcurrency || NumQueued <= NumStarting || FreeSlots.IsEmpty())
+		{
+			return INDEX_NONE;
+		}
+
+		++NumActive;
+		++NumStarting;
+		return FreeSlots.Pop(EAllowShrinking::No);
+	}
+
+	void FArenaConcurrencyLimiter::LaunchRunner(int32 Slot, const TCHAR* DebugName)
+	{
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+		UE::Tasks::Launch(DebugName, [this, Slot] { RunSlot(Slot); }, Params.Priority);
+	}
+
+	void FArenaConcurrencyLimiter::RunSlot(int32 Slot)
+	{
+		FSlot& SlotData = Slots[Slot];
+		bool bStarting = true;
+		bool bHasCompleted = false;
+
+		for (;;)
+		{
+			FItem Item;
+			int32 ExtraSlot = INDEX_NONE;
+			{
+				FScopeLock Lock(&Mutex);
+
+				if (bStarting)
+				{
+					--NumStarting;
+					bStarting = false;
+				}
+
+				if (bHasCompleted)
+				{
+					++NumCompleted;
+					--NumOutstanding;
+				}
+
+				// 并发度被调低时多余的 Runner 直接退出
+				if (NumActive > CurrentConcurrency || !Queue.Dequeue(Item))
+				{
+					FreeSlots.Push(Slot);
+					// 已占用槽位但尚未开始执行的 Runner 也计在 NumActive 内, 它们退出前限制器不会空闲
+					if (--NumActive == 0 && NumOutstanding == 0)
+					{
+						IdleEvent->Trigger();
+					}
+					// 解锁后不再访问成员: Wait 返回后限制器可能已被销毁
+					return;
+				}
+				--NumQueued;
+
+				RecordQueueWaitLocked(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Item.PushCycles) * 1000.0);
+				ExtraSlot = TryAcquireSlotLocked();
+			}
+
+			if (ExtraSlot != INDEX_NONE)
+			{
+				LaunchRunner(ExtraSlot, Item.DebugName);
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			{
+				UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Execute");
+				Item.Function(uint32(Slot), SlotData.Arena);
+			}
+			Item.Function.Reset();
+			SlotData.Arena.Reset();
+
+			SlotData.BusyCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+			SlotData.NumTasks.fetch_add(1, std::memory_order_relaxed);
+			bHasCompleted = true;
+		}
+	}
+
+	void FArenaConcurrencyLimiter::RecordQueueWaitLocked(double WaitMicroseconds)
+	{
+		const int32 Bucket = WaitMicroseconds < 1.0
+			? 0
+			: FMath::Min(FArenaConcurrencyLimiterStats::NumWaitBuckets - 1, 1 + int32(FMath::FloorLog2_64(uint64(WaitMicroseconds))));
+		++WaitHistogram[Bucket];
+
+		constexpr double SmoothingFactor = 0.125;
+		QueueWaitEma += SmoothingFactor * (WaitMicroseconds - QueueWaitEma);
+
+		if (!Params.bAdaptive || ++ItemsSinceAdapt < Params.AdaptIntervalItems)
+		{
+			return;
+		}
+		ItemsSinceAdapt = 0;
+
+		if (QueueWaitEma > Params.TargetQueueWaitMicroseconds && CurrentConcurrency < Params.MaxConcurrency)
+		{
+			++CurrentConcurrency;
+			++NumIncreases;
+		}
+		else if (QueueWaitEma < Params.TargetQueueWaitMicroseconds * 0.25 && CurrentConcurrency > Params.MinConcurrency)
+		{
+			--CurrentConcurrency;
+			++NumDecreases;
+		}
+	}
+}
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/**
+ * 带每槽位暂存内存 (Scratch Arena) 与自适应并发度的并发限制器
+ *
+ * 示例18 中 FTaskConcurrencyLimiter 的 Slot 索引可以无同步地索引固定缓冲区,
+ * FArenaConcurrencyLimiter 把这一点做成功能:
+ *
+ *   - 每个槽位拥有一块预分配的, 按缓存行对齐与填充的 FScratchArena
+ *     任务通过 Arena 分配临时内存 (解压缓冲, IO 块 ...), 任务结束后整体 Reset, 无需逐个释放
+ *   - 暂存内存按 "槽位" 而不是 "线程" 归属:
+ *     任务可能在任意工作线程上执行, 也可能被 Wait 的线程撤回执行 (work stealing / retraction),
+ *     线程本地缓冲在这种情况下会被同一线程上嵌套执行的另一个任务覆盖; 槽位在任务期间独占, 不存在该问题
+ *   - 并发度在 [MinConcurrency, MaxConcurrency] 之间自适应:
+ *     排队等待时间的 EMA 超过目标值时增加, 远低于目标值时减少
+ *   - GetStats 返回槽位利用率与排队等待时间直方图
+ *
+ *   Push ──► [Queue] ──► Runner(Slot 0) ── Item(0, Arena0) ── Reset ── Item(0, Arena0) ...
+ *                   └──► Runner(Slot 1) ── Item(1, Arena1) ── Reset ── ...
+ *                         (活动 Runner 数 <= CurrentConcurrency)
+ */
+namespace UE::TemplatesGuide
+{
+	/**
+	 * 线性暂存分配器: 只能整体 Reset
+	 *
+	 * 超出容量的分配退化为 FMemory::Malloc 并在 Reset 时释放 (计入 GetNumOverflows)
+	 * 后备内存按缓存行对齐并填充, 不同槽位的暂存内存不会共享缓存行
+	 */
+	class UNREALTEMPLATESGUIDE_API FScratchArena
+	{
+	public:
+		FScratchArena() = default;
+		~FScratchArena();
+
+		UE_NONCOPYABLE(FScratchArena);
+
+		/** 分配 Capacity 字节的后备内存 (向上取整到缓存行) */
+		void Initialize(SIZE_T Capacity);
+
+		void* Allocate(SIZE_T Size, SIZE_T Alignment = 16);
+
+		template<typename T>
+		TArrayView<T> AllocateArray(int32 Num)
+		{
+			return TArrayView<T>(static_cast<T*>(Allocate(sizeof(T) * Num, alignof(T))), Num);
+		}
+
+		/** 丢弃所有分配, 由限制器在每个任务结束后调用 */
+		void Reset();
+
+		SIZE_T GetCapacity() const { return Capacity; }
+		SIZE_T GetUsed() const { return Used; }
+
+		/** 单个任务使用的最大字节数 (不含溢出分配) */
+		SIZE_T GetHighWater() const { return HighWater; }
+
+		int64 GetNumOverflows() const { return NumOverflows; }
+
+	private:
+		uint8* Memory = nullptr;
+		SIZE_T Capacity = 0;
+		SIZE_T Used = 0;
+		SIZE_T HighWater = 0;
+		int64 NumOverflows = 0;
+		TArray<void*> OverflowAllocations;
+	};
+
+	/** FArenaConcurrencyLimiter 构造参数 */
+	struct FArenaConcurrencyLimiterParams
+	{
+		/** 槽位数, 也是并发度上限 */
+		uint32 MaxConcurrency = 4;
+
+		/** 自适应时的并发度下限 */
+		uint32 MinConcurrency = 1;
+
+		/** 初始并发度, 0 表示 MaxConcurrency */
+		uint32 InitialConcurrency = 0;
+
+		/** 每个槽位的暂存内存大小 */
+		SIZE_T ArenaBytesPerSlot = 64 * 1024;
+
+		/** 是否根据排队等待时间调整并发度 */
+		bool bAdaptive = false;
+
+		/** 排队等待 EMA 超过该值时增加并发度, 低于其 1/4 时减少 */
+		double TargetQueueWaitMicroseconds = 500.0;
+
+		/** 每出队多少个任务评估一次并发度 */
+		int32 AdaptIntervalItems = 16;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	/** FArenaConcurrencyLimiter 统计快照 */
+	struct FArenaConcurrencyLimiterStats
+	{
+		/** 等待时间直方图: 桶 0 为 < 1us, 桶 i 为 [2^(i-1), 2^i) us, 最后一个桶包含更长的等待 */
+		static constexpr int32 NumWaitBuckets = 20;
+
+		uint32 CurrentConcurrency = 0;
+		int64 NumCompleted = 0;
+		int64 NumConcurrencyIncreases = 0;
+		int64 NumConcurrencyDecreases = 0;
+		double QueueWaitEmaMicroseconds = 0.0;
+
+		/** 每个槽位: 执行任务的时间占统计区间的比例 */
+		TArray<double> SlotUtilization;
+		TArray<int64> SlotTasks;
+
+		SIZE_T ArenaHighWaterBytes = 0;
+		int64 ArenaOverflows = 0;
+
+		int64 WaitHistogram[NumWaitBuckets] = {};
+
+		/** 以 "[<1us]=N [1-2us]=N ..." 形式输出非空桶 */
+		UNREALTEMPLATESGUIDE_API FString HistogramToString() const;
+	};
+
+	class UNREALTEMPLATESGUIDE_API FArenaConcurrencyLimiter
+	{
+	public:
+		using FTaskFunction = TUniqueFunction<void(uint32 Slot, FScratchArena& Arena)>;
+
+		explicit FArenaConcurrencyLimiter(const FArenaConcurrencyLimiterParams& InParams = FArenaConcurrencyLimiterParams());
+		~FArenaConcurrencyLimiter();
+
+		UE_NONCOPYABLE(FArenaConcurrencyLimiter);
+
+		/** 推入一个任务, TaskFunction(Slot, Arena) 中 Arena 在任务期间由该任务独占 */
+		void Push(const TCHAR* DebugName, FTaskFunction&& TaskFunction);
+
+		/**
+		 * 等待所有已推入的任务完成, 且所有 Runner 都已退出
+		 *
+		 * Push 与 Runner 在锁外启动新 Runner; 只等任务完成时, 新 Runner 可能在限制器销毁后才开始执行,
+		 * 因此返回条件还包括没有活动 (含已占用槽位但尚未开始执行) 的 Runner, 返回后可以立即销毁限制器
+		 */
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue());
+
+		uint32 GetCurrentConcurrency() const;
+
+		FArenaConcurrencyLimiterStats GetStats() const;
+
+		/** 清空统计 (利用率从现在开始重新计时) */
+		void ResetStats();
+
+	private:
+		struct FItem
+		{
+			const TCHAR* DebugName = nullptr;
+			uint64 PushCycles = 0;
+			FTaskFunction Function;
+		};
+
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+		{
+			FScratchArena Arena;
+			std::atomic<uint64> BusyCycles{0};
+			std::atomic<int64> NumTasks{0};
+		};
+
+		/** 有排队任务且未达到并发度时占用一个空闲槽位, 返回 INDEX_NONE 表示无需启动 */
+		int32 TryAcquireSlotLocked();
+
+		void LaunchRunner(int32 Slot, const TCHAR* DebugName);
+		void RunSlot(int32 Slot);
+
+		/** 记录出队任务的排队时间, 必要时调整并发度 */
+		void RecordQueueWaitLocked(double WaitMicroseconds);
+
+		const FArenaConcurrencyLimiterParams Params;
+		TUniquePtr<FSlot[]> Slots;
+
+		mutable FCriticalSection Mutex;
+		TQueue<FItem> Queue;
+		int32 NumQueued = 0;
+		int64 NumOutstanding = 0;
+		TArray<int32> FreeSlots;
+		uint32 NumActive = 0;
+		int32 NumStarting = 0;
+		uint32 CurrentConcurrency = 0;
+
+		/** NumOutstanding == 0 且 NumActive == 0 (NumStarting 计在 NumActive 内) 时处于触发状态 */
+		FEventRef IdleEvent{EEventMode::ManualReset};
+
+		// 统计 (受 Mutex 保护)
+		int64 NumCompleted = 0;
+		int64 NumIncreases = 0;
+		int64 NumDecreases = 0;
+		int32 ItemsSinceAdapt = 0;
+		double QueueWaitEma = 0.0;
+		int64 WaitHistogram[FArenaConcurrencyLimiterStats::NumWaitBuckets] = {};
+		uint64 StatsStartCycles = 0;
+	};
+}
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DeadlineScheduler.h"
+#include "TaskTimer.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace UE::TemplatesGuide
+{
+	struct FDeadlineScheduler::FItem
+	{
+		TSharedRef<FCounters, ESPMode::ThreadSafe> Counters;
+		FTaskFunction Function;
+		double DeadlineSeconds = 0.0;
+		double EstimatedSeconds = 0.0;
+		EDeadlineMissPolicy MissPolicy = EDeadlineMissPolicy::RunLate;
+
+		/** 两个副本中先开始执行的一个认领任务体 */
+		std::atomic<bool> bClaimed{false};
+
+		UE::Tasks::FTaskEvent CompletionEvent{TEXT("TemplatesGuide::DeadlineDone")};
+		EDeadlineOutcome Outcome = EDeadlineOutcome::CompletedOnTime;
+
+		explicit FItem(const TSharedRef<FCounters, ESPMode::ThreadSafe>& InCounters)
+			: Counters(InCounters)
+		{
+		}
+	};
+
+	FDeadlineScheduler::FDeadlineScheduler(const FDeadlineSchedulerParams& InParams)
+		: Params(InParams)
+		, Counters(MakeShared<FCounters, ESPMode::ThreadSafe>())
+	{
+	}
+
+	UE::Tasks::TTask<EDeadlineOutcome> FDeadlineScheduler::Launch(const TCHAR* DebugName, double DeadlineSeconds, FTaskFunction&& TaskFunction,
+		const FDeadlineTaskParams& TaskParams)
+	{
+		check(TaskFunction);
+
+		TSharedRef<FItem, ESPMode::ThreadSafe> Item = MakeShared<FItem, ESPMode::ThreadSafe>(Counters);
+		Item->Function = MoveTemp(TaskFunction);
+		Item->DeadlineSeconds = DeadlineSeconds;
+		Item->EstimatedSeconds = TaskParams.EstimatedMicroseconds / 1000000.0;
+		Item->MissPolicy = TaskParams.MissPolicy;
+
+		Counters->NumLaunched.fetch_add(1, std::memory_order_relaxed);
+
+		// 结果任务 + 执行任务
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 2);
+
+		UE::Tasks::TTask<EDeadlineOutcome> ResultTask = UE::Tasks::Launch(DebugName,
+			[Item] { return Item->Outcome; },
+			UE::Tasks::Prerequisites(Item->CompletionEvent),
+			LowLevelTasks::ETaskPriority::Normal,
+			UE::Tasks::EExtendedTaskPriority::Inline);
+
+		// 距离 "最晚开始时间" 已不足提升提前量: 直接以提升后的优先级启动
+		const double PromoteInSeconds = DeadlineSeconds - Item->EstimatedSeconds - Params.PromotionLeadMicroseconds / 1000000.0 - FPlatformTime::Seconds();
+		if (PromoteInSeconds <= 0.0)
+		{
+			UE::Tasks::Launch(DebugName, [Item] { TryRun(Item); }, Params.PromotedPriority);
+			return ResultTask;
+		}
+
+		UE::Tasks::Launch(DebugName, [Item] { TryRun(Item); }, Params.BasePriority);
+
+		Private::ScheduleAfter(PromoteInSeconds * 1000000.0, [Item, DebugName, PromotedPriority = Params.PromotedPriority]
+		{
+			if (Item->bClaimed.load(std::memory_order_acquire))
+			{
+				return;
+			}
+
+			Item->Counters->NumPromoted.fetch_add(1, std::memory_order_relaxed);
+			UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+			UE::Tasks::Launch(DebugName, [Item] { TryRun(Item); }, PromotedPriority);
+		});
+
+		return ResultTask;
+	}
+
+	void FDeadlineScheduler::TryRun(const TSharedRef<FItem, ESPMode::ThreadSafe>& Item)
+	{
+		bool bExpected = false;
+		if (!Item->bClaimed.compare_exchange_strong(bExpected, true, std::memory_order_acq_rel))
+		{
+			// 另一个副本已经执行
+			return;
+		}
+
+		FCounters& ItemCounters = *Item->Counters;
+
+		if (Item->MissPolicy == EDeadlineMissPolicy::Drop && FPlatformTime::Seconds() + Item->EstimatedSeconds > Item->DeadlineSeconds)
+		{
+			Item->Function.Reset();
+			Item->Outcome = EDeadlineOutcome::Dropped;
+			ItemCounters.NumDropped.fetch_add(1, std::memory_order_relaxed);
+			Item->CompletionEvent.Trigger();
+			return;
+		}
+
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Execute");
+			Item->Function();
+		}
+		Item->Function.Reset();
+
+		const double LatenessSeconds = FPlatformTime::Seconds() - Item->DeadlineSeconds;
+		if (LatenessSeconds <= 0.0)
+		{
+			Item->Outcome = EDeadlineOutcome::CompletedOnTime;
+			ItemCounters.NumOnTime.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			Item->Outcome = EDeadlineOutcome::CompletedLate;
+			ItemCounters.NumLate.fetch_add(1, std::memory_order_relaxed);
+
+			const uint64 LatenessNanoseconds = uint64(LatenessSeconds * 1e9);
+			ItemCounters.TotalLatenessNanoseconds.fetch_add(LatenessNanoseconds, std::memory_order_relaxed);
+
+			uint64 Previous = ItemCounters.MaxLatenessNanoseconds.load(std::memory_order_relaxed);
+			while (LatenessNanoseconds > Previous && !ItemCounters.MaxLatenessNanoseconds.compare_exchange_weak(Previous, LatenessNanoseconds, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		Item->CompletionEvent.Trigger();
+	}
+
+	FDeadlineSchedulerStats FDeadlineScheduler::GetStats() const
+	{
+		FDeadlineSchedulerStats Stats;
+		Stats.NumLaunched = Counters->NumLaunched.load(std::memory_order_relaxed);
+		Stats.NumOnTime = Counters->NumOnTime.load(std::memory_order_relaxed);
+		Stats.NumLate = Counters->NumLate.load(std::memory_order_relaxed);
+		Stats.NumDropped = Counters->NumDropped.load(std::memory_order_relaxed);
+		Stats.NumPromoted = Counters->NumPromoted.load(std::memory_order_relaxed);
+		Stats.MeanLatenessMicroseconds = Stats.NumLate > 0
+			? double(Counters->TotalLatenessNanoseconds.load(std::memory_order_relaxed)) / 1000.0 / Stats.NumLate
+			: 0.0;
+		Stats.MaxLatenessMicroseconds = double(Counters->MaxLatenessNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+		return Stats;
+	}
+
+	void FDeadlineScheduler::ResetStats()
+	{
+		Counters->NumLaunched.store(0, std::memory_order_relaxed);
+		Counters->NumOnTime.store(0, std::memory_order_relaxed);
+		Counters->NumLate.store(0, std::memory_order_relaxed);
+		Counters->NumDropped.store(0, std::memory_order_relaxed);
+		Counters->NumPromoted.store(0, std::memory_order_relaxed);
+		Counters->TotalLatenessNanoseconds.store(0, std::memory_order_relaxed);
+		Counters->MaxLatenessNanoseconds.store(0, std::memory_order_relaxed);
+	}
+}
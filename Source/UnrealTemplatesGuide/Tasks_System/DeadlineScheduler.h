@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/**
+ * 截止时间调度: 带绝对截止时间启动任务, 临近截止时间时提升优先级, 来不及完成时丢弃或标记
+ *
+ * 示例20 的 Wait(Timeout) 与示例9 的优先级是两个独立的概念; 帧锁定的工作需要把它们合在一起:
+ *   "这个任务必须在本帧的 16.6ms 之前完成"
+ *
+ * UE::Tasks 不能修改已排队任务的优先级, 这里用 "重新启动 + 认领" 实现提升:
+ *
+ *   Launch(Deadline) ──► 以 BasePriority 启动副本 A
+ *        └─ 计时器 @ (Deadline - Estimated - PromotionLead) ──► 仍未开始? 以 PromotedPriority 启动副本 B
+ *   A / B 谁先开始执行谁认领 (原子 CAS), 另一个副本执行时直接返回
+ *
+ *   认领时:  Now + Estimated > Deadline  且 MissPolicy == Drop  → 丢弃 (不执行任务体)
+ *   完成时:  Now > Deadline                                      → 计为迟到 (CompletedLate)
+ *
+ * 结果任务 TTask<EDeadlineOutcome> 在任务体完成或被丢弃时完成
+ * GetStats 返回按时 / 迟到 / 丢弃 / 提升次数与迟到时长, 用于调整每帧安排的工作量
+ *
+ * 提升的代价: 被提升的任务多一个空副本任务 (低优先级副本之后出队并立即返回)
+ */
+namespace UE::TemplatesGuide
+{
+	enum class EDeadlineOutcome : uint8
+	{
+		CompletedOnTime,
+		CompletedLate,
+		Dropped,
+	};
+
+	enum class EDeadlineMissPolicy : uint8
+	{
+		/** 预计来不及完成时仍然执行, 结果标记为 CompletedLate */
+		RunLate,
+
+		/** 开始执行时预计来不及完成 (Now + Estimated > Deadline) 则不执行任务体 */
+		Drop,
+	};
+
+	/** 单个任务的参数 */
+	struct FDeadlineTaskParams
+	{
+		/** 任务体预计耗时, 用于计算提升时间点与丢弃判断 */
+		double EstimatedMicroseconds = 0.0;
+
+		EDeadlineMissPolicy MissPolicy = EDeadlineMissPolicy::RunLate;
+	};
+
+	/** 调度器参数, 优先级可以来自 FTaskPriorityCVar (GetTaskPriority()) */
+	struct FDeadlineSchedulerParams
+	{
+		/** 距离截止时间较远时的优先级 */
+		LowLevelTasks::ETaskPriority BasePriority = LowLevelTasks::ETaskPriority::BackgroundNormal;
+
+		/** 临近截止时间时的优先级 */
+		LowLevelTasks::ETaskPriority PromotedPriority = LowLevelTasks::ETaskPriority::High;
+
+		/** 在 "最晚开始时间" (Deadline - Estimated) 之前多久提升 */
+		double PromotionLeadMicroseconds = 2000.0;
+	};
+
+	struct FDeadlineSchedulerStats
+	{
+		int64 NumLaunched = 0;
+		int64 NumOnTime = 0;
+
+		/** 完成时已超过截止时间 */
+		int64 NumLate = 0;
+
+		/** 因来不及完成被丢弃 */
+		int64 NumDropped = 0;
+
+		/** 由计时器启动了高优先级副本 */
+		int64 NumPromoted = 0;
+
+		/** 迟到任务超过截止时间的平均 / 最大时长 */
+		double MeanLatenessMicroseconds = 0.0;
+		double MaxLatenessMicroseconds = 0.0;
+
+		/** 错过截止时间 (迟到 + 丢弃) 的比例 */
+		double GetMissRate() const
+		{
+			const int64 NumFinished = NumOnTime + NumLate + NumDropped;
+			return NumFinished > 0 ? double(NumLate + NumDropped) / NumFinished : 0.0;
+		}
+	};
+
+	class UNREALTEMPLATESGUIDE_API FDeadlineScheduler
+	{
+	public:
+		using FTaskFunction = TUniqueFunction<void()>;
+
+		explicit FDeadlineScheduler(const FDeadlineSchedulerParams& InParams = FDeadlineSchedulerParams());
+
+		UE_NONCOPYABLE(FDeadlineScheduler);
+
+		/**
+		 * 启动一个带截止时间的任务
+		 *
+		 * @param DeadlineSeconds  绝对截止时间 (FPlatformTime::Seconds() 时基), 如 FrameStart + 0.0166
+		 * @return 任务体完成或被丢弃时完成的结果任务
+		 */
+		UE::Tasks::TTask<EDeadlineOutcome> Launch(const TCHAR* DebugName, double DeadlineSeconds, FTaskFunction&& TaskFunction,
+			const FDeadlineTaskParams& TaskParams = FDeadlineTaskParams());
+
+		FDeadlineSchedulerStats GetStats() const;
+
+		/** 清空统计, 通常每帧或每个调整周期调用一次 */
+		void ResetStats();
+
+		const FDeadlineSchedulerParams& GetParams() const { return Params; }
+
+	private:
+		/** 统计由任务与计时器回调共享, 调度器销毁后仍可能被尚未执行的副本访问 */
+		struct FCounters
+		{
+			std::atomic<int64> NumLaunched{0};
+			std::atomic<int64> NumOnTime{0};
+			std::atomic<int64> NumLate{0};
+			std::atomic<int64> NumDropped{0};
+			std::atomic<int64> NumPromoted{0};
+			std::atomic<uint64> TotalLatenessNanoseconds{0};
+			std::atomic<uint64> MaxLatenessNanoseconds{0};
+		};
+
+		struct FItem;
+
+		static void TryRun(const TSharedRef<FItem, ESPMode::ThreadSafe>& Item);
+
+		const FDeadlineSchedulerParams Params;
+		TSharedRef<FCounters, ESPMode::ThreadSafe> Counters;
+	};
+}
@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InstrumentedWait.h"
+#include "Async/Fundamental/Scheduler.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	namespace WaitPrivate
+	{
+		struct FCounters
+		{
+			std::atomic<int64> NumWaits{0};
+			std::atomic<int64> NumAlreadyCompleted{0};
+			std::atomic<int64> NumRetracted{0};
+			std::atomic<int64> NumBlocked{0};
+			std::atomic<int64> NumTimedOut{0};
+			std::atomic<int64> NumNotAwaitable{0};
+			std::atomic<int64> NumDeferred{0};
+			std::atomic<int64> NumBlockedOnWorker{0};
+			std::atomic<int32> MaxNestedDepth{0};
+			std::atomic<uint64> TotalRetractNanoseconds{0};
+			std::atomic<uint64> TotalBlockedNanoseconds{0};
+			std::atomic<uint64> MaxBlockedNanoseconds{0};
+		};
+
+		static FCounters GCounters;
+
+		/** 当前线程上正在进行的计量等待层数, 以及其中出现过的最深层数 */
+		static thread_local int32 GWaitDepth = 0;
+		static thread_local int32 GDeepestWaitDepth = 0;
+
+		static uint64 ToNanoseconds(double Microseconds)
+		{
+			return uint64(Microseconds * 1000.0);
+		}
+
+		template<typename T>
+		static void AtomicMax(std::atomic<T>& Target, T Value)
+		{
+			T Current = Target.load(std::memory_order_relaxed);
+			while (Value > Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		/** 进入时加深一层, 退出时把本层之下出现的最深嵌套写入报告 */
+		struct FDepthScope
+		{
+			FWaitReport& Report;
+			int32 SavedDeepest;
+
+			explicit FDepthScope(FWaitReport& InReport)
+				: Report(InReport)
+				, SavedDeepest(GDeepestWaitDepth)
+			{
+				GDeepestWaitDepth = ++GWaitDepth;
+			}
+
+			~FDepthScope()
+			{
+				Report.NestedDepth = FMath::Max(Report.NestedDepth, GDeepestWaitDepth - GWaitDepth);
+				AtomicMax(GCounters.MaxNestedDepth, Report.NestedDepth);
+
+				GDeepestWaitDepth = FMath::Max(SavedDeepest, GDeepestWaitDepth);
+				--GWaitDepth;
+			}
+		};
+	}
+
+	namespace Private
+	{
+		bool TryCompleteWithoutBlocking(const UE::Tasks::FTask& Task, FWaitReport& Report)
+		{
+			using namespace WaitPrivate;
+
+			GCounters.NumWaits.fetch_add(1, std::memory_order_relaxed);
+			UE_TEMPLATESGUIDE_INC_COUNTER(TaskWaits, 1);
+			Report.bOnWorkerThread = LowLevelTasks::FScheduler::Get().IsWorkerThread();
+
+			if (Task.IsCompleted())
+			{
+				Report.bAlreadyCompleted = true;
+				GCounters.NumAlreadyCompleted.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			if (!Task.IsAwaitable())
+			{
+				Report.bNotAwaitable = true;
+				GCounters.NumNotAwaitable.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			FDepthScope DepthScope(Report);
+
+			// TryRetractAndExecute 不是 const, 在副本上调用; 它在当前线程就地执行任务及其先决条件
+			UE::Tasks::FTask Retractable = Task;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			{
+				UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Retract");
+				UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskRetract);
+				Report.bRetracted = Retractable.TryRetractAndExecute();
+			}
+			Report.RetractMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+			GCounters.TotalRetractNanoseconds.fetch_add(ToNanoseconds(Report.RetractMicroseconds), std::memory_order_relaxed);
+
+			if (Report.bRetracted)
+			{
+				GCounters.NumRetracted.fetch_add(1, std::memory_order_relaxed);
+			}
+			return Report.bRetracted;
+		}
+
+		void BlockingWait(const UE::Tasks::FTask& Task, FTimespan Timeout, FWaitReport& Report)
+		{
+			using namespace WaitPrivate;
+
+			FDepthScope DepthScope(Report);
+
+			Report.bBlocked = true;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			{
+				UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::BlockingWait");
+				UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskBlockingWait);
+				Report.bTimedOut = !Task.Wait(Timeout);
+			}
+			Report.BlockedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+			const uint64 BlockedNanoseconds = ToNanoseconds(Report.BlockedMicroseconds);
+			GCounters.NumBlocked.fetch_add(1, std::memory_order_relaxed);
+			UE_TEMPLATESGUIDE_INC_COUNTER(TaskBlockingWaits, 1);
+			GCounters.TotalBlockedNanoseconds.fetch_add(BlockedNanoseconds, std::memory_order_relaxed);
+			AtomicMax(GCounters.MaxBlockedNanoseconds, BlockedNanoseconds);
+
+			if (Report.bTimedOut)
+			{
+				GCounters.NumTimedOut.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (Report.bOnWorkerThread)
+			{
+				GCounters.NumBlockedOnWorker.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		void RecordDeferred(FWaitReport& Report)
+		{
+			Report.bDeferred = true;
+			WaitPrivate::GCounters.NumDeferred.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	FWaitReport InstrumentedWait(const UE::Tasks::FTask& Task, FTimespan Timeout)
+	{
+		FWaitReport Report;
+		if (!Private::TryCompleteWithoutBlocking(Task, Report))
+		{
+			Private::BlockingWait(Task, Timeout, Report);
+		}
+		return Report;
+	}
+
+	FWaitStats GetWaitStats()
+	{
+		using namespace WaitPrivate;
+
+		FWaitStats Stats;
+		Stats.NumWaits = GCounters.NumWaits.load(std::memory_order_relaxed);
+		Stats.NumAlreadyCompleted = GCounters.NumAlreadyCompleted.load(std::memory_order_relaxed);
+		Stats.NumRetracted = GCounters.NumRetracted.load(std::memory_order_relaxed);
+		Stats.NumBlocked = GCounters.NumBlocked.load(std::memory_order_relaxed);
+		Stats.NumTimedOut = GCounters.NumTimedOut.load(std::memory_order_relaxed);
+		Stats.NumNotAwaitable = GCounters.NumNotAwaitable.load(std::memory_order_relaxed);
+		Stats.NumDeferred = GCounters.NumDeferred.load(std::memory_order_relaxed);
+		Stats.NumBlockedOnWorker = GCounters.NumBlockedOnWorker.load(std::memory_order_relaxed);
+		Stats.MaxNestedDepth = GCounters.MaxNestedDepth.load(std::memory_order_relaxed);
+		Stats.TotalRetractMicroseconds = GCounters.TotalRetractNanoseconds.load(std::memory_order_relaxed) / 1000.0;
+		Stats.TotalBlockedMicroseconds = GCounters.TotalBlockedNanoseconds.load(std::memory_order_relaxed) / 1000.0;
+		Stats.MaxBlockedMicroseconds = GCounters.MaxBlockedNanoseconds.load(std::memory_order_relaxed) / 1000.0;
+		return Stats;
+	}
+
+	void ResetWaitStats()
+	{
+		using namespace WaitPrivate;
+
+		GCounters.NumWaits.store(0, std::memory_order_relaxed);
+		GCounters.NumAlreadyCompleted.store(0, std::memory_order_relaxed);
+		GCounters.NumRetracted.store(0, std::memory_order_relaxed);
+		GCounters.NumBlocked.store(0, std::memory_order_relaxed);
+		GCounters.NumTimedOut.store(0, std::memory_order_relaxed);
+		GCounters.NumNotAwaitable.store(0, std::memory_order_relaxed);
+		GCounters.NumDeferred.store(0, std::memory_order_relaxed);
+		GCounters.NumBlockedOnWorker.store(0, std::memory_order_relaxed);
+		GCounters.MaxNestedDepth.store(0, std::memory_order_relaxed);
+		GCounters.TotalRetractNanoseconds.store(0, std::memory_order_relaxed);
+		GCounters.TotalBlockedNanoseconds.store(0, std::memory_order_relaxed);
+		GCounters.MaxBlockedNanoseconds.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * 可计量的等待: 撤回优先, 报告撤回是否成功、嵌套多深、阻塞了多久
+ *
+ * Task.Wait() 先尝试撤回 (TryRetractAndExecute, 在当前线程就地执行任务及其先决条件),
+ * 撤回失败 (任务已在其他线程执行) 才阻塞。调用方看不到走了哪条路径,
+ * 而工作线程上的阻塞等待会占住一个工作线程, 最坏情况下 (示例13 IsAwaitable) 直接死锁
+ *
+ *   InstrumentedWait(Task)
+ *     ├─ 已完成                      → bAlreadyCompleted
+ *     ├─ !IsAwaitable()              → bNotAwaitable, 不等待 (等待会死锁)
+ *     ├─ TryRetractAndExecute 完成   → bRetracted, RetractMicroseconds
+ *     └─ 阻塞 Wait(Timeout)          → bBlocked, BlockedMicroseconds (bOnWorkerThread 标记工作线程上的阻塞)
+ *
+ * 嵌套深度: 撤回在当前线程执行的任务体内部再次调用 InstrumentedWait 时深度加一,
+ * NestedDepth 为本次等待期间出现的最深嵌套层数 (只统计经由本文件 API 的等待)
+ *
+ * WaitOrContinue 在此基础上提供 "不阻塞工作线程" 的策略:
+ * 撤回未能完成任务且调用方在工作线程上时, 不阻塞, 而是把剩余工作作为以 Task 为先决条件的续体启动
+ *
+ * 参数类型为公开的 UE::Tasks::FTask: TTask<T> 与 FTaskEvent 都从它派生, 可以直接传入,
+ * 接口不依赖引擎 Private 命名空间中的类型
+ */
+namespace UE::TemplatesGuide
+{
+	enum class EWaitPolicy : uint8
+	{
+		/** 撤回失败后阻塞等待 (与 Task.Wait() 行为一致) */
+		RetractThenBlock,
+
+		/** 撤回失败且在工作线程上时不阻塞, 把续体挂在任务之后 */
+		NeverBlockOnWorker,
+	};
+
+	/** 单次等待的报告 */
+	struct FWaitReport
+	{
+		/** 调用时任务已经完成 */
+		bool bAlreadyCompleted = false;
+
+		/** 撤回并就地执行后任务完成, 没有阻塞 */
+		bool bRetracted = false;
+
+		/** 撤回失败, 阻塞等待 */
+		bool bBlocked = false;
+
+		/** 阻塞等待超时 */
+		bool bTimedOut = false;
+
+		/** 在当前上下文中等待会死锁 (见 IsAwaitable), 没有等待 */
+		bool bNotAwaitable = false;
+
+		/** WaitOrContinue: 没有阻塞, 续体挂在任务之后 */
+		bool bDeferred = false;
+
+		/** 调用方是任务系统的工作线程 */
+		bool bOnWorkerThread = false;
+
+		/** 本次等待期间嵌套等待的最深层数, 0 表示没有嵌套 */
+		int32 NestedDepth = 0;
+
+		/** 撤回就地执行所用时间 (帮忙执行, 不是空等) */
+		double RetractMicroseconds = 0.0;
+
+		/** 阻塞时间 */
+		double BlockedMicroseconds = 0.0;
+
+		/** 任务已完成 (无论经由哪条路径) */
+		bool IsCompleted() const
+		{
+			return bAlreadyCompleted || bRetracted || (bBlocked && !bTimedOut);
+		}
+	};
+
+	/** 进程内所有计量等待的汇总, 用于发现工作线程上的阻塞 */
+	struct FWaitStats
+	{
+		int64 NumWaits = 0;
+		int64 NumAlreadyCompleted = 0;
+		int64 NumRetracted = 0;
+		int64 NumBlocked = 0;
+		int64 NumTimedOut = 0;
+		int64 NumNotAwaitable = 0;
+		int64 NumDeferred = 0;
+
+		/** 工作线程上发生的阻塞 */
+		int64 NumBlockedOnWorker = 0;
+
+		int32 MaxNestedDepth = 0;
+
+		double TotalRetractMicroseconds = 0.0;
+		double TotalBlockedMicroseconds = 0.0;
+		double MaxBlockedMicroseconds = 0.0;
+
+		/** 需要等待 (未完成) 的调用中撤回成功的比例 */
+		double GetRetractionRate() const
+		{
+			const int64 NumNeeded = NumWaits - NumAlreadyCompleted - NumNotAwaitable;
+			return NumNeeded > 0 ? double(NumRetracted) / NumNeeded : 0.0;
+		}
+	};
+
+	/**
+	 * 撤回优先的等待, 语义与 Task.Wait(Timeout) 相同, 额外返回报告并计入汇总
+	 *
+	 * 任务不可等待 (IsAwaitable() == false) 时不等待并返回 bNotAwaitable
+	 */
+	UNREALTEMPLATESGUIDE_API FWaitReport InstrumentedWait(const UE::Tasks::FTask& Task, FTimespan Timeout = FTimespan::MaxValue());
+
+	UNREALTEMPLATESGUIDE_API FWaitStats GetWaitStats();
+	UNREALTEMPLATESGUIDE_API void ResetWaitStats();
+
+	namespace Private
+	{
+		/** 撤回阶段: 已完成 / 不可等待 / 撤回成功时返回 true, 需要阻塞时返回 false */
+		UNREALTEMPLATESGUIDE_API bool TryCompleteWithoutBlocking(const UE::Tasks::FTask& Task, FWaitReport& Report);
+
+		/** 阻塞阶段 */
+		UNREALTEMPLATESGUIDE_API void BlockingWait(const UE::Tasks::FTask& Task, FTimespan Timeout, FWaitReport& Report);
+
+		UNREALTEMPLATESGUIDE_API void RecordDeferred(FWaitReport& Report);
+	}
+
+	/**
+	 * 等待 Task 后执行 Continuation
+	 *
+	 * 撤回完成了任务 (或策略为 RetractThenBlock 并阻塞等到了完成) 时在当前线程直接执行续体,
+	 * 返回无效 (即已完成) 的 FTask; 否则以 Task 为先决条件启动续体并返回它,
+	 * 调用方对有效的返回值 AddNested 或继续组合 (AddNested 不接受无效句柄)
+	 *
+	 * 任务不可等待时无论策略如何都挂起续体: 续体排在任务之后执行, 不会死锁
+	 */
+	template<typename ContinuationType>
+	UE::Tasks::FTask WaitOrContinue(const TCHAR* DebugName, const UE::Tasks::FTask& Task, ContinuationType&& Continuation,
+		EWaitPolicy Policy = EWaitPolicy::NeverBlockOnWorker, FWaitReport* OutReport = nullptr)
+	{
+		static_assert(std::is_invocable_r_v<void, ContinuationType>, "Continuation must be callable as void()");
+
+		FWaitReport LocalReport;
+		FWaitReport& Report = OutReport ? *OutReport : LocalReport;
+		Report = FWaitReport();
+
+		bool bCompleted = Private::TryCompleteWithoutBlocking(Task, Report);
+		const bool bMustDefer = Report.bNotAwaitable || (!bCompleted && Policy == EWaitPolicy::NeverBlockOnWorker && Report.bOnWorkerThread);
+
+		if (!bCompleted && !bMustDefer)
+		{
+			Private::BlockingWait(Task, FTimespan::MaxValue(), Report);
+			bCompleted = true;
+		}
+
+		if (bCompleted && !Report.bNotAwaitable)
+		{
+			Invoke(Continuation);
+			return UE::Tasks::FTask();
+		}
+
+		Private::RecordDeferred(Report);
+		return UE::Tasks::Launch(DebugName, Forward<ContinuationType>(Continuation), UE::Tasks::Prerequisites(Task));
+	}
+}
@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "NamedThreadBatcher.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideTrace.h"
+
+namespace UE::TemplatesGuide
+{
+	namespace Private
+	{
+		struct FNamedThreadBatch
+		{
+			struct FEntry
+			{
+				const TCHAR* DebugName = nullptr;
+				TUniqueFunction<void()> Body;
+			};
+
+			TArray<FEntry> Entries;
+			UE::Tasks::FTask Task;
+			UE::Tasks::FTaskEvent Gate{TEXT("NamedThreadBatchGate")};
+		};
+
+		/** 一个目标线程的当前批与统计, 由批任务共享持有 */
+		struct FNamedThreadTargetState
+		{
+			/** 批任务的 DebugName, 批任务可能比 FNamedThreadBatcher 活得久 */
+			FString DebugName;
+
+			FCriticalSection Mutex;
+			TSharedPtr<FNamedThreadBatch> Open;
+			UE::Tasks::FTask LastTask;
+
+			int64 NumEnqueued = 0;
+			int64 NumBatchTasks = 0;
+			int32 MaxBatchSize = 0;
+
+			/** 在目标线程上执行: 关闭批 (若仍打开) 并按顺序执行其中的闭包 */
+			void RunBatch(FNamedThreadBatch& Batch)
+			{
+				TArray<FNamedThreadBatch::FEntry> Entries;
+				{
+					FScopeLock Lock(&Mutex);
+					if (Open.Get() == &Batch)
+					{
+						Open.Reset();
+					}
+					Entries = MoveTemp(Batch.Entries);
+
+					++NumBatchTasks;
+					MaxBatchSize = FMath::Max(MaxBatchSize, Entries.Num());
+				}
+
+				for (FNamedThreadBatch::FEntry& Entry : Entries)
+				{
+					UE_TEMPLATESGUIDE_TRACE_SCOPE_TEXT(Entry.DebugName);
+					Entry.Body();
+					Entry.Body.Reset();
+				}
+			}
+		};
+	}
+
+	FNamedThreadBatcher::FNamedThreadBatcher(const TCHAR* InDebugName, const FNamedThreadBatcherParams& InParams)
+		: DebugName(InDebugName)
+		, Params(InParams)
+	{
+		const int32 NumTargets = int32(UE::Tasks::EExtendedTaskPriority::Count) - int32(UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri);
+		Targets.Reserve(NumTargets);
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			TSharedRef<Private::FNamedThreadTargetState> State = MakeShared<Private::FNamedThreadTargetState>();
+			State->DebugName = DebugName;
+			Targets.Add(MoveTemp(State));
+		}
+
+		if (Params.bReleaseAtEndOfFrame)
+		{
+			EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FNamedThreadBatcher::ReleaseBatches);
+		}
+	}
+
+	FNamedThreadBatcher::~FNamedThreadBatcher()
+	{
+		if (EndFrameHandle.IsValid())
+		{
+			FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		}
+
+		// 未放行的批任务永远不会执行
+		ReleaseBatches();
+	}
+
+	int32 FNamedThreadBatcher::GetTargetIndex(UE::Tasks::EExtendedTaskPriority Target)
+	{
+		checkf(Target >= UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri && Target < UE::Tasks::EExtendedTaskPriority::Count,
+			TEXT("FNamedThreadBatcher only batches named-thread targets"));
+		return int32(Target) - int32(UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri);
+	}
+
+	UE::Tasks::FTask FNamedThreadBatcher::EnqueueImpl(UE::Tasks::EExtendedTaskPriority Target, const TCHAR* EntryDebugName, TUniqueFunction<void()>&& Body)
+	{
+		const TSharedRef<Private::FNamedThreadTargetState>& State = Targets[GetTargetIndex(Target)];
+
+		TSharedPtr<Private::FNamedThreadBatch> NewBatch;
+		UE::Tasks::FTask BatchTask;
+		{
+			FScopeLock Lock(&State->Mutex);
+
+			if (!State->Open)
+			{
+				// 批任务以放行事件为先决条件, 在锁内启动也不会在放行之前执行;
+				// 这样同一批的所有 Enqueue 都能拿到同一个任务句柄
+				NewBatch = MakeShared<Private::FNamedThreadBatch>();
+				NewBatch->Task = UE::Tasks::Launch(*State->DebugName,
+					[State, Batch = NewBatch.ToSharedRef()] { State->RunBatch(*Batch); },
+					UE::Tasks::Prerequisites(NewBatch->Gate), Params.Priority, Target);
+
+				State->Open = NewBatch;
+				State->LastTask = NewBatch->Task;
+			}
+
+			State->Open->Entries.Add(Private::FNamedThreadBatch::FEntry{EntryDebugName, MoveTemp(Body)});
+			++State->NumEnqueued;
+			BatchTask = State->Open->Task;
+		}
+
+		if (NewBatch && !Params.bReleaseAtEndOfFrame)
+		{
+			NewBatch->Gate.Trigger();
+		}
+		return BatchTask;
+	}
+
+	void FNamedThreadBatcher::ReleaseBatches()
+	{
+		for (const TSharedRef<Private::FNamedThreadTargetState>& State : Targets)
+		{
+			TSharedPtr<Private::FNamedThreadBatch> Batch;
+			{
+				FScopeLock Lock(&State->Mutex);
+				Batch = MoveTemp(State->Open);
+			}
+
+			// 立即放行模式下 Gate 可能已触发, 重复触发无害
+			if (Batch)
+			{
+				Batch->Gate.Trigger();
+			}
+		}
+	}
+
+	bool FNamedThreadBatcher::Wait(FTimespan Timeout)
+	{
+		ReleaseBatches();
+
+		TArray<UE::Tasks::FTask> Tasks;
+		for (const TSharedRef<Private::FNamedThreadTargetState>& State : Targets)
+		{
+			FScopeLock Lock(&State->Mutex);
+			if (State->LastTask.IsValid())
+			{
+				Tasks.Add(State->LastTask);
+			}
+		}
+
+		// 同一目标线程的批按放行顺序执行, 最后一个完成即全部完成
+		return UE::Tasks::Wait(Tasks, Timeout);
+	}
+
+	FNamedThreadBatchStats FNamedThreadBatcher::GetStats(UE::Tasks::EExtendedTaskPriority Target) const
+	{
+		const TSharedRef<Private::FNamedThreadTargetState>& State = Targets[GetTargetIndex(Target)];
+		FScopeLock Lock(&State->Mutex);
+
+		FNamedThreadBatchStats Stats;
+		Stats.NumEnqueued = State->NumEnqueued;
+		Stats.NumBatchTasks = State->NumBatchTasks;
+		Stats.MaxBatchSize = State->MaxBatchSize;
+		return Stats;
+	}
+
+	FNamedThreadBatchStats FNamedThreadBatcher::GetStats() const
+	{
+		FNamedThreadBatchStats Total;
+		for (const TSharedRef<Private::FNamedThreadTargetState>& State : Targets)
+		{
+			FScopeLock Lock(&State->Mutex);
+			Total.NumEnqueued += State->NumEnqueued;
+			Total.NumBatchTasks += State->NumBatchTasks;
+			Total.MaxBatchSize = FMath::Max(Total.MaxBatchSize, State->MaxBatchSize);
+		}
+		return Total;
+	}
+
+	void FNamedThreadBatcher::ResetStats()
+	{
+		for (const TSharedRef<Private::FNamedThreadTargetState>& State : Targets)
+		{
+			FScopeLock Lock(&State->Mutex);
+			State->NumEnqueued = 0;
+			State->NumBatchTasks = 0;
+			State->MaxBatchSize = 0;
+		}
+	}
+}
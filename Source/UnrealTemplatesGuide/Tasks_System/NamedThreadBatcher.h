@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * 命名线程批量投递: 每个目标线程每批只启动一个任务
+ *
+ * 示例16 向 GameThread 投递单个任务; 游戏线程与渲染线程之间的交接每帧有成百上千个很小的闭包,
+ * 逐个 Launch 时每个闭包都是一次命名线程队列的入队 / 出队, 目标线程逐个取出执行
+ *
+ *   Batcher.Enqueue(EExtendedTaskPriority::GameThreadNormalPri, TEXT("ApplyResult"), [...] { ... });
+ *     ├─ 目标线程没有打开的批: 新建批, 启动一个批任务 (以批的放行事件为先决条件, 发往目标线程)
+ *     └─ 已有打开的批: 只把闭包追加到批中
+ *
+ *   放行: 默认批在帧末 (FCoreDelegates::OnEndFrame) 关闭并放行, 即每帧每个目标线程一个任务
+ *         (Wait / ReleaseBatches 可以提前放行)
+ *         bReleaseAtEndOfFrame = false 时第一次 Enqueue 即放行, 批在目标线程开始执行批任务时关闭,
+ *         之后的 Enqueue 进入新批, 一帧内的批数等于目标线程处理队列的次数
+ *
+ * 顺序: 同一目标线程的闭包按 Enqueue (取得锁) 的顺序执行; 不同批按放行顺序进入目标线程的队列
+ * Enqueue 返回闭包所在批的任务, 可 Wait 或用作先决条件 (完成表示批内全部闭包已执行)
+ *
+ * 每个目标线程的状态由批任务共享持有, 批任务可以在 FNamedThreadBatcher 销毁之后执行;
+ * 析构时放行所有打开的批, 但不等待它们
+ */
+namespace UE::TemplatesGuide
+{
+	struct FNamedThreadBatcherParams
+	{
+		/** 批在帧末才放行 (默认); 设为 false 时第一次 Enqueue 即放行, 目标线程取走批任务时关闭, 延迟更低但每帧可能有多个批 */
+		bool bReleaseAtEndOfFrame = true;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	struct FNamedThreadBatchStats
+	{
+		/** Enqueue 的闭包数 (逐个 Launch 时的任务数) */
+		int64 NumEnqueued = 0;
+
+		/** 实际启动的批任务数 */
+		int64 NumBatchTasks = 0;
+
+		int32 MaxBatchSize = 0;
+
+		int64 GetNumLaunchesSaved() const
+		{
+			return NumEnqueued - NumBatchTasks;
+		}
+
+		double GetMeanBatchSize() const
+		{
+			return NumBatchTasks > 0 ? double(NumEnqueued) / NumBatchTasks : 0.0;
+		}
+	};
+
+	namespace Private
+	{
+		struct FNamedThreadTargetState;
+	}
+
+	class UNREALTEMPLATESGUIDE_API FNamedThreadBatcher
+	{
+	public:
+		explicit FNamedThreadBatcher(const TCHAR* InDebugName, const FNamedThreadBatcherParams& InParams = FNamedThreadBatcherParams());
+
+		/** 放行所有打开的批 (不等待) */
+		~FNamedThreadBatcher();
+
+		UE_NONCOPYABLE(FNamedThreadBatcher);
+
+		/**
+		 * 把闭包追加到目标线程的当前批, 可从任意线程调用
+		 *
+		 * @param Target     命名线程, 如 GameThreadNormalPri / RenderThreadNormalPri
+		 * @param DebugName  在 Insights 中作为批任务内的 CPU 事件, 需在批执行完之前保持有效 (通常为字面量)
+		 * @return 闭包所在批的任务
+		 */
+		template<typename BodyType>
+		UE::Tasks::FTask Enqueue(UE::Tasks::EExtendedTaskPriority Target, const TCHAR* DebugName, BodyType&& Body)
+		{
+			static_assert(std::is_invocable_r_v<void, BodyType>, "Body must be callable as void()");
+			return EnqueueImpl(Target, DebugName, TUniqueFunction<void()>(Forward<BodyType>(Body)));
+		}
+
+		/** 关闭并放行所有打开的批; bReleaseAtEndOfFrame 时每帧末自动调用 */
+		void ReleaseBatches();
+
+		/** 放行并等待所有已启动的批; 在目标线程上等待时由当前线程执行该线程的批 */
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue());
+
+		/** 单个目标线程 / 全部目标线程的汇总 */
+		FNamedThreadBatchStats GetStats(UE::Tasks::EExtendedTaskPriority Target) const;
+		FNamedThreadBatchStats GetStats() const;
+		void ResetStats();
+
+	private:
+		UE::Tasks::FTask EnqueueImpl(UE::Tasks::EExtendedTaskPriority Target, const TCHAR* DebugName, TUniqueFunction<void()>&& Body);
+
+		static int32 GetTargetIndex(UE::Tasks::EExtendedTaskPriority Target);
+
+		const FString DebugName;
+		const FNamedThreadBatcherParams Params;
+
+		/** 按 EExtendedTaskPriority 从 GameThreadNormalPri 开始的命名线程索引 */
+		TArray<TSharedRef<Private::FNamedThreadTargetState>> Targets;
+
+		FDelegateHandle EndFrameHandle;
+	};
+}
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ParallelBatch.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace UE::TemplatesGuide::Private
+{
+	FBatchChunking ComputeChunking(int32 Num, int32 AlignItems, int32 Lead, const FBatchLaunchParams& Params)
+	{
+		FBatchChunking Chunking;
+		if (Num <= 0)
+		{
+			return Chunking;
+		}
+
+		AlignItems = FMath::Max(1, AlignItems);
+
+		const int32 MaxTasks = Params.MaxTasks > 0
+			? Params.MaxTasks
+			: FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+		// 按测量的单条目耗时选择块大小, 使每块约为 TargetChunkMicroseconds
+		int64 ChunkSize = FMath::Max(1, Params.InitialChunkSize);
+		const double NanosecondsPerItem = Params.CostModel ? Params.CostModel->GetNanosecondsPerItem() : 0.0;
+		if (NanosecondsPerItem > 0.0)
+		{
+			const double TargetItems = Params.TargetChunkMicroseconds * 1000.0 / NanosecondsPerItem;
+			ChunkSize = static_cast<int64>(FMath::Clamp(TargetItems, 1.0, double(Num)));
+
+			// 块数不足以让每个任务分到 MinChunksPerTask 块时缩小块,
+			// 但最多缩小到目标的 1/MinChunksPerTask, 避免调度开销重新占主导
+			const int32 MinChunksPerTask = FMath::Max(1, Params.MinChunksPerTask);
+			const int64 BalancedChunkSize = FMath::DivideAndRoundUp<int64>(Num, int64(MaxTasks) * MinChunksPerTask);
+			ChunkSize = FMath::Min(ChunkSize, FMath::Max(BalancedChunkSize, ChunkSize / MinChunksPerTask));
+		}
+
+		// 块大小取缓存行条目数的整数倍 (AlignItems 不一定是 2 的幂, 不能用 Align)
+		ChunkSize = FMath::Min<int64>(FMath::DivideAndRoundUp<int64>(ChunkSize, AlignItems) * AlignItems, MAX_int32);
+
+		Chunking.Num = Num;
+		Chunking.Lead = FMath::Clamp(Lead, 0, FMath::Min(Num, AlignItems - 1));
+		Chunking.ChunkSize = static_cast<int32>(ChunkSize);
+		Chunking.NumChunks = Num > Chunking.Lead
+			? static_cast<int32>(FMath::DivideAndRoundUp<int64>(Num - Chunking.Lead, ChunkSize))
+			: 1;
+		Chunking.NumTasks = FMath::Min(Chunking.NumChunks, MaxTasks);
+		return Chunking;
+	}
+}
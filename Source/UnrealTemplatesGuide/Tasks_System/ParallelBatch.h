@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+/**
+ * 基于 UE::Tasks::Launch 的数据并行批量启动工具
+ *
+ * Example_BasicLaunch / Example_Prerequisites 为每个条目启动一个任务,
+ * 当每帧有上万个小条目时, 每个任务的固定开销 (分配 TExecutableTask, 调度, 引用计数) 会占主导
+ *
+ * LaunchBatched 的做法:
+ *   1. 把 [0, Num) 切成若干块, 块边界按缓存行对齐 (相邻块不会写同一缓存行, 避免伪共享)
+ *   2. 根据 FBatchCostModel 记录的单条目耗时, 自适应选择块大小 (目标单块耗时 TargetChunkMicroseconds)
+ *   3. 约每个工作线程启动一个任务, 任务内部通过原子计数器动态领取块 (负载均衡)
+ *   4. 返回一个 FTask (FTaskEvent 合并点), 可以 Wait 或作为其他任务的先决条件
+ *
+ *   Items:  [0 ........................................................ Num)
+ *   Chunks: [ Lead+C ][   C   ][   C   ][   C   ]  ...  [  <=C  ]
+ *             ^ 首块额外包含 Lead 个条目, 使之后的块起点都落在缓存行边界
+ *   Tasks:  Task0 ─┐
+ *           Task1 ─┼─ NextChunk.fetch_add(1) 领取下一块, 直到全部完成
+ *           TaskN ─┘
+ *
+ * 用法:
+ *   static FBatchCostModel CostModel;  // 每个调用点一个, 跨帧保留测量结果
+ *
+ *   FBatchLaunchParams Params;
+ *   Params.CostModel = &CostModel;
+ *
+ *   FTask Batch = LaunchBatched(UE_SOURCE_LOCATION, MakeArrayView(Items),
+ *       [](FItem& Item) { Item.Update(); }, Params);
+ *
+ *   Launch(UE_SOURCE_LOCATION, [] { ... }, Prerequisites(Batch));
+ */
+namespace UE::TemplatesGuide
+{
+	/**
+	 * 单条目耗时模型 (指数滑动平均)
+	 *
+	 * 每个调用点持有一个实例, 各工作任务在每块结束时上报样本
+	 * 并发更新可能丢失个别样本, 对估计值没有影响, 因此不加锁
+	 */
+	class FBatchCostModel
+	{
+	public:
+		/** 当前估计的单条目耗时 (纳秒), 0 表示尚未测量 */
+		double GetNanosecondsPerItem() const
+		{
+			return NanosecondsPerItem.load(std::memory_order_relaxed);
+		}
+
+		/** 上报一块的测量结果 */
+		void AddSample(int32 NumItems, uint64 Cycles)
+		{
+			if (NumItems <= 0)
+			{
+				return;
+			}
+
+			const double Sample = FPlatformTime::ToSeconds64(Cycles) * 1e9 / NumItems;
+			const double Old = NanosecondsPerItem.load(std::memory_order_relaxed);
+			NanosecondsPerItem.store(Old <= 0.0 ? Sample : Old + SmoothingFactor * (Sample - Old), std::memory_order_relaxed);
+		}
+
+		void Reset()
+		{
+			NanosecondsPerItem.store(0.0, std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr double SmoothingFactor = 0.25;
+		std::atomic<double> NanosecondsPerItem{0.0};
+	};
+
+	/** LaunchBatched 参数 */
+	struct FBatchLaunchParams
+	{
+		/** 可选的耗时模型, 为空时始终使用 InitialChunkSize */
+		FBatchCostModel* CostModel = nullptr;
+
+		/** 目标单块耗时 (微秒): 块越大调度开销占比越小, 块越小负载越均衡 */
+		double TargetChunkMicroseconds = 50.0;
+
+		/** 尚无测量数据时的块大小 */
+		int32 InitialChunkSize = 256;
+
+		/** 每个任务至少分到的块数, 保证动态领取有负载均衡的余地 */
+		int32 MinChunksPerTask = 4;
+
+		/** 最多启动的任务数, 0 表示工作线程数 */
+		int32 MaxTasks = 0;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+
+		/** 只有一块时直接在调用线程执行 (返回已完成的任务) */
+		bool bInlineSingleChunk = true;
+	};
+
+	namespace Private
+	{
+		/** 一次批量启动的分块方案 */
+		struct FBatchChunking
+		{
+			int32 Num = 0;
+			int32 Lead = 0;
+			int32 ChunkSize = 1;
+			int32 NumChunks = 0;
+			int32 NumTasks = 0;
+
+			int32 GetChunkBegin(int32 ChunkIndex) const
+			{
+				return ChunkIndex == 0 ? 0 : Lead + ChunkIndex * ChunkSize;
+			}
+
+			int32 GetChunkEnd(int32 ChunkIndex) const
+			{
+				return static_cast<int32>(FMath::Min<int64>(Num, int64(Lead) + int64(ChunkIndex + 1) * ChunkSize));
+			}
+		};
+
+		/**
+		 * 计算分块方案
+		 *
+		 * @param Num          条目数
+		 * @param AlignItems   一个缓存行容纳的条目数 (块大小取其整数倍)
+		 * @param Lead         到下一个缓存行边界的条目数 [0, AlignItems)
+		 */
+		UNREALTEMPLATESGUIDE_API FBatchChunking ComputeChunking(int32 Num, int32 AlignItems, int32 Lead, const FBatchLaunchParams& Params);
+
+		template<typename RangeBodyType>
+		struct TBatchState
+		{
+			TBatchState(RangeBodyType&& InBody, const FBatchChunking& InChunking, FBatchCostModel* InCostModel)
+				: Body(MoveTemp(InBody))
+				, Chunking(InChunking)
+				, CostModel(InCostModel)
+			{
+			}
+
+			/** 由每个工作任务调用: 动态领取块直到全部完成 */
+			void Run()
+			{
+				UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::BatchRun");
+
+				for (int32 ChunkIndex = NextChunk.fetch_add(1, std::memory_order_relaxed);
+					ChunkIndex < Chunking.NumChunks;
+					ChunkIndex = NextChunk.fetch_add(1, std::memory_order_relaxed))
+				{
+					const int32 Begin = Chunking.GetChunkBegin(ChunkIndex);
+					const int32 End = Chunking.GetChunkEnd(ChunkIndex);
+
+					const uint64 StartCycles = FPlatformTime::Cycles64();
+					Body(Begin, End);
+					if (CostModel)
+					{
+						CostModel->AddSample(End - Begin, FPlatformTime::Cycles64() - StartCycles);
+					}
+				}
+			}
+
+			RangeBodyType Body;
+			FBatchChunking Chunking;
+			FBatchCostModel* CostModel;
+			std::atomic<int32> NextChunk{0};
+		};
+	}
+
+	/**
+	 * 对 [0, Num) 分块并行执行 RangeBody(int32 Begin, int32 End)
+	 *
+	 * @param AlignItems  块大小与块边界对齐的条目数, 通常为 PLATFORM_CACHE_LINE_SIZE / sizeof(Element)
+	 * @param Lead        首块额外包含的条目数, 使之后的块起点对齐 (通常由数组地址计算)
+	 * @return 所有块完成后才完成的任务
+	 */
+	template<typename RangeBodyType>
+	UE::Tasks::FTask LaunchBatchedRange(const TCHAR* DebugName, int32 Num, RangeBodyType&& RangeBody,
+		const FBatchLaunchParams& Params = FBatchLaunchParams(), int32 AlignItems = 1, int32 Lead = 0)
+	{
+		using FState = Private::TBatchState<std::decay_t<RangeBodyType>>;
+
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Launch");
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+		const Private::FBatchChunking Chunking = Private::ComputeChunking(Num, AlignItems, Lead, Params);
+		if (Chunking.NumChunks == 0)
+		{
+			return UE::Tasks::FTask();
+		}
+
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>(
+			std::decay_t<RangeBodyType>(Forward<RangeBodyType>(RangeBody)), Chunking, Params.CostModel);
+
+		if (Chunking.NumChunks == 1 && Params.bInlineSingleChunk)
+		{
+			// 只有一块: Inline 任务在调用线程立即执行, 省去一次调度
+			UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+			return UE::Tasks::Launch(DebugName, [State] { State->Run(); },
+				Params.Priority, UE::Tasks::EExtendedTaskPriority::Inline);
+		}
+
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, Chunking.NumTasks);
+		UE::Tasks::FTaskEvent Joiner(DebugName);
+		for (int32 TaskIndex = 0; TaskIndex < Chunking.NumTasks; ++TaskIndex)
+		{
+			Joiner.AddPrerequisites(UE::Tasks::Launch(DebugName, [State] { State->Run(); }, Params.Priority));
+		}
+		Joiner.Trigger();
+		return Joiner;
+	}
+
+	/**
+	 * 对数组中的每个条目并行执行 ItemBody(ElementType&)
+	 *
+	 * 块边界按数组元素的实际地址对齐到 PLATFORM_CACHE_LINE_SIZE
+	 * 注意: Items 引用的内存必须保持有效, 直到返回的任务完成
+	 */
+	template<typename ElementType, typename ItemBodyType>
+	UE::Tasks::FTask LaunchBatched(const TCHAR* DebugName, TArrayView<ElementType> Items, ItemBodyType&& ItemBody,
+		const FBatchLaunchParams& Params = FBatchLaunchParams())
+	{
+		constexpr int32 AlignItems = FMath::Max<int32>(1, PLATFORM_CACHE_LINE_SIZE / sizeof(ElementType));
+
+		int32 Lead = 0;
+		if constexpr (PLATFORM_CACHE_LINE_SIZE % sizeof(ElementType) == 0)
+		{
+			const UPTRINT Misalignment = reinterpret_cast<UPTRINT>(Items.GetData()) % PLATFORM_CACHE_LINE_SIZE;
+			if (Misalignment != 0 && Misalignment % sizeof(ElementType) == 0)
+			{
+				Lead = static_cast<int32>((PLATFORM_CACHE_LINE_SIZE - Misalignment) / sizeof(ElementType));
+			}
+		}
+
+		ElementType* Data = Items.GetData();
+		return LaunchBatchedRange(DebugName, Items.Num(),
+			[Data, ItemBody = std::decay_t<ItemBodyType>(Forward<ItemBodyType>(ItemBody))](int32 Begin, int32 End) mutable
+			{
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					ItemBody(Data[Index]);
+				}
+			},
+			Params, AlignItems, FMath::Min(Lead, Items.Num()));
+	}
+}
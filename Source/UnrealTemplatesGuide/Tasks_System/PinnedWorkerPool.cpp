@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PinnedWorkerPool.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideTrace.h"
+
+namespace UE::TemplatesGuide
+{
+	/** 一个绑定核心的线程与它自己的唤醒事件 */
+	class FPinnedWorkerPool::FWorker final : public FRunnable
+	{
+	public:
+		FWorker(FPinnedWorkerPool& InPool, int32 InIndex)
+			: Pool(InPool)
+			, Index(InIndex)
+		{
+		}
+
+		virtual ~FWorker() override
+		{
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+			}
+		}
+
+		void Start(const TCHAR* ThreadName, EThreadPriority Priority, uint64 Mask)
+		{
+			Thread = FRunnableThread::Create(this, ThreadName, 0, Priority, Mask);
+		}
+
+		virtual uint32 Run() override
+		{
+			Pool.RunWorker(Index);
+			return 0;
+		}
+
+		FPinnedWorkerPool& Pool;
+		const int32 Index;
+		FEventRef WakeEvent;
+		FRunnableThread* Thread = nullptr;
+	};
+
+	uint64 FPinnedWorkerPool::GetDefaultBackgroundMask()
+	{
+		const int32 NumCores = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, 64);
+		const uint64 AllCores = NumCores == 64 ? ~uint64(0) : (uint64(1) << NumCores) - 1;
+
+		const uint64 Reserved = FPlatformAffinity::GetMainGameMask() | FPlatformAffinity::GetRenderingThreadMask();
+		const uint64 Background = AllCores & ~Reserved;
+		return Background != 0 ? Background : AllCores;
+	}
+
+	FPinnedWorkerPool::FPinnedWorkerPool(const TCHAR* InDebugName, const FPinnedWorkerPoolParams& InParams)
+		: DebugName(InDebugName)
+	{
+		AffinityMask = InParams.AffinityMask != 0 ? InParams.AffinityMask : GetDefaultBackgroundMask();
+
+		if (!FPlatformProcess::SupportsMultithreading())
+		{
+			return;
+		}
+
+		const int32 NumThreads = InParams.NumThreads > 0 ? InParams.NumThreads : FMath::Max(1, int32(FMath::CountBits(AffinityMask)));
+		Workers.Reserve(NumThreads);
+		for (int32 Index = 0; Index < NumThreads; ++Index)
+		{
+			Workers.Add(MakeUnique<FWorker>(*this, Index));
+		}
+
+		// 全部 FWorker 构造完再启动线程, RunWorker 会按索引访问 Workers
+		for (int32 Index = 0; Index < NumThreads; ++Index)
+		{
+			Workers[Index]->Start(*FString::Printf(TEXT("%s %d"), *DebugName, Index), InParams.ThreadPriority, AffinityMask);
+		}
+	}
+
+	FPinnedWorkerPool::~FPinnedWorkerPool()
+	{
+		{
+			FScopeLock Lock(&Mutex);
+			bStopping = true;
+		}
+		for (const TUniquePtr<FWorker>& Worker : Workers)
+		{
+			Worker->WakeEvent->Trigger();
+		}
+
+		// FWorker 析构时等待线程退出
+		Workers.Empty();
+	}
+
+	UE::Tasks::FTaskEvent FPinnedWorkerPool::LaunchImpl(const TCHAR* EntryDebugName, TUniqueFunction<void()>&& Body)
+	{
+		FItem Item;
+		Item.DebugName = EntryDebugName;
+		Item.Body = MoveTemp(Body);
+		Item.Completion.Emplace(TEXT("PinnedWorkerCompletion"));
+		UE::Tasks::FTaskEvent Completion = *Item.Completion;
+
+		if (Workers.IsEmpty())
+		{
+			Execute(Item);
+			return Completion;
+		}
+
+		int32 WakeIndex = INDEX_NONE;
+		{
+			FScopeLock Lock(&Mutex);
+			checkf(!bStopping, TEXT("%s: Launch during destruction"), *DebugName);
+
+			Queue.Enqueue(MoveTemp(Item));
+			PeakQueueDepth = FMath::Max(PeakQueueDepth, ++NumQueued);
+
+			if (!IdleWorkers.IsEmpty())
+			{
+				WakeIndex = IdleWorkers.Pop(EAllowShrinking::No);
+			}
+		}
+
+		if (WakeIndex != INDEX_NONE)
+		{
+			Workers[WakeIndex]->WakeEvent->Trigger();
+		}
+		return Completion;
+	}
+
+	void FPinnedWorkerPool::RunWorker(int32 WorkerIndex)
+	{
+		FWorker& Worker = *Workers[WorkerIndex];
+		uint64 ExecutedCycles = 0;
+
+		for (;;)
+		{
+			FItem Item;
+			bool bHasItem = false;
+			{
+				FScopeLock Lock(&Mutex);
+
+				if (ExecutedCycles != 0)
+				{
+					++NumExecuted;
+					BusyCycles += ExecutedCycles;
+					ExecutedCycles = 0;
+				}
+
+				bHasItem = Queue.Dequeue(Item);
+				if (bHasItem)
+				{
+					--NumQueued;
+				}
+				else if (bStopping)
+				{
+					return;
+				}
+				else
+				{
+					// 先登记为空闲再等待: Launch 在登记之后触发的唤醒不会丢失 (事件为自动重置, 保留一次触发)
+					IdleWorkers.Push(WorkerIndex);
+				}
+			}
+
+			if (!bHasItem)
+			{
+				Worker.WakeEvent->Wait();
+				continue;
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Execute(Item);
+			ExecutedCycles = FMath::Max<uint64>(1, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+	void FPinnedWorkerPool::Execute(FItem& Item)
+	{
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE_TEXT(Item.DebugName);
+			Item.Body();
+			Item.Body.Reset();
+		}
+		Item.Completion->Trigger();
+	}
+
+	FPinnedWorkerPoolStats FPinnedWorkerPool::GetStats() const
+	{
+		FScopeLock Lock(&Mutex);
+
+		FPinnedWorkerPoolStats Stats;
+		Stats.NumExecuted = NumExecuted;
+		Stats.QueueDepth = NumQueued;
+		Stats.PeakQueueDepth = PeakQueueDepth;
+		Stats.BusyMicroseconds = FPlatformTime::ToMilliseconds64(BusyCycles) * 1000.0;
+		return Stats;
+	}
+
+	void FPinnedWorkerPool::ResetStats()
+	{
+		FScopeLock Lock(&Mutex);
+
+		NumExecuted = 0;
+		PeakQueueDepth = NumQueued;
+		BusyCycles = 0;
+	}
+}
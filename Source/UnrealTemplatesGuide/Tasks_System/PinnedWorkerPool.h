@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "Tasks/Task.h"
+
+class FRunnableThread;
+
+/**
+ * 绑定核心的后台工作线程池
+ *
+ * UE::Tasks 的工作线程由调度器统一管理, 单个任务不能指定在哪些核心上执行;
+ * CPU 密集的后台工作 (烘焙、压缩、寻路预计算) 与游戏线程抢同一个核心时会拖慢帧时间。
+ * FPinnedWorkerPool 创建一组带亲和性掩码的专用线程 (FRunnableThread::Create 的 ThreadAffinityMask),
+ * 任务体只在掩码内的核心上执行:
+ *
+ *   FPinnedWorkerPool Pool(TEXT("Bake"));                     // 默认掩码: 除游戏线程 / 渲染线程核心之外的核心
+ *   FTaskEvent Done = Pool.Launch(TEXT("BakeChunk"), [] { ... });
+ *   UE::Tasks::Launch(TEXT("Apply"), [] { ... }, UE::Tasks::Prerequisites(Done));
+ *
+ * Launch 返回的 FTaskEvent 在任务体执行完后触发, 可 Wait 或用作 UE::Tasks 的先决条件
+ * 任务体按 FIFO 出队, 多个线程并发执行; 析构时执行完已排队的任务体再退出
+ *
+ * 平台不支持亲和性 (GetMainGameMask() 返回 NoAffinityMask) 时默认掩码退化为所有核心
+ */
+namespace UE::TemplatesGuide
+{
+	struct FPinnedWorkerPoolParams
+	{
+		/** 0: 使用 GetDefaultBackgroundMask() */
+		uint64 AffinityMask = 0;
+
+		/** 0: 掩码中的核心数 */
+		int32 NumThreads = 0;
+
+		EThreadPriority ThreadPriority = TPri_BelowNormal;
+	};
+
+	struct FPinnedWorkerPoolStats
+	{
+		int64 NumExecuted = 0;
+		int32 QueueDepth = 0;
+		int32 PeakQueueDepth = 0;
+		double BusyMicroseconds = 0.0;
+	};
+
+	class UNREALTEMPLATESGUIDE_API FPinnedWorkerPool
+	{
+	public:
+		explicit FPinnedWorkerPool(const TCHAR* InDebugName, const FPinnedWorkerPoolParams& InParams = FPinnedWorkerPoolParams());
+
+		/** 执行完已排队的任务体后停止所有线程 */
+		~FPinnedWorkerPool();
+
+		UE_NONCOPYABLE(FPinnedWorkerPool);
+
+		/** 可从任意线程调用; 平台不支持多线程时在调用线程上直接执行 */
+		template<typename BodyType>
+		UE::Tasks::FTaskEvent Launch(const TCHAR* DebugName, BodyType&& Body)
+		{
+			static_assert(std::is_invocable_r_v<void, BodyType>, "Body must be callable as void()");
+			return LaunchImpl(DebugName, TUniqueFunction<void()>(Forward<BodyType>(Body)));
+		}
+
+		uint64 GetAffinityMask() const { return AffinityMask; }
+		int32 GetNumThreads() const { return Workers.Num(); }
+
+		FPinnedWorkerPoolStats GetStats() const;
+		void ResetStats();
+
+		/** 所有核心去掉游戏线程与渲染线程的亲和性掩码, 结果为空时返回所有核心 */
+		static uint64 GetDefaultBackgroundMask();
+
+	private:
+		class FWorker;
+
+		struct FItem
+		{
+			const TCHAR* DebugName = nullptr;
+			TUniqueFunction<void()> Body;
+
+			/** 只在 Launch 时创建, 出队用的空条目不分配事件 */
+			TOptional<UE::Tasks::FTaskEvent> Completion;
+		};
+
+		UE::Tasks::FTaskEvent LaunchImpl(const TCHAR* DebugName, TUniqueFunction<void()>&& Body);
+
+		/** 工作线程主循环 */
+		void RunWorker(int32 WorkerIndex);
+
+		static void Execute(FItem& Item);
+
+		const FString DebugName;
+		uint64 AffinityMask = 0;
+		TArray<TUniquePtr<FWorker>> Workers;
+
+		mutable FCriticalSection Mutex;
+		TQueue<FItem> Queue;
+		int32 NumQueued = 0;
+		TArray<int32> IdleWorkers;
+		bool bStopping = false;
+
+		int64 NumExecuted = 0;
+		int32 PeakQueueDepth = 0;
+		uint64 BusyCycles = 0;
+	};
+}
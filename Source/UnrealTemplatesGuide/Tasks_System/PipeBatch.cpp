@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PipeBatch.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	namespace PipeBatchPrivate
+	{
+		static std::atomic<int64> GNumFusedTasks{0};
+		static std::atomic<int64> GNumFusedSubmissions{0};
+		static std::atomic<int32> GMaxFusedPerTask{0};
+	}
+
+	FPipeBatchStats GetPipeBatchStats()
+	{
+		using namespace PipeBatchPrivate;
+
+		FPipeBatchStats Stats;
+		Stats.NumFusedTasks = GNumFusedTasks.load(std::memory_order_relaxed);
+		Stats.NumFusedSubmissions = GNumFusedSubmissions.load(std::memory_order_relaxed);
+		Stats.MaxFusedPerTask = GMaxFusedPerTask.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	void ResetPipeBatchStats()
+	{
+		using namespace PipeBatchPrivate;
+
+		GNumFusedTasks.store(0, std::memory_order_relaxed);
+		GNumFusedSubmissions.store(0, std::memory_order_relaxed);
+		GMaxFusedPerTask.store(0, std::memory_order_relaxed);
+	}
+
+	FPipeBatchScope::FPipeBatchScope(UE::Tasks::FPipe& InPipe, const TCHAR* InDebugName, const FPipeBatchParams& InParams)
+		: Pipe(InPipe)
+		, DebugName(InDebugName)
+		, Params(InParams)
+	{
+		if (Params.MaxFusedPerTask > 0)
+		{
+			Pending.Reserve(Params.MaxFusedPerTask);
+		}
+	}
+
+	FPipeBatchScope::~FPipeBatchScope()
+	{
+		Flush();
+	}
+
+	UE::Tasks::FTask FPipeBatchScope::Flush()
+	{
+		using namespace PipeBatchPrivate;
+
+		const int32 NumEntries = Pending.Num();
+		if (NumEntries == 0)
+		{
+			return LastTask;
+		}
+
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::PipeEnqueue");
+
+		// 批内的执行顺序即依赖顺序: 上一批的最后一个任务体 → 本批第一个 → ...
+		for (const FEntry& Entry : Pending)
+		{
+			if (LastTraceId != 0 && Entry.TraceId != 0)
+			{
+				Trace::OutputEdge(LastTraceId, Entry.TraceId);
+			}
+			LastTraceId = Entry.TraceId;
+		}
+
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+		LastTask = Pipe.Launch(DebugName,
+			[Entries = MoveTemp(Pending)]() mutable { ExecuteEntries(Entries); },
+			Params.Priority);
+		Pending.Reset();
+		if (Params.MaxFusedPerTask > 0)
+		{
+			Pending.Reserve(Params.MaxFusedPerTask);
+		}
+
+		NumFused += NumEntries;
+		++NumFusedTasks;
+
+		GNumFusedTasks.fetch_add(1, std::memory_order_relaxed);
+		GNumFusedSubmissions.fetch_add(NumEntries, std::memory_order_relaxed);
+		int32 PrevMax = GMaxFusedPerTask.load(std::memory_order_relaxed);
+		while (PrevMax < NumEntries && !GMaxFusedPerTask.compare_exchange_weak(PrevMax, NumEntries, std::memory_order_relaxed))
+		{
+		}
+
+		return LastTask;
+	}
+
+	void FPipeBatchScope::ExecuteEntries(TArray<FEntry>& Entries)
+	{
+		for (FEntry& Entry : Entries)
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE_TEXT(Entry.DebugName);
+			Trace::FTaskExecuteScope ExecuteScope(Entry.TraceId);
+
+			Entry.Body();
+			// 尽早释放捕获的资源, 与逐个启动时任务体执行完即销毁一致
+			Entry.Body.Reset();
+		}
+	}
+}
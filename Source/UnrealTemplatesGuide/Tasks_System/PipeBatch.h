@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+#include "Profiling/TemplatesGuideTrace.h"
+
+/**
+ * 管道批量提交: 作用域内收集的任务体在作用域结束时合并为一个管道任务
+ *
+ * 示例15 的 FPipeSuspensionScope 挂起管道后逐个 Launch, 恢复时每个任务仍是一次调度 (N 次入队 / 出队 / 唤醒)
+ * FPipeBatchScope 不挂起管道, 只在本地收集任务体, Flush (或析构) 时启动一个融合任务顺序执行它们:
+ *
+ *   FPipeBatchScope Batch(Pipe, TEXT("MeshUpdates"));
+ *   for (...) { Batch.Add(TEXT("UpdateMesh"), [...] { ... }); }    // 不启动任务
+ *   // 析构: Pipe.Launch(TEXT("MeshUpdates"), [全部任务体] { 按 Add 顺序执行 })
+ *
+ * 顺序: 批内按 Add 顺序执行; 整批在管道上的位置由 Flush 时刻决定,
+ * 在它之前启动到管道上的任务先执行, 之后启动的后执行 (作用域打开期间其他线程的管道任务会排在批之前)
+ *
+ * 追踪: 每个合并的任务体保留自己的 DebugName, 在 Insights 中作为融合任务内的 CPU 事件,
+ * 并输出 TaskLaunched / TaskStarted / TaskCompleted 以及批内前后两个任务体之间的 TaskEdge
+ *
+ * FPipeBatchScope 只能由一个线程使用 (通常是提交方自己的栈对象); 管道本身仍可被多个线程并发使用
+ */
+namespace UE::TemplatesGuide
+{
+	struct FPipeBatchParams
+	{
+		/** 一个融合任务最多合并的任务体数, 达到时自动 Flush; 0 表示不限 */
+		int32 MaxFusedPerTask = 0;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	/** 进程内所有批量提交的汇总 */
+	struct FPipeBatchStats
+	{
+		/** 实际启动的融合任务数 */
+		int64 NumFusedTasks = 0;
+
+		/** 合并进融合任务的任务体数 (逐个启动时的任务数) */
+		int64 NumFusedSubmissions = 0;
+
+		int32 MaxFusedPerTask = 0;
+
+		/** 节省的调度次数 */
+		int64 GetNumLaunchesSaved() const
+		{
+			return NumFusedSubmissions - NumFusedTasks;
+		}
+	};
+
+	UNREALTEMPLATESGUIDE_API FPipeBatchStats GetPipeBatchStats();
+	UNREALTEMPLATESGUIDE_API void ResetPipeBatchStats();
+
+	class UNREALTEMPLATESGUIDE_API FPipeBatchScope
+	{
+	public:
+		FPipeBatchScope(UE::Tasks::FPipe& InPipe, const TCHAR* InDebugName, const FPipeBatchParams& InParams = FPipeBatchParams());
+
+		/** Flush 剩余的任务体 */
+		~FPipeBatchScope();
+
+		UE_NONCOPYABLE(FPipeBatchScope);
+
+		/** 收集一个任务体, 不启动任务; DebugName 需在融合任务执行完之前保持有效 (通常为字面量) */
+		template<typename BodyType>
+		void Add(const TCHAR* DebugName, BodyType&& Body)
+		{
+			static_assert(std::is_invocable_r_v<void, BodyType>, "Body must be callable as void()");
+
+			FEntry& Entry = Pending.Emplace_GetRef();
+			Entry.DebugName = DebugName;
+			Entry.TraceId = Trace::OutputLaunched(DebugName);
+			Entry.Body = Forward<BodyType>(Body);
+
+			if (Params.MaxFusedPerTask > 0 && Pending.Num() >= Params.MaxFusedPerTask)
+			{
+				Flush();
+			}
+		}
+
+		/**
+		 * 把已收集的任务体作为一个融合任务启动到管道上
+		 *
+		 * @return 融合任务 (可 Wait / 用作先决条件), 没有待提交的任务体时返回最后一个融合任务
+		 */
+		UE::Tasks::FTask Flush();
+
+		/** 最后启动的融合任务, 完成即表示之前 Add 的任务体都已执行 */
+		UE::Tasks::FTask GetLastTask() const { return LastTask; }
+
+		int32 GetNumPending() const { return Pending.Num(); }
+
+		/** 本作用域合并的任务体数与启动的融合任务数 */
+		int32 GetNumFused() const { return NumFused; }
+		int32 GetNumFusedTasks() const { return NumFusedTasks; }
+
+	private:
+		struct FEntry
+		{
+			const TCHAR* DebugName = nullptr;
+			Trace::FTaskId TraceId = 0;
+			TUniqueFunction<void()> Body;
+		};
+
+		static void ExecuteEntries(TArray<FEntry>& Entries);
+
+		UE::Tasks::FPipe& Pipe;
+		const TCHAR* DebugName;
+		const FPipeBatchParams Params;
+
+		TArray<FEntry> Pending;
+		UE::Tasks::FTask LastTask;
+		Trace::FTaskId LastTraceId = 0;
+		int32 NumFused = 0;
+		int32 NumFusedTasks = 0;
+	};
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PooledTaskBody.h"
+#include "Containers/LockFreeFixedSizeAllocator.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	namespace
+	{
+		// 各大小级别一个分配器, 每个线程缓存一个 bundle, 满/空时与全局空闲链表整体交换
+		TLockFreeFixedSizeAllocator_TLSCache<64> GTaskBodyAllocator64;
+		TLockFreeFixedSizeAllocator_TLSCache<128> GTaskBodyAllocator128;
+		TLockFreeFixedSizeAllocator_TLSCache<256> GTaskBodyAllocator256;
+		TLockFreeFixedSizeAllocator_TLSCache<512> GTaskBodyAllocator512;
+		TLockFreeFixedSizeAllocator_TLSCache<1024> GTaskBodyAllocator1024;
+
+#if UE_TEMPLATESGUIDE_POOLED_TASK_STATS
+		std::atomic<int64> GPooledAllocations{0};
+		std::atomic<int64> GHeapFallbacks{0};
+		std::atomic<int64> GInlineBodies{0};
+		std::atomic<int64> GLiveBodies{0};
+
+		#define POOLED_TASK_STAT_ADD(Counter, Value) Counter.fetch_add(Value, std::memory_order_relaxed)
+#else
+		#define POOLED_TASK_STAT_ADD(Counter, Value)
+#endif
+
+		bool IsPoolable(SIZE_T Size, SIZE_T Alignment)
+		{
+			return Size <= PooledTaskBodyMaxSize && Alignment <= PooledTaskBodyMaxAlignment;
+		}
+	}
+
+	namespace Private
+	{
+		void* AllocatePooledTaskBody(SIZE_T Size, SIZE_T Alignment)
+		{
+			POOLED_TASK_STAT_ADD(GLiveBodies, 1);
+
+			if (!IsPoolable(Size, Alignment))
+			{
+				POOLED_TASK_STAT_ADD(GHeapFallbacks, 1);
+				return FMemory::Malloc(Size, Alignment);
+			}
+
+			POOLED_TASK_STAT_ADD(GPooledAllocations, 1);
+			if (Size <= 64)
+			{
+				return GTaskBodyAllocator64.Allocate();
+			}
+			if (Size <= 128)
+			{
+				return GTaskBodyAllocator128.Allocate();
+			}
+			if (Size <= 256)
+			{
+				return GTaskBodyAllocator256.Allocate();
+			}
+			if (Size <= 512)
+			{
+				return GTaskBodyAllocator512.Allocate();
+			}
+			return GTaskBodyAllocator1024.Allocate();
+		}
+
+		void FreePooledTaskBody(void* Ptr, SIZE_T Size, SIZE_T Alignment)
+		{
+			POOLED_TASK_STAT_ADD(GLiveBodies, -1);
+
+			if (!IsPoolable(Size, Alignment))
+			{
+				FMemory::Free(Ptr);
+			}
+			else if (Size <= 64)
+			{
+				GTaskBodyAllocator64.Free(Ptr);
+			}
+			else if (Size <= 128)
+			{
+				GTaskBodyAllocator128.Free(Ptr);
+			}
+			else if (Size <= 256)
+			{
+				GTaskBodyAllocator256.Free(Ptr);
+			}
+			else if (Size <= 512)
+			{
+				GTaskBodyAllocator512.Free(Ptr);
+			}
+			else
+			{
+				GTaskBodyAllocator1024.Free(Ptr);
+			}
+		}
+
+		void CountInlineTaskBody()
+		{
+			POOLED_TASK_STAT_ADD(GInlineBodies, 1);
+		}
+	}
+
+	FPooledTaskBodyStats GetPooledTaskBodyStats()
+	{
+		FPooledTaskBodyStats Stats;
+#if UE_TEMPLATESGUIDE_POOLED_TASK_STATS
+		Stats.PooledAllocations = GPooledAllocations.load(std::memory_order_relaxed);
+		Stats.HeapFallbacks = GHeapFallbacks.load(std::memory_order_relaxed);
+		Stats.InlineBodies = GInlineBodies.load(std::memory_order_relaxed);
+		Stats.LiveBodies = GLiveBodies.load(std::memory_order_relaxed);
+#endif
+		return Stats;
+	}
+
+	void ResetPooledTaskBodyStats()
+	{
+#if UE_TEMPLATESGUIDE_POOLED_TASK_STATS
+		// LiveBodies 反映实际存活数量, 不清零
+		GPooledAllocations.store(0, std::memory_order_relaxed);
+		GHeapFallbacks.store(0, std::memory_order_relaxed);
+		GInlineBodies.store(0, std::memory_order_relaxed);
+#endif
+	}
+
+#undef POOLED_TASK_STAT_ADD
+}
@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+/** 是否统计 LaunchPooled 的分配计数 (统计使用全局原子计数, Shipping 下关闭) */
+#ifndef UE_TEMPLATESGUIDE_POOLED_TASK_STATS
+	#define UE_TEMPLATESGUIDE_POOLED_TASK_STATS !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * LaunchPooled: 任务体存放在按大小分级的线程本地空闲链表中的 Launch 包装
+ *
+ * UE::Tasks::Launch 把任务体 (lambda 及其捕获) 内联存放在 TExecutableTask 中:
+ *   - 任务对象不超过小任务块大小时, 由引擎的小对象分配器分配
+ *   - 捕获较大时, 整个任务对象退化为 FMemory::Malloc
+ * 每帧上千次的 Fire-and-Forget 启动 (示例11) 会因此在分配分析中出现
+ *
+ * LaunchPooled 把较大的任务体移动到 TLockFreeFixedSizeAllocator_TLSCache 分级池中,
+ * 传给 Launch 的可调用对象只持有一个指针, 任务对象 (含结果存储) 保持在小任务块内:
+ *
+ *   TaskBodyFitsSmallTaskBlock<Body>            → 直接 Launch (任务对象已在小任务块内, 池化没有收益)
+ *   sizeof(Body) <= 1024 且 alignof(Body) <= 16  → 64/128/256/512/1024 分级池 (线程本地缓存)
+ *   其他                                        → FMemory::Malloc (计入 HeapFallbacks)
+ *
+ * 任务体在执行完毕后由执行线程析构并归还池 (TExecutableTask 执行后立即析构任务体),
+ * 跨线程归还由 TLS 缓存自行处理
+ *
+ * 用法与 Launch 相同:
+ *   LaunchPooled(UE_SOURCE_LOCATION, [Payload]() mutable { ... });
+ *   LaunchPooled(UE_SOURCE_LOCATION, [Payload] { return Payload.Num(); }, Prerequisites(Other));
+ */
+namespace UE::TemplatesGuide
+{
+	/**
+	 * 任务体内联后的任务对象 (TExecutableTask, 含结果存储) 放得进引擎的小任务块, Launch 本身不做堆分配
+	 *
+	 * 与 TExecutableTask::operator new 的判断相同; 这样的任务体直接交给 Launch, 不计入避免的分配
+	 */
+	template<typename BodyType>
+	inline constexpr bool TaskBodyFitsSmallTaskBlock = sizeof(UE::Tasks::Private::TExecutableTask<BodyType>) <= UE::Tasks::Private::SmallTaskSize;
+
+	/** 池化的最大任务体大小和对齐 */
+	inline constexpr SIZE_T PooledTaskBodyMaxSize = 1024;
+	inline constexpr SIZE_T PooledTaskBodyMaxAlignment = 16;
+
+	/** LaunchPooled 的分配统计 */
+	struct FPooledTaskBodyStats
+	{
+		/** 由分级池分配的任务体数 (直接 Launch 时任务对象会超出小任务块, 即避免的堆分配) */
+		int64 PooledAllocations = 0;
+
+		/** 超出池化范围, 退化为 FMemory::Malloc 的任务体数 */
+		int64 HeapFallbacks = 0;
+
+		/** 任务对象放得进小任务块, 直接内联的任务体数 */
+		int64 InlineBodies = 0;
+
+		/** 当前尚未归还的任务体数 */
+		int64 LiveBodies = 0;
+	};
+
+	UNREALTEMPLATESGUIDE_API FPooledTaskBodyStats GetPooledTaskBodyStats();
+	UNREALTEMPLATESGUIDE_API void ResetPooledTaskBodyStats();
+
+	namespace Private
+	{
+		UNREALTEMPLATESGUIDE_API void* AllocatePooledTaskBody(SIZE_T Size, SIZE_T Alignment);
+		UNREALTEMPLATESGUIDE_API void FreePooledTaskBody(void* Ptr, SIZE_T Size, SIZE_T Alignment);
+		UNREALTEMPLATESGUIDE_API void CountInlineTaskBody();
+
+		/** 持有池化任务体的可调用对象, 只包含一个指针 (仅可移动) */
+		template<typename BodyType>
+		class TPooledTaskBody
+		{
+		public:
+			explicit TPooledTaskBody(BodyType&& InBody)
+				: Body(new (AllocatePooledTaskBody(sizeof(BodyType), alignof(BodyType))) BodyType(MoveTemp(InBody)))
+			{
+			}
+
+			TPooledTaskBody(TPooledTaskBody&& Other)
+				: Body(Other.Body)
+			{
+				Other.Body = nullptr;
+			}
+
+			TPooledTaskBody(const TPooledTaskBody&) = delete;
+			TPooledTaskBody& operator=(const TPooledTaskBody&) = delete;
+			TPooledTaskBody& operator=(TPooledTaskBody&&) = delete;
+
+			~TPooledTaskBody()
+			{
+				if (Body)
+				{
+					Body->~BodyType();
+					FreePooledTaskBody(Body, sizeof(BodyType), alignof(BodyType));
+				}
+			}
+
+			// 非 const: 支持 mutable lambda
+			decltype(auto) operator()()
+			{
+				return Invoke(*Body);
+			}
+
+		private:
+			BodyType* Body;
+		};
+	}
+
+	/**
+	 * 与 UE::Tasks::Launch 相同的参数 (先决条件, 优先级, 扩展优先级, 标志),
+	 * 较大的任务体存放在分级池中
+	 */
+	template<typename TaskBodyType, typename... ArgTypes>
+	auto LaunchPooled(const TCHAR* DebugName, TaskBodyType&& TaskBody, ArgTypes&&... Args)
+	{
+		using FBody = std::decay_t<TaskBodyType>;
+
+		UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+		UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+
+		if constexpr (TaskBodyFitsSmallTaskBlock<FBody>)
+		{
+			Private::CountInlineTaskBody();
+			return UE::Tasks::Launch(DebugName, Forward<TaskBodyType>(TaskBody), Forward<ArgTypes>(Args)...);
+		}
+		else
+		{
+			static_assert(TaskBodyFitsSmallTaskBlock<Private::TPooledTaskBody<FBody>>, "the pooled wrapper must fit in the small task block");
+			return UE::Tasks::Launch(DebugName, Private::TPooledTaskBody<FBody>(FBody(Forward<TaskBodyType>(TaskBody))),
+				Forward<ArgTypes>(Args)...);
+		}
+	}
+}
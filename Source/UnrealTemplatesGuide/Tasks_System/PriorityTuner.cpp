@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PriorityTuner.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	static bool GPriorityTunerEnabled = true;
+	static FAutoConsoleVariableRef CVarPriorityTunerEnabled(
+		TEXT("TemplatesGuide.PriorityTuner.Enabled"),
+		GPriorityTunerEnabled,
+		TEXT("When 0, FPriorityTuner keeps measuring frame time and queue latency but stops changing task priority CVars."),
+		ECVF_Default);
+
+	namespace PriorityTunerPrivate
+	{
+		static constexpr double SmoothingFactor = 0.125;
+		static constexpr int32 NumPriorities = int32(LowLevelTasks::ETaskPriority::Count);
+	}
+
+	namespace Private
+	{
+		/** 每个优先级最多一个探测任务在途, 排队延迟 EMA 只由该探测任务写入 */
+		struct FPriorityProbe
+		{
+			std::atomic<double> LatencyEma[PriorityTunerPrivate::NumPriorities] = {};
+			std::atomic<bool> bHasSample[PriorityTunerPrivate::NumPriorities] = {};
+			std::atomic<bool> bInFlight[PriorityTunerPrivate::NumPriorities] = {};
+		};
+	}
+
+	const TCHAR* LexToString(EPriorityTunerReason Reason)
+	{
+		switch (Reason)
+		{
+		case EPriorityTunerReason::FrameOverBudget:	return TEXT("FrameOverBudget");
+		case EPriorityTunerReason::QueueLatency:	return TEXT("QueueLatency");
+		default:									return TEXT("Unknown");
+		}
+	}
+
+	FPriorityTuner::FPriorityTuner(const FPriorityTunerParams& InParams)
+		: Params(InParams)
+		, Probe(MakeShared<Private::FPriorityProbe>())
+	{
+		check(Params.EvaluationIntervalFrames > 0);
+		check(Params.MinDwellFrames >= 0);
+		checkf(Params.PromoteFrameFraction <= 1.0 + Params.FrameTolerance, TEXT("PromoteFrameFraction must not exceed the demotion threshold"));
+	}
+
+	FPriorityTuner::~FPriorityTuner() = default;
+
+	void FPriorityTuner::RegisterCategory(const TCHAR* Category, UE::Tasks::FTaskPriorityCVar& CVar, const TCHAR* CVarName,
+		const FPriorityTunerCategoryParams& CategoryParams)
+	{
+		checkf(CategoryParams.HighestPriority <= CategoryParams.LowestPriority, TEXT("%s: HighestPriority must not be lower than LowestPriority"), Category);
+
+		IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(CVarName);
+		checkf(ConsoleVariable, TEXT("%s: console variable %s not found"), Category, CVarName);
+
+		const LowLevelTasks::ETaskPriority Current = CVar.GetTaskPriority();
+		checkf(Current >= CategoryParams.HighestPriority && Current <= CategoryParams.LowestPriority,
+			TEXT("%s: current priority %s is outside the tuning range"), Category, LowLevelTasks::ToString(Current));
+
+		FScopeLock Lock(&Mutex);
+		Categories.Add(FCategory{Category, &CVar, ConsoleVariable, CategoryParams});
+	}
+
+	void FPriorityTuner::Update(double FrameMilliseconds)
+	{
+		FScopeLock Lock(&Mutex);
+
+		++Frame;
+		FrameEma = Frame == 1 ? FrameMilliseconds : FrameEma + PriorityTunerPrivate::SmoothingFactor * (FrameMilliseconds - FrameEma);
+
+		// 平台不统计进程 CPU 时间时为 0, 总是视为有空闲核心
+		CpuPercent = FPlatformTime::GetCPUTime().CPUTimePctRelative;
+
+		LaunchProbesLocked();
+
+		if (GPriorityTunerEnabled && Frame % uint64(Params.EvaluationIntervalFrames) == 0)
+		{
+			EvaluateLocked();
+		}
+	}
+
+	void FPriorityTuner::LaunchProbesLocked()
+	{
+		using namespace PriorityTunerPrivate;
+
+		bool bInUse[NumPriorities] = {};
+		for (const FCategory& Category : Categories)
+		{
+			bInUse[int32(Category.CVar->GetTaskPriority())] = true;
+		}
+
+		for (int32 Index = 0; Index < NumPriorities; ++Index)
+		{
+			// 上一个探测还在排队: 不叠加, 等它完成 (排队很久本身会体现在它的样本里)
+			if (!bInUse[Index] || Probe->bInFlight[Index].exchange(true, std::memory_order_acquire))
+			{
+				continue;
+			}
+
+			const uint64 LaunchCycles = FPlatformTime::Cycles64();
+			UE::Tasks::Launch(TEXT("PriorityTunerProbe"), [Probe = Probe, Index, LaunchCycles]
+			{
+				const double Latency = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - LaunchCycles) * 1000.0;
+				const double Previous = Probe->LatencyEma[Index].load(std::memory_order_relaxed);
+				const bool bHasSample = Probe->bHasSample[Index].exchange(true, std::memory_order_relaxed);
+				Probe->LatencyEma[Index].store(bHasSample ? Previous + SmoothingFactor * (Latency - Previous) : Latency, std::memory_order_relaxed);
+				Probe->bInFlight[Index].store(false, std::memory_order_release);
+			}, LowLevelTasks::ETaskPriority(Index));
+		}
+	}
+
+	void FPriorityTuner::EvaluateLocked()
+	{
+		const bool bOverBudget = FrameEma > Params.TargetFrameMilliseconds * (1.0 + Params.FrameTolerance);
+		const bool bUnderPromoteThreshold = FrameEma < Params.TargetFrameMilliseconds * Params.PromoteFrameFraction;
+		const bool bIdleCores = CpuPercent < Params.IdleCpuPercent;
+
+		for (FCategory& Category : Categories)
+		{
+			// 上次调整的效果还没有稳定体现在帧时间 EMA 里, 不再改动
+			if (Category.LastChangeFrame != 0 && Frame - Category.LastChangeFrame < uint64(Params.MinDwellFrames))
+			{
+				continue;
+			}
+
+			const LowLevelTasks::ETaskPriority Current = Category.CVar->GetTaskPriority();
+			const double QueueLatency = Probe->LatencyEma[int32(Current)].load(std::memory_order_relaxed);
+
+			if (bOverBudget && Category.Params.bYieldToFrame && Current < Category.Params.LowestPriority)
+			{
+				ApplyLocked(Category, LowLevelTasks::ETaskPriority(int32(Current) + 1), EPriorityTunerReason::FrameOverBudget, QueueLatency);
+			}
+			else if (bUnderPromoteThreshold && bIdleCores && QueueLatency > Category.Params.TargetQueueLatencyMicroseconds
+				&& Current > Category.Params.HighestPriority)
+			{
+				ApplyLocked(Category, LowLevelTasks::ETaskPriority(int32(Current) - 1), EPriorityTunerReason::QueueLatency, QueueLatency);
+			}
+		}
+	}
+
+	void FPriorityTuner::ApplyLocked(FCategory& Category, LowLevelTasks::ETaskPriority To, EPriorityTunerReason Reason, double QueueLatency)
+	{
+		const LowLevelTasks::ETaskPriority From = Category.CVar->GetTaskPriority();
+		const UE::Tasks::EExtendedTaskPriority Extended = Category.CVar->GetExtendedTaskPriority();
+
+		// 写回与控制台相同的格式 "Priority [ExtendedPriority]", 保留扩展优先级
+		FString Value = LowLevelTasks::ToString(To);
+		if (Extended != UE::Tasks::EExtendedTaskPriority::None)
+		{
+			Value += TEXT(" ");
+			Value += UE::Tasks::ToString(Extended);
+		}
+		Category.ConsoleVariable->Set(*Value, ECVF_SetByCode);
+
+		if (Category.CVar->GetTaskPriority() != To)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("PriorityTuner: %s stays %s (%s overridden by a higher-priority setting)"),
+				*Category.Name, LowLevelTasks::ToString(From), LexToString(Reason));
+			return;
+		}
+
+		Category.LastChangeFrame = Frame;
+
+		FPriorityTunerDecision& Decision = Decisions.Emplace_GetRef();
+		Decision.Category = Category.Name;
+		Decision.From = From;
+		Decision.To = To;
+		Decision.Reason = Reason;
+		Decision.Frame = Frame;
+		Decision.FrameMilliseconds = FrameEma;
+		Decision.QueueLatencyMicroseconds = QueueLatency;
+		Decision.CpuPercent = CpuPercent;
+
+		if (Decisions.Num() > Params.MaxDecisions)
+		{
+			Decisions.RemoveAt(0, Decisions.Num() - Params.MaxDecisions, EAllowShrinking::No);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("PriorityTuner: %s %s -> %s (%s: frame %.2fms / %.2fms, queue %.0fus, cpu %.0f%%)"),
+			*Category.Name, LowLevelTasks::ToString(From), LowLevelTasks::ToString(To), LexToString(Reason),
+			FrameEma, Params.TargetFrameMilliseconds, QueueLatency, CpuPercent);
+	}
+
+	FPriorityTunerSnapshot FPriorityTuner::GetSnapshot() const
+	{
+		FScopeLock Lock(&Mutex);
+
+		FPriorityTunerSnapshot Snapshot;
+		Snapshot.Frame = Frame;
+		Snapshot.FrameMilliseconds = FrameEma;
+		Snapshot.CpuPercent = CpuPercent;
+		for (int32 Index = 0; Index < PriorityTunerPrivate::NumPriorities; ++Index)
+		{
+			Snapshot.QueueLatencyMicroseconds[Index] = Probe->LatencyEma[Index].load(std::memory_order_relaxed);
+		}
+		return Snapshot;
+	}
+
+	TArray<FPriorityTunerDecision> FPriorityTuner::GetDecisions() const
+	{
+		FScopeLock Lock(&Mutex);
+		return Decisions;
+	}
+}
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+struct IConsoleVariable;
+
+/**
+ * 运行时优先级自动调整: 根据帧时间、各优先级的排队延迟与 CPU 占用调整 FTaskPriorityCVar
+ *
+ * 示例17 的 FTaskPriorityCVar 让优先级可以在控制台修改, 但每个平台手工调参。
+ * FPriorityTuner 把已注册的任务类别 (每个类别对应一个 FTaskPriorityCVar) 在配置的上下界内自动调整:
+ *
+ *   每帧 Update(FrameMs)
+ *     ├─ 帧时间 EMA、进程 CPU 占用 (FPlatformTime::GetCPUTime)
+ *     └─ 每个在用的优先级启动一个空探测任务, 测 "启动到开始执行" 的排队延迟 EMA
+ *   每 EvaluationIntervalFrames 帧评估一次, 每个类别最多移动一级:
+ *     帧时间超出预算 且 bYieldToFrame      → 降一级 (不低于 LowestPriority)
+ *     帧时间低于预算 * PromoteFrameFraction
+ *       且 排队延迟超过目标 且 CPU 有空闲   → 升一级 (不高于 HighestPriority)
+ *
+ * 降级与升级的阈值之间留出滞回区间, 每个类别调整后至少停留 MinDwellFrames 帧, 避免在预算附近来回翻转
+ *
+ * 调整通过控制台变量以 ECVF_SetByCode 写入, 控制台 / ini 设置的值优先级更高时调整被引擎忽略 (手动覆盖优先)
+ * 每次调整以 UE_LOG 输出, 并保存在 GetDecisions() 的最近记录中
+ * TemplatesGuide.PriorityTuner.Enabled 0 冻结所有调整 (仍然测量)
+ */
+namespace UE::TemplatesGuide
+{
+	enum class EPriorityTunerReason : uint8
+	{
+		/** 帧时间超出预算, 让出工作线程 */
+		FrameOverBudget,
+
+		/** 排队延迟超过目标且有空闲核心 */
+		QueueLatency,
+	};
+
+	UNREALTEMPLATESGUIDE_API const TCHAR* LexToString(EPriorityTunerReason Reason);
+
+	/** 一个任务类别的调整范围 */
+	struct FPriorityTunerCategoryParams
+	{
+		/** 可调到的最高优先级 (ETaskPriority 数值越小优先级越高) */
+		LowLevelTasks::ETaskPriority HighestPriority = LowLevelTasks::ETaskPriority::Normal;
+
+		/** 可调到的最低优先级 */
+		LowLevelTasks::ETaskPriority LowestPriority = LowLevelTasks::ETaskPriority::BackgroundLow;
+
+		/** 该类别在用的排队延迟目标 (微秒) */
+		double TargetQueueLatencyMicroseconds = 500.0;
+
+		/** 帧时间超出预算时降级 (后台工作); false 时只会因排队延迟升级 */
+		bool bYieldToFrame = true;
+	};
+
+	struct FPriorityTunerParams
+	{
+		/** 帧时间预算 */
+		double TargetFrameMilliseconds = 16.6;
+
+		/** 超出预算的容差, 帧时间 EMA > Target * (1 + Tolerance) 才算超预算 */
+		double FrameTolerance = 0.05;
+
+		/** 帧时间 EMA < Target * PromoteFrameFraction 才允许升级, 与降级阈值之间为滞回区间 */
+		double PromoteFrameFraction = 0.85;
+
+		/** 进程 CPU 占用 (所有核心的百分比) 低于该值才认为有空闲核心 */
+		double IdleCpuPercent = 85.0;
+
+		int32 EvaluationIntervalFrames = 30;
+
+		/** 类别调整后至少停留的帧数, 期间评估不再改动该类别 */
+		int32 MinDwellFrames = 60;
+
+		/** 保留的最近调整记录数 */
+		int32 MaxDecisions = 64;
+	};
+
+	/** 一次调整 */
+	struct FPriorityTunerDecision
+	{
+		FString Category;
+		LowLevelTasks::ETaskPriority From = LowLevelTasks::ETaskPriority::Normal;
+		LowLevelTasks::ETaskPriority To = LowLevelTasks::ETaskPriority::Normal;
+		EPriorityTunerReason Reason = EPriorityTunerReason::FrameOverBudget;
+
+		uint64 Frame = 0;
+		double FrameMilliseconds = 0.0;
+		double QueueLatencyMicroseconds = 0.0;
+		double CpuPercent = 0.0;
+	};
+
+	/** 当前测量值 */
+	struct FPriorityTunerSnapshot
+	{
+		uint64 Frame = 0;
+		double FrameMilliseconds = 0.0;
+		double CpuPercent = 0.0;
+
+		/** 按 ETaskPriority 索引, 未测量的优先级为 0 */
+		double QueueLatencyMicroseconds[int32(LowLevelTasks::ETaskPriority::Count)] = {};
+	};
+
+	namespace Private
+	{
+		struct FPriorityProbe;
+	}
+
+	class UNREALTEMPLATESGUIDE_API FPriorityTuner
+	{
+	public:
+		explicit FPriorityTuner(const FPriorityTunerParams& InParams = FPriorityTunerParams());
+		~FPriorityTuner();
+
+		UE_NONCOPYABLE(FPriorityTuner);
+
+		/**
+		 * 注册一个类别; CVarName 为 CVar 构造时的名字 (FTaskPriorityCVar 不公开名字)
+		 * CVar 必须比调整器活得久, 当前值须在 [HighestPriority, LowestPriority] 范围内
+		 */
+		void RegisterCategory(const TCHAR* Category, UE::Tasks::FTaskPriorityCVar& CVar, const TCHAR* CVarName,
+			const FPriorityTunerCategoryParams& CategoryParams = FPriorityTunerCategoryParams());
+
+		/** 每帧调用一次 (通常在 GameThread), FrameMilliseconds 为上一帧的时间 */
+		void Update(double FrameMilliseconds);
+
+		FPriorityTunerSnapshot GetSnapshot() const;
+		TArray<FPriorityTunerDecision> GetDecisions() const;
+
+	private:
+		struct FCategory
+		{
+			FString Name;
+			UE::Tasks::FTaskPriorityCVar* CVar = nullptr;
+			IConsoleVariable* ConsoleVariable = nullptr;
+			FPriorityTunerCategoryParams Params;
+
+			/** 最近一次生效调整的帧, 0 表示尚未调整 (Frame 从 1 开始) */
+			uint64 LastChangeFrame = 0;
+		};
+
+		void LaunchProbesLocked();
+		void EvaluateLocked();
+		void ApplyLocked(FCategory& Category, LowLevelTasks::ETaskPriority To, EPriorityTunerReason Reason, double QueueLatency);
+
+		const FPriorityTunerParams Params;
+
+		mutable FCriticalSection Mutex;
+		TArray<FCategory> Categories;
+		TArray<FPriorityTunerDecision> Decisions;
+
+		/** 探测结果由探测任务写入, 共享持有: 探测任务可能比调整器活得久 */
+		TSharedRef<Private::FPriorityProbe> Probe;
+
+		uint64 Frame = 0;
+		double FrameEma = 0.0;
+		double CpuPercent = 0.0;
+	};
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpeculativeExecution.h"
+#include "Misc/ScopeLock.h"
+
+namespace UE::TemplatesGuide
+{
+	// ============================================================================
+	// FHedgePolicy
+	// ============================================================================
+	FHedgePolicy::FHedgePolicy(const FHedgeParams& InParams)
+		: Params(InParams)
+	{
+		check(Params.Percentile > 0.0 && Params.Percentile <= 1.0);
+		check(Params.WindowSize > 0);
+
+		Samples.Reserve(Params.WindowSize);
+		CachedDelayMicroseconds.store(FMath::Max(Params.InitialDelayMicroseconds, Params.MinDelayMicroseconds), std::memory_order_relaxed);
+	}
+
+	void FHedgePolicy::RecordOutcome(double LatencyMicroseconds, int32 NumBackups, bool bBackupWon)
+	{
+		NumRequests.fetch_add(1, std::memory_order_relaxed);
+		NumBackupAttempts.fetch_add(NumBackups, std::memory_order_relaxed);
+		if (bBackupWon)
+		{
+			NumBackupWins.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		FScopeLock Lock(&Mutex);
+
+		if (Samples.Num() < Params.WindowSize)
+		{
+			Samples.Add(float(LatencyMicroseconds));
+		}
+		else
+		{
+			Samples[NextSample] = float(LatencyMicroseconds);
+			NextSample = (NextSample + 1) % Params.WindowSize;
+		}
+
+		// 排序窗口的开销按每 16 个样本摊销
+		if (Samples.Num() < Params.WarmupSamples || ++SamplesSinceUpdate < 16)
+		{
+			return;
+		}
+		SamplesSinceUpdate = 0;
+
+		TArray<float, TInlineAllocator<256>> Sorted(Samples);
+		Sorted.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Params.Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		CachedDelayMicroseconds.store(FMath::Max<double>(Sorted[Rank], Params.MinDelayMicroseconds), std::memory_order_relaxed);
+	}
+
+	FHedgeStats FHedgePolicy::GetStats() const
+	{
+		FHedgeStats Stats;
+		Stats.NumRequests = NumRequests.load(std::memory_order_relaxed);
+		Stats.NumBackupAttempts = NumBackupAttempts.load(std::memory_order_relaxed);
+		Stats.NumBackupWins = NumBackupWins.load(std::memory_order_relaxed);
+		Stats.CurrentDelayMicroseconds = GetHedgeDelayMicroseconds();
+		return Stats;
+	}
+}
@@ -0,0 +1,317 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "TaskTimer.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include <atomic>
+
+/**
+ * 基于 FCancellationToken 的推测执行: 竞速 (Race) 与对冲请求 (Hedged Request)
+ *
+ * 示例8 只演示了手动检查 Token; 这里把 "多个方案同时跑, 谁先完成用谁" 做成原语:
+ *
+ *   LaunchRace: 同时启动 N 个备选方案 (缓存查找 vs 重新计算, 多个 LOD 构建 ...)
+ *     Strategy 0 ──[.....完成]──► 胜出: 写入结果, Token.Cancel(), 触发完成事件
+ *     Strategy 1 ──[........检查 Token → 放弃]
+ *     Strategy 2 ──[...返回空 (缓存未命中) → 不参与胜出]
+ *
+ *   LaunchHedged: 先只启动一次尝试, 超过历史延迟的某个百分位 (默认 P95) 仍未完成时才启动备份
+ *     Attempt 0 ──[...................慢]      (被取消)
+ *                  └─ P95 ─► Attempt 1 ──[..完成] 胜出
+ *     正常情况下只有一次尝试, 只在尾部付出额外的工作, 用于降低流送任务的尾延迟
+ *
+ * 方案返回 TOptional<T>: 空值表示放弃 (未命中 / 看到取消), 所有方案都放弃时结果为空
+ * 结果以 TTask<TSpeculativeResult<T>> 返回, 可等待或作为先决条件; 胜出者完成即返回, 不等待落败者
+ *
+ * 方案执行时当前线程的 FCancellationTokenScope 指向共享 Token,
+ * 嵌套代码可以用 FCancellationTokenScope::IsCurrentWorkCanceled() 检查
+ */
+namespace UE::TemplatesGuide
+{
+	template<typename ResultType>
+	struct TSpeculativeResult
+	{
+		/** 胜出方案的结果, 所有方案都放弃时为空 */
+		TOptional<ResultType> Value;
+
+		/** 胜出方案 (LaunchRace) 或尝试 (LaunchHedged) 的索引, 没有胜出者时为 INDEX_NONE */
+		int32 WinnerIndex = INDEX_NONE;
+
+		bool IsSet() const { return Value.IsSet(); }
+	};
+
+	/** 竞速方案: 接收共享 Token, 返回空值表示放弃 */
+	template<typename ResultType>
+	using TSpeculativeStrategy = TUniqueFunction<TOptional<ResultType>(const UE::Tasks::FCancellationToken& Token)>;
+
+	/** 对冲尝试: 同一个函数以不同的 AttemptIndex 多次调用, 可能同时在多个线程上执行 */
+	template<typename ResultType>
+	using THedgedAttempt = TFunction<TOptional<ResultType>(const UE::Tasks::FCancellationToken& Token, int32 AttemptIndex)>;
+
+	struct FHedgeParams
+	{
+		/** 备份请求的触发点: 历史延迟的百分位 */
+		double Percentile = 0.95;
+
+		/** 包括首次尝试在内的最大尝试次数 */
+		int32 MaxAttempts = 2;
+
+		/** 样本不足 WarmupSamples 时使用的对冲延迟 */
+		double InitialDelayMicroseconds = 5000.0;
+
+		/** 对冲延迟下限, 避免延迟分布很窄时几乎每次都对冲 */
+		double MinDelayMicroseconds = 100.0;
+
+		int32 WarmupSamples = 32;
+
+		/** 保留最近多少个延迟样本 */
+		int32 WindowSize = 256;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	struct FHedgeStats
+	{
+		/** 有结果的请求数 */
+		int64 NumRequests = 0;
+
+		/** 启动的备份尝试数 (因超时或前一次尝试放弃) */
+		int64 NumBackupAttempts = 0;
+
+		/** 由备份尝试胜出的请求数 */
+		int64 NumBackupWins = 0;
+
+		double CurrentDelayMicroseconds = 0.0;
+	};
+
+	/**
+	 * 对冲策略: 记录请求延迟并给出对冲延迟
+	 *
+	 * 同一类请求共享一个策略对象; 必须比使用它的请求活得久
+	 */
+	class UNREALTEMPLATESGUIDE_API FHedgePolicy
+	{
+	public:
+		explicit FHedgePolicy(const FHedgeParams& InParams = FHedgeParams());
+
+		UE_NONCOPYABLE(FHedgePolicy);
+
+		const FHedgeParams& GetParams() const { return Params; }
+
+		/** 当前对冲延迟: 预热期间为 InitialDelayMicroseconds, 之后为窗口内延迟的 Percentile 分位数 */
+		double GetHedgeDelayMicroseconds() const { return CachedDelayMicroseconds.load(std::memory_order_relaxed); }
+
+		/**
+		 * 记录一次有结果的请求, 由 LaunchHedged 的胜出尝试调用
+		 *
+		 * @param LatencyMicroseconds  从请求启动到胜出的延迟
+		 * @param NumBackups           胜出时已启动的备份尝试数
+		 * @param bBackupWon           是否由备份尝试胜出
+		 */
+		void RecordOutcome(double LatencyMicroseconds, int32 NumBackups, bool bBackupWon);
+
+		/** 统计只包含有结果的请求 (所有尝试都放弃的请求不会回到策略对象) */
+		FHedgeStats GetStats() const;
+
+	private:
+		const FHedgeParams Params;
+
+		mutable FCriticalSection Mutex;
+		TArray<float> Samples;
+		int32 NextSample = 0;
+		int32 SamplesSinceUpdate = 0;
+
+		std::atomic<double> CachedDelayMicroseconds{0.0};
+		std::atomic<int64> NumRequests{0};
+		std::atomic<int64> NumBackupAttempts{0};
+		std::atomic<int64> NumBackupWins{0};
+	};
+
+	namespace Private
+	{
+		/** 竞速 / 对冲共享的状态: 第一个返回非空结果的方案胜出 */
+		template<typename ResultType>
+		struct TSpeculativeState
+		{
+			explicit TSpeculativeState(int32 InNumAttempts)
+				: NumAttempts(InNumAttempts)
+			{
+			}
+
+			/**
+			 * 运行一个方案, 胜出返回 true
+			 *
+			 * 胜出者在触发完成事件之前调用 OnWin; 最后一个无结果完成的方案在没有胜出者时触发完成事件
+			 */
+			template<typename FunctionType, typename OnWinType>
+			bool Run(int32 Index, FunctionType& Function, OnWinType&& OnWin)
+			{
+				TOptional<ResultType> Result;
+
+				// 排队期间已经有胜出者: 不再执行
+				if (!Token.IsCanceled())
+				{
+					UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Speculative");
+					UE::Tasks::FCancellationTokenScope TokenScope(Token);
+					Result = Function();
+				}
+
+				bool bWon = false;
+				if (Result.IsSet() && !Token.IsCanceled())
+				{
+					int32 Expected = INDEX_NONE;
+					if (WinnerIndex.compare_exchange_strong(Expected, Index, std::memory_order_acq_rel))
+					{
+						Value = MoveTemp(Result);
+						Token.Cancel();
+						OnWin();
+						bWon = true;
+					}
+				}
+
+				// 胜出者先写入 WinnerIndex 再计数, 最后一个计数者一定能看到胜出者
+				const bool bLast = NumFinished.fetch_add(1, std::memory_order_acq_rel) + 1 == NumAttempts;
+				if (bWon || (bLast && WinnerIndex.load(std::memory_order_acquire) == INDEX_NONE))
+				{
+					CompletionEvent.Trigger();
+				}
+				return bWon;
+			}
+
+			bool HasWinner() const
+			{
+				return WinnerIndex.load(std::memory_order_acquire) != INDEX_NONE;
+			}
+
+			/** 结果任务: 完成事件之后内联执行, 移出胜出结果 */
+			static UE::Tasks::TTask<TSpeculativeResult<ResultType>> LaunchResultTask(const TCHAR* DebugName, const TSharedRef<TSpeculativeState, ESPMode::ThreadSafe>& State)
+			{
+				return UE::Tasks::Launch(DebugName,
+					[State]
+					{
+						return TSpeculativeResult<ResultType>{MoveTemp(State->Value), State->WinnerIndex.load(std::memory_order_acquire)};
+					},
+					UE::Tasks::Prerequisites(State->CompletionEvent),
+					LowLevelTasks::ETaskPriority::Normal,
+					UE::Tasks::EExtendedTaskPriority::Inline);
+			}
+
+			UE::Tasks::FCancellationToken Token;
+			UE::Tasks::FTaskEvent CompletionEvent{TEXT("TemplatesGuide::SpeculativeDone")};
+			std::atomic<int32> WinnerIndex{INDEX_NONE};
+			std::atomic<int32> NumFinished{0};
+			const int32 NumAttempts;
+			TOptional<ResultType> Value;
+
+			// 对冲: 已启动的尝试数, 请求开始时确定的对冲延迟
+			std::atomic<int32> NumLaunched{0};
+			uint64 StartCycles = 0;
+			double HedgeDelayMicroseconds = 0.0;
+		};
+
+		template<typename ResultType>
+		using TSpeculativeStateRef = TSharedRef<TSpeculativeState<ResultType>, ESPMode::ThreadSafe>;
+
+		/**
+		 * 启动下一次尝试, 并在对冲延迟后安排再下一次
+		 *
+		 * Policy 只在胜出者的 OnWin 中访问 (完成事件触发之前): 调用方等到结果之后即可销毁它
+		 */
+		template<typename ResultType>
+		void TryLaunchNextAttempt(const TSpeculativeStateRef<ResultType>& State, const TSharedRef<THedgedAttempt<ResultType>, ESPMode::ThreadSafe>& Attempt,
+			FHedgePolicy* Policy, LowLevelTasks::ETaskPriority Priority)
+		{
+			// 超时与前一次尝试放弃可能同时发生, 用 CAS 保证每个索引只启动一次
+			int32 Index = State->NumLaunched.load(std::memory_order_relaxed);
+			do
+			{
+				if (Index >= State->NumAttempts || State->HasWinner())
+				{
+					return;
+				}
+			}
+			while (!State->NumLaunched.compare_exchange_weak(Index, Index + 1, std::memory_order_acq_rel));
+
+			UE::Tasks::Launch(TEXT("TemplatesGuide::HedgedAttempt"), [State, Attempt, Policy, Priority, Index]
+			{
+				auto Function = [&State, &Attempt, Index] { return (*Attempt)(State->Token, Index); };
+				const bool bWon = State->Run(Index, Function, [&State, Policy, Index]
+				{
+					Policy->RecordOutcome(
+						FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - State->StartCycles) * 1000.0,
+						State->NumLaunched.load(std::memory_order_acquire) - 1,
+						Index > 0);
+				});
+
+				// 放弃: 不等对冲延迟, 立即启动下一次尝试
+				if (!bWon)
+				{
+					TryLaunchNextAttempt(State, Attempt, Policy, Priority);
+				}
+			}, Priority);
+
+			if (Index + 1 < State->NumAttempts)
+			{
+				ScheduleAfter(State->HedgeDelayMicroseconds, [State, Attempt, Policy, Priority]
+				{
+					TryLaunchNextAttempt(State, Attempt, Policy, Priority);
+				});
+			}
+		}
+	}
+
+	/**
+	 * 同时启动所有方案, 第一个返回非空结果的方案胜出并取消其余方案
+	 *
+	 * 胜出后结果任务立即完成, 落败方案在看到取消后自行结束 (它们持有共享状态, 不需要等待)
+	 */
+	template<typename ResultType>
+	UE::Tasks::TTask<TSpeculativeResult<ResultType>> LaunchRace(const TCHAR* DebugName, TArray<TSpeculativeStrategy<ResultType>>&& Strategies,
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal)
+	{
+		check(!Strategies.IsEmpty());
+
+		using FState = Private::TSpeculativeState<ResultType>;
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>(Strategies.Num());
+
+		// 先创建结果任务, 避免方案在注册先决条件之前就已全部完成 (事件已触发也没有问题, 只是更清晰)
+		UE::Tasks::TTask<TSpeculativeResult<ResultType>> ResultTask = FState::LaunchResultTask(DebugName, State);
+
+		for (int32 Index = 0; Index < Strategies.Num(); ++Index)
+		{
+			UE::Tasks::Launch(DebugName, [State, Index, Strategy = MoveTemp(Strategies[Index])]() mutable
+			{
+				auto Function = [&Strategy, &State] { return Strategy(State->Token); };
+				State->Run(Index, Function, [] {});
+			}, Priority);
+		}
+
+		return ResultTask;
+	}
+
+	/**
+	 * 对冲请求: 先启动一次尝试, 超过 Policy 的对冲延迟仍没有结果时启动下一次, 最多 MaxAttempts 次
+	 *
+	 * 尝试返回空值 (失败) 时立即启动下一次尝试; 胜出尝试的延迟反馈给 Policy
+	 */
+	template<typename ResultType>
+	UE::Tasks::TTask<TSpeculativeResult<ResultType>> LaunchHedged(const TCHAR* DebugName, THedgedAttempt<ResultType> Attempt, FHedgePolicy& Policy)
+	{
+		check(Attempt);
+
+		using FState = Private::TSpeculativeState<ResultType>;
+		const FHedgeParams& Params = Policy.GetParams();
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>(FMath::Max(1, Params.MaxAttempts));
+		State->StartCycles = FPlatformTime::Cycles64();
+		State->HedgeDelayMicroseconds = Policy.GetHedgeDelayMicroseconds();
+
+		UE::Tasks::TTask<TSpeculativeResult<ResultType>> ResultTask = FState::LaunchResultTask(DebugName, State);
+
+		Private::TryLaunchNextAttempt<ResultType>(State, MakeShared<THedgedAttempt<ResultType>, ESPMode::ThreadSafe>(MoveTemp(Attempt)), &Policy, Params.Priority);
+
+		return ResultTask;
+	}
+}
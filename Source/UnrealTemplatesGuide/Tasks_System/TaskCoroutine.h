@@ -0,0 +1,343 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Async/Future.h"
+#include "Templates/SharedPointer.h"
+
+/**
+ * C++20 协程前端: 在 UE::Tasks 协程中 co_await 任务 / 事件 / Future
+ *
+ * 示例5 的嵌套任务与示例8 的 Wait 都有同一个问题: 在任务中阻塞等待另一个任务 (或 IO 事件)
+ * 会占住一个工作线程直到等待结束。协程在等待处挂起, 工作线程立即返回调度器,
+ * 被等待的对象完成后, 协程作为一个新任务在某个工作线程上继续执行:
+ *
+ *   阻塞:  Worker ──[A]──────── Wait(IO) 阻塞 ────────[B]──
+ *   协程:  Worker ──[A]── 挂起 ── (执行其他任务) ...
+ *                               IO 完成 ─► Launch(Resume, Prerequisites(IO)) ──[B]── (任意工作线程)
+ *
+ *   TCoTask<int32> LoadAndParse(FString Path)
+ *   {
+ *       co_await ResumeOnWorker();                    // 切换到工作线程
+ *       TArray<uint8> Bytes = co_await ReadAsync(Path);      // TFuture<TArray<uint8>>
+ *       int32 Count = co_await UE::Tasks::Launch(...);       // TTask<int32>
+ *       co_await ParseDoneEvent;                             // FTaskEvent
+ *       co_return Count;
+ *   }
+ *
+ * 可在 TCoTask 协程中 co_await:
+ *   FTask / TTask<T> / FTaskEvent    完成后作为任务恢复, TTask<T> 返回 GetResult() 的引用
+ *   TFuture<T> (右值)                完成后作为任务恢复, 返回 Consume() 的值
+ *   TCoTask<T>                       子协程完成后恢复
+ *   ResumeOnWorker(Priority)         立即挂起并在工作线程上恢复
+ *
+ * TCoTask<T> 本身是任务式句柄: IsCompleted / Wait / GetResult, GetEvent() 可用作 Prerequisites
+ *
+ * 注意:
+ *   - 协程立即开始执行 (initial_suspend 不挂起), 直到第一个挂起点都在调用者线程上
+ *   - Lambda 协程的捕获不在协程帧中, 第一次挂起后可能已销毁 -- 用参数 (按值复制进协程帧) 传递状态
+ *   - 被 co_await 的 FTaskEvent 永不触发时协程帧永不释放
+ *   - co_await TTask<T> 返回的引用在完整表达式结束后由任务保持, 任务句柄释放后失效
+ *   - 引擎默认禁用异常, 协程内的异常直接 checkNoEntry
+ */
+#ifndef UE_TEMPLATESGUIDE_WITH_COROUTINES
+	#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		#define UE_TEMPLATESGUIDE_WITH_COROUTINES 1
+	#else
+		#define UE_TEMPLATESGUIDE_WITH_COROUTINES 0
+	#endif
+#endif
+
+#if UE_TEMPLATESGUIDE_WITH_COROUTINES
+
+#include <coroutine>
+
+namespace UE::TemplatesGuide
+{
+	template<typename ResultType>
+	class TCoTask;
+
+	/** 挂起当前协程并作为新任务在工作线程上恢复 */
+	struct FResumeOnWorker
+	{
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+
+		bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> Handle) const
+		{
+			UE::Tasks::Launch(TEXT("TemplatesGuide::CoroutineResume"), [Handle] { Handle.resume(); }, Priority);
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	inline FResumeOnWorker ResumeOnWorker(LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal)
+	{
+		return FResumeOnWorker{Priority};
+	}
+
+	namespace Private
+	{
+		template<typename T>
+		struct TIsTTask : std::false_type {};
+
+		template<typename T>
+		struct TIsTTask<UE::Tasks::TTask<T>> : std::true_type {};
+
+		template<typename T>
+		struct TIsTFuture : std::false_type {};
+
+		template<typename T>
+		struct TIsTFuture<TFuture<T>> : std::true_type {};
+
+		template<typename T>
+		struct TIsCoTask : std::false_type {};
+
+		template<typename T>
+		struct TIsCoTask<TCoTask<T>> : std::true_type {};
+
+		/** Prerequisite 完成后作为任务恢复 Handle */
+		template<typename HandleType>
+		void ResumeAfter(const HandleType& Prerequisite, std::coroutine_handle<> Handle)
+		{
+			TArray<UE::Tasks::FTask, TInlineAllocator<1>> Prerequisites;
+			Prerequisites.Add(Prerequisite);
+			UE::Tasks::Launch(TEXT("TemplatesGuide::CoroutineResume"), [Handle] { Handle.resume(); }, Prerequisites);
+		}
+
+		/** FTask / TTask<T> / FTaskEvent */
+		template<typename HandleType>
+		struct TTaskAwaiter
+		{
+			HandleType Task;
+
+			bool await_ready() const { return Task.IsCompleted(); }
+
+			// 调度恢复任务后不再访问 this: 协程可能已在其他线程上恢复
+			void await_suspend(std::coroutine_handle<> Handle) const { ResumeAfter(Task, Handle); }
+
+			decltype(auto) await_resume()
+			{
+				if constexpr (TIsTTask<HandleType>::value)
+				{
+					return Task.GetResult();
+				}
+			}
+		};
+
+		template<typename ResultType>
+		struct TFutureAwaiter
+		{
+			TFuture<ResultType> Future;
+			TOptional<ResultType> Result;
+
+			bool await_ready() const { return Future.IsReady(); }
+
+			void await_suspend(std::coroutine_handle<> Handle)
+			{
+				// Then 可能在当前线程上立即执行续接, 先把 Future 移出成员
+				TFuture<ResultType> Local = MoveTemp(Future);
+				Local.Then([this, Handle](TFuture<ResultType> Completed)
+				{
+					Result.Emplace(Completed.Consume());
+					UE::Tasks::Launch(TEXT("TemplatesGuide::CoroutineResume"), [Handle] { Handle.resume(); });
+				});
+			}
+
+			ResultType await_resume()
+			{
+				return Result.IsSet() ? MoveTemp(Result.GetValue()) : Future.Consume();
+			}
+		};
+
+		template<>
+		struct TFutureAwaiter<void>
+		{
+			TFuture<void> Future;
+
+			bool await_ready() const { return Future.IsReady(); }
+
+			void await_suspend(std::coroutine_handle<> Handle)
+			{
+				TFuture<void> Local = MoveTemp(Future);
+				Local.Then([Handle](TFuture<void>)
+				{
+					UE::Tasks::Launch(TEXT("TemplatesGuide::CoroutineResume"), [Handle] { Handle.resume(); });
+				});
+			}
+
+			void await_resume() {}
+		};
+
+		template<typename ResultType>
+		struct TCoTaskState
+		{
+			UE::Tasks::FTaskEvent CompletionEvent{TEXT("TemplatesGuide::CoTask")};
+			TOptional<ResultType> Result;
+		};
+
+		template<>
+		struct TCoTaskState<void>
+		{
+			UE::Tasks::FTaskEvent CompletionEvent{TEXT("TemplatesGuide::CoTask")};
+		};
+
+		template<typename ResultType>
+		using TCoTaskStateRef = TSharedRef<TCoTaskState<ResultType>, ESPMode::ThreadSafe>;
+
+		/** TCoTask<T> 的等待: 等完成事件, 返回子协程结果的引用 */
+		template<typename ResultType>
+		struct TCoTaskAwaiter
+		{
+			TCoTaskStateRef<ResultType> State;
+
+			bool await_ready() const { return State->CompletionEvent.IsCompleted(); }
+
+			void await_suspend(std::coroutine_handle<> Handle) const { ResumeAfter(State->CompletionEvent, Handle); }
+
+			decltype(auto) await_resume() const
+			{
+				if constexpr (!std::is_void_v<ResultType>)
+				{
+					return (State->Result.GetValue());
+				}
+			}
+		};
+
+		class FCoTaskPromiseBase
+		{
+		public:
+			std::suspend_never initial_suspend() noexcept { return {}; }
+
+			void unhandled_exception() { checkNoEntry(); }
+
+			/** 把 UE 的任务 / Future 句柄转换为等待器, 其他可等待对象原样通过 */
+			template<typename AwaitableType>
+			decltype(auto) await_transform(AwaitableType&& Awaitable)
+			{
+				using FDecayed = std::decay_t<AwaitableType>;
+
+				// FTask / TTask<T> / FTaskEvent 都派生自公开的 UE::Tasks::FTask
+				if constexpr (std::is_base_of_v<UE::Tasks::FTask, FDecayed>)
+				{
+					return TTaskAwaiter<FDecayed>{Awaitable};
+				}
+				else if constexpr (TIsTFuture<FDecayed>::value)
+				{
+					static_assert(!std::is_lvalue_reference_v<AwaitableType>, "co_await takes ownership of a TFuture, use co_await MoveTemp(Future)");
+					return MakeFutureAwaiter(MoveTemp(Awaitable));
+				}
+				else if constexpr (TIsCoTask<FDecayed>::value)
+				{
+					return Awaitable.MakeAwaiter();
+				}
+				else
+				{
+					return Forward<AwaitableType>(Awaitable);
+				}
+			}
+
+		private:
+			template<typename ResultType>
+			static TFutureAwaiter<ResultType> MakeFutureAwaiter(TFuture<ResultType>&& Future)
+			{
+				return TFutureAwaiter<ResultType>{MoveTemp(Future)};
+			}
+		};
+
+		template<typename ResultType>
+		class TCoTaskPromise : public FCoTaskPromiseBase
+		{
+		public:
+			TCoTask<ResultType> get_return_object() { return TCoTask<ResultType>(State); }
+
+			template<typename ValueType>
+			void return_value(ValueType&& Value)
+			{
+				State->Result.Emplace(Forward<ValueType>(Value));
+			}
+
+			// 局部变量此时已经析构, 协程帧随后释放; 结果由共享状态保持
+			std::suspend_never final_suspend() noexcept
+			{
+				State->CompletionEvent.Trigger();
+				return {};
+			}
+
+		private:
+			TCoTaskStateRef<ResultType> State = MakeShared<TCoTaskState<ResultType>, ESPMode::ThreadSafe>();
+		};
+
+		template<>
+		class TCoTaskPromise<void> : public FCoTaskPromiseBase
+		{
+		public:
+			TCoTask<void> get_return_object();
+
+			void return_void() {}
+
+			std::suspend_never final_suspend() noexcept
+			{
+				State->CompletionEvent.Trigger();
+				return {};
+			}
+
+		private:
+			TCoTaskStateRef<void> State = MakeShared<TCoTaskState<void>, ESPMode::ThreadSafe>();
+		};
+	}
+
+	/**
+	 * 协程任务句柄
+	 *
+	 * 协程帧在协程结束时自动释放, 句柄只持有结果与完成事件, 可以复制
+	 */
+	template<typename ResultType>
+	class TCoTask
+	{
+	public:
+		using promise_type = Private::TCoTaskPromise<ResultType>;
+
+		bool IsCompleted() const { return State->CompletionEvent.IsCompleted(); }
+
+		/** 阻塞等待: 与 FTask::Wait 相同, 在工作线程上调用会占住该线程 */
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue()) const { return State->CompletionEvent.Wait(Timeout); }
+
+		/** 等待并返回结果 (void 版本只等待) */
+		decltype(auto) GetResult()
+		{
+			State->CompletionEvent.Wait();
+			if constexpr (!std::is_void_v<ResultType>)
+			{
+				return (State->Result.GetValue());
+			}
+		}
+
+		/** 完成事件, 可用作 UE::Tasks::Prerequisites */
+		UE::Tasks::FTaskEvent GetEvent() const { return State->CompletionEvent; }
+
+		Private::TCoTaskAwaiter<ResultType> MakeAwaiter() const { return {State}; }
+
+	private:
+		friend promise_type;
+
+		explicit TCoTask(Private::TCoTaskStateRef<ResultType> InState)
+			: State(MoveTemp(InState))
+		{
+		}
+
+		Private::TCoTaskStateRef<ResultType> State;
+	};
+
+	using FCoTask = TCoTask<void>;
+
+	inline TCoTask<void> Private::TCoTaskPromise<void>::get_return_object()
+	{
+		return TCoTask<void>(State);
+	}
+}
+
+#endif // UE_TEMPLATESGUIDE_WITH_COROUTINES
@@ -0,0 +1,389 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+#include <atomic>
+
+/**
+ * 有界无锁 MPSC 环形队列 + Actor 风格邮箱
+ *
+ * 示例14 用 FPipe 实现 "Primitive Actor": 每次方法调用都 Pipe.Launch 一个新任务
+ * 对于高频的小消息, 每条消息的任务分配与调度开销远大于消息本身
+ *
+ * TTaskMailbox 的做法:
+ *   - 消息写入有界环形队列 (Vyukov 算法, 多生产者 CAS 领取槽位, 单消费者无需原子 RMW)
+ *   - 一个 "排空任务" 在一次调度中连续处理多条消息
+ *   - 只有待处理计数从 0 变为 1 时才启动排空任务 (重新武装), 繁忙时生产者不产生任何任务
+ *
+ *   Producer 0 ─┐                        ┌────────────── Drain Task ──────────────┐
+ *   Producer 1 ─┼─ TryEmplace ─► [Ring] ─┤ Handler(Cmd) × N, 直到队列为空或达到上限 │
+ *   Producer N ─┘      │                 └────────────────────────────────────────┘
+ *                      └─ Pending.fetch_add(1) == 0 ? Launch(Drain) : 无需调度
+ *
+ * 消息处理保证与 FPipe 相同: 同一邮箱的消息串行处理, 同一生产者的消息按 FIFO 处理
+ */
+namespace UE::TemplatesGuide
+{
+	/**
+	 * 有界多生产者单消费者环形队列 (Dmitry Vyukov 的有界队列, 消费端简化为单线程)
+	 *
+	 * 每个槽位带一个序号:
+	 *   Sequence == Pos         槽位空闲, 生产者可以写入 Pos
+	 *   Sequence == Pos + 1     数据已发布, 消费者可以读取 Pos
+	 *   Sequence == Pos + Cap   消费者已读取, 槽位可用于下一圈
+	 */
+	template<typename T>
+	class TMpscRingQueue
+	{
+	public:
+		/** 容量向上取整为 2 的幂 */
+		explicit TMpscRingQueue(uint32 InCapacity)
+			: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u)))
+			, Mask(Capacity - 1)
+		{
+			Cells = static_cast<FCell*>(FMemory::Malloc(sizeof(FCell) * Capacity, alignof(FCell)));
+			for (uint32 Index = 0; Index < Capacity; ++Index)
+			{
+				new (&Cells[Index]) FCell();
+				Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+			}
+		}
+
+		~TMpscRingQueue()
+		{
+			while (TryConsume([](T&) {}))
+			{
+			}
+
+			for (uint32 Index = 0; Index < Capacity; ++Index)
+			{
+				Cells[Index].~FCell();
+			}
+			FMemory::Free(Cells);
+		}
+
+		UE_NONCOPYABLE(TMpscRingQueue);
+
+		/** 多生产者: 原地构造一个元素, 队列已满时返回 false */
+		template<typename... ArgTypes>
+		bool TryEmplace(ArgTypes&&... Args)
+		{
+			uint32 Pos = EnqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				FCell& Cell = Cells[Pos & Mask];
+				const uint32 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+				const int32 Diff = static_cast<int32>(Sequence - Pos);
+
+				if (Diff == 0)
+				{
+					// 槽位空闲, 竞争领取; 失败时 Pos 被更新为最新值
+					if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+					{
+						new (Cell.Storage.GetTypedPtr()) T(Forward<ArgTypes>(Args)...);
+						Cell.Sequence.store(Pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (Diff < 0)
+				{
+					// 消费者还没读取上一圈的数据: 队列已满
+					return false;
+				}
+				else
+				{
+					Pos = EnqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * 单消费者: 对队首元素原地调用 Consumer(T&) 后出队
+		 *
+		 * 队列为空, 或队首槽位已被生产者领取但尚未发布时返回 false
+		 */
+		template<typename ConsumerType>
+		bool TryConsume(ConsumerType&& Consumer)
+		{
+			FCell& Cell = Cells[DequeuePos & Mask];
+			const uint32 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+			if (static_cast<int32>(Sequence - (DequeuePos + 1)) < 0)
+			{
+				return false;
+			}
+
+			T* Item = Cell.Storage.GetTypedPtr();
+			Invoke(Consumer, *Item);
+			DestructItem(Item);
+
+			Cell.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+			++DequeuePos;
+			return true;
+		}
+
+		/** 单消费者: 出队并移动到 OutItem */
+		bool TryPop(T& OutItem)
+		{
+			return TryConsume([&OutItem](T& Item) { OutItem = MoveTemp(Item); });
+		}
+
+		uint32 GetCapacity() const
+		{
+			return Capacity;
+		}
+
+	private:
+		struct FCell
+		{
+			std::atomic<uint32> Sequence;
+			TTypeCompatibleBytes<T> Storage;
+		};
+
+		FCell* Cells = nullptr;
+		const uint32 Capacity;
+		const uint32 Mask;
+
+		// 生产者与消费者的位置放在不同缓存行, 避免伪共享
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> EnqueuePos{0};
+		alignas(PLATFORM_CACHE_LINE_SIZE) uint32 DequeuePos = 0;
+	};
+
+	/** TTaskMailbox 统计 */
+	struct FTaskMailboxStats
+	{
+		/** 已处理的消息数 */
+		int64 NumCommands = 0;
+
+		/** 启动过的排空任务数 (重新武装次数 + 达到单次上限后的续接) */
+		int64 NumDrains = 0;
+	};
+
+	/**
+	 * Actor 风格邮箱: 任意线程 Post, 消息在排空任务中串行交给 Handler 处理
+	 *
+	 * 用法 (与示例14 的 FAsyncCounter 形状相同):
+	 *   class FMailboxCounter
+	 *   {
+	 *   public:
+	 *       void Add(int32 Value) { Mailbox.Post(Value); }
+	 *       void WaitForEmpty() { Mailbox.WaitForEmpty(); }
+	 *   private:
+	 *       int32 Counter = 0;
+	 *       TTaskMailbox<int32> Mailbox{ TEXT("Counter"), [this](int32& Value) { Counter += Value; } };
+	 *   };
+	 *
+	 * 注意:
+	 *   - Handler 引用的状态必须在邮箱之前声明 (后析构), 邮箱析构时会等待排空
+	 *   - 队列满时 Post 会让出 CPU 等待排空任务腾出空间; 不要在 Handler 内对同一个邮箱 Post 超过容量的消息
+	 */
+	template<typename CommandType>
+	class TTaskMailbox
+	{
+	public:
+		using FHandler = TUniqueFunction<void(CommandType&)>;
+
+		/**
+		 * @param InDebugName          排空任务的调试名
+		 * @param InHandler            消息处理函数, 同一时刻只在一个线程上调用
+		 * @param Capacity             环形队列容量 (向上取整为 2 的幂)
+		 * @param InPriority           排空任务优先级
+		 * @param InExtendedPriority   排空任务扩展优先级 (可用于在命名线程上排空)
+		 */
+		TTaskMailbox(const TCHAR* InDebugName, FHandler&& InHandler, uint32 Capacity = 1024,
+			LowLevelTasks::ETaskPriority InPriority = LowLevelTasks::ETaskPriority::Normal,
+			UE::Tasks::EExtendedTaskPriority InExtendedPriority = UE::Tasks::EExtendedTaskPriority::None)
+			: DebugName(InDebugName)
+			, Handler(MoveTemp(InHandler))
+			, Queue(Capacity)
+			, Priority(InPriority)
+			, ExtendedPriority(InExtendedPriority)
+		{
+		}
+
+		~TTaskMailbox()
+		{
+			WaitForEmpty();
+		}
+
+		UE_NONCOPYABLE(TTaskMailbox);
+
+		/** 投递一条消息, 队列已满时返回 false (消息未投递) */
+		template<typename... ArgTypes>
+		bool TryPost(ArgTypes&&... Args)
+		{
+			// 先计数再入队: 计数 > 0 时必然有一个排空任务在运行或即将启动
+			const int32 PrevPending = Pending.fetch_add(1, std::memory_order_acq_rel);
+
+			if (!Queue.TryEmplace(Forward<ArgTypes>(Args)...))
+			{
+				// 计数之前不为 0, 说明排空任务仍在运行, 撤销计数即可
+				check(PrevPending > 0);
+				Pending.fetch_sub(1, std::memory_order_acq_rel);
+				return false;
+			}
+
+			if (PrevPending == 0)
+			{
+				Arm();
+			}
+			return true;
+		}
+
+		/** 投递一条消息, 队列已满时等待排空任务腾出空间 */
+		template<typename... ArgTypes>
+		void Post(ArgTypes&&... Args)
+		{
+			// TryEmplace 只在领取到槽位后才移动参数, 失败的尝试不会消耗 Command
+			CommandType Command(Forward<ArgTypes>(Args)...);
+			while (!TryPost(MoveTemp(Command)))
+			{
+				checkf(GetDrainingMailbox() != this, TEXT("TTaskMailbox '%s' is full and Post was called from its own handler"), DebugName);
+				FPlatformProcess::Yield();
+			}
+		}
+
+		/** 等待所有已投递的消息处理完毕 (不能在 Handler 内调用) */
+		void WaitForEmpty()
+		{
+			check(GetDrainingMailbox() != this);
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+
+			while (Pending.load(std::memory_order_acquire) != 0)
+			{
+				UE::Tasks::FTask Task;
+				{
+					FScopeLock Lock(&DrainTaskLock);
+					Task = DrainTask;
+				}
+
+				// 句柄总是最近一次启动的排空任务 (启动与保存在同一个锁内);
+				// 已完成说明生产者刚把计数从 0 变为 1 而尚未武装, 让出 CPU 后重新读取
+				if (Task.IsValid() && !Task.IsCompleted())
+				{
+					// Wait 会尝试撤回排空任务在当前线程执行 (命名线程上的排空也由此推进)
+					Task.Wait();
+				}
+				else
+				{
+					FPlatformProcess::Yield();
+				}
+			}
+		}
+
+		bool IsEmpty() const
+		{
+			return Pending.load(std::memory_order_acquire) == 0;
+		}
+
+		/** 已投递但尚未处理完的消息数 */
+		int32 GetNumPending() const
+		{
+			return Pending.load(std::memory_order_relaxed);
+		}
+
+		/** 单个排空任务最多连续处理的消息数, 达到后续接一个新任务, 避免长期占用一个工作线程 */
+		void SetMaxCommandsPerDrain(int32 InMaxCommandsPerDrain)
+		{
+			MaxCommandsPerDrain = FMath::Max(1, InMaxCommandsPerDrain);
+		}
+
+		FTaskMailboxStats GetStats() const
+		{
+			FTaskMailboxStats Stats;
+			Stats.NumCommands = NumCommands.load(std::memory_order_relaxed);
+			Stats.NumDrains = NumDrains.load(std::memory_order_relaxed);
+			return Stats;
+		}
+
+	private:
+		/** 当前线程正在排空的邮箱, 用于检测 Handler 内的非法等待 */
+		static const void*& GetDrainingMailbox()
+		{
+			static thread_local const void* DrainingMailbox = nullptr;
+			return DrainingMailbox;
+		}
+
+		void Arm()
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Launch");
+			UE_TEMPLATESGUIDE_SCOPE_CYCLE_COUNTER(TaskLaunch);
+			UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+			NumDrains.fetch_add(1, std::memory_order_relaxed);
+
+			// 启动与保存在同一个锁内, WaitForEmpty 读到的句柄不会比正在运行的排空任务更旧
+			FScopeLock Lock(&DrainTaskLock);
+			const uint32 Generation = ++DrainGeneration;
+
+			UE::Tasks::FTask Task = UE::Tasks::Launch(DebugName, [this] { Drain(); }, Priority, ExtendedPriority);
+
+			// Inline 扩展优先级下 Drain 在 Launch 内执行, 可能已递归武装了更新的任务 (FCriticalSection 可重入)
+			if (Generation == DrainGeneration)
+			{
+				DrainTask = MoveTemp(Task);
+			}
+		}
+
+		void Drain()
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::MailboxDrain");
+			const void* PrevDrainingMailbox = GetDrainingMailbox();
+			GetDrainingMailbox() = this;
+
+			int32 Processed = 0;
+			int32 ProcessedInTask = 0;
+			for (;;)
+			{
+				if (ProcessedInTask < MaxCommandsPerDrain && Queue.TryConsume(Handler))
+				{
+					++Processed;
+					++ProcessedInTask;
+					continue;
+				}
+
+				NumCommands.fetch_add(Processed, std::memory_order_relaxed);
+				const int32 Remaining = Pending.fetch_sub(Processed, std::memory_order_acq_rel) - Processed;
+				Processed = 0;
+
+				if (Remaining == 0)
+				{
+					// 之后的 Post 会重新武装; 此后不能再访问成员 (邮箱可能已被销毁)
+					break;
+				}
+
+				if (ProcessedInTask >= MaxCommandsPerDrain)
+				{
+					// 仍有消息: 计数 > 0, 生产者不会启动新任务, 由当前任务续接
+					Arm();
+					break;
+				}
+
+				// 有生产者已计数但尚未发布数据, 稍后重试
+				FPlatformProcess::Yield();
+			}
+
+			GetDrainingMailbox() = PrevDrainingMailbox;
+		}
+
+		const TCHAR* DebugName;
+		FHandler Handler;
+		TMpscRingQueue<CommandType> Queue;
+		LowLevelTasks::ETaskPriority Priority;
+		UE::Tasks::EExtendedTaskPriority ExtendedPriority;
+		int32 MaxCommandsPerDrain = 4096;
+
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int32> Pending{0};
+
+		std::atomic<int64> NumCommands{0};
+		std::atomic<int64> NumDrains{0};
+
+		FCriticalSection DrainTaskLock;
+		UE::Tasks::FTask DrainTask;
+		uint32 DrainGeneration = 0;
+	};
+}
@@ -0,0 +1,300 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TaskPipeline.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Profiling/TemplatesGuideStats.h"
+
+namespace UE::TemplatesGuide
+{
+	struct FTaskPipeline::FStage
+	{
+		FString Name;
+		FPipelineStageParams Params;
+		FStageBody Body;
+
+		TUniquePtr<UE::Tasks::FPipe> Pipe;
+		TUniquePtr<UE::Tasks::FTaskConcurrencyLimiter> Limiter;
+
+		// 以下成员受流水线的 Mutex 保护
+		TQueue<FItemPtr> Queue;
+		int32 NumQueued = 0;
+		int32 NumRunning = 0;
+		bool bStalled = false;
+
+		int64 NumProcessed = 0;
+		int32 PeakQueueDepth = 0;
+		int64 NumBackpressureStalls = 0;
+		uint64 QueueWaitCycles = 0;
+		uint64 BusyCycles = 0;
+
+		int32 GetMaxRunning() const
+		{
+			return Params.Mode == EPipelineStageMode::Serial ? Params.MaxInFlight : int32(Params.MaxConcurrency);
+		}
+	};
+
+	FTaskPipeline::FTaskPipeline(const TCHAR* InDebugName)
+		: DebugName(InDebugName)
+	{
+		StatsStartCycles = FPlatformTime::Cycles64();
+		CompletionEvent->Trigger();
+	}
+
+	FTaskPipeline::~FTaskPipeline()
+	{
+		Wait();
+
+		// 最后一个条目的任务解锁之后还在 FPipe / 限制器内部收尾, 先等它们退出再销毁
+		for (const TUniquePtr<FStage>& Stage : Stages)
+		{
+			if (Stage->Pipe)
+			{
+				Stage->Pipe->WaitUntilEmpty();
+			}
+			if (Stage->Limiter)
+			{
+				Stage->Limiter->Wait();
+			}
+		}
+	}
+
+	void FTaskPipeline::AddStage(const TCHAR* Name, FStageBody&& Body, const FPipelineStageParams& Params)
+	{
+		FScopeLock Lock(&Mutex);
+		checkf(!bStarted, TEXT("%s: all stages must be added before the first Submit"), *DebugName);
+		check(Params.QueueCapacity > 0);
+
+		TUniquePtr<FStage> Stage = MakeUnique<FStage>();
+		Stage->Name = Name;
+		Stage->Params = Params;
+		Stage->Body = MoveTemp(Body);
+
+		if (Params.Mode == EPipelineStageMode::Serial)
+		{
+			check(Params.MaxInFlight > 0);
+			Stage->Pipe = MakeUnique<UE::Tasks::FPipe>(*Stage->Name);
+		}
+		else
+		{
+			check(Params.MaxConcurrency > 0);
+			Stage->Limiter = MakeUnique<UE::Tasks::FTaskConcurrencyLimiter>(Params.MaxConcurrency, Params.Priority);
+		}
+
+		Stages.Add(MoveTemp(Stage));
+	}
+
+	bool FTaskPipeline::TrySubmit(FItemPtr& Item)
+	{
+		FScopeLock Lock(&Mutex);
+		return TrySubmitLocked(Item);
+	}
+
+	void FTaskPipeline::Submit(FItemPtr&& Item)
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&Mutex);
+				if (TrySubmitLocked(Item))
+				{
+					return;
+				}
+			}
+
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::PipelineBackpressure");
+			SpaceEvent->Wait();
+		}
+	}
+
+	bool FTaskPipeline::TrySubmitLocked(FItemPtr& Item)
+	{
+		checkf(!Stages.IsEmpty(), TEXT("%s: Submit without stages"), *DebugName);
+		check(Item.IsValid());
+		bStarted = true;
+
+		FStage& First = *Stages[0];
+		if (First.NumQueued >= First.Params.QueueCapacity)
+		{
+			return false;
+		}
+
+		Item->EnqueueCycles = FPlatformTime::Cycles64();
+		First.Queue.Enqueue(MoveTemp(Item));
+		First.PeakQueueDepth = FMath::Max(First.PeakQueueDepth, ++First.NumQueued);
+
+		if (NumOutstanding++ == 0)
+		{
+			CompletionEvent->Reset();
+		}
+
+		DispatchLocked();
+		return true;
+	}
+
+	bool FTaskPipeline::Wait(FTimespan Timeout)
+	{
+		UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::Wait");
+
+		if (!CompletionEvent->Wait(Timeout))
+		{
+			return false;
+		}
+
+		// 与最后一个条目的解锁同步
+		FScopeLock Lock(&Mutex);
+		return true;
+	}
+
+	void FTaskPipeline::DispatchLocked()
+	{
+		// 从下游往上游: 下游启动条目腾出队列空间后, 同一轮内上游就能继续启动
+		bool bProgress = true;
+		while (bProgress)
+		{
+			bProgress = false;
+			for (int32 StageIndex = Stages.Num() - 1; StageIndex >= 0; --StageIndex)
+			{
+				while (TryDispatchOneLocked(StageIndex))
+				{
+					bProgress = true;
+				}
+			}
+		}
+
+		if (Stages[0]->NumQueued < Stages[0]->Params.QueueCapacity)
+		{
+			SpaceEvent->Trigger();
+		}
+	}
+
+	bool FTaskPipeline::TryDispatchOneLocked(int32 StageIndex)
+	{
+		FStage& Stage = *Stages[StageIndex];
+		if (Stage.NumQueued == 0 || Stage.NumRunning >= Stage.GetMaxRunning())
+		{
+			return false;
+		}
+
+		// 背压: 执行中的条目完成后都要放得进下游队列
+		if (Stages.IsValidIndex(StageIndex + 1))
+		{
+			const FStage& Next = *Stages[StageIndex + 1];
+			if (Next.NumQueued + Stage.NumRunning >= Next.Params.QueueCapacity)
+			{
+				if (!Stage.bStalled)
+				{
+					Stage.bStalled = true;
+					++Stage.NumBackpressureStalls;
+				}
+				return false;
+			}
+		}
+		Stage.bStalled = false;
+
+		FItemPtr Item;
+		verify(Stage.Queue.Dequeue(Item));
+		--Stage.NumQueued;
+		++Stage.NumRunning;
+		Stage.QueueWaitCycles += FPlatformTime::Cycles64() - Item->EnqueueCycles;
+
+		// 在锁内启动: 串行阶段的 FPipe 按启动顺序执行, 锁外启动可能让两个线程的启动交错
+		if (Stage.Pipe)
+		{
+			UE_TEMPLATESGUIDE_INC_COUNTER(TasksLaunched, 1);
+			Stage.Pipe->Launch(*Stage.Name,
+				[this, StageIndex, Item = MoveTemp(Item)]() mutable { RunItem(StageIndex, MoveTemp(Item)); },
+				Stage.Params.Priority);
+		}
+		else
+		{
+			Stage.Limiter->Push(*Stage.Name,
+				[this, StageIndex, Item = MoveTemp(Item)](uint32) mutable { RunItem(StageIndex, MoveTemp(Item)); });
+		}
+		return true;
+	}
+
+	void FTaskPipeline::RunItem(int32 StageIndex, FItemPtr&& Item)
+	{
+		FStage& Stage = *Stages[StageIndex];
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		{
+			UE_TEMPLATESGUIDE_TRACE_SCOPE("TemplatesGuide::PipelineStage");
+			Stage.Body(*Item);
+		}
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+
+		FScopeLock Lock(&Mutex);
+
+		--Stage.NumRunning;
+		++Stage.NumProcessed;
+		Stage.BusyCycles += EndCycles - StartCycles;
+
+		if (Stages.IsValidIndex(StageIndex + 1))
+		{
+			FStage& Next = *Stages[StageIndex + 1];
+			Item->EnqueueCycles = EndCycles;
+			Next.Queue.Enqueue(MoveTemp(Item));
+			Next.PeakQueueDepth = FMath::Max(Next.PeakQueueDepth, ++Next.NumQueued);
+			check(Next.NumQueued <= Next.Params.QueueCapacity);
+		}
+		else
+		{
+			Item.Reset();
+			if (--NumOutstanding == 0)
+			{
+				// 解锁后不再访问成员: Wait 返回后流水线可能已被销毁
+				CompletionEvent->Trigger();
+				return;
+			}
+		}
+
+		DispatchLocked();
+	}
+
+	TArray<FPipelineStageStats> FTaskPipeline::GetStats() const
+	{
+		FScopeLock Lock(&Mutex);
+
+		const double ElapsedSeconds = FMath::Max(1e-9, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StatsStartCycles));
+
+		TArray<FPipelineStageStats> Result;
+		Result.Reserve(Stages.Num());
+		for (const TUniquePtr<FStage>& Stage : Stages)
+		{
+			FPipelineStageStats& Stats = Result.AddDefaulted_GetRef();
+			Stats.Name = Stage->Name;
+			Stats.Mode = Stage->Params.Mode;
+			Stats.NumProcessed = Stage->NumProcessed;
+			Stats.QueueDepth = Stage->NumQueued;
+			Stats.PeakQueueDepth = Stage->PeakQueueDepth;
+			Stats.NumRunning = Stage->NumRunning;
+			Stats.NumBackpressureStalls = Stage->NumBackpressureStalls;
+			Stats.BusyMicroseconds = FPlatformTime::ToMilliseconds64(Stage->BusyCycles) * 1000.0;
+			Stats.ThroughputPerSecond = Stage->NumProcessed / ElapsedSeconds;
+
+			// 排队时间在出队时累计, 按已启动的条目数 (已处理 + 执行中) 平均
+			const int64 NumStarted = Stage->NumProcessed + Stage->NumRunning;
+			Stats.MeanQueueWaitMicroseconds = NumStarted > 0
+				? FPlatformTime::ToMilliseconds64(Stage->QueueWaitCycles) * 1000.0 / NumStarted
+				: 0.0;
+		}
+		return Result;
+	}
+
+	void FTaskPipeline::ResetStats()
+	{
+		FScopeLock Lock(&Mutex);
+
+		for (const TUniquePtr<FStage>& Stage : Stages)
+		{
+			Stage->NumProcessed = 0;
+			Stage->PeakQueueDepth = Stage->NumQueued;
+			Stage->NumBackpressureStalls = 0;
+			Stage->QueueWaitCycles = 0;
+			Stage->BusyCycles = 0;
+		}
+		StatsStartCycles = FPlatformTime::Cycles64();
+	}
+}
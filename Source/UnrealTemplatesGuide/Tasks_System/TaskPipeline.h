@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/TaskConcurrencyLimiter.h"
+
+/**
+ * 多阶段流式流水线: read → decompress → parse → upload
+ *
+ * 示例6 / 示例19 的 FPipe 只串行化一个阶段; 流式处理需要多个阶段同时工作 (不同条目处于不同阶段),
+ * 而每个阶段内部保持顺序或限制并发, 阶段之间的队列有上限, 下游跟不上时上游停下 (背压)
+ *
+ *   Submit ─► [Q0 ≤ Cap] ─► Stage0 (FPipe, 串行) ─► [Q1 ≤ Cap] ─► Stage1 (FTaskConcurrencyLimiter, 并行 N)
+ *                                                                     ─► [Q2 ≤ Cap] ─► Stage2 ...
+ *
+ *   Serial    阶段的任务启动在该阶段的 FPipe 上, 按到达顺序执行, 最多 MaxInFlight 个已启动
+ *   Parallel  阶段的任务推入 FTaskConcurrencyLimiter, 最多 MaxConcurrency 个同时执行
+ *   背压      阶段 k 只有在 "下游队列深度 + 自身执行中的条目" 小于下游容量时才启动新条目,
+ *             保证执行完成的条目一定放得进下游队列; 执行中的任务从不阻塞等待队列空间
+ *   Submit    第一个队列满时阻塞调用线程 (TrySubmit 不阻塞, 返回 false)
+ *
+ * 顺序: 串行阶段按到达顺序处理; 并行阶段之后的条目顺序取决于完成顺序,
+ * 需要端到端保持提交顺序时, 并行阶段之后只放不关心顺序的阶段
+ *
+ * 条目在阶段之间移动 (不复制), TTaskPipeline<T> 的每个阶段以 T& 就地处理同一个条目
+ * GetStats 返回每个阶段的吞吐量、队列深度 (当前 / 峰值)、排队时间与背压次数
+ */
+namespace UE::TemplatesGuide
+{
+	enum class EPipelineStageMode : uint8
+	{
+		/** 由 FPipe 串行执行, 保持到达顺序 */
+		Serial,
+
+		/** 由 FTaskConcurrencyLimiter 并行执行 */
+		Parallel,
+	};
+
+	struct FPipelineStageParams
+	{
+		EPipelineStageMode Mode = EPipelineStageMode::Serial;
+
+		/** Parallel: 同时执行的条目数 */
+		uint32 MaxConcurrency = 4;
+
+		/** Serial: 已启动到 FPipe 上的条目数, 大于 1 时条目之间不必回到流水线的锁 */
+		int32 MaxInFlight = 2;
+
+		/** 阶段输入队列的容量 */
+		int32 QueueCapacity = 16;
+
+		LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal;
+	};
+
+	struct FPipelineStageStats
+	{
+		FString Name;
+		EPipelineStageMode Mode = EPipelineStageMode::Serial;
+
+		int64 NumProcessed = 0;
+		int32 QueueDepth = 0;
+		int32 PeakQueueDepth = 0;
+		int32 NumRunning = 0;
+
+		/** 因下游队列满而停止启动新条目的次数 */
+		int64 NumBackpressureStalls = 0;
+
+		double MeanQueueWaitMicroseconds = 0.0;
+		double BusyMicroseconds = 0.0;
+
+		/** 统计周期内每秒处理的条目数 */
+		double ThroughputPerSecond = 0.0;
+	};
+
+	namespace Private
+	{
+		struct FPipelineItem
+		{
+			virtual ~FPipelineItem() = default;
+
+			/** 进入当前阶段队列的时间 */
+			uint64 EnqueueCycles = 0;
+		};
+
+		template<typename ItemType>
+		struct TPipelineItem : FPipelineItem
+		{
+			explicit TPipelineItem(ItemType&& InValue)
+				: Value(MoveTemp(InValue))
+			{
+			}
+
+			ItemType Value;
+		};
+	}
+
+	/** 条目类型擦除后的流水线, 一般通过 TTaskPipeline<T> 使用 */
+	class UNREALTEMPLATESGUIDE_API FTaskPipeline
+	{
+	public:
+		using FItemPtr = TUniquePtr<Private::FPipelineItem>;
+		using FStageBody = TUniqueFunction<void(Private::FPipelineItem&)>;
+
+		explicit FTaskPipeline(const TCHAR* InDebugName);
+
+		/** 等待所有已提交条目处理完 */
+		~FTaskPipeline();
+
+		UE_NONCOPYABLE(FTaskPipeline);
+
+		/** 追加一个阶段; 必须在第一次提交之前完成全部阶段的添加 */
+		void AddStage(const TCHAR* Name, FStageBody&& Body, const FPipelineStageParams& Params = FPipelineStageParams());
+
+		/** 第一个队列满时返回 false, Item 保持不变 */
+		bool TrySubmit(FItemPtr& Item);
+
+		/** 第一个队列满时阻塞调用线程, 不要在流水线自身的阶段任务中调用 */
+		void Submit(FItemPtr&& Item);
+
+		/** 等待所有已提交条目处理完 */
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue());
+
+		TArray<FPipelineStageStats> GetStats() const;
+		void ResetStats();
+
+		int32 GetNumStages() const { return Stages.Num(); }
+
+	private:
+		struct FStage;
+
+		bool TrySubmitLocked(FItemPtr& Item);
+
+		/** 从后往前尝试启动所有可以启动的条目 (在锁内启动, 保证串行阶段的启动顺序) */
+		void DispatchLocked();
+		bool TryDispatchOneLocked(int32 StageIndex);
+
+		void RunItem(int32 StageIndex, FItemPtr&& Item);
+
+		const FString DebugName;
+		TArray<TUniquePtr<FStage>> Stages;
+
+		mutable FCriticalSection Mutex;
+		int64 NumOutstanding = 0;
+		bool bStarted = false;
+		FEventRef CompletionEvent{EEventMode::ManualReset};
+		FEventRef SpaceEvent{EEventMode::AutoReset};
+		uint64 StatsStartCycles = 0;
+	};
+
+	/**
+	 * 类型化的流水线: 每个阶段以 ItemType& 就地处理条目
+	 *
+	 *   TTaskPipeline<FIngestItem> Pipeline(TEXT("Ingest"));
+	 *   Pipeline.AddStage(TEXT("Read"), [](FIngestItem& Item) { Item.Compressed = Read(Item.Path); });
+	 *   Pipeline.AddStage(TEXT("Decompress"), [](FIngestItem& Item) { ... }, ParallelParams);
+	 *   Pipeline.AddStage(TEXT("Upload"), [](FIngestItem& Item) { ... });
+	 *   for (...) { Pipeline.Submit(FIngestItem{Path}); }
+	 *   Pipeline.Wait();
+	 */
+	template<typename ItemType>
+	class TTaskPipeline
+	{
+	public:
+		explicit TTaskPipeline(const TCHAR* DebugName)
+			: Pipeline(DebugName)
+		{
+		}
+
+		/** Parallel 阶段的 Body 会被并发调用 */
+		template<typename StageBodyType>
+		TTaskPipeline& AddStage(const TCHAR* Name, StageBodyType&& Body, const FPipelineStageParams& Params = FPipelineStageParams())
+		{
+			static_assert(std::is_invocable_v<StageBodyType&, ItemType&>, "Stage body must be callable as void(ItemType&)");
+
+			Pipeline.AddStage(Name,
+				[Body = std::decay_t<StageBodyType>(Forward<StageBodyType>(Body))](Private::FPipelineItem& Item) mutable
+				{
+					Body(static_cast<Private::TPipelineItem<ItemType>&>(Item).Value);
+				},
+				Params);
+			return *this;
+		}
+
+		bool TrySubmit(ItemType& Value)
+		{
+			FTaskPipeline::FItemPtr Item = MakeUnique<Private::TPipelineItem<ItemType>>(MoveTemp(Value));
+			if (Pipeline.TrySubmit(Item))
+			{
+				return true;
+			}
+
+			// 队列满: 把条目还给调用方
+			Value = MoveTemp(static_cast<Private::TPipelineItem<ItemType>&>(*Item).Value);
+			return false;
+		}
+
+		void Submit(ItemType&& Value)
+		{
+			Pipeline.Submit(MakeUnique<Private::TPipelineItem<ItemType>>(MoveTemp(Value)));
+		}
+
+		bool Wait(FTimespan Timeout = FTimespan::MaxValue()) { return Pipeline.Wait(Timeout); }
+
+		TArray<FPipelineStageStats> GetStats() const { return Pipeline.GetStats(); }
+		void ResetStats() { Pipeline.ResetStats(); }
+
+	private:
+		FTaskPipeline Pipeline;
+	};
+}
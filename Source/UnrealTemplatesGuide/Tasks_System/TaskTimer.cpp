@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TaskTimer.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace UE::TemplatesGuide
+{
+	namespace Private
+	{
+		/** 按截止时间排序的回调小顶堆 + 一个专用线程 */
+		class FTaskTimer final : public FRunnable
+		{
+		public:
+			/**
+			 * 有意泄漏, 不在静态析构时停止线程: 那时模块与任务调度器都已销毁
+			 * 由 ShutdownTaskTimer (模块的 ShutdownModule) 显式停止
+			 */
+			static FTaskTimer& Get()
+			{
+				static FTaskTimer* Instance = []
+				{
+					FTaskTimer* Created = new FTaskTimer();
+					CreatedInstance.store(Created, std::memory_order_release);
+					return Created;
+				}();
+				return *Instance;
+			}
+
+			/** 尚未使用过时返回空, 关闭时不必为此创建线程 */
+			static FTaskTimer* GetIfCreated()
+			{
+				return CreatedInstance.load(std::memory_order_acquire);
+			}
+
+			FTaskTimer()
+			{
+				if (FPlatformProcess::SupportsMultithreading())
+				{
+					Thread = FRunnableThread::Create(this, TEXT("TemplatesGuideTaskTimer"), 0, TPri_AboveNormal);
+					bHasThread = Thread != nullptr;
+				}
+			}
+
+			void Schedule(double Microseconds, TUniqueFunction<void()>&& Callback)
+			{
+				const uint64 DeadlineCycles = FPlatformTime::Cycles64() + uint64(Microseconds / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0));
+				{
+					FScopeLock Lock(&Mutex);
+					if (bHasThread && !bShutdown)
+					{
+						Timers.HeapPush(FTimer{DeadlineCycles, MoveTemp(Callback)}, FTimerOrder());
+						WakeEvent->Trigger();
+						return;
+					}
+				}
+
+				// 没有计时线程 (或已关闭) 时立即执行
+				Callback();
+			}
+
+			/** 停止计时线程; 未到期的回调立即执行, 等待它们的一方 (对冲请求 / 截止时间提升) 不会永远等下去 */
+			void Shutdown()
+			{
+				{
+					FScopeLock Lock(&Mutex);
+					if (bShutdown)
+					{
+						return;
+					}
+					bShutdown = true;
+				}
+
+				if (Thread)
+				{
+					Thread->Kill(true);
+					delete Thread;
+					Thread = nullptr;
+				}
+
+				TArray<FTimer> Remaining;
+				{
+					FScopeLock Lock(&Mutex);
+					Remaining = MoveTemp(Timers);
+				}
+				for (FTimer& Timer : Remaining)
+				{
+					Timer.Callback();
+				}
+			}
+
+			virtual uint32 Run() override
+			{
+				TArray<TUniqueFunction<void()>> Expired;
+				while (!bStop.load(std::memory_order_relaxed))
+				{
+					double WaitMicroseconds = 1000000.0;
+					{
+						FScopeLock Lock(&Mutex);
+						const uint64 NowCycles = FPlatformTime::Cycles64();
+						while (!Timers.IsEmpty() && Timers.HeapTop().DeadlineCycles <= NowCycles)
+						{
+							FTimer Timer;
+							Timers.HeapPop(Timer, FTimerOrder(), EAllowShrinking::No);
+							Expired.Add(MoveTemp(Timer.Callback));
+						}
+
+						if (!Timers.IsEmpty())
+						{
+							WaitMicroseconds = FPlatformTime::ToMilliseconds64(Timers.HeapTop().DeadlineCycles - NowCycles) * 1000.0;
+						}
+					}
+
+					for (TUniqueFunction<void()>& Callback : Expired)
+					{
+						Callback();
+					}
+					Expired.Reset();
+
+					// 事件等待以毫秒为单位, 不足 1ms 的剩余时间让出时间片
+					if (WaitMicroseconds < 1000.0)
+					{
+						FPlatformProcess::SleepNoStats(0.0f);
+					}
+					else
+					{
+						WakeEvent->Wait(uint32(WaitMicroseconds / 1000.0));
+					}
+				}
+				return 0;
+			}
+
+			virtual void Stop() override
+			{
+				bStop.store(true, std::memory_order_relaxed);
+				WakeEvent->Trigger();
+			}
+
+		private:
+			struct FTimer
+			{
+				uint64 DeadlineCycles = 0;
+				TUniqueFunction<void()> Callback;
+			};
+
+			struct FTimerOrder
+			{
+				bool operator()(const FTimer& A, const FTimer& B) const
+				{
+					return A.DeadlineCycles < B.DeadlineCycles;
+				}
+			};
+
+			inline static std::atomic<FTaskTimer*> CreatedInstance{nullptr};
+
+			FCriticalSection Mutex;
+			TArray<FTimer> Timers;
+			FEventRef WakeEvent;
+			std::atomic<bool> bStop{false};
+			FRunnableThread* Thread = nullptr;
+
+			// 受 Mutex 保护
+			bool bHasThread = false;
+			bool bShutdown = false;
+		};
+
+		void ScheduleAfter(double Microseconds, TUniqueFunction<void()>&& Callback)
+		{
+			FTaskTimer::Get().Schedule(Microseconds, MoveTemp(Callback));
+		}
+
+		void ShutdownTaskTimer()
+		{
+			if (FTaskTimer* Timer = FTaskTimer::GetIfCreated())
+			{
+				Timer->Shutdown();
+			}
+		}
+	}
+}
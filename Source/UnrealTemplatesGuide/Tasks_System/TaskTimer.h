@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 任务用的轻量计时器
+ *
+ * 对冲请求的备份尝试 (SpeculativeExecution.h) 与截止时间调度的提升 (DeadlineScheduler.h)
+ * 都需要在 "若干微秒之后" 做一件很小的事 (通常是 Launch 一个任务)。
+ * 用任务 Wait(Timeout) 等待会在整个延迟期间占住一个工作线程, 这里改用一个专用线程:
+ * 回调按截止时间放在小顶堆中, 计时线程在最近的截止时间醒来并执行到期的回调
+ *
+ * 精度: 剩余时间不足 1ms 时计时线程让出时间片轮询, 否则在事件上等待
+ *
+ * 生命周期: 计时线程在首次使用时创建, 由模块的 ShutdownModule 调用 ShutdownTaskTimer 停止
+ * (不依赖静态析构, 那时任务调度器已经销毁)
+ */
+namespace UE::TemplatesGuide::Private
+{
+	/**
+	 * 在计时线程上, Microseconds 之后调用 Callback
+	 *
+	 * Callback 应该很轻 (不要阻塞计时线程); 计时线程在首次使用时创建,
+	 * 平台不支持多线程时 Callback 立即在调用线程上执行
+	 */
+	UNREALTEMPLATESGUIDE_API void ScheduleAfter(double Microseconds, TUniqueFunction<void()>&& Callback);
+
+	/**
+	 * 停止计时线程并立即执行所有未到期的回调; 之后的 ScheduleAfter 在调用线程上立即执行
+	 *
+	 * 由 FUnrealTemplatesGuideModule::ShutdownModule 调用, 可重复调用
+	 */
+	UNREALTEMPLATESGUIDE_API void ShutdownTaskTimer();
+}
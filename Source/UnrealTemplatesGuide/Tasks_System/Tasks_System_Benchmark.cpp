@@ -0,0 +1,1904 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// Tasks_System 基准用例
+//
+// 每个用例对应 Tasks_System_Example.cpp 中的一个示例 (Example_BasicLaunch ...
+// Example_DeepRetraction_WaitTimeout), 保持相同的任务结构:
+//   - FPlatformProcess::Sleep 占位替换为可配置的 Context.Work() (忙等)
+//   - UE_LOG 输出去掉, 避免日志格式化成为测量对象
+//   - 每个任务体开头记录 "启动到开始执行" 的延迟
+//
+// 运行: TemplatesGuide.Benchmark Filter=Tasks. Iterations=1000 WorkUs=5
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/TaskConcurrencyLimiter.h"
+#include "ParallelBatch.h"
+#include "PooledTaskBody.h"
+#include "TaskMailbox.h"
+#include "ArenaConcurrencyLimiter.h"
+#include "TaskCoroutine.h"
+#include "SpeculativeExecution.h"
+#include "DeadlineScheduler.h"
+#include "InstrumentedWait.h"
+#include "TaskPipeline.h"
+#include "PipeBatch.h"
+#include "NamedThreadBatcher.h"
+#include "PinnedWorkerPool.h"
+#include "PriorityTuner.h"
+#include "Profiling/TemplatesGuideTrace.h"
+#include "Async/Async.h"
+#include "Async/Fundamental/Scheduler.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+
+// 示例1: 基础任务启动 - Launch + Wait 往返
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, BasicLaunch, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+		});
+		Task.Wait();
+	}
+
+	Context.Report(TEXT("BasicLaunch"), Iterations, Timer.GetSeconds(), &Latency);
+}
+
+// 示例2: 带返回值的任务
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskWithResult, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	int64 Checksum = 0;
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::TTask<int32> Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]() -> int32
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+			return 5050;
+		});
+		Checksum += Task.GetResult();
+	}
+
+	const double Seconds = Timer.GetSeconds();
+	check(Checksum == int64(5050) * Iterations);
+	Context.Report(TEXT("TaskWithResult"), Iterations, Seconds, &Latency);
+}
+
+// 示例3: 先决条件链 TaskA → TaskB → TaskC, 以及 (IndependentA, IndependentB) → FinalTask
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, Prerequisites, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 6;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		auto Body = [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+		};
+
+		UE::Tasks::FTask TaskA = UE::Tasks::Launch(UE_SOURCE_LOCATION, Body);
+		UE::Tasks::FTask TaskB = UE::Tasks::Launch(UE_SOURCE_LOCATION, Body, UE::Tasks::Prerequisites(TaskA));
+		UE::Tasks::FTask TaskC = UE::Tasks::Launch(UE_SOURCE_LOCATION, Body, UE::Tasks::Prerequisites(TaskB));
+
+		TArray<UE::Tasks::FTask> PrereqTasks;
+		PrereqTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, Body));
+		PrereqTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, Body));
+		UE::Tasks::FTask FinalTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, Body, PrereqTasks);
+
+		TaskC.Wait();
+		FinalTask.Wait();
+	}
+
+	Context.Report(TEXT("Prerequisites"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例4: FTaskEvent - 延迟为 "Trigger 到等待任务开始执行"
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskEvent, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		std::atomic<uint64> TriggerCycles{0};
+
+		UE::Tasks::FTaskEvent Event(UE_SOURCE_LOCATION);
+		UE::Tasks::FTask WaitingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Latency, &TriggerCycles]
+		{
+			Latency.RecordSince(TriggerCycles.load());
+		},
+		UE::Tasks::Prerequisites(Event));
+
+		Context.Work();
+		TriggerCycles = FLatencyRecorder::Now();
+		Event.Trigger();
+		WaitingTask.Wait();
+
+		// FTaskEvent 以任务为先决条件
+		UE::Tasks::FTask SetupTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context] { Context.Work(); });
+		UE::Tasks::FTaskEvent DataReady(UE_SOURCE_LOCATION);
+		DataReady.AddPrerequisites(UE::Tasks::Prerequisites(SetupTask));
+		UE::Tasks::FTask ProcessTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {}, UE::Tasks::Prerequisites(DataReady));
+		DataReady.Trigger();
+		ProcessTask.Wait();
+	}
+
+	Context.Report(TEXT("TaskEvent"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例5: 嵌套任务 - 父任务启动两个子任务并 AddNested
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, NestedTasks, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTask ParentTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+
+			const uint64 ChildLaunchCycles = FLatencyRecorder::Now();
+			auto ChildBody = [&Context, &Latency, ChildLaunchCycles]
+			{
+				Latency.RecordSince(ChildLaunchCycles);
+				Context.Work();
+			};
+			UE::Tasks::AddNested(UE::Tasks::Launch(UE_SOURCE_LOCATION, ChildBody));
+			UE::Tasks::AddNested(UE::Tasks::Launch(UE_SOURCE_LOCATION, ChildBody));
+		});
+		ParentTask.Wait();
+	}
+
+	Context.Report(TEXT("NestedTasks"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例6: FPipe 串行执行 - 每次迭代三个管道任务
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, Pipe, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	UE::Tasks::FPipe Pipe(UE_SOURCE_LOCATION);
+	int32 SharedCounter = 0;
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		for (int32 Step = 1; Step <= TasksPerIteration; ++Step)
+		{
+			const uint64 LaunchCycles = FLatencyRecorder::Now();
+			Pipe.Launch(UE_SOURCE_LOCATION, [&Context, &Latency, &SharedCounter, LaunchCycles, Step]
+			{
+				Latency.RecordSince(LaunchCycles);
+				Context.Work();
+				SharedCounter += Step * 10;
+			});
+		}
+		Pipe.WaitUntilEmpty();
+	}
+
+	const double Seconds = Timer.GetSeconds();
+	check(SharedCounter == 60 * Iterations);
+	Context.Report(TEXT("Pipe"), int64(Iterations) * TasksPerIteration, Seconds, &Latency);
+}
+
+// 示例7: Wait / WaitAny / Any
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, WaitMultipleTasks, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 5;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		auto MakeBody = [&Context, &Latency, LaunchCycles](int32 WorkUnits)
+		{
+			return [&Context, &Latency, LaunchCycles, WorkUnits]
+			{
+				Latency.RecordSince(LaunchCycles);
+				for (int32 Unit = 0; Unit < WorkUnits; ++Unit)
+				{
+					Context.Work();
+				}
+			};
+		};
+
+		// 原示例: 30ms / 10ms / 20ms, 这里按 3:1:2 的工作单位保持相对时长
+		TArray<UE::Tasks::FTask> Tasks;
+		Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(3)));
+		Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(1)));
+		Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(2)));
+
+		verify(UE::Tasks::WaitAny(Tasks) != INDEX_NONE);
+		UE::Tasks::Wait(Tasks);
+
+		TArray<UE::Tasks::FTask> MoreTasks;
+		MoreTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(2)));
+		MoreTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(1)));
+		UE::Tasks::Any(MoreTasks).Wait();
+		UE::Tasks::Wait(MoreTasks);
+	}
+
+	Context.Report(TEXT("WaitMultipleTasks"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例8: FCancellationToken - 附加指标为取消信号到任务退出的延迟
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, CancellationToken, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+	FLatencyRecorder CancelLatency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		UE::Tasks::FCancellationToken Token;
+		std::atomic<uint64> CancelCycles{0};
+
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTask CancellableTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[&Context, &Latency, &CancelLatency, &Token, &CancelCycles, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				for (int32 Unit = 0; Unit < 100; ++Unit)
+				{
+					if (Token.IsCanceled())
+					{
+						CancelLatency.RecordSince(CancelCycles.load());
+						return;
+					}
+					Context.Work();
+				}
+			});
+
+		// 原示例在 10 个工作单位 (10ms / 1ms) 后取消
+		for (int32 Unit = 0; Unit < 10; ++Unit)
+		{
+			Context.Work();
+		}
+		CancelCycles = FLatencyRecorder::Now();
+		Token.Cancel();
+		CancellableTask.Wait();
+	}
+
+	FBenchmarkResult& Result = Context.Report(TEXT("CancellationToken"), Iterations, Timer.GetSeconds(), &Latency);
+	Result.Metrics.Emplace(TEXT("CancelToExitP50Us"), CancelLatency.GetPercentileMicroseconds(50.0));
+	Result.Metrics.Emplace(TEXT("CancelToExitP99Us"), CancelLatency.GetPercentileMicroseconds(99.0));
+}
+
+// 示例9: 任务优先级 - 按优先级分别统计延迟
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskPriority, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+	FLatencyRecorder HighLatency(Iterations);
+	FLatencyRecorder NormalLatency(Iterations);
+	FLatencyRecorder BackgroundLatency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		auto MakeBody = [&Context, &Latency, LaunchCycles](FLatencyRecorder& PriorityLatency)
+		{
+			return [&Context, &Latency, &PriorityLatency, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				PriorityLatency.RecordSince(LaunchCycles);
+				Context.Work();
+			};
+		};
+
+		UE::Tasks::FTask HighPriTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(HighLatency), LowLevelTasks::ETaskPriority::High);
+		UE::Tasks::FTask BgTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(BackgroundLatency), LowLevelTasks::ETaskPriority::BackgroundLow);
+		UE::Tasks::FTask NormalTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, MakeBody(NormalLatency));
+
+		HighPriTask.Wait();
+		BgTask.Wait();
+		NormalTask.Wait();
+	}
+
+	FBenchmarkResult& Result = Context.Report(TEXT("TaskPriority"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+	Result.Metrics.Emplace(TEXT("HighP50Us"), HighLatency.GetPercentileMicroseconds(50.0));
+	Result.Metrics.Emplace(TEXT("NormalP50Us"), NormalLatency.GetPercentileMicroseconds(50.0));
+	Result.Metrics.Emplace(TEXT("BackgroundLowP50Us"), BackgroundLatency.GetPercentileMicroseconds(50.0));
+	Result.Metrics.Emplace(TEXT("BackgroundLowP99Us"), BackgroundLatency.GetPercentileMicroseconds(99.0));
+}
+
+// 示例10: MakeCompletedTask + 以其为先决条件的后续任务
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, MakeCompletedTask, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 2;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		UE::Tasks::TTask<int32> CompletedIntTask = UE::Tasks::MakeCompletedTask<int32>(42);
+		check(CompletedIntTask.IsCompleted());
+
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTask FollowUp = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+		},
+		UE::Tasks::Prerequisites(CompletedIntTask));
+		FollowUp.Wait();
+	}
+
+	Context.Report(TEXT("MakeCompletedTask"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例11: Fire-and-Forget - 一次性启动全部任务, 不保留句柄, 用原子计数等待
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, FireAndForget, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+	std::atomic<int32> NumDone{0};
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, &NumDone, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+			NumDone.fetch_add(1, std::memory_order_release);
+		});
+	}
+	const double LaunchSeconds = Timer.GetSeconds();
+
+	while (NumDone.load(std::memory_order_acquire) < Iterations)
+	{
+		FPlatformProcess::Yield();
+	}
+
+	FBenchmarkResult& Result = Context.Report(TEXT("FireAndForget"), Iterations, Timer.GetSeconds(), &Latency);
+	Result.Metrics.Emplace(TEXT("LaunchesPerSecond"), LaunchSeconds > 0.0 ? Iterations / LaunchSeconds : 0.0);
+}
+
+// 示例12: 任务内部访问自身 (FTaskHandle::Launch 成员函数)
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, AccessTaskFromInside, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		UE::Tasks::FTask Task;
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		Task.Launch(UE_SOURCE_LOCATION, [&Context, &Latency, &Task, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			check(!Task.IsCompleted());
+			Context.Work();
+		});
+		Task.Wait();
+	}
+
+	Context.Report(TEXT("AccessTaskFromInside"), Iterations, Timer.GetSeconds(), &Latency);
+}
+
+// 示例13: IsAwaitable() - 外层任务内启动 Inline 子任务并检查
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, IsAwaitable, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 2;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		UE::Tasks::FTask Outer;
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		Outer.Launch(UE_SOURCE_LOCATION, [&Context, &Latency, &Outer, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			UE::Tasks::FTask Inner = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[&Context, &Outer]
+				{
+					check(!Outer.IsAwaitable());
+					Context.Work();
+				},
+				LowLevelTasks::ETaskPriority::Default,
+				UE::Tasks::EExtendedTaskPriority::Inline);
+			check(Inner.IsCompleted());
+		});
+		check(Outer.IsAwaitable());
+		Outer.Wait();
+	}
+
+	Context.Report(TEXT("IsAwaitable"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例14: Pipe 作为异步类 - 两个调用方任务并发调用 Add
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PipeAsAsyncClass, EBenchmarkFlags::ScalesWithWorkers)
+{
+	class FAsyncCounter
+	{
+	public:
+		UE::Tasks::TTask<int32> Add(int32 Value, FLatencyRecorder& Latency)
+		{
+			const uint64 LaunchCycles = FLatencyRecorder::Now();
+			return Pipe.Launch(TEXT("Add"), [this, Value, &Latency, LaunchCycles]() -> int32
+			{
+				Latency.RecordSince(LaunchCycles);
+				Counter += Value;
+				return Counter;
+			});
+		}
+
+		int32 GetValue()
+		{
+			return Pipe.Launch(TEXT("GetValue"), [this]() -> int32 { return Counter; }).GetResult();
+		}
+
+		void WaitForEmpty()
+		{
+			Pipe.WaitUntilEmpty();
+		}
+
+	private:
+		UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+		int32 Counter = 0;
+	};
+
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+	FAsyncCounter AsyncCounter;
+
+	FBenchmarkTimer Timer;
+	const int32 FirstHalf = Iterations / 2;
+	UE::Tasks::FTask Caller1 = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&AsyncCounter, &Latency, FirstHalf]
+	{
+		for (int32 i = 0; i < FirstHalf; ++i)
+		{
+			AsyncCounter.Add(1, Latency);
+		}
+	});
+	UE::Tasks::FTask Caller2 = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&AsyncCounter, &Latency, Count = Iterations - FirstHalf]
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			AsyncCounter.Add(1, Latency);
+		}
+	});
+	Caller1.Wait();
+	Caller2.Wait();
+	AsyncCounter.WaitForEmpty();
+	const double Seconds = Timer.GetSeconds();
+
+	check(AsyncCounter.GetValue() == Iterations);
+	AsyncCounter.WaitForEmpty();
+	Context.Report(TEXT("PipeAsAsyncClass"), Iterations, Seconds, &Latency);
+}
+
+// 示例15: FPipeSuspensionScope - 延迟为 "恢复到排队任务开始执行"
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PipeSuspension, EBenchmarkFlags::ScalesWithWorkers)
+{
+	struct FPipeSuspensionScope
+	{
+		explicit FPipeSuspensionScope(UE::Tasks::FPipe& InPipe)
+		{
+			InPipe.Launch(UE_SOURCE_LOCATION, [this]
+			{
+				UE::Tasks::AddNested(ResumeSignal);
+				SuspendSignal.Trigger();
+			});
+			SuspendSignal.Wait();
+		}
+
+		~FPipeSuspensionScope()
+		{
+			ResumeSignal.Trigger();
+		}
+
+		UE::Tasks::FTaskEvent SuspendSignal{UE_SOURCE_LOCATION};
+		UE::Tasks::FTaskEvent ResumeSignal{UE_SOURCE_LOCATION};
+	};
+
+	constexpr int32 QueuedPerIteration = 4;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * QueuedPerIteration);
+
+	UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		std::atomic<uint64> ResumeCycles{0};
+		{
+			FPipeSuspensionScope Suspension(Pipe);
+			for (int32 Queued = 0; Queued < QueuedPerIteration; ++Queued)
+			{
+				Pipe.Launch(UE_SOURCE_LOCATION, [&Context, &Latency, &ResumeCycles]
+				{
+					Latency.RecordSince(ResumeCycles.load());
+					Context.Work();
+				});
+			}
+			ResumeCycles = FLatencyRecorder::Now();
+		}
+		Pipe.WaitUntilEmpty();
+	}
+
+	Context.Report(TEXT("PipeSuspension"), int64(Iterations) * (QueuedPerIteration + 1), Timer.GetSeconds(), &Latency);
+}
+
+// 示例16: 命名线程任务 - GameThread 任务由等待的 GameThread 自身执行
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, NamedThreadTask, EBenchmarkFlags::None)
+{
+	check(IsInGameThread());
+
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTask GTTask = UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[&Context, &Latency, LaunchCycles]
+			{
+				check(IsInGameThread());
+				Latency.RecordSince(LaunchCycles);
+				Context.Work();
+			},
+			LowLevelTasks::ETaskPriority::Default,
+			UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri);
+		GTTask.Wait();
+	}
+
+	Context.Report(TEXT("NamedThreadTask"), Iterations, Timer.GetSeconds(), &Latency);
+}
+
+// 示例17: FTaskPriorityCVar
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskPriorityCVar, EBenchmarkFlags::ScalesWithWorkers)
+{
+	static UE::Tasks::FTaskPriorityCVar BenchmarkCVar{
+		TEXT("TasksExample.Benchmark.Priority"),
+		TEXT("Task priority used by the TaskPriorityCVar benchmark"),
+		LowLevelTasks::ETaskPriority::Normal,
+		UE::Tasks::EExtendedTaskPriority::None
+	};
+
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[&Context, &Latency, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				Context.Work();
+			},
+			BenchmarkCVar.GetTaskPriority(),
+			BenchmarkCVar.GetExtendedTaskPriority()
+		).Wait();
+	}
+
+	Context.Report(TEXT("TaskPriorityCVar"), Iterations, Timer.GetSeconds(), &Latency);
+}
+
+// 示例18: FTaskConcurrencyLimiter - 上限等于可用工作线程数, 延迟为 "Push 到开始执行"
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskConcurrencyLimiter, EBenchmarkFlags::ScalesWithWorkers)
+{
+	const int32 Iterations = Context.GetIterations();
+	const uint32 MaxConcurrency = static_cast<uint32>(Context.GetWorkers());
+	FLatencyRecorder Latency(Iterations);
+
+	std::atomic<uint32> CurrentConcurrency{0};
+	std::atomic<uint32> MaxObserved{0};
+
+	FBenchmarkTimer Timer;
+	UE::Tasks::FTaskConcurrencyLimiter Limiter(MaxConcurrency);
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 PushCycles = FLatencyRecorder::Now();
+		Limiter.Push(UE_SOURCE_LOCATION,
+			[&Context, &Latency, &CurrentConcurrency, &MaxObserved, PushCycles, MaxConcurrency](uint32 Slot)
+			{
+				Latency.RecordSince(PushCycles);
+				check(Slot < MaxConcurrency);
+
+				const uint32 Current = CurrentConcurrency.fetch_add(1) + 1;
+				uint32 PrevMax = MaxObserved.load();
+				while (PrevMax < Current && !MaxObserved.compare_exchange_weak(PrevMax, Current)) {}
+
+				Context.Work();
+				CurrentConcurrency.fetch_sub(1);
+			});
+	}
+	Limiter.Wait();
+
+	FBenchmarkResult& Result = Context.Report(TEXT("TaskConcurrencyLimiter"), Iterations, Timer.GetSeconds(), &Latency);
+	Result.Metrics.Emplace(TEXT("MaxObservedConcurrency"), MaxObserved.load());
+	check(MaxObserved.load() <= MaxConcurrency);
+}
+
+// 示例19: 带先决条件的管道任务不阻塞管道 / Move-Only 结果
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PipedPrereqAndMoveOnlyResult, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		UE::Tasks::FTaskEvent Prereq{UE_SOURCE_LOCATION};
+
+		UE::Tasks::FTask Task1 = Pipe.Launch(UE_SOURCE_LOCATION, [&Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+		}, UE::Tasks::Prerequisites(Prereq));
+
+		UE::Tasks::FTask Task2 = Pipe.Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+		});
+		Task2.Wait();
+		check(!Task1.IsCompleted());
+
+		Prereq.Trigger();
+		Task1.Wait();
+
+		UE::Tasks::TTask<TUniquePtr<int32>> MoveOnlyTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[&Latency, LaunchCycles]() -> TUniquePtr<int32>
+			{
+				Latency.RecordSince(LaunchCycles);
+				return MakeUnique<int32>(42);
+			});
+		TUniquePtr<int32> Result = MoveTemp(MoveOnlyTask.GetResult());
+		check(Result.IsValid() && *Result == 42);
+	}
+	Pipe.WaitUntilEmpty();
+
+	Context.Report(TEXT("PipedPrereqAndMoveOnlyResult"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例20: 深度撤回 - 两级先决条件 + 两个嵌套任务
+//   原示例中的 100ms 超时等待只用于验证 "未完成", 这里用 Wait(FTimespan::Zero()) 代替
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, DeepRetraction_WaitTimeout, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 8;
+	const int32 Iterations = Context.GetIterations();
+	FLatencyRecorder Latency(Iterations * TasksPerIteration);
+
+	FBenchmarkTimer Timer;
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		// Wait 带超时
+		{
+			UE::Tasks::FTaskEvent Blocker{UE_SOURCE_LOCATION};
+			UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {}, UE::Tasks::Prerequisites(Blocker));
+			verify(!Task.Wait(FTimespan::Zero()));
+			Blocker.Trigger();
+			verify(Task.Wait(FTimespan::FromMilliseconds(100)));
+		}
+
+		// 深度撤回
+		const uint64 LaunchCycles = FLatencyRecorder::Now();
+		auto Body = [&Context, &Latency, LaunchCycles]
+		{
+			Latency.RecordSince(LaunchCycles);
+			Context.Work();
+		};
+
+		UE::Tasks::FTask P11 = UE::Tasks::Launch(TEXT("P11"), Body);
+		UE::Tasks::FTask P12 = UE::Tasks::Launch(TEXT("P12"), Body);
+		UE::Tasks::FTask P21 = UE::Tasks::Launch(TEXT("P21"), Body, UE::Tasks::Prerequisites(P11, P12));
+		UE::Tasks::FTask P22 = UE::Tasks::Launch(TEXT("P22"), Body);
+
+		UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[&Latency, Body, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				UE::Tasks::AddNested(UE::Tasks::Launch(TEXT("N11"), Body));
+				UE::Tasks::AddNested(UE::Tasks::Launch(TEXT("N12"), Body));
+			},
+			UE::Tasks::Prerequisites(P21, P22));
+
+		Task.Wait();
+		check(P11.IsCompleted() && P12.IsCompleted() && P21.IsCompleted() && P22.IsCompleted());
+	}
+
+	Context.Report(TEXT("DeepRetraction_WaitTimeout"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds(), &Latency);
+}
+
+// 示例21: 每条目单独 Launch 与 LaunchBatched 对比
+//   条目数 = Iterations * 100, 每个条目是几十纳秒的小计算 (不使用 WorkUs)
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, ParallelBatch, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 WarmRounds = 8;
+	const int32 NumItems = FMath::Max(1000, Context.GetIterations() * 100);
+
+	TArray<float> Values;
+	Values.Init(0.0f, NumItems);
+
+	auto ItemBody = [](float& Value)
+	{
+		Value = FMath::Sqrt(Value * Value) + 1.0f;
+	};
+
+	// 每条目一个任务
+	{
+		TArray<UE::Tasks::FTask> Tasks;
+		Tasks.Reserve(NumItems);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			float* Value = &Values[i];
+			Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Value, &ItemBody] { ItemBody(*Value); }));
+		}
+		UE::Tasks::Wait(Tasks);
+
+		Context.Report(TEXT("PerItemLaunch"), NumItems, Timer.GetSeconds()).Metrics.Emplace(TEXT("TasksLaunched"), NumItems);
+	}
+
+	UE::TemplatesGuide::FBatchCostModel CostModel;
+	UE::TemplatesGuide::FBatchLaunchParams Params;
+	Params.CostModel = &CostModel;
+	Params.MaxTasks = Context.GetWorkers();
+
+	auto ReportBatched = [&](const TCHAR* CaseName, int32 Rounds, double Seconds, const UE::TemplatesGuide::Private::FBatchChunking& Chunking)
+	{
+		FBenchmarkResult& Result = Context.Report(CaseName, int64(NumItems) * Rounds, Seconds);
+		Result.Metrics.Emplace(TEXT("ChunkSize"), Chunking.ChunkSize);
+		Result.Metrics.Emplace(TEXT("TasksLaunched"), Chunking.NumTasks);
+		Result.Metrics.Emplace(TEXT("NsPerItem"), CostModel.GetNanosecondsPerItem());
+	};
+
+	constexpr int32 AlignItems = PLATFORM_CACHE_LINE_SIZE / sizeof(float);
+
+	// 冷启动: 尚无测量数据, 使用 InitialChunkSize
+	{
+		const UE::TemplatesGuide::Private::FBatchChunking Chunking = UE::TemplatesGuide::Private::ComputeChunking(NumItems, AlignItems, 0, Params);
+
+		FBenchmarkTimer Timer;
+		UE::TemplatesGuide::LaunchBatched(UE_SOURCE_LOCATION, MakeArrayView(Values), ItemBody, Params).Wait();
+		ReportBatched(TEXT("Batched_Cold"), 1, Timer.GetSeconds(), Chunking);
+	}
+
+	// 预热后: 使用耗时模型选择的块大小
+	{
+		// 先不计时地预热, 再读取块大小: 报告的是计时轮次实际使用的块大小, 不是冷启动的 InitialChunkSize
+		for (int32 Round = 0; Round < WarmRounds; ++Round)
+		{
+			UE::TemplatesGuide::LaunchBatched(UE_SOURCE_LOCATION, MakeArrayView(Values), ItemBody, Params).Wait();
+		}
+		const UE::TemplatesGuide::Private::FBatchChunking Chunking = UE::TemplatesGuide::Private::ComputeChunking(NumItems, AlignItems, 0, Params);
+
+		FBenchmarkTimer Timer;
+		for (int32 Round = 0; Round < WarmRounds; ++Round)
+		{
+			UE::TemplatesGuide::LaunchBatched(UE_SOURCE_LOCATION, MakeArrayView(Values), ItemBody, Params).Wait();
+		}
+		ReportBatched(TEXT("Batched_Warm"), WarmRounds, Timer.GetSeconds(), Chunking);
+	}
+
+	// 每个条目恰好被处理 PerItemLaunch + Batched_Cold + 预热与计时各 WarmRounds 次
+	for (float Value : Values)
+	{
+		check(Value == static_cast<float>(2 + 2 * WarmRounds));
+	}
+}
+
+// 示例22: Fire-and-Forget 大捕获任务, Launch 与 LaunchPooled 对比
+namespace TasksBenchmark
+{
+	template<int32 PayloadBytes, bool bPooled>
+	void RunPayloadLaunch(FBenchmarkContext& Context, const TCHAR* CaseName)
+	{
+		struct FPayload
+		{
+			uint8 Bytes[PayloadBytes];
+		};
+
+		const int32 NumTasks = Context.GetIterations() * 10;
+		FPayload Payload;
+		FMemory::Memset(Payload.Bytes, 1, PayloadBytes);
+
+		std::atomic<int32> Completed{0};
+		FLatencyRecorder Latency(NumTasks);
+		const UE::TemplatesGuide::FPooledTaskBodyStats Before = UE::TemplatesGuide::GetPooledTaskBodyStats();
+
+		// 任务体类型在循环外可见, 用于判断任务对象是否放得进小任务块
+		auto MakeBody = [&Completed, &Latency](const FPayload& InPayload, uint64 LaunchCycles)
+		{
+			return [Payload = InPayload, &Completed, &Latency, LaunchCycles]() mutable
+			{
+				Latency.RecordSince(LaunchCycles);
+				Payload.Bytes[0] += Payload.Bytes[PayloadBytes - 1];
+				Completed.fetch_add(1, std::memory_order_release);
+			};
+		};
+		using FBody = decltype(MakeBody(Payload, 0));
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumTasks; ++i)
+		{
+			FBody Body = MakeBody(Payload, FLatencyRecorder::Now());
+
+			if constexpr (bPooled)
+			{
+				UE::TemplatesGuide::LaunchPooled(UE_SOURCE_LOCATION, MoveTemp(Body));
+			}
+			else
+			{
+				UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Body));
+			}
+		}
+		while (Completed.load(std::memory_order_acquire) < NumTasks)
+		{
+			FPlatformProcess::Yield();
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		const UE::TemplatesGuide::FPooledTaskBodyStats After = UE::TemplatesGuide::GetPooledTaskBodyStats();
+
+		// 两边报告同一个指标: 任务对象超出引擎小任务块时 (与 TExecutableTask::operator new 相同的判断) 每次启动一次堆分配,
+		// LaunchPooled 的包装总在小任务块内, 只有超出池化范围的任务体 (HeapFallbacks) 才分配
+		const bool bBodyFitsSmallTask = UE::TemplatesGuide::TaskBodyFitsSmallTaskBlock<FBody>;
+		const int64 PooledAllocations = After.PooledAllocations - Before.PooledAllocations;
+		const int64 HeapAllocations = bPooled
+			? After.HeapFallbacks - Before.HeapFallbacks
+			: (bBodyFitsSmallTask ? 0 : NumTasks);
+
+		FBenchmarkResult& Result = Context.Report(CaseName, NumTasks, Seconds, &Latency);
+		Result.Metrics.Emplace(TEXT("PayloadBytes"), PayloadBytes);
+		Result.Metrics.Emplace(TEXT("TaskFitsSmallBlock"), bBodyFitsSmallTask ? 1.0 : 0.0);
+		Result.Metrics.Emplace(TEXT("HeapAllocations"), double(HeapAllocations));
+		Result.Metrics.Emplace(TEXT("PooledAllocations"), double(PooledAllocations));
+	}
+}
+
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PooledTaskBody, EBenchmarkFlags::ScalesWithWorkers)
+{
+	TasksBenchmark::RunPayloadLaunch<256, false>(Context, TEXT("Launch_256B"));
+	TasksBenchmark::RunPayloadLaunch<256, true>(Context, TEXT("LaunchPooled_256B"));
+	TasksBenchmark::RunPayloadLaunch<768, false>(Context, TEXT("Launch_768B"));
+	TasksBenchmark::RunPayloadLaunch<768, true>(Context, TEXT("LaunchPooled_768B"));
+}
+
+// 示例23: 示例14 的 FPipe 异步类与 TTaskMailbox 吞吐量对比
+//   1/4/16 个专用生产者线程 (EAsyncExecution::Thread), 共 Iterations * 100 条消息
+namespace TasksBenchmark
+{
+	/** 在 NumProducers 个专用线程上同时运行 Producer(ProducerIndex, NumMessages), 返回总耗时 */
+	template<typename ProducerType, typename FlushType>
+	double RunProducers(int32 NumProducers, int32 MessagesPerProducer, ProducerType Producer, FlushType Flush)
+	{
+		std::atomic<bool> bStart{false};
+		std::atomic<int32> NumReady{0};
+
+		TArray<TFuture<void>> Producers;
+		for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+		{
+			Producers.Add(Async(EAsyncExecution::Thread, [&bStart, &NumReady, &Producer, MessagesPerProducer]
+			{
+				NumReady.fetch_add(1);
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::Yield();
+				}
+				Producer(MessagesPerProducer);
+			}));
+		}
+
+		while (NumReady.load() < NumProducers)
+		{
+			FPlatformProcess::Yield();
+		}
+
+		FBenchmarkTimer Timer;
+		bStart.store(true, std::memory_order_release);
+		for (TFuture<void>& Future : Producers)
+		{
+			Future.Wait();
+		}
+		Flush();
+		return Timer.GetSeconds();
+	}
+}
+
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TaskMailbox, EBenchmarkFlags::None)
+{
+	constexpr int32 ProducerCounts[] = {1, 4, 16};
+	const int32 NumMessages = Context.GetIterations() * 100;
+
+	for (const int32 NumProducers : ProducerCounts)
+	{
+		const int32 MessagesPerProducer = FMath::Max(1, NumMessages / NumProducers);
+		const int64 TotalMessages = int64(MessagesPerProducer) * NumProducers;
+
+		// FPipe: 每条消息一个管道任务
+		{
+			UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+			int64 Counter = 0;
+
+			const double Seconds = TasksBenchmark::RunProducers(NumProducers, MessagesPerProducer,
+				[&Pipe, &Counter](int32 Count)
+				{
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Pipe.Launch(TEXT("Add"), [&Counter] { ++Counter; });
+					}
+				},
+				[&Pipe] { Pipe.WaitUntilEmpty(); });
+
+			check(Counter == TotalMessages);
+			Context.Report(*FString::Printf(TEXT("Pipe_%dProducers"), NumProducers), TotalMessages, Seconds)
+				.Metrics.Emplace(TEXT("Producers"), NumProducers);
+		}
+
+		// TTaskMailbox: 消息写入环形队列, 排空任务批量处理
+		{
+			int64 Counter = 0;
+			UE::TemplatesGuide::TTaskMailbox<int32> Mailbox(TEXT("BenchmarkMailbox"), [&Counter](int32& Delta) { Counter += Delta; });
+
+			const double Seconds = TasksBenchmark::RunProducers(NumProducers, MessagesPerProducer,
+				[&Mailbox](int32 Count)
+				{
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Mailbox.Post(1);
+					}
+				},
+				[&Mailbox] { Mailbox.WaitForEmpty(); });
+
+			check(Counter == TotalMessages);
+			const UE::TemplatesGuide::FTaskMailboxStats Stats = Mailbox.GetStats();
+			FBenchmarkResult& Result = Context.Report(*FString::Printf(TEXT("Mailbox_%dProducers"), NumProducers), TotalMessages, Seconds);
+			Result.Metrics.Emplace(TEXT("Producers"), NumProducers);
+			Result.Metrics.Emplace(TEXT("DrainTasks"), double(Stats.NumDrains));
+			Result.Metrics.Emplace(TEXT("CommandsPerDrain"), double(Stats.NumCommands) / FMath::Max<int64>(1, Stats.NumDrains));
+		}
+	}
+}
+
+// 示例24: 每个任务需要 16KB 临时内存
+//   FTaskConcurrencyLimiter + 每任务 TArray 堆分配 / FArenaConcurrencyLimiter 固定并发 / 自适应并发 (从 1 开始)
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, ArenaConcurrencyLimiter, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 ScratchBytes = 16 * 1024;
+	const int32 Iterations = Context.GetIterations();
+	const uint32 MaxConcurrency = static_cast<uint32>(Context.GetWorkers());
+
+	auto TouchScratch = [](uint8* Data, int32 Num)
+	{
+		FMemory::Memset(Data, 0xAB, Num);
+	};
+
+	// 基线: 引擎限制器, 每个任务自己分配临时内存
+	{
+		FLatencyRecorder Latency(Iterations);
+
+		FBenchmarkTimer Timer;
+		UE::Tasks::FTaskConcurrencyLimiter Limiter(MaxConcurrency);
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 PushCycles = FLatencyRecorder::Now();
+			Limiter.Push(UE_SOURCE_LOCATION, [&Context, &Latency, &TouchScratch, PushCycles](uint32 Slot)
+			{
+				Latency.RecordSince(PushCycles);
+				TArray<uint8> Scratch;
+				Scratch.SetNumUninitialized(ScratchBytes);
+				TouchScratch(Scratch.GetData(), Scratch.Num());
+				Context.Work();
+			});
+		}
+		Limiter.Wait();
+
+		Context.Report(TEXT("EngineLimiter_HeapScratch"), Iterations, Timer.GetSeconds(), &Latency);
+	}
+
+	auto RunArenaLimiter = [&](const TCHAR* CaseName, bool bAdaptive)
+	{
+		UE::TemplatesGuide::FArenaConcurrencyLimiterParams Params;
+		Params.MaxConcurrency = MaxConcurrency;
+		Params.InitialConcurrency = bAdaptive ? 1 : MaxConcurrency;
+		Params.ArenaBytesPerSlot = ScratchBytes;
+		Params.bAdaptive = bAdaptive;
+		Params.TargetQueueWaitMicroseconds = Context.GetConfig().WorkMicroseconds * 4.0;
+
+		FLatencyRecorder Latency(Iterations);
+
+		FBenchmarkTimer Timer;
+		UE::TemplatesGuide::FArenaConcurrencyLimiter Limiter(Params);
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 PushCycles = FLatencyRecorder::Now();
+			Limiter.Push(UE_SOURCE_LOCATION, [&Context, &Latency, &TouchScratch, PushCycles](uint32 Slot, UE::TemplatesGuide::FScratchArena& Arena)
+			{
+				Latency.RecordSince(PushCycles);
+				TArrayView<uint8> Scratch = Arena.AllocateArray<uint8>(ScratchBytes);
+				TouchScratch(Scratch.GetData(), Scratch.Num());
+				Context.Work();
+			});
+		}
+		Limiter.Wait();
+		const double Seconds = Timer.GetSeconds();
+
+		const UE::TemplatesGuide::FArenaConcurrencyLimiterStats Stats = Limiter.GetStats();
+		check(Stats.NumCompleted == Iterations);
+
+		double TotalUtilization = 0.0;
+		for (double Utilization : Stats.SlotUtilization)
+		{
+			TotalUtilization += Utilization;
+		}
+
+		FBenchmarkResult& Result = Context.Report(CaseName, Iterations, Seconds, &Latency);
+		Result.Metrics.Emplace(TEXT("FinalConcurrency"), Stats.CurrentConcurrency);
+		Result.Metrics.Emplace(TEXT("MeanSlotUtilization"), TotalUtilization / FMath::Max(1, Stats.SlotUtilization.Num()));
+		Result.Metrics.Emplace(TEXT("QueueWaitEmaUs"), Stats.QueueWaitEmaMicroseconds);
+		Result.Metrics.Emplace(TEXT("ArenaOverflows"), double(Stats.ArenaOverflows));
+	};
+
+	RunArenaLimiter(TEXT("ArenaLimiter_Fixed"), false);
+	RunArenaLimiter(TEXT("ArenaLimiter_Adaptive"), true);
+}
+
+// 追踪开销: 示例3 的 A → B → C 链, Launch 与 LaunchTraced 对比
+//   分别在 TemplatesGuide 通道开启 / 关闭时运行, 差值即为追踪开销
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, TraceOverhead, EBenchmarkFlags::ScalesWithWorkers)
+{
+	constexpr int32 TasksPerIteration = 3;
+	const int32 Iterations = Context.GetIterations();
+
+	{
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			UE::Tasks::FTask TaskA = UE::Tasks::Launch(TEXT("TaskA"), [&Context] { Context.Work(); });
+			UE::Tasks::FTask TaskB = UE::Tasks::Launch(TEXT("TaskB"), [&Context] { Context.Work(); }, UE::Tasks::Prerequisites(TaskA));
+			UE::Tasks::FTask TaskC = UE::Tasks::Launch(TEXT("TaskC"), [&Context] { Context.Work(); }, UE::Tasks::Prerequisites(TaskB));
+			TaskC.Wait();
+		}
+		Context.Report(TEXT("Launch"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds());
+	}
+
+	{
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			UE::TemplatesGuide::FTracedTask TaskA = UE::TemplatesGuide::LaunchTraced(TEXT("TaskA"), [&Context] { Context.Work(); });
+			UE::TemplatesGuide::FTracedTask TaskB = UE::TemplatesGuide::LaunchTraced(TEXT("TaskB"), [&Context] { Context.Work(); },
+				UE::TemplatesGuide::TracedPrerequisites(TaskA));
+			UE::TemplatesGuide::FTracedTask TaskC = UE::TemplatesGuide::LaunchTraced(TEXT("TaskC"), [&Context] { Context.Work(); },
+				UE::TemplatesGuide::TracedPrerequisites(TaskB));
+			UE::TemplatesGuide::WaitTraced(TaskC);
+		}
+
+		FBenchmarkResult& Result = Context.Report(TEXT("LaunchTraced"), int64(Iterations) * TasksPerIteration, Timer.GetSeconds());
+#if UE_TEMPLATESGUIDE_TRACE_ENABLED
+		Result.Metrics.Emplace(TEXT("ChannelEnabled"), UE_TRACE_CHANNELEXPR_IS_ENABLED(TemplatesGuideChannel) ? 1.0 : 0.0);
+#else
+		Result.Metrics.Emplace(TEXT("ChannelEnabled"), 0.0);
+#endif
+	}
+}
+
+#if UE_TEMPLATESGUIDE_WITH_COROUTINES
+namespace TasksBenchmark
+{
+	/**
+	 * 模拟 IO: Start() 返回一个事件, 由专用线程在 Latency 之后触发
+	 * 完成不消耗工作线程, 与真实的异步 IO 相同
+	 */
+	class FSimulatedIo
+	{
+	public:
+		explicit FSimulatedIo(double LatencyMicroseconds)
+			: LatencyCycles(uint64(LatencyMicroseconds / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0)))
+		{
+			Completer = Async(EAsyncExecution::Thread, [this] { Run(); });
+		}
+
+		~FSimulatedIo()
+		{
+			bStop.store(true, std::memory_order_relaxed);
+			Completer.Wait();
+		}
+
+		UE::Tasks::FTaskEvent Start()
+		{
+			UE::Tasks::FTaskEvent Event(TEXT("SimulatedIo"));
+			FScopeLock Lock(&Mutex);
+			Pending.Emplace(FPlatformTime::Cycles64() + LatencyCycles, Event);
+			return Event;
+		}
+
+	private:
+		void Run()
+		{
+			TArray<UE::Tasks::FTaskEvent> Expired;
+			for (;;)
+			{
+				bool bEmpty;
+				{
+					FScopeLock Lock(&Mutex);
+					const uint64 NowCycles = FPlatformTime::Cycles64();
+					for (int32 Index = Pending.Num() - 1; Index >= 0; --Index)
+					{
+						if (Pending[Index].Key <= NowCycles)
+						{
+							Expired.Add(MoveTemp(Pending[Index].Value));
+							Pending.RemoveAtSwap(Index, EAllowShrinking::No);
+						}
+					}
+					bEmpty = Pending.IsEmpty();
+				}
+
+				for (UE::Tasks::FTaskEvent& Event : Expired)
+				{
+					Event.Trigger();
+				}
+				Expired.Reset();
+
+				if (bEmpty && bStop.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+				FPlatformProcess::Sleep(0.00005f);
+			}
+		}
+
+		const uint64 LatencyCycles;
+		FCriticalSection Mutex;
+		TArray<TPair<uint64, UE::Tasks::FTaskEvent>> Pending;
+		std::atomic<bool> bStop{false};
+		TFuture<void> Completer;
+	};
+
+	/** 当前 / 峰值计数 */
+	struct FPeakCounter
+	{
+		std::atomic<int32> Current{0};
+		std::atomic<int32> Peak{0};
+
+		void Enter()
+		{
+			const int32 Now = Current.fetch_add(1, std::memory_order_relaxed) + 1;
+			int32 Previous = Peak.load(std::memory_order_relaxed);
+			while (Now > Previous && !Peak.compare_exchange_weak(Previous, Now, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void Leave()
+		{
+			Current.fetch_sub(1, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * 等待 IO 事件并计数的等待器: Waiting 为逻辑上在等待的操作数, OnWorkers 为等待期间占着工作线程的操作数
+	 *
+	 * 挂起的协程只在调度恢复任务的这段时间占用工作线程, await_suspend 返回后工作线程回到调度器
+	 */
+	struct FCountedIoAwaiter
+	{
+		UE::Tasks::FTaskEvent Event;
+		FPeakCounter* Waiting = nullptr;
+		FPeakCounter* OnWorkers = nullptr;
+		bool bSuspended = false;
+
+		bool await_ready() const { return Event.IsCompleted(); }
+
+		void await_suspend(std::coroutine_handle<> Handle)
+		{
+			bSuspended = true;
+			Waiting->Enter();
+
+			// 调度恢复任务后不再访问 this: 协程可能已在其他线程上恢复
+			FPeakCounter* LocalOnWorkers = OnWorkers;
+			const bool bOnWorker = LowLevelTasks::FScheduler::Get().IsWorkerThread();
+			if (bOnWorker)
+			{
+				LocalOnWorkers->Enter();
+			}
+			UE::TemplatesGuide::Private::ResumeAfter(Event, Handle);
+			if (bOnWorker)
+			{
+				LocalOnWorkers->Leave();
+			}
+		}
+
+		void await_resume()
+		{
+			if (bSuspended)
+			{
+				Waiting->Leave();
+			}
+		}
+	};
+
+	static UE::TemplatesGuide::FCoTask RunCoroutineOperation(const FBenchmarkContext* Context, FSimulatedIo* Io, FPeakCounter* Waiting, FPeakCounter* OnWorkers)
+	{
+		co_await UE::TemplatesGuide::ResumeOnWorker();
+		Context->Work();
+
+		co_await FCountedIoAwaiter{Io->Start(), Waiting, OnWorkers};
+
+		Context->Work();
+	}
+}
+
+// 示例25: 每个操作 "计算 → 等待 1ms IO → 计算", 阻塞 Wait 与 co_await 对比
+//   阻塞版本中等待 IO 的操作占着工作线程 (PeakWaitingOnWorkers), 吞吐量受工作线程数限制
+//   协程版本等待期间不占用工作线程, 所有操作的 IO 可以同时进行
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, CoroutineOccupancy, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace TasksBenchmark;
+
+	constexpr double IoLatencyMicroseconds = 1000.0;
+	const int32 NumOperations = FMath::Max(64, Context.GetIterations());
+
+	{
+		FSimulatedIo Io(IoLatencyMicroseconds);
+		FPeakCounter Waiting;
+		FPeakCounter OnWorkers;
+
+		FBenchmarkTimer Timer;
+		TArray<UE::Tasks::FTask> Operations;
+		Operations.Reserve(NumOperations);
+		for (int32 i = 0; i < NumOperations; ++i)
+		{
+			Operations.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Io, &Waiting, &OnWorkers]
+			{
+				Context.Work();
+
+				// 被 Wait(Operations) 撤回到调用线程上执行的操作不占工作线程
+				UE::Tasks::FTaskEvent IoEvent = Io.Start();
+				const bool bOnWorker = LowLevelTasks::FScheduler::Get().IsWorkerThread();
+				Waiting.Enter();
+				if (bOnWorker)
+				{
+					OnWorkers.Enter();
+				}
+				IoEvent.Wait();
+				if (bOnWorker)
+				{
+					OnWorkers.Leave();
+				}
+				Waiting.Leave();
+
+				Context.Work();
+			}));
+		}
+		UE::Tasks::Wait(Operations);
+
+		FBenchmarkResult& Result = Context.Report(TEXT("BlockingWait"), NumOperations, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("PeakWaiting"), Waiting.Peak.load());
+		Result.Metrics.Emplace(TEXT("PeakWaitingOnWorkers"), OnWorkers.Peak.load());
+	}
+
+	{
+		FSimulatedIo Io(IoLatencyMicroseconds);
+		FPeakCounter Waiting;
+		FPeakCounter OnWorkers;
+
+		FBenchmarkTimer Timer;
+		TArray<UE::TemplatesGuide::FCoTask> Operations;
+		Operations.Reserve(NumOperations);
+		for (int32 i = 0; i < NumOperations; ++i)
+		{
+			Operations.Add(RunCoroutineOperation(&Context, &Io, &Waiting, &OnWorkers));
+		}
+		for (const UE::TemplatesGuide::FCoTask& Operation : Operations)
+		{
+			Operation.Wait();
+		}
+
+		FBenchmarkResult& Result = Context.Report(TEXT("CoAwait"), NumOperations, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("PeakWaiting"), Waiting.Peak.load());
+		Result.Metrics.Emplace(TEXT("PeakWaitingOnWorkers"), OnWorkers.Peak.load());
+	}
+}
+#endif // UE_TEMPLATESGUIDE_WITH_COROUTINES
+
+namespace TasksBenchmark
+{
+	/** 重尾延迟的模拟请求: 约 5% 的 (请求, 尝试) 组合落在 20 倍的尾部, 等待期间每 100us 检查一次取消 */
+	static TOptional<int32> RunHeavyTailAttempt(const UE::Tasks::FCancellationToken& Token, int32 RequestIndex, int32 AttemptIndex)
+	{
+		const uint32 Hash = uint32(RequestIndex) * 2654435761u + uint32(AttemptIndex) * 40503u;
+		const double LatencySeconds = (Hash >> 16) % 20 == 0 ? 0.02 : 0.001;
+
+		const double EndTime = FPlatformTime::Seconds() + LatencySeconds;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+			if (Token.IsCanceled())
+			{
+				return {};
+			}
+			FPlatformProcess::Sleep(0.0001f);
+		}
+		return RequestIndex;
+	}
+
+	static void RunHedgedRequests(FBenchmarkContext& Context, const TCHAR* CaseName, int32 MaxAttempts)
+	{
+		using namespace UE::TemplatesGuide;
+
+		const int32 NumRequests = FMath::Clamp(Context.GetIterations(), 40, 400);
+
+		FHedgeParams Params;
+		Params.MaxAttempts = MaxAttempts;
+		Params.InitialDelayMicroseconds = 2000.0;
+		FHedgePolicy Policy(Params);
+
+		FLatencyRecorder Latency(NumRequests);
+		FBenchmarkTimer Timer;
+		for (int32 RequestIndex = 0; RequestIndex < NumRequests; ++RequestIndex)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+			UE::Tasks::TTask<TSpeculativeResult<int32>> Request = LaunchHedged<int32>(TEXT("HedgedRequest"),
+				[RequestIndex](const UE::Tasks::FCancellationToken& Token, int32 AttemptIndex)
+				{
+					return RunHeavyTailAttempt(Token, RequestIndex, AttemptIndex);
+				},
+				Policy);
+
+			check(Request.GetResult().Value.GetValue() == RequestIndex);
+			Latency.RecordSince(StartCycles);
+		}
+
+		const FHedgeStats Stats = Policy.GetStats();
+		FBenchmarkResult& Result = Context.Report(CaseName, NumRequests, Timer.GetSeconds(), &Latency);
+		Result.Metrics.Emplace(TEXT("BackupsPerRequest"), double(Stats.NumBackupAttempts) / NumRequests);
+		Result.Metrics.Emplace(TEXT("BackupWins"), double(Stats.NumBackupWins));
+		Result.Metrics.Emplace(TEXT("HedgeDelayUs"), Stats.CurrentDelayMicroseconds);
+	}
+}
+
+// 示例26: 重尾延迟请求 (5% 为 20 倍), 单次尝试与 P95 对冲对比
+//   P50/P99 列为单个请求从启动到得到结果的延迟; 对冲以约 5% 的额外尝试换取 P99 的下降
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, HedgedRequest, EBenchmarkFlags::None)
+{
+	using namespace TasksBenchmark;
+
+	RunHedgedRequests(Context, TEXT("SingleAttempt"), 1);
+	RunHedgedRequests(Context, TEXT("HedgedP95"), 2);
+}
+
+namespace TasksBenchmark
+{
+	/**
+	 * 每 "帧" 先用 BackgroundNormal 的填充任务占满工作线程, 再安排 16 个 8ms 截止时间的任务
+	 * 不提升时截止任务与填充任务同一优先级排队; 提升后在截止时间前插到填充任务之前
+	 */
+	static void RunDeadlineFrames(FBenchmarkContext& Context, const TCHAR* CaseName, LowLevelTasks::ETaskPriority PromotedPriority)
+	{
+		using namespace UE::TemplatesGuide;
+
+		constexpr int32 ItemsPerFrame = 16;
+		constexpr double FrameBudgetSeconds = 0.008;
+		const int32 NumFrames = FMath::Clamp(Context.GetIterations() / 10, 5, 50);
+		const int32 NumFillers = FMath::Max(1, Context.GetWorkers()) * 8;
+
+		FDeadlineSchedulerParams Params;
+		Params.BasePriority = LowLevelTasks::ETaskPriority::BackgroundNormal;
+		Params.PromotedPriority = PromotedPriority;
+		FDeadlineScheduler Scheduler(Params);
+
+		FDeadlineTaskParams TaskParams;
+		TaskParams.EstimatedMicroseconds = Context.GetConfig().WorkMicroseconds;
+
+		FBenchmarkTimer Timer;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TArray<UE::Tasks::FTask> Fillers;
+			for (int32 i = 0; i < NumFillers; ++i)
+			{
+				Fillers.Add(UE::Tasks::Launch(TEXT("DeadlineFiller"), [] { SpinWork(2000.0); }, LowLevelTasks::ETaskPriority::BackgroundNormal));
+			}
+
+			const double Deadline = FPlatformTime::Seconds() + FrameBudgetSeconds;
+			TArray<UE::Tasks::TTask<EDeadlineOutcome>> Items;
+			for (int32 i = 0; i < ItemsPerFrame; ++i)
+			{
+				Items.Add(Scheduler.Launch(TEXT("DeadlineItem"), Deadline, [&Context] { Context.Work(); }, TaskParams));
+			}
+
+			UE::Tasks::Wait(Items);
+			UE::Tasks::Wait(Fillers);
+		}
+
+		const FDeadlineSchedulerStats Stats = Scheduler.GetStats();
+		FBenchmarkResult& Result = Context.Report(CaseName, int64(NumFrames) * ItemsPerFrame, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("MissRate"), Stats.GetMissRate());
+		Result.Metrics.Emplace(TEXT("Promoted"), double(Stats.NumPromoted));
+		Result.Metrics.Emplace(TEXT("MeanLatenessUs"), Stats.MeanLatenessMicroseconds);
+		Result.Metrics.Emplace(TEXT("MaxLatenessUs"), Stats.MaxLatenessMicroseconds);
+	}
+}
+
+// 示例27: 工作线程被低优先级工作占满时, 截止时间任务的错过率
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, DeadlineScheduling, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace TasksBenchmark;
+
+	RunDeadlineFrames(Context, TEXT("NoPromotion"), LowLevelTasks::ETaskPriority::BackgroundNormal);
+	RunDeadlineFrames(Context, TEXT("PromoteToHigh"), LowLevelTasks::ETaskPriority::High);
+}
+
+namespace TasksBenchmark
+{
+	/**
+	 * 每次迭代启动 Workers 个父任务, 父任务等待一个子任务后做一份工作
+	 * 子任务的先决条件 (Producer) 已在其他工作线程上执行, 撤回无法完成子任务:
+	 * RetractThenBlock 的父任务阻塞占住工作线程, NeverBlockOnWorker 把剩余工作挂成续体
+	 */
+	static void RunWaitPolicy(FBenchmarkContext& Context, const TCHAR* CaseName, UE::TemplatesGuide::EWaitPolicy Policy)
+	{
+		using namespace UE::TemplatesGuide;
+
+		const int32 Iterations = FMath::Max(1, Context.GetIterations() / 10);
+		const int32 NumParents = FMath::Max(1, Context.GetWorkers());
+		FLatencyRecorder Latency(Iterations);
+
+		ResetWaitStats();
+		FBenchmarkTimer Timer;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 StartCycles = FLatencyRecorder::Now();
+
+			TArray<UE::Tasks::FTask> Parents;
+			Parents.Reserve(NumParents);
+			for (int32 i = 0; i < NumParents; ++i)
+			{
+				UE::Tasks::FTask Producer = UE::Tasks::Launch(TEXT("WaitPolicyProducer"), [&Context] { Context.Work(); });
+				UE::Tasks::FTask Child = UE::Tasks::Launch(TEXT("WaitPolicyChild"), [] {}, UE::Tasks::Prerequisites(Producer));
+
+				Parents.Add(UE::Tasks::Launch(TEXT("WaitPolicyParent"), [&Context, Child, Policy]
+				{
+					UE::Tasks::FTask Continuation = WaitOrContinue(TEXT("WaitPolicyContinuation"), Child,
+						[&Context] { Context.Work(); }, Policy);
+					if (Continuation.IsValid())
+					{
+						UE::Tasks::AddNested(Continuation);
+					}
+				}));
+			}
+
+			UE::Tasks::Wait(Parents);
+			Latency.RecordSince(StartCycles);
+		}
+
+		const FWaitStats Stats = GetWaitStats();
+		FBenchmarkResult& Result = Context.Report(CaseName, int64(Iterations) * NumParents, Timer.GetSeconds(), &Latency);
+		Result.Metrics.Emplace(TEXT("BlockedOnWorker"), double(Stats.NumBlockedOnWorker));
+		Result.Metrics.Emplace(TEXT("Deferred"), double(Stats.NumDeferred));
+		Result.Metrics.Emplace(TEXT("RetractionRate"), Stats.GetRetractionRate());
+		Result.Metrics.Emplace(TEXT("MeanBlockedUs"), Stats.NumBlocked > 0 ? Stats.TotalBlockedMicroseconds / Stats.NumBlocked : 0.0);
+	}
+}
+
+// 示例28: 工作线程上的等待, 阻塞与挂起续体对比 (P50/P99 为一轮父任务全部完成的时间)
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, WaitPolicy, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace TasksBenchmark;
+
+	RunWaitPolicy(Context, TEXT("RetractThenBlock"), UE::TemplatesGuide::EWaitPolicy::RetractThenBlock);
+	RunWaitPolicy(Context, TEXT("NeverBlockOnWorker"), UE::TemplatesGuide::EWaitPolicy::NeverBlockOnWorker);
+}
+
+namespace TasksBenchmark
+{
+	struct FPipelineBenchmarkItem
+	{
+		uint64 SubmitCycles = 0;
+	};
+
+	/**
+	 * 三阶段流水线 Read → Process → Upload, 每个阶段一份工作
+	 * Process 为 Parallel 时并发度等于工作线程数; 延迟为 "Submit 到 Upload 完成"
+	 */
+	static void RunPipeline(FBenchmarkContext& Context, const TCHAR* CaseName, UE::TemplatesGuide::EPipelineStageMode ProcessMode, int32 QueueCapacity)
+	{
+		using namespace UE::TemplatesGuide;
+
+		const int32 Iterations = Context.GetIterations();
+		FLatencyRecorder Latency(Iterations);
+
+		FPipelineStageParams SerialParams;
+		SerialParams.QueueCapacity = QueueCapacity;
+
+		FPipelineStageParams ProcessParams = SerialParams;
+		ProcessParams.Mode = ProcessMode;
+		ProcessParams.MaxConcurrency = uint32(FMath::Max(1, Context.GetWorkers()));
+
+		TArray<FPipelineStageStats> Stats;
+		FBenchmarkTimer Timer;
+		{
+			TTaskPipeline<FPipelineBenchmarkItem> Pipeline(CaseName);
+			Pipeline
+				.AddStage(TEXT("Read"), [&Context](FPipelineBenchmarkItem&) { Context.Work(); }, SerialParams)
+				.AddStage(TEXT("Process"), [&Context](FPipelineBenchmarkItem&) { Context.Work(); }, ProcessParams)
+				.AddStage(TEXT("Upload"), [&Context, &Latency](FPipelineBenchmarkItem& Item)
+				{
+					Context.Work();
+					Latency.RecordSince(Item.SubmitCycles);
+				}, SerialParams);
+
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Pipeline.Submit(FPipelineBenchmarkItem{FLatencyRecorder::Now()});
+			}
+			Pipeline.Wait();
+			Stats = Pipeline.GetStats();
+		}
+
+		FBenchmarkResult& Result = Context.Report(CaseName, Iterations, Timer.GetSeconds(), &Latency);
+		for (const FPipelineStageStats& Stage : Stats)
+		{
+			check(Stage.NumProcessed == Iterations);
+			Result.Metrics.Emplace(FString::Printf(TEXT("%sPeakQueue"), *Stage.Name), double(Stage.PeakQueueDepth));
+			Result.Metrics.Emplace(FString::Printf(TEXT("%sStalls"), *Stage.Name), double(Stage.NumBackpressureStalls));
+			Result.Metrics.Emplace(FString::Printf(TEXT("%sQueueWaitUs"), *Stage.Name), Stage.MeanQueueWaitMicroseconds);
+		}
+	}
+}
+
+// 示例29: 多阶段流水线 - 全串行 / 中间阶段并行 / 小队列容量下的背压
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, Pipeline, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace TasksBenchmark;
+	using UE::TemplatesGuide::EPipelineStageMode;
+
+	RunPipeline(Context, TEXT("AllSerial"), EPipelineStageMode::Serial, 16);
+	RunPipeline(Context, TEXT("ParallelProcess"), EPipelineStageMode::Parallel, 16);
+	RunPipeline(Context, TEXT("ParallelProcess/Cap2"), EPipelineStageMode::Parallel, 2);
+}
+
+// 示例30: 每次迭代向管道提交 BatchSize 个小任务, 逐个 Launch 与 FPipeBatchScope 合并对比
+// 延迟为 "第一个提交到最后一个任务体执行完"
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PipeBatch, EBenchmarkFlags::None)
+{
+	using namespace UE::TemplatesGuide;
+
+	const int32 Iterations = FMath::Max(1, Context.GetIterations() / 10);
+
+	for (const int32 BatchSize : {8, 64, 512})
+	{
+		{
+			FLatencyRecorder Latency(Iterations);
+			UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const uint64 StartCycles = FLatencyRecorder::Now();
+				UE::Tasks::FTask Last;
+				for (int32 i = 0; i < BatchSize; ++i)
+				{
+					Last = Pipe.Launch(TEXT("PipeBatchIndividual"), [&Context] { Context.Work(); });
+				}
+				Last.Wait();
+				Latency.RecordSince(StartCycles);
+			}
+			Pipe.WaitUntilEmpty();
+
+			Context.Report(*FString::Printf(TEXT("Individual/%d"), BatchSize), int64(Iterations) * BatchSize, Timer.GetSeconds(), &Latency);
+		}
+
+		{
+			FLatencyRecorder Latency(Iterations);
+			UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+
+			ResetPipeBatchStats();
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const uint64 StartCycles = FLatencyRecorder::Now();
+				UE::Tasks::FTask Last;
+				{
+					FPipeBatchScope Batch(Pipe, TEXT("PipeBatchFused"));
+					for (int32 i = 0; i < BatchSize; ++i)
+					{
+						Batch.Add(TEXT("PipeBatchEntry"), [&Context] { Context.Work(); });
+					}
+					Last = Batch.Flush();
+				}
+				Last.Wait();
+				Latency.RecordSince(StartCycles);
+			}
+			Pipe.WaitUntilEmpty();
+
+			const FPipeBatchStats Stats = GetPipeBatchStats();
+			FBenchmarkResult& Result = Context.Report(*FString::Printf(TEXT("Fused/%d"), BatchSize), int64(Iterations) * BatchSize, Timer.GetSeconds(), &Latency);
+			Result.Metrics.Emplace(TEXT("LaunchesSaved"), double(Stats.GetNumLaunchesSaved()));
+			Result.Metrics.Emplace(TEXT("FusedTasks"), double(Stats.NumFusedTasks));
+		}
+	}
+}
+
+// 示例31: 每次迭代从一个工作线程向 GameThread 投递 BatchSize 个闭包, 逐个 Launch 与 FNamedThreadBatcher 对比
+// 延迟为 "开始投递到 GameThread 执行完全部闭包"
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, NamedThreadBatch, EBenchmarkFlags::None)
+{
+	using namespace UE::TemplatesGuide;
+
+	check(IsInGameThread());
+
+	const int32 Iterations = FMath::Max(1, Context.GetIterations() / 10);
+	constexpr UE::Tasks::EExtendedTaskPriority GameThread = UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri;
+
+	for (const int32 BatchSize : {16, 256})
+	{
+		{
+			FLatencyRecorder Latency(Iterations);
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const uint64 StartCycles = FLatencyRecorder::Now();
+				UE::Tasks::TTask<TArray<UE::Tasks::FTask>> Producer = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, BatchSize]
+				{
+					TArray<UE::Tasks::FTask> Tasks;
+					Tasks.Reserve(BatchSize);
+					for (int32 i = 0; i < BatchSize; ++i)
+					{
+						Tasks.Add(UE::Tasks::Launch(TEXT("NamedThreadIndividual"), [&Context] { Context.Work(); },
+							LowLevelTasks::ETaskPriority::Normal, GameThread));
+					}
+					return Tasks;
+				});
+				UE::Tasks::Wait(Producer.GetResult());
+				Latency.RecordSince(StartCycles);
+			}
+
+			Context.Report(*FString::Printf(TEXT("Individual/%d"), BatchSize), int64(Iterations) * BatchSize, Timer.GetSeconds(), &Latency);
+		}
+
+		{
+			FLatencyRecorder Latency(Iterations);
+			FNamedThreadBatcher Batcher(TEXT("NamedThreadBatched"));
+
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const uint64 StartCycles = FLatencyRecorder::Now();
+				UE::Tasks::FTask Producer = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Batcher, BatchSize]
+				{
+					for (int32 i = 0; i < BatchSize; ++i)
+					{
+						Batcher.Enqueue(GameThread, TEXT("NamedThreadBatchEntry"), [&Context] { Context.Work(); });
+					}
+				});
+				Producer.Wait();
+				Batcher.Wait();
+				Latency.RecordSince(StartCycles);
+			}
+
+			const FNamedThreadBatchStats Stats = Batcher.GetStats();
+			FBenchmarkResult& Result = Context.Report(*FString::Printf(TEXT("Batched/%d"), BatchSize), int64(Iterations) * BatchSize, Timer.GetSeconds(), &Latency);
+			Result.Metrics.Emplace(TEXT("BatchTasks"), double(Stats.NumBatchTasks));
+			Result.Metrics.Emplace(TEXT("MeanBatchSize"), Stats.GetMeanBatchSize());
+			Result.Metrics.Emplace(TEXT("LaunchesSaved"), double(Stats.GetNumLaunchesSaved()));
+		}
+	}
+}
+
+// 示例31: 后台 CPU 工作, UE::Tasks 工作线程与绑定核心的专用线程 (线程数相同) 对比
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PinnedWorkerPool, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace UE::TemplatesGuide;
+
+	const int32 Iterations = Context.GetIterations();
+
+	{
+		FLatencyRecorder Latency(Iterations);
+		TArray<UE::Tasks::FTask> Tasks;
+		Tasks.Reserve(Iterations);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 LaunchCycles = FLatencyRecorder::Now();
+			Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Context, &Latency, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				Context.Work();
+			}, LowLevelTasks::ETaskPriority::BackgroundNormal));
+		}
+		UE::Tasks::Wait(Tasks);
+
+		Context.Report(TEXT("TasksBackground"), Iterations, Timer.GetSeconds(), &Latency);
+	}
+
+	{
+		FPinnedWorkerPoolParams Params;
+		Params.NumThreads = FMath::Max(1, Context.GetWorkers());
+		FPinnedWorkerPool Pool(TEXT("BenchmarkPinned"), Params);
+
+		FLatencyRecorder Latency(Iterations);
+		TArray<UE::Tasks::FTaskEvent> Events;
+		Events.Reserve(Iterations);
+
+		FBenchmarkTimer Timer;
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			const uint64 LaunchCycles = FLatencyRecorder::Now();
+			Events.Add(Pool.Launch(TEXT("PinnedWork"), [&Context, &Latency, LaunchCycles]
+			{
+				Latency.RecordSince(LaunchCycles);
+				Context.Work();
+			}));
+		}
+		UE::Tasks::Wait(Events);
+
+		const FPinnedWorkerPoolStats Stats = Pool.GetStats();
+		FBenchmarkResult& Result = Context.Report(TEXT("PinnedPool"), Iterations, Timer.GetSeconds(), &Latency);
+		Result.Metrics.Emplace(TEXT("PeakQueueDepth"), double(Stats.PeakQueueDepth));
+		Result.Metrics.Emplace(TEXT("AffinityCores"), double(FMath::CountBits(Pool.GetAffinityMask())));
+	}
+}
+
+namespace TasksBenchmark
+{
+	static const TCHAR* PriorityTunerCVarName = TEXT("TemplatesGuide.Benchmark.TunedBackgroundPriority");
+	static UE::Tasks::FTaskPriorityCVar PriorityTunerCVar{
+		PriorityTunerCVarName,
+		TEXT("Priority of the PriorityTuner benchmark's background flood"),
+		LowLevelTasks::ETaskPriority::High,
+		UE::Tasks::EExtendedTaskPriority::None
+	};
+
+	/**
+	 * 模拟帧: 每帧 Workers 个 Normal 优先级的帧任务 (各一份工作), 同时后台持续保持 2 * Workers 个泛洪任务在途,
+	 * 泛洪任务的优先级取自 PriorityTunerCVar (初始 High, 与帧任务抢工作线程)
+	 * bTune 时每帧把帧时间交给 FPriorityTuner, 预算为无泛洪时的基线帧时间
+	 */
+	static void RunPriorityTuner(FBenchmarkContext& Context, const TCHAR* CaseName, bool bTune, double BaselineFrameMilliseconds)
+	{
+		using namespace UE::TemplatesGuide;
+
+		IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(PriorityTunerCVarName);
+		ConsoleVariable->Set(TEXT("High"), ECVF_SetByCode);
+
+		FPriorityTunerParams Params;
+		Params.TargetFrameMilliseconds = BaselineFrameMilliseconds;
+		Params.FrameTolerance = 0.25;
+		Params.EvaluationIntervalFrames = 5;
+		Params.MinDwellFrames = 10;
+		FPriorityTuner Tuner(Params);
+
+		FPriorityTunerCategoryParams CategoryParams;
+		CategoryParams.HighestPriority = LowLevelTasks::ETaskPriority::High;
+		CategoryParams.LowestPriority = LowLevelTasks::ETaskPriority::BackgroundLow;
+		Tuner.RegisterCategory(TEXT("BenchmarkFlood"), PriorityTunerCVar, PriorityTunerCVarName, CategoryParams);
+
+		const int32 NumFrames = FMath::Max(10, Context.GetIterations() / 10);
+		const int32 NumFrameTasks = FMath::Max(1, Context.GetWorkers());
+		const double WorkMicroseconds = Context.GetConfig().WorkMicroseconds;
+		FLatencyRecorder Latency(NumFrames);
+
+		std::atomic<bool> bStopFlood{false};
+		std::atomic<int32> NumFloodInFlight{0};
+		TFunction<void()> LaunchFlood;
+		LaunchFlood = [&LaunchFlood, &bStopFlood, &NumFloodInFlight, WorkMicroseconds]
+		{
+			++NumFloodInFlight;
+			UE::Tasks::Launch(TEXT("PriorityTunerFlood"), [&LaunchFlood, &bStopFlood, &NumFloodInFlight, WorkMicroseconds]
+			{
+				SpinWork(WorkMicroseconds * 4.0);
+				if (!bStopFlood.load(std::memory_order_relaxed))
+				{
+					LaunchFlood();
+				}
+				--NumFloodInFlight;
+			}, PriorityTunerCVar.GetTaskPriority());
+		};
+		for (int32 i = 0; i < NumFrameTasks * 2; ++i)
+		{
+			LaunchFlood();
+		}
+
+		FBenchmarkTimer Timer;
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+		{
+			const uint64 FrameStartCycles = FLatencyRecorder::Now();
+
+			TArray<UE::Tasks::FTask> FrameTasks;
+			FrameTasks.Reserve(NumFrameTasks);
+			for (int32 i = 0; i < NumFrameTasks; ++i)
+			{
+				FrameTasks.Add(UE::Tasks::Launch(TEXT("PriorityTunerFrame"), [&Context] { Context.Work(); }));
+			}
+			UE::Tasks::Wait(FrameTasks);
+			Latency.RecordSince(FrameStartCycles);
+
+			if (bTune)
+			{
+				Tuner.Update(FPlatformTime::ToMilliseconds64(FLatencyRecorder::Now() - FrameStartCycles));
+			}
+		}
+		const double Seconds = Timer.GetSeconds();
+
+		bStopFlood = true;
+		while (NumFloodInFlight.load() > 0)
+		{
+			FPlatformProcess::Yield();
+		}
+
+		FBenchmarkResult& Result = Context.Report(CaseName, NumFrames, Seconds, &Latency);
+		Result.Metrics.Emplace(TEXT("Decisions"), double(Tuner.GetDecisions().Num()));
+		Result.Metrics.Emplace(TEXT("FinalFloodPriority"), double(PriorityTunerCVar.GetTaskPriority()));
+
+		ConsoleVariable->Set(TEXT("High"), ECVF_SetByCode);
+	}
+}
+
+// 示例32: 后台泛洪与帧任务抢工作线程, 固定优先级与 FPriorityTuner 调整对比 (P50/P99 为帧时间)
+UE_TEMPLATESGUIDE_BENCHMARK(Tasks, PriorityTuner, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace TasksBenchmark;
+
+	// 基线: 无泛洪时的帧时间
+	const int32 NumFrameTasks = FMath::Max(1, Context.GetWorkers());
+	const uint64 BaselineStartCycles = FLatencyRecorder::Now();
+	for (int32 FrameIndex = 0; FrameIndex < 10; ++FrameIndex)
+	{
+		TArray<UE::Tasks::FTask> FrameTasks;
+		for (int32 i = 0; i < NumFrameTasks; ++i)
+		{
+			FrameTasks.Add(UE::Tasks::Launch(TEXT("PriorityTunerBaseline"), [&Context] { Context.Work(); }));
+		}
+		UE::Tasks::Wait(FrameTasks);
+	}
+	const double BaselineFrameMilliseconds = FMath::Max(0.01, FPlatformTime::ToMilliseconds64(FLatencyRecorder::Now() - BaselineStartCycles) / 10.0);
+
+	RunPriorityTuner(Context, TEXT("FixedHigh"), false, BaselineFrameMilliseconds);
+	RunPriorityTuner(Context, TEXT("Tuned"), true, BaselineFrameMilliseconds);
+}
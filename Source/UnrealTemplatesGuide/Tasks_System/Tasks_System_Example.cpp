@@ -4,6 +4,23 @@
 #include "Tasks/Task.h"
 #include "Tasks/Pipe.h"
 #include "Tasks/TaskConcurrencyLimiter.h"
+#include "ParallelBatch.h"
+#include "PooledTaskBody.h"
+#include "TaskMailbox.h"
+#include "ArenaConcurrencyLimiter.h"
+#include "TaskCoroutine.h"
+#include "SpeculativeExecution.h"
+#include "DeadlineScheduler.h"
+#include "InstrumentedWait.h"
+#include "TaskPipeline.h"
+#include "PipeBatch.h"
+#include "NamedThreadBatcher.h"
+#include "PinnedWorkerPool.h"
+#include "PriorityTuner.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/IConsoleManager.h"
+#include "Profiling/TemplatesGuideTrace.h"
 
 ATasks_System_Example::ATasks_System_Example()
 {
@@ -41,6 +58,21 @@ void ATasks_System_Example::BeginPlay()
 	Example_PipedPrereqAndMoveOnlyResult();
 	Example_DeepRetraction_WaitTimeout();
 	
+	UE_LOG(LogTemp, Warning, TEXT("========== Extensions =========="));
+	
+	Example_ParallelBatch();
+	Example_PooledTaskBody();
+	Example_TaskMailbox();
+	Example_ArenaConcurrencyLimiter();
+	Example_Coroutines();
+	Example_SpeculativeExecution();
+	Example_DeadlineScheduler();
+	Example_InstrumentedWait();
+	Example_TaskPipeline();
+	Example_PipeBatch();
+	Example_NamedThreadBatching();
+	Example_PriorityTuner();
+	
 	UE_LOG(LogTemp, Warning, TEXT("========== Tasks System Examples End =========="));
 }
 
@@ -275,6 +307,25 @@ void ATasks_System_Example::Example_Prerequisites()
 	PrereqTasks);
 	
 	FinalTask.Wait();
+	
+	// --- 带追踪的同一条链 (Profiling/TemplatesGuideTrace.h) ---
+	// 开启 TemplatesGuide 通道后, Insights 中可以看到 TaskA → TaskB → TaskC 的依赖边
+	// 以及每个任务的启动 / 执行 / 等待范围
+	{
+		UE::TemplatesGuide::FTracedTask TracedA = UE::TemplatesGuide::LaunchTraced(TEXT("TracedTaskA"), []
+		{
+			FPlatformProcess::Sleep(0.01f);
+		});
+		UE::TemplatesGuide::FTracedTask TracedB = UE::TemplatesGuide::LaunchTraced(TEXT("TracedTaskB"), [] {},
+			UE::TemplatesGuide::TracedPrerequisites(TracedA));
+		UE::TemplatesGuide::FTracedTask TracedC = UE::TemplatesGuide::LaunchTraced(TEXT("TracedTaskC"), [] {},
+			UE::TemplatesGuide::TracedPrerequisites(TracedB));
+		
+		UE::TemplatesGuide::WaitTraced(TracedC);
+		check(TracedA.IsCompleted() && TracedB.IsCompleted());
+		UE_LOG(LogTemp, Log, TEXT("  Traced chain completed (trace ids: %llu -> %llu -> %llu)"),
+			TracedA.GetTraceId(), TracedB.GetTraceId(), TracedC.GetTraceId());
+	}
 }
 
 // ============================================================================
@@ -1090,7 +1141,8 @@ void ATasks_System_Example::Example_PipeAsAsyncClass()
 	public:
 		UE::Tasks::TTask<int32> Add(int32 Value)
 		{
-			return Pipe.Launch(TEXT("Add"), [this, Value]() -> int32
+			// LaunchTraced(Pipe, ...) 与 Pipe.Launch 相同, 额外输出管道入队 / 执行追踪
+			return UE::TemplatesGuide::LaunchTraced(Pipe, TEXT("Add"), [this, Value]() -> int32
 			{
 				Counter += Value;
 				return Counter;
@@ -1617,3 +1669,1110 @@ void ATasks_System_Example::Example_DeepRetraction_WaitTimeout()
 		UE_LOG(LogTemp, Log, TEXT("  FTaskEvent as joiner: all %d tasks joined"), NumTasks);
 	}
 }
+
+// ============================================================================
+// 示例21: LaunchBatched 分块批量启动 (ParallelBatch.h)
+// ============================================================================
+void ATasks_System_Example::Example_ParallelBatch()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 21] LaunchBatched (Chunked Parallel Launch)"));
+	
+	/*
+	 * 为每个小条目单独 Launch 时, 每个任务都要:
+	 *   - 分配 TExecutableTask (含任务体捕获)
+	 *   - 压入调度器队列, 唤醒工作线程
+	 *   - 完成时维护引用计数和后续任务列表
+	 * 条目只有几百纳秒的工作量时, 这些开销会超过工作本身
+	 *
+	 * LaunchBatched 只启动约 "工作线程数" 个任务, 每个任务循环领取块:
+	 *   - 块大小由 FBatchCostModel 的测量值决定 (首次调用使用 InitialChunkSize)
+	 *   - 块边界按缓存行对齐, 相邻块写入不会伪共享
+	 *   - 返回的 FTask 可以直接用作先决条件
+	 */
+	
+	constexpr int32 NumItems = 20000;
+	
+	TArray<float> Values;
+	Values.SetNumUninitialized(NumItems);
+	for (int32 i = 0; i < NumItems; ++i)
+	{
+		Values[i] = static_cast<float>(i);
+	}
+	
+	// 每个调用点一个耗时模型, 跨调用保留测量结果
+	static UE::TemplatesGuide::FBatchCostModel CostModel;
+	
+	UE::TemplatesGuide::FBatchLaunchParams Params;
+	Params.CostModel = &CostModel;
+	
+	// 两轮: 第一轮用 InitialChunkSize 并测量, 第二轮使用测量得到的块大小
+	for (int32 Round = 0; Round < 2; ++Round)
+	{
+		UE::Tasks::FTask Batch = UE::TemplatesGuide::LaunchBatched(UE_SOURCE_LOCATION, MakeArrayView(Values),
+			[](float& Value)
+			{
+				Value = FMath::Sqrt(Value * Value) + 1.0f;
+			},
+			Params);
+		
+		// 批量任务作为先决条件
+		UE::Tasks::FTask Verify = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Values, Round]
+		{
+			for (int32 i = 0; i < Values.Num(); ++i)
+			{
+				check(FMath::IsNearlyEqual(Values[i], static_cast<float>(i + Round + 1), 0.01f));
+			}
+		},
+		UE::Tasks::Prerequisites(Batch));
+		Verify.Wait();
+		
+		UE_LOG(LogTemp, Log, TEXT("  Round %d: %d items processed, cost model: %.1f ns/item"),
+			Round, NumItems, CostModel.GetNanosecondsPerItem());
+	}
+	
+	// 索引区间版本: RangeBody(Begin, End), 适合需要块内局部累加的场景
+	{
+		std::atomic<int64> Sum{0};
+		UE::Tasks::FTask RangeBatch = UE::TemplatesGuide::LaunchBatchedRange(UE_SOURCE_LOCATION, NumItems,
+			[&Sum](int32 Begin, int32 End)
+			{
+				int64 LocalSum = 0;
+				for (int32 i = Begin; i < End; ++i)
+				{
+					LocalSum += i;
+				}
+				Sum.fetch_add(LocalSum, std::memory_order_relaxed);
+			});
+		RangeBatch.Wait();
+		
+		check(Sum.load() == int64(NumItems) * (NumItems - 1) / 2);
+		UE_LOG(LogTemp, Log, TEXT("  Range sum: %lld"), Sum.load());
+	}
+}
+
+// ============================================================================
+// 示例22: LaunchPooled 池化任务体存储 (PooledTaskBody.h)
+// ============================================================================
+void ATasks_System_Example::Example_PooledTaskBody()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 22] LaunchPooled (Pooled Task Body Storage)"));
+	
+	/*
+	 * 示例11 的 Fire-and-Forget 模式如果捕获了较大的数据:
+	 *
+	 *   Launch(UE_SOURCE_LOCATION, [Payload]() mutable { ... });  // sizeof(Payload) = 256
+	 *
+	 * 任务体内联在 TExecutableTask 中, 任务对象超出小任务块后每次启动都是一次堆分配
+	 * LaunchPooled 把任务体放进线程本地的分级空闲链表, 任务对象本身只捕获一个指针
+	 */
+	
+	constexpr int32 NumTasks = 1000;
+	
+	struct FPayload
+	{
+		int32 Values[64];
+	};
+	
+	FPayload Payload;
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Payload.Values); ++i)
+	{
+		Payload.Values[i] = i;
+	}
+	
+	const UE::TemplatesGuide::FPooledTaskBodyStats Before = UE::TemplatesGuide::GetPooledTaskBodyStats();
+	
+	// --- 大捕获: 走分级池 ---
+	std::atomic<int32> Completed{0};
+	std::atomic<int64> Sum{0};
+	for (int32 i = 0; i < NumTasks; ++i)
+	{
+		// Fire-and-Forget + mutable lambda, 与示例11 相同
+		UE::TemplatesGuide::LaunchPooled(UE_SOURCE_LOCATION, [Payload, &Completed, &Sum]() mutable
+		{
+			Payload.Values[0] += 1;  // 修改的是池中的副本
+			Sum.fetch_add(Payload.Values[0] + Payload.Values[63], std::memory_order_relaxed);
+			Completed.fetch_add(1, std::memory_order_release);
+		});
+	}
+	while (Completed.load(std::memory_order_acquire) < NumTasks)
+	{
+		FPlatformProcess::Yield();
+	}
+	check(Sum.load() == int64(NumTasks) * (1 + 63));
+	
+	// --- 小捕获: 直接 Launch, 带返回值 ---
+	const int32 Result = UE::TemplatesGuide::LaunchPooled(UE_SOURCE_LOCATION, [] { return 42; }).GetResult();
+	check(Result == 42);
+	
+	const UE::TemplatesGuide::FPooledTaskBodyStats After = UE::TemplatesGuide::GetPooledTaskBodyStats();
+	UE_LOG(LogTemp, Log, TEXT("  Pooled: %lld, HeapFallbacks: %lld, Inline: %lld, Live: %lld"),
+		After.PooledAllocations - Before.PooledAllocations,
+		After.HeapFallbacks - Before.HeapFallbacks,
+		After.InlineBodies - Before.InlineBodies,
+		After.LiveBodies);
+#if UE_TEMPLATESGUIDE_POOLED_TASK_STATS
+	check(After.PooledAllocations - Before.PooledAllocations >= NumTasks);
+#endif
+}
+
+// ============================================================================
+// 示例23: TTaskMailbox 无锁 MPSC 邮箱 (TaskMailbox.h)
+// ============================================================================
+void ATasks_System_Example::Example_TaskMailbox()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 23] TTaskMailbox (Lock-Free MPSC Mailbox)"));
+	
+	/*
+	 * 与示例14 的 FAsyncCounter 公开形状相同, 但:
+	 *   - Add 不再为每次调用启动任务, 只把消息写入环形队列
+	 *   - 一个排空任务连续处理多条消息
+	 *   - 只有队列从空变为非空时才启动排空任务
+	 *
+	 * 需要返回值的调用 (GetValue) 随消息携带一个 FTaskEvent,
+	 * Handler 处理到该消息时写入结果并 Trigger
+	 */
+	
+	class FMailboxCounter
+	{
+	public:
+		void Add(int32 Value)
+		{
+			Mailbox.Post(FCommand{Value, nullptr});
+		}
+		
+		UE::Tasks::TTask<int32> GetValue()
+		{
+			TSharedRef<FValueReply, ESPMode::ThreadSafe> Reply = MakeShared<FValueReply, ESPMode::ThreadSafe>();
+			Mailbox.Post(FCommand{0, Reply});
+			
+			// Inline: 在 Trigger 的线程上直接完成, 不占用额外的调度
+			return UE::Tasks::Launch(TEXT("GetValue"), [Reply] { return Reply->Value; },
+				UE::Tasks::Prerequisites(Reply->Ready), LowLevelTasks::ETaskPriority::Normal, UE::Tasks::EExtendedTaskPriority::Inline);
+		}
+		
+		void WaitForEmpty()
+		{
+			Mailbox.WaitForEmpty();
+		}
+		
+		UE::TemplatesGuide::FTaskMailboxStats GetStats() const
+		{
+			return Mailbox.GetStats();
+		}
+		
+	private:
+		struct FValueReply
+		{
+			UE::Tasks::FTaskEvent Ready{UE_SOURCE_LOCATION};
+			int32 Value = 0;
+		};
+		
+		struct FCommand
+		{
+			int32 Delta = 0;
+			TSharedPtr<FValueReply, ESPMode::ThreadSafe> Reply;
+		};
+		
+		void Handle(FCommand& Command)
+		{
+			if (Command.Reply.IsValid())
+			{
+				Command.Reply->Value = Counter;
+				Command.Reply->Ready.Trigger();
+			}
+			else
+			{
+				Counter += Command.Delta;
+			}
+		}
+		
+		// Counter 在 Mailbox 之前声明: 邮箱析构时等待排空, Handler 仍可访问 Counter
+		int32 Counter = 0;
+		UE::TemplatesGuide::TTaskMailbox<FCommand> Mailbox{TEXT("FMailboxCounter"), [this](FCommand& Command) { Handle(Command); }};
+	};
+	
+	constexpr int32 NumCallers = 4;
+	constexpr int32 AddsPerCaller = 1000;
+	
+	FMailboxCounter MailboxCounter;
+	
+	// 可从多线程安全调用
+	TArray<UE::Tasks::FTask> Callers;
+	for (int32 CallerIndex = 0; CallerIndex < NumCallers; ++CallerIndex)
+	{
+		Callers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&MailboxCounter]
+		{
+			for (int32 i = 0; i < AddsPerCaller; ++i)
+			{
+				MailboxCounter.Add(1);
+			}
+		}));
+	}
+	UE::Tasks::Wait(Callers);
+	
+	// GetValue 排在所有 Add 之后, FIFO 保证看到全部结果
+	const int32 FinalValue = MailboxCounter.GetValue().GetResult();
+	MailboxCounter.WaitForEmpty();
+	
+	const UE::TemplatesGuide::FTaskMailboxStats Stats = MailboxCounter.GetStats();
+	UE_LOG(LogTemp, Log, TEXT("  MailboxCounter final value: %d (expected %d), %lld commands in %lld drain tasks"),
+		FinalValue, NumCallers * AddsPerCaller, Stats.NumCommands, Stats.NumDrains);
+	check(FinalValue == NumCallers * AddsPerCaller);
+	check(Stats.NumDrains <= Stats.NumCommands);
+}
+
+// ============================================================================
+// 示例24: FArenaConcurrencyLimiter 每槽位暂存内存与自适应并发度 (ArenaConcurrencyLimiter.h)
+// ============================================================================
+void ATasks_System_Example::Example_ArenaConcurrencyLimiter()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 24] FArenaConcurrencyLimiter - Per-Slot Scratch Arenas"));
+	
+	/*
+	 * 示例18 中 Slot 可以无同步地索引固定缓冲区
+	 * FArenaConcurrencyLimiter 为每个槽位预分配一块暂存内存 (FScratchArena):
+	 *
+	 *   Limiter.Push(UE_SOURCE_LOCATION, [](uint32 Slot, FScratchArena& Arena)
+	 *   {
+	 *       TArrayView<uint8> Buffer = Arena.AllocateArray<uint8>(16 * 1024);  // 无堆分配
+	 *       ...
+	 *   });  // 任务结束后 Arena 整体 Reset
+	 *
+	 * bAdaptive: 排队等待时间 EMA 超过 TargetQueueWaitMicroseconds 时增加并发度,
+	 *            低于其 1/4 时减少, 范围 [MinConcurrency, MaxConcurrency]
+	 */
+	
+	constexpr uint32 MaxConcurrency = 4;
+	constexpr int32 NumJobs = 64;
+	constexpr int32 ScratchBytes = 16 * 1024;
+	
+	UE::TemplatesGuide::FArenaConcurrencyLimiterParams Params;
+	Params.MaxConcurrency = MaxConcurrency;
+	Params.InitialConcurrency = 1;
+	Params.ArenaBytesPerSlot = 32 * 1024;
+	Params.bAdaptive = true;
+	Params.TargetQueueWaitMicroseconds = 200.0;
+	Params.AdaptIntervalItems = 4;
+	
+	UE::TemplatesGuide::FArenaConcurrencyLimiter Limiter(Params);
+	
+	// 每个槽位一个占用标记, 验证同一槽位不会被两个任务同时使用
+	std::atomic<bool> SlotInUse[MaxConcurrency] = {};
+	std::atomic<int64> Checksum{0};
+	
+	for (int32 Job = 0; Job < NumJobs; ++Job)
+	{
+		Limiter.Push(UE_SOURCE_LOCATION, [&SlotInUse, &Checksum, Job](uint32 Slot, UE::TemplatesGuide::FScratchArena& Arena)
+		{
+			check(Slot < MaxConcurrency);
+			check(!SlotInUse[Slot].exchange(true));
+			
+			// 模拟解压: 在暂存内存中展开数据
+			check(Arena.GetUsed() == 0);
+			TArrayView<uint8> Buffer = Arena.AllocateArray<uint8>(ScratchBytes);
+			FMemory::Memset(Buffer.GetData(), uint8(Job), Buffer.Num());
+			
+			int64 LocalSum = 0;
+			for (uint8 Byte : Buffer)
+			{
+				LocalSum += Byte;
+			}
+			Checksum.fetch_add(LocalSum);
+			
+			FPlatformProcess::Sleep(0.001f);  // 模拟 IO
+			SlotInUse[Slot].store(false);
+		});
+	}
+	Limiter.Wait();
+	
+	int64 ExpectedChecksum = 0;
+	for (int32 Job = 0; Job < NumJobs; ++Job)
+	{
+		ExpectedChecksum += int64(uint8(Job)) * ScratchBytes;
+	}
+	check(Checksum.load() == ExpectedChecksum);
+	
+	const UE::TemplatesGuide::FArenaConcurrencyLimiterStats Stats = Limiter.GetStats();
+	check(Stats.NumCompleted == NumJobs);
+	check(Stats.ArenaOverflows == 0);
+	
+	FString Utilization;
+	for (int32 Slot = 0; Slot < Stats.SlotUtilization.Num(); ++Slot)
+	{
+		Utilization += FString::Printf(TEXT("%d:%.0f%%(%lld) "), Slot, Stats.SlotUtilization[Slot] * 100.0, Stats.SlotTasks[Slot]);
+	}
+	UE_LOG(LogTemp, Log, TEXT("  Completed %lld jobs, concurrency %u (+%lld/-%lld), arena high water %llu bytes"),
+		Stats.NumCompleted, Stats.CurrentConcurrency, Stats.NumConcurrencyIncreases, Stats.NumConcurrencyDecreases,
+		uint64(Stats.ArenaHighWaterBytes));
+	UE_LOG(LogTemp, Log, TEXT("  Slot utilization: %s"), *Utilization);
+	UE_LOG(LogTemp, Log, TEXT("  Queue wait histogram: %s"), *Stats.HistogramToString());
+}
+
+// ============================================================================
+// 示例25: TCoTask 协程 co_await 任务 / 事件 / Future
+// ============================================================================
+#if UE_TEMPLATESGUIDE_WITH_COROUTINES
+namespace TasksCoroutineExample
+{
+	using namespace UE::TemplatesGuide;
+
+	// 协程的状态通过参数传递 (按值复制进协程帧), 不使用 Lambda 捕获
+	static TCoTask<int32> DoubleOnWorker(int32 Value)
+	{
+		co_await ResumeOnWorker();
+		
+		// co_await TTask<int32>: 挂起直到任务完成, 返回 GetResult()
+		const int32 Doubled = co_await UE::Tasks::Launch(UE_SOURCE_LOCATION, [Value] { return Value * 2; });
+		co_return Doubled;
+	}
+
+	static TCoTask<FString> AwaitEverything(UE::Tasks::FTaskEvent IoEvent, TFuture<int32> Future)
+	{
+		co_await ResumeOnWorker();
+		const uint32 StartThreadId = FPlatformTLS::GetCurrentThreadId();
+		
+		// 子协程
+		const int32 A = co_await DoubleOnWorker(21);
+		
+		// FTaskEvent: 等待期间不占用工作线程
+		co_await IoEvent;
+		
+		// TFuture<int32>
+		const int32 B = co_await MoveTemp(Future);
+		
+		// FTask
+		co_await UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {});
+		
+		// 每个挂起点之后都可能换到另一个工作线程
+		const uint32 EndThreadId = FPlatformTLS::GetCurrentThreadId();
+		co_return FString::Printf(TEXT("A=%d B=%d (started on thread %u, finished on thread %u)"), A, B, StartThreadId, EndThreadId);
+	}
+}
+#endif
+
+void ATasks_System_Example::Example_Coroutines()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 25] Coroutines (co_await Tasks / Events / Futures)"));
+	
+	/*
+	 * 示例5 的注释提到: 在任务中 SubTask.Wait() 阻塞会占住一个工作线程
+	 * (可等待对象能被撤回时 Wait 会就地执行它, 等待 IO 事件等外部完成时则真正阻塞)
+	 * 
+	 * TCoTask (TaskCoroutine.h) 在等待处挂起:
+	 *   co_await Task / Event / MoveTemp(Future) / ChildCoroutine
+	 *     → 工作线程立即返回调度器
+	 *     → 被等待对象完成后 Launch(Resume, Prerequisites(...)) 在任意工作线程上继续
+	 * 
+	 * 基准 Tasks.CoroutineOccupancy 对比阻塞 Wait 与 co_await 在等待模拟 IO 时的工作线程占用
+	 */
+	
+#if UE_TEMPLATESGUIDE_WITH_COROUTINES
+	using namespace UE::TemplatesGuide;
+	
+	UE::Tasks::FTaskEvent IoEvent(UE_SOURCE_LOCATION);
+	TPromise<int32> Promise;
+	
+	TCoTask<FString> Task = TasksCoroutineExample::AwaitEverything(IoEvent, Promise.GetFuture());
+	
+	// 模拟 IO 完成: 另一个线程稍后触发事件并设置 Promise
+	Async(EAsyncExecution::Thread, [IoEvent, Promise = MoveTemp(Promise)]() mutable
+	{
+		FPlatformProcess::Sleep(0.01f);
+		IoEvent.Trigger();
+		Promise.SetValue(100);
+	});
+	
+	// TCoTask 可以像任务一样等待, 也可以把 GetEvent() 作为先决条件
+	UE::Tasks::FTaskEvent CompletionEvent = Task.GetEvent();
+	UE::Tasks::FTask AfterCoroutine = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {}, UE::Tasks::Prerequisites(CompletionEvent));
+	
+	const FString& Result = Task.GetResult();
+	AfterCoroutine.Wait();
+	check(Result.StartsWith(TEXT("A=42 B=100")));
+	UE_LOG(LogTemp, Log, TEXT("  Coroutine result: %s"), *Result);
+#else
+	UE_LOG(LogTemp, Log, TEXT("  Coroutines are not available with this compiler configuration"));
+#endif
+}
+
+// ============================================================================
+// 示例26: LaunchRace / LaunchHedged 推测执行
+// ============================================================================
+void ATasks_System_Example::Example_SpeculativeExecution()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 26] Speculative Execution (Race / Hedged Request)"));
+	
+	/*
+	 * 示例8 中取消需要手动管理 Token; SpeculativeExecution.h 把它用于推测执行:
+	 * 
+	 *   LaunchRace(Name, { StrategyA, StrategyB, ... })
+	 *     所有方案同时启动, 第一个返回非空 TOptional 的方案胜出,
+	 *     通过共享 Token 取消其余方案, 结果任务立即完成
+	 * 
+	 *   LaunchHedged(Name, Attempt, Policy)
+	 *     首次尝试超过 Policy 记录的 P95 延迟仍未完成时才启动备份尝试
+	 *     (或首次尝试放弃时立即启动), 胜出尝试的延迟反馈到 Policy
+	 * 
+	 * 方案应定期检查 Token (或 FCancellationTokenScope::IsCurrentWorkCanceled()) 并尽早返回
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	// 可取消的 "工作": 每 1ms 检查一次 Token, 被取消时返回 false
+	const auto CancellableSleep = [](const UE::Tasks::FCancellationToken& Token, int32 Milliseconds)
+	{
+		for (int32 i = 0; i < Milliseconds; ++i)
+		{
+			if (Token.IsCanceled())
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	};
+	
+	// --- 竞速: 缓存查找 vs 重新计算 ---
+	{
+		std::atomic<bool> bRecomputeCanceled{false};
+		
+		TArray<TSpeculativeStrategy<int32>> Strategies;
+		
+		// 缓存命中: 很快返回结果
+		Strategies.Add([](const UE::Tasks::FCancellationToken&) -> TOptional<int32>
+		{
+			return 42;
+		});
+		
+		// 重新计算: 50ms, 期间被取消
+		Strategies.Add([&CancellableSleep, &bRecomputeCanceled](const UE::Tasks::FCancellationToken& Token) -> TOptional<int32>
+		{
+			if (!CancellableSleep(Token, 50))
+			{
+				bRecomputeCanceled = true;
+				return {};
+			}
+			return 42;
+		});
+		
+		UE::Tasks::TTask<TSpeculativeResult<int32>> Race = LaunchRace(UE_SOURCE_LOCATION, MoveTemp(Strategies));
+		const TSpeculativeResult<int32>& Result = Race.GetResult();
+		check(Result.IsSet() && Result.Value.GetValue() == 42);
+		check(Result.WinnerIndex == 0);
+		UE_LOG(LogTemp, Log, TEXT("  Race (cache hit): winner %d, value %d"), Result.WinnerIndex, Result.Value.GetValue());
+		
+		// 胜出后结果立即可用, 落败方案随后在看到取消时结束 (这里为了检查而等待它)
+		while (!bRecomputeCanceled)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+	
+	// --- 竞速: 缓存未命中 (返回空值) 时由重新计算胜出 ---
+	{
+		TArray<TSpeculativeStrategy<FString>> Strategies;
+		Strategies.Add([](const UE::Tasks::FCancellationToken&) -> TOptional<FString>
+		{
+			return {};
+		});
+		Strategies.Add([&CancellableSleep](const UE::Tasks::FCancellationToken& Token) -> TOptional<FString>
+		{
+			CancellableSleep(Token, 5);
+			return FString(TEXT("Recomputed"));
+		});
+		
+		UE::Tasks::TTask<TSpeculativeResult<FString>> Race = LaunchRace(UE_SOURCE_LOCATION, MoveTemp(Strategies));
+		const TSpeculativeResult<FString>& Result = Race.GetResult();
+		check(Result.WinnerIndex == 1);
+		UE_LOG(LogTemp, Log, TEXT("  Race (cache miss): winner %d, value %s"), Result.WinnerIndex, *Result.Value.GetValue());
+	}
+	
+	// --- 对冲请求: 首次尝试落在尾部, 备份尝试胜出 ---
+	{
+		FHedgeParams Params;
+		Params.InitialDelayMicroseconds = 2000.0;
+		FHedgePolicy Policy(Params);
+		
+		// 首次尝试 100ms (尾延迟), 备份尝试 1ms
+		UE::Tasks::TTask<TSpeculativeResult<int32>> Request = LaunchHedged<int32>(UE_SOURCE_LOCATION,
+			[CancellableSleep](const UE::Tasks::FCancellationToken& Token, int32 AttemptIndex) -> TOptional<int32>
+			{
+				if (!CancellableSleep(Token, AttemptIndex == 0 ? 100 : 1))
+				{
+					return {};
+				}
+				return AttemptIndex;
+			},
+			Policy);
+		
+		const TSpeculativeResult<int32>& Result = Request.GetResult();
+		check(Result.WinnerIndex == 1);
+		
+		const FHedgeStats Stats = Policy.GetStats();
+		check(Stats.NumBackupWins == 1);
+		UE_LOG(LogTemp, Log, TEXT("  Hedged: winner attempt %d, backups %lld, hedge delay %.0fus"),
+			Result.WinnerIndex, Stats.NumBackupAttempts, Stats.CurrentDelayMicroseconds);
+	}
+}
+
+// ============================================================================
+// 示例27: FDeadlineScheduler 截止时间调度
+// ============================================================================
+void ATasks_System_Example::Example_DeadlineScheduler()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 27] Deadline Scheduling"));
+	
+	/*
+	 * 示例9 (优先级) 与示例20 (Wait 超时) 合在一起: 任务带绝对截止时间启动
+	 * 
+	 *   Deadline ────────────────────────────────────────────────┐
+	 *   Launch ─► BasePriority 副本 ... [提升点] ─► PromotedPriority 副本
+	 *                                   = Deadline - Estimated - PromotionLead
+	 *   先开始执行的副本认领任务体; 开始时已来不及完成且 MissPolicy == Drop 则丢弃
+	 * 
+	 * 提升后的优先级可以来自 FTaskPriorityCVar (示例17), 运行时在控制台调整
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	static UE::Tasks::FTaskPriorityCVar PromotedPriorityCVar{
+		TEXT("TasksExample.DeadlinePromotedPriority"),
+		TEXT("Priority that deadline tasks are promoted to as their deadline approaches"),
+		LowLevelTasks::ETaskPriority::High,
+		UE::Tasks::EExtendedTaskPriority::None
+	};
+	
+	FDeadlineSchedulerParams Params;
+	Params.BasePriority = LowLevelTasks::ETaskPriority::BackgroundNormal;
+	Params.PromotedPriority = PromotedPriorityCVar.GetTaskPriority();
+	FDeadlineScheduler Scheduler(Params);
+	
+	// 一帧 16.6ms 内要完成的工作: 每个约 1ms
+	const double FrameDeadline = FPlatformTime::Seconds() + 0.0166;
+	
+	FDeadlineTaskParams TaskParams;
+	TaskParams.EstimatedMicroseconds = 1000.0;
+	TaskParams.MissPolicy = EDeadlineMissPolicy::Drop;
+	
+	TArray<UE::Tasks::TTask<EDeadlineOutcome>> Outcomes;
+	for (int32 i = 0; i < 8; ++i)
+	{
+		Outcomes.Add(Scheduler.Launch(UE_SOURCE_LOCATION, FrameDeadline, []
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}, TaskParams));
+	}
+	
+	// 截止时间已过: 以 Drop 策略启动时任务体不会执行
+	bool bLateBodyRan = false;
+	UE::Tasks::TTask<EDeadlineOutcome> Expired = Scheduler.Launch(UE_SOURCE_LOCATION, FPlatformTime::Seconds() - 0.001,
+		[&bLateBodyRan] { bLateBodyRan = true; }, TaskParams);
+	
+	check(Expired.GetResult() == EDeadlineOutcome::Dropped);
+	check(!bLateBodyRan);
+	
+	UE::Tasks::Wait(Outcomes);
+	
+	const FDeadlineSchedulerStats Stats = Scheduler.GetStats();
+	check(Stats.NumOnTime + Stats.NumLate + Stats.NumDropped == Stats.NumLaunched);
+	UE_LOG(LogTemp, Log, TEXT("  Launched %lld: on time %lld, late %lld, dropped %lld, promoted %lld (miss rate %.0f%%)"),
+		Stats.NumLaunched, Stats.NumOnTime, Stats.NumLate, Stats.NumDropped, Stats.NumPromoted, Stats.GetMissRate() * 100.0);
+}
+
+// ============================================================================
+// 示例28: InstrumentedWait 可计量的撤回优先等待
+// ============================================================================
+void ATasks_System_Example::Example_InstrumentedWait()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 28] Instrumented Wait"));
+	
+	/*
+	 * 示例20 的 Wait() 先撤回再阻塞, 但调用方看不到走了哪条路径:
+	 * 
+	 *   InstrumentedWait(Task) → FWaitReport
+	 *     bAlreadyCompleted / bRetracted (RetractMicroseconds) / bBlocked (BlockedMicroseconds)
+	 *     bNotAwaitable: 等待会死锁 (示例13), 不等待
+	 *     bOnWorkerThread: 阻塞发生在工作线程上
+	 * 
+	 * WaitOrContinue(..., NeverBlockOnWorker): 工作线程上撤回失败时不阻塞,
+	 * 把剩余工作作为以 Task 为先决条件的续体启动
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	ResetWaitStats();
+	
+	// 场景1: 撤回 - 结果取决于调度 (工作线程可能已经取走了任务), 只打印
+	{
+		UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {});
+		const FWaitReport Report = InstrumentedWait(Task);
+		check(Report.IsCompleted());
+		UE_LOG(LogTemp, Log, TEXT("  Short task: already=%d retracted=%d blocked=%d (retract %.1fus, blocked %.1fus)"),
+			Report.bAlreadyCompleted, Report.bRetracted, Report.bBlocked, Report.RetractMicroseconds, Report.BlockedMicroseconds);
+	}
+	
+	// 场景2: 任务已在其他线程执行, 撤回失败, 只能阻塞
+	{
+		std::atomic<bool> bStarted{false};
+		UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&bStarted]
+		{
+			bStarted = true;
+			FPlatformProcess::Sleep(0.005f);
+		});
+		while (!bStarted)
+		{
+			FPlatformProcess::Yield();
+		}
+		
+		const FWaitReport Report = InstrumentedWait(Task);
+		check(Report.bBlocked && !Report.bRetracted && Report.IsCompleted());
+		UE_LOG(LogTemp, Log, TEXT("  Running task: blocked for %.0fus"), Report.BlockedMicroseconds);
+	}
+	
+	// 场景3: 工作线程上不阻塞 - 被等待的任务在等事件, 续体挂在它之后
+	{
+		UE::Tasks::FTaskEvent Blocker{UE_SOURCE_LOCATION};
+		UE::Tasks::FTask Slow = UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {}, UE::Tasks::Prerequisites(Blocker));
+		
+		FWaitReport Report;
+		std::atomic<bool> bWaited{false};
+		bool bContinued = false;
+		UE::Tasks::FTask Outer = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Slow, &Report, &bWaited, &bContinued]
+		{
+			UE::Tasks::FTask Continuation = WaitOrContinue(UE_SOURCE_LOCATION, Slow,
+				[&bContinued] { bContinued = true; }, EWaitPolicy::NeverBlockOnWorker, &Report);
+			
+			// 续体作为嵌套任务: Outer 在续体完成后才完成
+			if (Continuation.IsValid())
+			{
+				UE::Tasks::AddNested(Continuation);
+			}
+			bWaited = true;
+		});
+		
+		// 不要在这里 Outer.Wait(): 撤回会把 Outer 拉到本线程执行, 非工作线程上的等待仍会阻塞
+		while (!bWaited)
+		{
+			FPlatformProcess::Yield();
+		}
+		check(Report.bDeferred && Report.bOnWorkerThread && !Report.bBlocked);
+		check(!Outer.IsCompleted());
+		
+		Blocker.Trigger();
+		Outer.Wait();
+		check(bContinued);
+		UE_LOG(LogTemp, Log, TEXT("  Worker wait deferred as continuation (no worker blocked)"));
+	}
+	
+	// 场景4: 在任务内部等待自身 (示例13 的死锁) - 不等待, 续体排在任务之后
+	{
+		UE::Tasks::FTask Continuation;
+		bool bContinued = false;
+		UE::Tasks::FTask Task;
+		Task.Launch(UE_SOURCE_LOCATION, [&Task, &Continuation, &bContinued]
+		{
+			FWaitReport Report;
+			Continuation = WaitOrContinue(UE_SOURCE_LOCATION, Task,
+				[&bContinued] { bContinued = true; }, EWaitPolicy::RetractThenBlock, &Report);
+			check(Report.bNotAwaitable && Report.bDeferred);
+		});
+		
+		Task.Wait();
+		Continuation.Wait();
+		check(bContinued);
+		UE_LOG(LogTemp, Log, TEXT("  Self-wait avoided deadlock"));
+	}
+	
+	const FWaitStats Stats = GetWaitStats();
+	UE_LOG(LogTemp, Log, TEXT("  Waits %lld: retracted %lld, blocked %lld (on worker %lld), deferred %lld, not awaitable %lld, max blocked %.0fus"),
+		Stats.NumWaits, Stats.NumRetracted, Stats.NumBlocked, Stats.NumBlockedOnWorker, Stats.NumDeferred, Stats.NumNotAwaitable,
+		Stats.MaxBlockedMicroseconds);
+}
+
+// ============================================================================
+// 示例29: TTaskPipeline 多阶段流式流水线
+// ============================================================================
+void ATasks_System_Example::Example_TaskPipeline()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 29] Task Pipeline"));
+	
+	/*
+	 * 资源导入: read → decompress → parse → upload, 不同条目同时处于不同阶段
+	 * 
+	 *   Read       串行 (FPipe, 示例6): 顺序读盘
+	 *   Decompress 并行 4 (FTaskConcurrencyLimiter, 示例18): CPU 密集
+	 *   Parse      并行 2
+	 *   Upload     串行: 上传通道只有一条, 队列容量小, 上游被背压拖住
+	 * 
+	 * 阶段之间的队列有上限: 下游满时上游不再启动新条目, Submit 在第一个队列满时阻塞调用线程
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	struct FIngestItem
+	{
+		int32 Index = 0;
+		TArray<uint8> Compressed;
+		TArray<uint8> Decompressed;
+		int32 Checksum = 0;
+	};
+	
+	std::atomic<int32> NumUploaded{0};
+	std::atomic<int64> ChecksumSum{0};
+	int32 LastRead = -1;
+	
+	FPipelineStageParams ReadParams;
+	ReadParams.QueueCapacity = 4;
+	
+	FPipelineStageParams DecompressParams;
+	DecompressParams.Mode = EPipelineStageMode::Parallel;
+	DecompressParams.MaxConcurrency = 4;
+	DecompressParams.QueueCapacity = 8;
+	
+	FPipelineStageParams ParseParams;
+	ParseParams.Mode = EPipelineStageMode::Parallel;
+	ParseParams.MaxConcurrency = 2;
+	ParseParams.QueueCapacity = 8;
+	
+	FPipelineStageParams UploadParams;
+	UploadParams.QueueCapacity = 2;
+	UploadParams.MaxInFlight = 1;
+	
+	constexpr int32 NumItems = 64;
+	{
+		TTaskPipeline<FIngestItem> Pipeline(TEXT("AssetIngest"));
+		Pipeline
+			.AddStage(TEXT("Read"), [&LastRead](FIngestItem& Item)
+			{
+				// 串行阶段按提交顺序执行, 且同一时刻只有一个条目在执行
+				check(Item.Index == LastRead + 1);
+				LastRead = Item.Index;
+				Item.Compressed.Init(uint8(Item.Index), 256);
+			}, ReadParams)
+			.AddStage(TEXT("Decompress"), [](FIngestItem& Item)
+			{
+				Item.Decompressed.Reserve(Item.Compressed.Num() * 4);
+				for (int32 Repeat = 0; Repeat < 4; ++Repeat)
+				{
+					Item.Decompressed.Append(Item.Compressed);
+				}
+				Item.Compressed.Empty();
+				FPlatformProcess::Sleep(0.0005f);
+			}, DecompressParams)
+			.AddStage(TEXT("Parse"), [](FIngestItem& Item)
+			{
+				for (uint8 Byte : Item.Decompressed)
+				{
+					Item.Checksum += Byte;
+				}
+			}, ParseParams)
+			.AddStage(TEXT("Upload"), [&NumUploaded, &ChecksumSum](FIngestItem& Item)
+			{
+				FPlatformProcess::Sleep(0.001f);
+				ChecksumSum += Item.Checksum;
+				++NumUploaded;
+			}, UploadParams);
+		
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			Pipeline.Submit(FIngestItem{i});
+		}
+		
+		// 第一个队列满时 TrySubmit 不阻塞, 把条目还给调用方
+		FIngestItem Extra{NumItems};
+		while (!Pipeline.TrySubmit(Extra))
+		{
+			FPlatformProcess::Yield();
+		}
+		
+		Pipeline.Wait();
+		
+		for (const FPipelineStageStats& Stats : Pipeline.GetStats())
+		{
+			check(Stats.NumProcessed == NumItems + 1 && Stats.QueueDepth == 0 && Stats.NumRunning == 0);
+			UE_LOG(LogTemp, Log, TEXT("  %-10s %s: %lld items, %.0f/s, peak queue %d, mean queue wait %.0fus, stalls %lld"),
+				*Stats.Name, Stats.Mode == EPipelineStageMode::Serial ? TEXT("serial  ") : TEXT("parallel"),
+				Stats.NumProcessed, Stats.ThroughputPerSecond, Stats.PeakQueueDepth, Stats.MeanQueueWaitMicroseconds,
+				Stats.NumBackpressureStalls);
+		}
+	}
+	
+	// 每个条目的校验和 = 1024 * Index (按 uint8 截断)
+	int64 ExpectedSum = 0;
+	for (int32 i = 0; i <= NumItems; ++i)
+	{
+		ExpectedSum += 1024 * int64(uint8(i));
+	}
+	check(NumUploaded == NumItems + 1);
+	check(ChecksumSum == ExpectedSum);
+}
+
+// ============================================================================
+// 示例30: FPipeBatchScope 管道批量提交
+// ============================================================================
+void ATasks_System_Example::Example_PipeBatch()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 30] Pipe Batch Scope"));
+	
+	/*
+	 * 示例15 挂起管道后逐个 Launch, 恢复时仍是 N 次调度; FPipeBatchScope 在本地收集任务体,
+	 * 作用域结束时作为一个管道任务按 Add 顺序执行:
+	 * 
+	 *   {
+	 *       FPipeBatchScope Batch(Pipe, TEXT("Batch"));
+	 *       Batch.Add(TEXT("A"), ...);  Batch.Add(TEXT("B"), ...);  ...
+	 *   }   // 析构: Pipe.Launch(TEXT("Batch"), [A, B, ...])
+	 * 
+	 * 顺序: 批内按 Add 顺序; 整批排在 Flush 之前启动到管道上的任务之后
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	ResetPipeBatchStats();
+	
+	UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+	TArray<int32> Order;
+	
+	// 批之前启动的普通管道任务先执行
+	Pipe.Launch(UE_SOURCE_LOCATION, [&Order] { Order.Add(-1); });
+	
+	UE::Tasks::FTask BatchTask;
+	{
+		FPipeBatchScope Batch(Pipe, TEXT("OrderedBatch"));
+		for (int32 i = 0; i < 100; ++i)
+		{
+			Batch.Add(TEXT("AppendIndex"), [&Order, i] { Order.Add(i); });
+		}
+		check(Batch.GetNumPending() == 100);
+		
+		BatchTask = Batch.Flush();
+		check(Batch.GetNumFusedTasks() == 1 && Batch.GetNumFused() == 100);
+	}
+	
+	// 上限: 每 16 个任务体自动 Flush 一次, 限制单个融合任务的执行时间
+	FPipeBatchParams ChunkedParams;
+	ChunkedParams.MaxFusedPerTask = 16;
+	int32 NumChunks = 0;
+	{
+		FPipeBatchScope Batch(Pipe, TEXT("ChunkedBatch"), ChunkedParams);
+		for (int32 i = 100; i < 140; ++i)
+		{
+			Batch.Add(TEXT("AppendIndex"), [&Order, i] { Order.Add(i); });
+		}
+		BatchTask = Batch.Flush();
+		NumChunks = Batch.GetNumFusedTasks();
+	}
+	check(NumChunks == 3);
+	
+	BatchTask.Wait();
+	Pipe.WaitUntilEmpty();
+	
+	check(Order.Num() == 141 && Order[0] == -1);
+	for (int32 i = 1; i < Order.Num(); ++i)
+	{
+		check(Order[i] == i - 1);
+	}
+	
+	const FPipeBatchStats Stats = GetPipeBatchStats();
+	UE_LOG(LogTemp, Log, TEXT("  %lld submissions fused into %lld pipe tasks (%lld launches saved, largest batch %d)"),
+		Stats.NumFusedSubmissions, Stats.NumFusedTasks, Stats.GetNumLaunchesSaved(), Stats.MaxFusedPerTask);
+}
+
+// ============================================================================
+// 示例31: 命名线程批量投递与绑定核心的后台线程
+// ============================================================================
+void ATasks_System_Example::Example_NamedThreadBatching()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 31] Named Thread Batching / Pinned Worker Pool"));
+	
+	/*
+	 * 示例16 逐个向 GameThread 投递任务; FNamedThreadBatcher 每个目标线程每批只启动一个任务:
+	 * 
+	 *   Enqueue(GameThreadNormalPri, ...) ×N  →  1 个 GameThread 任务, 按 Enqueue 顺序执行 N 个闭包
+	 * 
+	 * CPU 密集的后台工作放到 FPinnedWorkerPool: 线程带亲和性掩码, 不占游戏线程 / 渲染线程的核心
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	check(IsInGameThread());
+	
+	// 场景1: 4 个工作线程各投递 50 个闭包到 GameThread, 每个生产者的闭包保持提交顺序
+	// 显式选择立即放行: 批在 GameThread 取走批任务时关闭, 批数取决于 GameThread 处理队列的次数
+	{
+		constexpr int32 NumProducers = 4;
+		constexpr int32 PerProducer = 50;
+		
+		FNamedThreadBatcherParams Params;
+		Params.bReleaseAtEndOfFrame = false;
+		FNamedThreadBatcher Batcher(TEXT("GameThreadHandoff"), Params);
+		TArray<int32> LastSeen;
+		LastSeen.Init(-1, NumProducers);
+		int32 NumExecuted = 0;
+		
+		TArray<UE::Tasks::FTask> Producers;
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Batcher, &LastSeen, &NumExecuted, Producer]
+			{
+				for (int32 i = 0; i < PerProducer; ++i)
+				{
+					Batcher.Enqueue(UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri, TEXT("ApplyResult"),
+						[&LastSeen, &NumExecuted, Producer, i]
+						{
+							check(IsInGameThread());
+							check(LastSeen[Producer] == i - 1);
+							LastSeen[Producer] = i;
+							++NumExecuted;
+						});
+				}
+			}));
+		}
+		UE::Tasks::Wait(Producers);
+		
+		// 在 GameThread 上等待: 由当前线程执行 GameThread 的批
+		Batcher.Wait();
+		check(NumExecuted == NumProducers * PerProducer);
+		
+		const FNamedThreadBatchStats Stats = Batcher.GetStats(UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri);
+		UE_LOG(LogTemp, Log, TEXT("  %lld closures in %lld GameThread tasks (mean batch %.1f, largest %d, %lld launches saved)"),
+			Stats.NumEnqueued, Stats.NumBatchTasks, Stats.GetMeanBatchSize(), Stats.MaxBatchSize, Stats.GetNumLaunchesSaved());
+	}
+	
+	// 场景2: 帧末放行 (默认) - 批任务在 ReleaseBatches (或 FCoreDelegates::OnEndFrame) 之前不会执行
+	{
+		FNamedThreadBatcher Batcher(TEXT("EndOfFrameHandoff"));
+		
+		int32 NumExecuted = 0;
+		UE::Tasks::FTask BatchTask;
+		for (int32 i = 0; i < 3; ++i)
+		{
+			BatchTask = Batcher.Enqueue(UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri, TEXT("DeferredUpdate"),
+				[&NumExecuted] { ++NumExecuted; });
+		}
+		check(!BatchTask.IsCompleted() && NumExecuted == 0);
+		
+		Batcher.Wait();
+		check(NumExecuted == 3);
+		check(Batcher.GetStats().NumBatchTasks == 1);
+		UE_LOG(LogTemp, Log, TEXT("  End-of-frame batch released as one task"));
+	}
+	
+	// 场景3: 绑定核心的后台线程, 完成事件作为 UE::Tasks 的先决条件
+	{
+		FPinnedWorkerPoolParams Params;
+		Params.NumThreads = 2;
+		FPinnedWorkerPool Pool(TEXT("PinnedBake"), Params);
+		
+		std::atomic<int32> NumBaked{0};
+		TArray<UE::Tasks::FTask> Baked;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			UE::Tasks::FTaskEvent Done = Pool.Launch(TEXT("BakeChunk"), [&NumBaked]
+			{
+				check(!IsInGameThread());
+				FPlatformProcess::Sleep(0.001f);
+				++NumBaked;
+			});
+			Baked.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [] {}, UE::Tasks::Prerequisites(Done)));
+		}
+		UE::Tasks::Wait(Baked);
+		check(NumBaked == 8);
+		
+		UE_LOG(LogTemp, Log, TEXT("  Pinned pool: %d threads, affinity mask 0x%llx (game thread mask 0x%llx)"),
+			Pool.GetNumThreads(), Pool.GetAffinityMask(), FPlatformAffinity::GetMainGameMask());
+	}
+}
+
+// ============================================================================
+// 示例32: FPriorityTuner 运行时优先级自动调整
+// ============================================================================
+void ATasks_System_Example::Example_PriorityTuner()
+{
+	UE_LOG(LogTemp, Log, TEXT("[Example 32] Priority Tuner"));
+	
+	/*
+	 * 示例17 的 FTaskPriorityCVar 由调整器在上下界内自动改写:
+	 * 
+	 *   每帧 Tuner.Update(FrameMs): 帧时间 EMA + CPU 占用 + 每个在用优先级的探测任务排队延迟
+	 *   每 EvaluationIntervalFrames 帧:
+	 *     超预算 → bYieldToFrame 的类别降一级;  低于预算 * 0.85 + 排队延迟超目标 + 有空闲核心 → 升一级
+	 *     调整后至少停留 MinDwellFrames 帧
+	 * 
+	 * 控制台 / ini 设置的值优先于调整器 (调整以 ECVF_SetByCode 写入)
+	 */
+	
+	using namespace UE::TemplatesGuide;
+	
+	static const TCHAR* CVarName = TEXT("TasksExample.TunedBackgroundPriority");
+	static UE::Tasks::FTaskPriorityCVar BackgroundCVar{
+		CVarName,
+		TEXT("Priority of the example's background work, adjusted by FPriorityTuner"),
+		LowLevelTasks::ETaskPriority::BackgroundHigh,
+		UE::Tasks::EExtendedTaskPriority::None
+	};
+	
+	// CVar 是静态的, 重复 BeginPlay 时先恢复初始值
+	IConsoleVariable* ConsoleVariable = IConsoleManager::Get().FindConsoleVariable(CVarName);
+	ConsoleVariable->Set(TEXT("BackgroundHigh"), ECVF_SetByCode);
+	
+	FPriorityTunerParams Params;
+	Params.TargetFrameMilliseconds = 16.6;
+	Params.EvaluationIntervalFrames = 10;
+	Params.MinDwellFrames = 10;
+	FPriorityTuner Tuner(Params);
+	
+	// TemplatesGuide.PriorityTuner.Enabled 0 时调整被冻结, 下面的结果只打印不检查
+	const bool bTunerEnabled = IConsoleManager::Get().FindConsoleVariable(TEXT("TemplatesGuide.PriorityTuner.Enabled"))->GetBool();
+	if (!bTunerEnabled)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("  TemplatesGuide.PriorityTuner.Enabled is 0: tuning is frozen, skipping the decision checks"));
+	}
+	
+	FPriorityTunerCategoryParams CategoryParams;
+	CategoryParams.HighestPriority = LowLevelTasks::ETaskPriority::BackgroundHigh;
+	CategoryParams.LowestPriority = LowLevelTasks::ETaskPriority::BackgroundLow;
+	Tuner.RegisterCategory(TEXT("Streaming"), BackgroundCVar, CVarName, CategoryParams);
+	
+	// 模拟 20 帧超预算 (25ms): 两次评估, 每次降一级, 到下界为止
+	for (int32 FrameIndex = 0; FrameIndex < 20; ++FrameIndex)
+	{
+		Tuner.Update(25.0);
+	}
+	check(!bTunerEnabled || BackgroundCVar.GetTaskPriority() == LowLevelTasks::ETaskPriority::BackgroundLow);
+	
+	// 再超预算也不会低于下界
+	for (int32 FrameIndex = 0; FrameIndex < 10; ++FrameIndex)
+	{
+		Tuner.Update(25.0);
+	}
+	check(!bTunerEnabled || BackgroundCVar.GetTaskPriority() == LowLevelTasks::ETaskPriority::BackgroundLow);
+	
+	// 15ms 在预算内但高于升级阈值 (16.6 * 0.85): 滞回区间内不升级, 与排队延迟无关
+	for (int32 FrameIndex = 0; FrameIndex < 60; ++FrameIndex)
+	{
+		Tuner.Update(15.0);
+	}
+	
+	const TArray<FPriorityTunerDecision> Decisions = Tuner.GetDecisions();
+	check(!bTunerEnabled || Decisions.Num() == 2);
+	for (const FPriorityTunerDecision& Decision : Decisions)
+	{
+		check(Decision.Reason == EPriorityTunerReason::FrameOverBudget);
+		UE_LOG(LogTemp, Log, TEXT("  Frame %llu: %s %s -> %s (frame %.1fms)"), Decision.Frame, *Decision.Category,
+			LowLevelTasks::ToString(Decision.From), LowLevelTasks::ToString(Decision.To), Decision.FrameMilliseconds);
+	}
+	
+	// 帧时间回到预算内后, 是否升级取决于实际排队延迟与 CPU 占用, 只打印
+	for (int32 FrameIndex = 0; FrameIndex < 60; ++FrameIndex)
+	{
+		Tuner.Update(8.0);
+	}
+	
+	const FPriorityTunerSnapshot Snapshot = Tuner.GetSnapshot();
+	UE_LOG(LogTemp, Log, TEXT("  Now %s: frame EMA %.1fms, cpu %.0f%%, BackgroundLow queue latency %.0fus"),
+		LowLevelTasks::ToString(BackgroundCVar.GetTaskPriority()), Snapshot.FrameMilliseconds, Snapshot.CpuPercent,
+		Snapshot.QueueLatencyMicroseconds[int32(LowLevelTasks::ETaskPriority::BackgroundLow)]);
+	
+	ConsoleVariable->Set(TEXT("BackgroundHigh"), ECVF_SetByCode);
+}
@@ -91,4 +91,44 @@ private:
 
 	/** 示例20: 深度撤回 (Deep Retraction) / Wait 带超时 */
 	void Example_DeepRetraction_WaitTimeout();
+
+	// ========================================================================
+	// 工程化扩展 (示例 21+, 基于 UE::Tasks 构建的工具)
+	// ========================================================================
+
+	/** 示例21: LaunchBatched 分块批量启动 (ParallelBatch.h) */
+	void Example_ParallelBatch();
+
+	/** 示例22: LaunchPooled 池化任务体存储 (PooledTaskBody.h) */
+	void Example_PooledTaskBody();
+
+	/** 示例23: TTaskMailbox 无锁 MPSC 邮箱 (TaskMailbox.h) */
+	void Example_TaskMailbox();
+
+	/** 示例24: FArenaConcurrencyLimiter 每槽位暂存内存与自适应并发度 (ArenaConcurrencyLimiter.h) */
+	void Example_ArenaConcurrencyLimiter();
+
+	/** 示例25: TCoTask 协程 co_await 任务 / 事件 / Future (TaskCoroutine.h) */
+	void Example_Coroutines();
+
+	/** 示例26: LaunchRace / LaunchHedged 推测执行 (SpeculativeExecution.h) */
+	void Example_SpeculativeExecution();
+
+	/** 示例27: FDeadlineScheduler 截止时间调度 (DeadlineScheduler.h) */
+	void Example_DeadlineScheduler();
+
+	/** 示例28: InstrumentedWait / WaitOrContinue 可计量的撤回优先等待 (InstrumentedWait.h) */
+	void Example_InstrumentedWait();
+
+	/** 示例29: TTaskPipeline 多阶段流式流水线与背压 (TaskPipeline.h) */
+	void Example_TaskPipeline();
+
+	/** 示例30: FPipeBatchScope 管道批量提交, 合并为一个管道任务 (PipeBatch.h) */
+	void Example_PipeBatch();
+
+	/** 示例31: FNamedThreadBatcher 命名线程批量投递 / FPinnedWorkerPool 绑定核心的后台线程 (NamedThreadBatcher.h, PinnedWorkerPool.h) */
+	void Example_NamedThreadBatching();
+
+	/** 示例32: FPriorityTuner 根据帧时间与排队延迟调整 FTaskPriorityCVar (PriorityTuner.h) */
+	void Example_PriorityTuner();
 };
@@ -0,0 +1,319 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// Tasks_System 压力用例
+//
+// 示例与基准用例的规模停留在每次几十到几千个任务; 这里把同样的模式放大到生产负载,
+// 检查吞吐量下限、峰值内存和正确性 (顺序 / 并发度 / 完成数):
+//   - FireAndForget:     100 万个不保留句柄的任务 (Launch / LaunchPooled / LaunchBatchedRange)
+//   - DeepPipe:          1 万个任务排在同一个 FPipe 上, 以及 1 万层的先决条件链
+//   - LimiterSaturation: 多个生产者同时向 FArenaConcurrencyLimiter 推入 20 万个任务
+//   - LimiterTeardown:   多个生产者推入少量任务, Wait 返回后立即销毁限制器, 重复 2000 轮
+//
+// 运行: Automation RunTests TemplatesGuide.Stress.TasksStress
+//       或 TemplatesGuide.Stress Filter=TasksStress. [Scale=1.0] [Floor=1.0]
+//
+// 下限按单个工作线程也能达到的量级设定, 用于发现数量级的退化 (如每个任务多一次锁或堆分配),
+// 不用于比较细微的差异; 细微差异看基准用例
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
+#include "ParallelBatch.h"
+#include "PooledTaskBody.h"
+#include "ArenaConcurrencyLimiter.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+
+namespace TasksStress
+{
+	/** 等待不保留句柄的任务全部完成 (与示例11的基准用例相同, 用原子计数) */
+	static void WaitForCount(const std::atomic<int64>& NumDone, int64 Expected)
+	{
+		while (NumDone.load(std::memory_order_acquire) < Expected)
+		{
+			FPlatformProcess::Yield();
+		}
+	}
+
+	/** 每 SampleInterval 次启动采样一次内存, 启动循环中的峰值出现在排队任务最多的时候 */
+	constexpr int64 SampleInterval = 64 * 1024;
+}
+
+// 100 万个 Fire-and-Forget 任务
+UE_TEMPLATESGUIDE_BENCHMARK(TasksStress, FireAndForget, EBenchmarkFlags::Stress)
+{
+	const int64 NumTasks = Context.Scaled(1'000'000);
+
+	// Launch: 任务体只捕获一个引用, 任务对象在小任务块内
+	{
+		std::atomic<int64> NumDone{0};
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		for (int64 i = 0; i < NumTasks; ++i)
+		{
+			UE::Tasks::Launch(UE_SOURCE_LOCATION, [&NumDone]
+			{
+				NumDone.fetch_add(1, std::memory_order_release);
+			});
+
+			if (i % TasksStress::SampleInterval == 0)
+			{
+				Memory.Sample();
+			}
+		}
+		Memory.Sample();
+		TasksStress::WaitForCount(NumDone, NumTasks);
+
+		FBenchmarkResult& Result = Context.Report(TEXT("Launch"), NumTasks, Timer.GetSeconds());
+		Context.ExpectThroughput(Result, 250'000.0);
+		Context.ExpectPeakMemory(Result, Memory, NumTasks * 512);
+	}
+
+	// LaunchPooled: 256 字节捕获, 任务体在分级池中
+	{
+		struct FPayload
+		{
+			uint8 Bytes[256];
+		};
+
+		std::atomic<int64> NumDone{0};
+		FPayload Payload;
+		FMemory::Memset(Payload.Bytes, 1, sizeof(Payload.Bytes));
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		for (int64 i = 0; i < NumTasks; ++i)
+		{
+			UE::TemplatesGuide::LaunchPooled(UE_SOURCE_LOCATION, [&NumDone, Payload]
+			{
+				NumDone.fetch_add(Payload.Bytes[0], std::memory_order_release);
+			});
+
+			if (i % TasksStress::SampleInterval == 0)
+			{
+				Memory.Sample();
+			}
+		}
+		Memory.Sample();
+		TasksStress::WaitForCount(NumDone, NumTasks);
+
+		FBenchmarkResult& Result = Context.Report(TEXT("LaunchPooled_256B"), NumTasks, Timer.GetSeconds());
+		Context.ExpectThroughput(Result, 200'000.0);
+		Context.ExpectPeakMemory(Result, Memory, NumTasks * 1024);
+	}
+
+	// LaunchBatchedRange: 同样数量的条目合并为少量任务
+	{
+		std::atomic<int64> NumDone{0};
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		UE::TemplatesGuide::LaunchBatchedRange(UE_SOURCE_LOCATION, static_cast<int32>(NumTasks), [&NumDone](int32 Begin, int32 End)
+		{
+			NumDone.fetch_add(End - Begin, std::memory_order_release);
+		});
+		Memory.Sample();
+		TasksStress::WaitForCount(NumDone, NumTasks);
+
+		FBenchmarkResult& Result = Context.Report(TEXT("LaunchBatchedRange"), NumTasks, Timer.GetSeconds());
+		Context.ExpectThroughput(Result, 5'000'000.0);
+		Context.ExpectPeakMemory(Result, Memory, 64 * 1024 * 1024);
+	}
+}
+
+// 1 万个任务排在同一个管道上 / 1 万层先决条件链
+UE_TEMPLATESGUIDE_BENCHMARK(TasksStress, DeepPipe, EBenchmarkFlags::Stress)
+{
+	const int64 Depth = Context.Scaled(10'000);
+
+	// FPipe: 一次性启动全部任务, 检查执行顺序与启动顺序一致
+	{
+		UE::Tasks::FPipe Pipe{UE_SOURCE_LOCATION};
+		int64 NextExpected = 0;
+		int64 NumOutOfOrder = 0;
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		for (int64 i = 0; i < Depth; ++i)
+		{
+			// 管道保证同一时刻只有一个任务在执行, 任务体之间不需要同步
+			Pipe.Launch(UE_SOURCE_LOCATION, [&NextExpected, &NumOutOfOrder, i]
+			{
+				NumOutOfOrder += NextExpected != i ? 1 : 0;
+				NextExpected = i + 1;
+			});
+		}
+		Memory.Sample();
+		Pipe.WaitUntilEmpty();
+
+		FBenchmarkResult& Result = Context.Report(TEXT("Pipe"), Depth, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("OutOfOrder"), static_cast<double>(NumOutOfOrder));
+		Context.Expect(Result, NumOutOfOrder == 0 && NextExpected == Depth,
+			FString::Printf(TEXT("%lld of %lld pipe tasks ran out of order"), NumOutOfOrder, Depth));
+		Context.ExpectThroughput(Result, 50'000.0);
+		Context.ExpectPeakMemory(Result, Memory, Depth * 1024);
+	}
+
+	// 先决条件链: 每个任务依赖前一个, 只保留链尾的句柄;
+	// 链尾完成时整条链都已完成, 中间任务随前驱的引用释放而逐个销毁
+	{
+		std::atomic<int64> NextExpected{0};
+		std::atomic<int64> NumOutOfOrder{0};
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		UE::Tasks::FTask Tail;
+		for (int64 i = 0; i < Depth; ++i)
+		{
+			auto Body = [&NextExpected, &NumOutOfOrder, i]
+			{
+				if (NextExpected.exchange(i + 1, std::memory_order_acq_rel) != i)
+				{
+					NumOutOfOrder.fetch_add(1, std::memory_order_relaxed);
+				}
+			};
+			Tail = Tail.IsValid()
+				? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Body), UE::Tasks::Prerequisites(Tail))
+				: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Body));
+		}
+		Memory.Sample();
+		Tail.Wait();
+
+		FBenchmarkResult& Result = Context.Report(TEXT("PrerequisiteChain"), Depth, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("OutOfOrder"), static_cast<double>(NumOutOfOrder.load()));
+		Context.Expect(Result, NumOutOfOrder.load() == 0 && NextExpected.load() == Depth,
+			FString::Printf(TEXT("%lld of %lld chained tasks ran before their prerequisite"), NumOutOfOrder.load(), Depth));
+		Context.ExpectThroughput(Result, 20'000.0);
+		Context.ExpectPeakMemory(Result, Memory, Depth * 1024);
+	}
+}
+
+// 并发限制器饱和: 每个工作线程一个生产者, 同时推入远多于并发度的任务
+UE_TEMPLATESGUIDE_BENCHMARK(TasksStress, LimiterSaturation, EBenchmarkFlags::Stress)
+{
+	constexpr int32 ScratchBytes = 4 * 1024;
+	const int64 NumTasks = Context.Scaled(200'000);
+	const int32 NumProducers = Context.GetWorkers();
+	const uint32 MaxConcurrency = static_cast<uint32>(FMath::Max(1, Context.GetWorkers() / 2));
+
+	auto RunLimiter = [&](const TCHAR* CaseName, bool bAdaptive)
+	{
+		UE::TemplatesGuide::FArenaConcurrencyLimiterParams Params;
+		Params.MaxConcurrency = MaxConcurrency;
+		Params.InitialConcurrency = bAdaptive ? 1 : MaxConcurrency;
+		Params.ArenaBytesPerSlot = ScratchBytes;
+		Params.bAdaptive = bAdaptive;
+
+		UE::TemplatesGuide::FArenaConcurrencyLimiter Limiter(Params);
+		std::atomic<int32> NumRunning{0};
+		std::atomic<int32> MaxRunning{0};
+		std::atomic<int64> NumDone{0};
+		FPeakMemoryScope Memory;
+
+		FBenchmarkTimer Timer;
+		TArray<UE::Tasks::FTask> Producers;
+		Producers.Reserve(NumProducers);
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			const int64 Begin = NumTasks * Producer / NumProducers;
+			const int64 End = NumTasks * (Producer + 1) / NumProducers;
+			Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&, Begin, End]
+			{
+				for (int64 i = Begin; i < End; ++i)
+				{
+					Limiter.Push(UE_SOURCE_LOCATION, [&](uint32 Slot, UE::TemplatesGuide::FScratchArena& Arena)
+					{
+						const int32 Running = NumRunning.fetch_add(1, std::memory_order_acq_rel) + 1;
+						int32 Observed = MaxRunning.load(std::memory_order_relaxed);
+						while (Running > Observed && !MaxRunning.compare_exchange_weak(Observed, Running, std::memory_order_relaxed))
+						{
+						}
+
+						TArrayView<uint8> Scratch = Arena.AllocateArray<uint8>(ScratchBytes / 2);
+						FMemory::Memset(Scratch.GetData(), 0xAB, Scratch.Num());
+
+						NumRunning.fetch_sub(1, std::memory_order_acq_rel);
+						NumDone.fetch_add(1, std::memory_order_relaxed);
+					});
+				}
+			}));
+		}
+		UE::Tasks::Wait(Producers);
+		Memory.Sample();
+		Limiter.Wait();
+
+		const UE::TemplatesGuide::FArenaConcurrencyLimiterStats Stats = Limiter.GetStats();
+
+		FBenchmarkResult& Result = Context.Report(CaseName, NumTasks, Timer.GetSeconds());
+		Result.Metrics.Emplace(TEXT("MaxConcurrency"), static_cast<double>(MaxConcurrency));
+		Result.Metrics.Emplace(TEXT("ObservedConcurrency"), static_cast<double>(MaxRunning.load()));
+		Result.Metrics.Emplace(TEXT("ArenaOverflows"), static_cast<double>(Stats.ArenaOverflows));
+		Result.Metrics.Emplace(TEXT("QueueWaitEmaUs"), Stats.QueueWaitEmaMicroseconds);
+
+		Context.Expect(Result, NumDone.load() == NumTasks,
+			FString::Printf(TEXT("%lld of %lld tasks completed"), NumDone.load(), NumTasks));
+		Context.Expect(Result, MaxRunning.load() <= static_cast<int32>(MaxConcurrency),
+			FString::Printf(TEXT("observed concurrency %d above limit %u"), MaxRunning.load(), MaxConcurrency));
+		Context.Expect(Result, Stats.ArenaOverflows == 0,
+			FString::Printf(TEXT("%lld arena overflows"), Stats.ArenaOverflows));
+		Context.ExpectThroughput(Result, 100'000.0);
+		// 排队的任务体 (TUniqueFunction) 是唯一随任务数增长的部分
+		Context.ExpectPeakMemory(Result, Memory, NumTasks * 256);
+	};
+
+	RunLimiter(TEXT("Fixed"), false);
+	RunLimiter(TEXT("Adaptive"), true);
+}
+
+// 回归: Push / Runner 在锁外启动的 Runner 不能在 Wait 返回、限制器销毁之后才开始执行
+UE_TEMPLATESGUIDE_BENCHMARK(TasksStress, LimiterTeardown, EBenchmarkFlags::Stress)
+{
+	const int64 NumRounds = Context.Scaled(2'000);
+	const int32 NumProducers = FMath::Max(2, Context.GetWorkers());
+	constexpr int32 ItemsPerProducer = 4;
+
+	int64 NumIncompleteRounds = 0;
+	FBenchmarkTimer Timer;
+	for (int64 Round = 0; Round < NumRounds; ++Round)
+	{
+		UE::TemplatesGuide::FArenaConcurrencyLimiterParams Params;
+		Params.MaxConcurrency = static_cast<uint32>(NumProducers);
+		Params.ArenaBytesPerSlot = 256;
+
+		// 堆上分配: 销毁后的访问更容易被分配器的调试填充或复用暴露
+		TUniquePtr<UE::TemplatesGuide::FArenaConcurrencyLimiter> Limiter = MakeUnique<UE::TemplatesGuide::FArenaConcurrencyLimiter>(Params);
+		std::atomic<int32> NumDone{0};
+
+		TArray<UE::Tasks::FTask> Producers;
+		Producers.Reserve(NumProducers);
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Limiter, &NumDone]
+			{
+				for (int32 i = 0; i < ItemsPerProducer; ++i)
+				{
+					Limiter->Push(UE_SOURCE_LOCATION, [&NumDone](uint32 Slot, UE::TemplatesGuide::FScratchArena& Arena)
+					{
+						NumDone.fetch_add(1, std::memory_order_relaxed);
+					});
+				}
+			}));
+		}
+		UE::Tasks::Wait(Producers);
+		Limiter->Wait();
+		Limiter.Reset();
+
+		if (NumDone.load() != NumProducers * ItemsPerProducer)
+		{
+			++NumIncompleteRounds;
+		}
+	}
+
+	FBenchmarkResult& Result = Context.Report(TEXT("PushWaitDestroy"), NumRounds, Timer.GetSeconds());
+	Result.Metrics.Emplace(TEXT("Producers"), static_cast<double>(NumProducers));
+	Context.Expect(Result, NumIncompleteRounds == 0,
+		FString::Printf(TEXT("%lld of %lld rounds returned from Wait before all tasks completed"), NumIncompleteRounds, NumRounds));
+}
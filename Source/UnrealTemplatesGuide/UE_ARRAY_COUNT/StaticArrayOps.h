@@ -0,0 +1,442 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks_System/ParallelBatch.h"
+#include <type_traits>
+#include <utility>
+
+/**
+ * 编译期已知长度的 C 数组的遍历与数值运算
+ *
+ * 与 UE_ARRAY_COUNT 一样只接受数组引用 T (&)[N], 传入指针时没有匹配的重载, 编译失败
+ * 元素个数 N 是模板参数, 按 N 在编译期选择实现:
+ *
+ *   N <= UnrollThreshold      折叠表达式完全展开, 没有循环 (DamageMultipliers 这类小表)
+ *   N <  ParallelThreshold    SIMD 内核 (float / int32 使用 VectorRegister, 其他算术类型为标量循环)
+ *   N >= ParallelThreshold    LaunchBatchedRange 分块并行, 每块内部仍用 SIMD 内核, 调用线程等待完成
+ *
+ * 用法:
+ *   static constexpr int32 DamageMultipliers[] = { 1, 2, 4, 8, 16 };
+ *
+ *   static_assert(StaticArray::Sum(DamageMultipliers) == 31);        // 展开路径可在编译期求值
+ *   const StaticArray::TMinMax<int32> Range = StaticArray::MinMax(DamageMultipliers);
+ *
+ *   int32 Scaled[UE_ARRAY_COUNT(DamageMultipliers)];
+ *   StaticArray::Scale(DamageMultipliers, 3, Scaled);
+ *
+ *   StaticArray::ForEach(WeaponTypeNames, [](const TCHAR* Name) { ... });
+ *
+ *   const TCHAR** Ptr = ...;
+ *   StaticArray::ForEach(Ptr, ...);                                   // 编译错误！指针不是数组
+ *
+ * 注意: float 的 SIMD / 并行求和改变了加法顺序, 结果与逐个相加可能有舍入误差; 并行路径的合并顺序不固定
+ */
+namespace UE::TemplatesGuide::StaticArray
+{
+	/** 不超过此长度时完全展开 */
+	inline constexpr uint32 UnrollThreshold = 16;
+
+	/** 达到此长度时分块并行 (更短的数组并行后调度开销大于收益) */
+	inline constexpr uint32 ParallelThreshold = 64 * 1024;
+
+	template<typename T>
+	struct TMinMax
+	{
+		T Min;
+		T Max;
+	};
+
+	namespace Private
+	{
+		/** SIMD 内核所需的寄存器操作, 未特化的类型走标量循环 */
+		template<typename T>
+		struct TSimdKernel
+		{
+			static constexpr bool bSupported = false;
+		};
+
+		template<>
+		struct TSimdKernel<float>
+		{
+			static constexpr bool bSupported = true;
+			static constexpr int32 Width = 4;
+			using FRegister = VectorRegister4Float;
+
+			static FORCEINLINE FRegister Load(const float* Data) { return VectorLoad(Data); }
+			static FORCEINLINE void Store(const FRegister& Value, float* Data) { VectorStore(Value, Data); }
+			static FORCEINLINE FRegister Splat(float Value) { return VectorSetFloat1(Value); }
+			static FORCEINLINE FRegister Zero() { return VectorZeroFloat(); }
+			static FORCEINLINE FRegister Add(const FRegister& A, const FRegister& B) { return VectorAdd(A, B); }
+			static FORCEINLINE FRegister Multiply(const FRegister& A, const FRegister& B) { return VectorMultiply(A, B); }
+			static FORCEINLINE FRegister Min(const FRegister& A, const FRegister& B) { return VectorMin(A, B); }
+			static FORCEINLINE FRegister Max(const FRegister& A, const FRegister& B) { return VectorMax(A, B); }
+		};
+
+		template<>
+		struct TSimdKernel<int32>
+		{
+			static constexpr bool bSupported = true;
+			static constexpr int32 Width = 4;
+			using FRegister = VectorRegister4Int;
+
+			static FORCEINLINE FRegister Load(const int32* Data) { return VectorIntLoad(Data); }
+			static FORCEINLINE void Store(const FRegister& Value, int32* Data) { VectorIntStore(Value, Data); }
+			static FORCEINLINE FRegister Splat(int32 Value) { return VectorIntSet1(Value); }
+			static FORCEINLINE FRegister Zero() { return VectorIntSet1(0); }
+			static FORCEINLINE FRegister Add(const FRegister& A, const FRegister& B) { return VectorIntAdd(A, B); }
+			static FORCEINLINE FRegister Multiply(const FRegister& A, const FRegister& B) { return VectorIntMultiply(A, B); }
+			static FORCEINLINE FRegister Min(const FRegister& A, const FRegister& B) { return VectorIntMin(A, B); }
+			static FORCEINLINE FRegister Max(const FRegister& A, const FRegister& B) { return VectorIntMax(A, B); }
+		};
+
+		// ====================================================================
+		// 完全展开 (N <= UnrollThreshold)
+		// ====================================================================
+		template<typename T, uint32 N, typename FunctionType, size_t... Indices>
+		constexpr void UnrolledForEach(T (&Array)[N], FunctionType& Function, std::index_sequence<Indices...>)
+		{
+			(Function(Array[Indices]), ...);
+		}
+
+		template<typename T, uint32 N, size_t... Indices>
+		constexpr T UnrolledSum(const T (&Array)[N], std::index_sequence<Indices...>)
+		{
+			return (T(0) + ... + Array[Indices]);
+		}
+
+		template<typename T, uint32 N, size_t... Indices>
+		constexpr TMinMax<T> UnrolledMinMax(const T (&Array)[N], std::index_sequence<Indices...>)
+		{
+			TMinMax<T> Result{Array[0], Array[0]};
+			((Result.Min = Array[Indices] < Result.Min ? Array[Indices] : Result.Min,
+				Result.Max = Result.Max < Array[Indices] ? Array[Indices] : Result.Max), ...);
+			return Result;
+		}
+
+		template<typename T, uint32 N, size_t... Indices>
+		constexpr void UnrolledScale(const T (&In)[N], T Factor, T (&Out)[N], std::index_sequence<Indices...>)
+		{
+			((Out[Indices] = In[Indices] * Factor), ...);
+		}
+
+		// ====================================================================
+		// 区间内核: 编译期求值与标量类型走逐个循环, float / int32 走 SIMD
+		// ====================================================================
+		template<typename T>
+		constexpr T SumRange(const T* Data, int32 Num)
+		{
+			using FKernel = TSimdKernel<T>;
+
+			int32 Index = 0;
+			T Result = T(0);
+			if constexpr (FKernel::bSupported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					// 两个累加器交替使用, 隐藏加法延迟
+					typename FKernel::FRegister Sum0 = FKernel::Zero();
+					typename FKernel::FRegister Sum1 = FKernel::Zero();
+					for (; Index + 2 * FKernel::Width <= Num; Index += 2 * FKernel::Width)
+					{
+						Sum0 = FKernel::Add(Sum0, FKernel::Load(Data + Index));
+						Sum1 = FKernel::Add(Sum1, FKernel::Load(Data + Index + FKernel::Width));
+					}
+					for (; Index + FKernel::Width <= Num; Index += FKernel::Width)
+					{
+						Sum0 = FKernel::Add(Sum0, FKernel::Load(Data + Index));
+					}
+
+					alignas(16) T Lanes[FKernel::Width];
+					FKernel::Store(FKernel::Add(Sum0, Sum1), Lanes);
+					for (const T Lane : Lanes)
+					{
+						Result += Lane;
+					}
+				}
+			}
+
+			for (; Index < Num; ++Index)
+			{
+				Result += Data[Index];
+			}
+			return Result;
+		}
+
+		/** Num 必须大于 0 */
+		template<typename T>
+		constexpr TMinMax<T> MinMaxRange(const T* Data, int32 Num)
+		{
+			using FKernel = TSimdKernel<T>;
+
+			int32 Index = 0;
+			TMinMax<T> Result{Data[0], Data[0]};
+			if constexpr (FKernel::bSupported)
+			{
+				if (!std::is_constant_evaluated() && Num >= FKernel::Width)
+				{
+					typename FKernel::FRegister MinValue = FKernel::Load(Data);
+					typename FKernel::FRegister MaxValue = MinValue;
+					for (Index = FKernel::Width; Index + FKernel::Width <= Num; Index += FKernel::Width)
+					{
+						const typename FKernel::FRegister Value = FKernel::Load(Data + Index);
+						MinValue = FKernel::Min(MinValue, Value);
+						MaxValue = FKernel::Max(MaxValue, Value);
+					}
+
+					alignas(16) T MinLanes[FKernel::Width];
+					alignas(16) T MaxLanes[FKernel::Width];
+					FKernel::Store(MinValue, MinLanes);
+					FKernel::Store(MaxValue, MaxLanes);
+					for (int32 Lane = 0; Lane < FKernel::Width; ++Lane)
+					{
+						Result.Min = MinLanes[Lane] < Result.Min ? MinLanes[Lane] : Result.Min;
+						Result.Max = Result.Max < MaxLanes[Lane] ? MaxLanes[Lane] : Result.Max;
+					}
+				}
+			}
+
+			for (; Index < Num; ++Index)
+			{
+				Result.Min = Data[Index] < Result.Min ? Data[Index] : Result.Min;
+				Result.Max = Result.Max < Data[Index] ? Data[Index] : Result.Max;
+			}
+			return Result;
+		}
+
+		/** In 与 Out 可以是同一数组 (原地缩放) */
+		template<typename T>
+		constexpr void ScaleRange(const T* In, T Factor, T* Out, int32 Num)
+		{
+			using FKernel = TSimdKernel<T>;
+
+			int32 Index = 0;
+			if constexpr (FKernel::bSupported)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					const typename FKernel::FRegister FactorValue = FKernel::Splat(Factor);
+					for (; Index + FKernel::Width <= Num; Index += FKernel::Width)
+					{
+						FKernel::Store(FKernel::Multiply(FKernel::Load(In + Index), FactorValue), Out + Index);
+					}
+				}
+			}
+
+			for (; Index < Num; ++Index)
+			{
+				Out[Index] = In[Index] * Factor;
+			}
+		}
+
+		// ====================================================================
+		// 分块并行 (N >= ParallelThreshold)
+		// ====================================================================
+
+		/** 到下一个缓存行边界的元素数, 与 LaunchBatched 的对齐方式相同 */
+		template<typename T>
+		int32 GetCacheLineLead(const T* Data, int32 Num)
+		{
+			if constexpr (PLATFORM_CACHE_LINE_SIZE % sizeof(T) == 0)
+			{
+				const UPTRINT Misalignment = reinterpret_cast<UPTRINT>(Data) % PLATFORM_CACHE_LINE_SIZE;
+				if (Misalignment != 0 && Misalignment % sizeof(T) == 0)
+				{
+					return FMath::Min(Num, static_cast<int32>((PLATFORM_CACHE_LINE_SIZE - Misalignment) / sizeof(T)));
+				}
+			}
+			return 0;
+		}
+
+		template<typename T>
+		constexpr int32 GetCacheLineItems()
+		{
+			return FMath::Max<int32>(1, PLATFORM_CACHE_LINE_SIZE / sizeof(T));
+		}
+
+		/**
+		 * 各块用 ReduceRange(const T*, int32) 求出部分结果, 再用 Combine 合并
+		 * 块数不多 (约为工作线程数的 MinChunksPerTask 倍), 合并直接加锁
+		 */
+		template<typename ResultType, typename T, typename ReduceRangeType, typename CombineType>
+		ResultType ParallelReduce(const TCHAR* DebugName, const T* Data, int32 Num, ReduceRangeType ReduceRange, CombineType Combine)
+		{
+			static FBatchCostModel CostModel;
+
+			FBatchLaunchParams Params;
+			Params.CostModel = &CostModel;
+
+			FCriticalSection Mutex;
+			TOptional<ResultType> Result;
+			LaunchBatchedRange(DebugName, Num,
+				[Data, &ReduceRange, &Combine, &Mutex, &Result](int32 Begin, int32 End)
+				{
+					const ResultType Partial = ReduceRange(Data + Begin, End - Begin);
+
+					FScopeLock Lock(&Mutex);
+					Result = Result.IsSet() ? Combine(Result.GetValue(), Partial) : Partial;
+				},
+				Params, GetCacheLineItems<T>(), GetCacheLineLead(Data, Num)).Wait();
+
+			return Result.GetValue();
+		}
+
+		/** 各块独立处理 [Begin, End), 输出按缓存行分块, 块之间不会伪共享 */
+		template<typename T, typename RangeBodyType>
+		void ParallelRange(const TCHAR* DebugName, const T* AlignData, int32 Num, RangeBodyType&& RangeBody)
+		{
+			static FBatchCostModel CostModel;
+
+			FBatchLaunchParams Params;
+			Params.CostModel = &CostModel;
+
+			LaunchBatchedRange(DebugName, Num, Forward<RangeBodyType>(RangeBody),
+				Params, GetCacheLineItems<T>(), GetCacheLineLead(AlignData, Num)).Wait();
+		}
+	}
+
+	/** 对每个元素调用 Function(T&); 小数组展开, 更长的数组为串行循环 (需要并行时用 ParallelForEach) */
+	template<typename T, uint32 N, typename FunctionType>
+	constexpr void ForEach(T (&Array)[N], FunctionType&& Function)
+	{
+		if constexpr (N <= UnrollThreshold)
+		{
+			Private::UnrolledForEach(Array, Function, std::make_index_sequence<N>());
+		}
+		else
+		{
+			for (T& Element : Array)
+			{
+				Function(Element);
+			}
+		}
+	}
+
+	/** 同 ForEach, 但 N >= ParallelThreshold 时分块并行执行; Function 须可并发调用 */
+	template<typename T, uint32 N, typename FunctionType>
+	void ParallelForEach(T (&Array)[N], FunctionType&& Function)
+	{
+		if constexpr (N >= ParallelThreshold)
+		{
+			T* Data = Array;
+			Private::ParallelRange(TEXT("StaticArray::ParallelForEach"), Data, int32(N),
+				[Data, &Function](int32 Begin, int32 End)
+				{
+					for (int32 Index = Begin; Index < End; ++Index)
+					{
+						Function(Data[Index]);
+					}
+				});
+		}
+		else
+		{
+			ForEach(Array, Forward<FunctionType>(Function));
+		}
+	}
+
+	template<typename T, uint32 N>
+	constexpr T Sum(const T (&Array)[N])
+	{
+		static_assert(std::is_arithmetic_v<T>, "StaticArray::Sum requires an arithmetic element type");
+
+		if constexpr (N <= UnrollThreshold)
+		{
+			return Private::UnrolledSum(Array, std::make_index_sequence<N>());
+		}
+		else if constexpr (N >= ParallelThreshold)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				return Private::ParallelReduce<T>(TEXT("StaticArray::Sum"), Array, int32(N),
+					[](const T* Data, int32 Num) { return Private::SumRange(Data, Num); },
+					[](T A, T B) { return A + B; });
+			}
+			return Private::SumRange(Array, int32(N));
+		}
+		else
+		{
+			return Private::SumRange(Array, int32(N));
+		}
+	}
+
+	template<typename T, uint32 N>
+	constexpr TMinMax<T> MinMax(const T (&Array)[N])
+	{
+		static_assert(std::is_arithmetic_v<T>, "StaticArray::MinMax requires an arithmetic element type");
+
+		if constexpr (N <= UnrollThreshold)
+		{
+			return Private::UnrolledMinMax(Array, std::make_index_sequence<N>());
+		}
+		else if constexpr (N >= ParallelThreshold)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				return Private::ParallelReduce<TMinMax<T>>(TEXT("StaticArray::MinMax"), Array, int32(N),
+					[](const T* Data, int32 Num) { return Private::MinMaxRange(Data, Num); },
+					[](const TMinMax<T>& A, const TMinMax<T>& B)
+					{
+						return TMinMax<T>{B.Min < A.Min ? B.Min : A.Min, A.Max < B.Max ? B.Max : A.Max};
+					});
+			}
+			return Private::MinMaxRange(Array, int32(N));
+		}
+		else
+		{
+			return Private::MinMaxRange(Array, int32(N));
+		}
+	}
+
+	template<typename T, uint32 N>
+	constexpr T Min(const T (&Array)[N])
+	{
+		return MinMax(Array).Min;
+	}
+
+	template<typename T, uint32 N>
+	constexpr T Max(const T (&Array)[N])
+	{
+		return MinMax(Array).Max;
+	}
+
+	/** Out[i] = In[i] * Factor; In 与 Out 长度相同 (由类型保证), 可以是同一数组 */
+	template<typename T, uint32 N>
+	constexpr void Scale(const T (&In)[N], T Factor, T (&Out)[N])
+	{
+		static_assert(std::is_arithmetic_v<T>, "StaticArray::Scale requires an arithmetic element type");
+
+		if constexpr (N <= UnrollThreshold)
+		{
+			Private::UnrolledScale(In, Factor, Out, std::make_index_sequence<N>());
+		}
+		else if constexpr (N >= ParallelThreshold)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				const T* InData = In;
+				T* OutData = Out;
+				Private::ParallelRange(TEXT("StaticArray::Scale"), OutData, int32(N),
+					[InData, Factor, OutData](int32 Begin, int32 End)
+					{
+						Private::ScaleRange(InData + Begin, Factor, OutData + Begin, End - Begin);
+					});
+				return;
+			}
+			Private::ScaleRange(In, Factor, Out, int32(N));
+		}
+		else
+		{
+			Private::ScaleRange(In, Factor, Out, int32(N));
+		}
+	}
+
+	/** 原地缩放 */
+	template<typename T, uint32 N>
+	constexpr void Scale(T (&Array)[N], T Factor)
+	{
+		Scale(Array, Factor, Array);
+	}
+}
@@ -0,0 +1,339 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 编译期查找表: 由 UE_ARRAY_COUNT 可计数的静态数组在编译期构建, 运行时 O(1) 查找, 没有运行时初始化
+ *
+ * 线性扫描 (for i < UE_ARRAY_COUNT(Names): if Names[i] == Name) 在热路径上做 名称→下标 查找时,
+ * 代价随表长线性增长; 手写的下标范围检查也容易遗漏
+ *
+ *   TStaticNameTable    名称 → 下标 (开放寻址哈希, 编译期挑选种子使最长探测距离最小, 多数表为 0 即完美哈希)
+ *     Slots: [ 0 ][ 3 ][   ][ 1 ][   ][ 2 ][   ][   ]     槽位数 = 2N 向上取 2 的幂, 存 下标 + 1
+ *     Find("Staff"): Hash(Seed) & (NumSlots - 1) → 槽位 → 比较长度与一次字符串 → 2
+ *
+ *   TStaticSortedIndex  值 → 下标 (编译期排序, 运行时二分查找), 用于 DamageMultipliers 这类数值表
+ *
+ * 与 UE_ARRAY_COUNT 相同, 构建函数只接受数组引用 (const T (&)[N]), 传入指针不能匹配, 编译报错
+ * 表对象为 constexpr, 可以 static_assert 其大小、有效性, 甚至在编译期执行查找:
+ *
+ *   static constexpr const TCHAR* WeaponTypeNames[] = { TEXT("Sword"), TEXT("Bow"), ... };
+ *   static constexpr auto WeaponTypeTable = MakeStaticNameTable(WeaponTypeNames);
+ *   static_assert(WeaponTypeTable.Num() == UE_ARRAY_COUNT(WeaponTypeNames));
+ *   static_assert(WeaponTypeTable.IsValid(), "duplicate weapon names");
+ *   static_assert(WeaponTypeTable.Find(TEXT("Bow")) == 1);
+ *
+ *   const int32 Index = WeaponTypeTable.Find(FStringView(InName));     // 运行时, INDEX_NONE 表示未找到
+ *   const TCHAR* Name = WeaponTypeTable.GetName(Index);                // 越界返回 nullptr, 不需要手写范围检查
+ *
+ * 名称比较区分大小写; 表中的字符串必须是常量表达式 (字符串字面量)
+ */
+namespace UE::TemplatesGuide::StaticLookup
+{
+	namespace Private
+	{
+		constexpr int32 StrLen(const TCHAR* String)
+		{
+			int32 Len = 0;
+			while (String[Len] != 0)
+			{
+				++Len;
+			}
+			return Len;
+		}
+
+		/** FNV-1a + 末尾混合; 编译期与运行期使用同一实现, 结果一致 */
+		constexpr uint32 HashChars(const TCHAR* Data, int32 Len, uint32 Seed)
+		{
+			uint32 Hash = 2166136261u ^ (Seed * 0x9E3779B9u);
+			for (int32 i = 0; i < Len; ++i)
+			{
+				Hash ^= uint32(Data[i]);
+				Hash *= 16777619u;
+			}
+			Hash ^= Hash >> 15;
+			Hash *= 0x2C1B3C6Du;
+			Hash ^= Hash >> 12;
+			return Hash;
+		}
+
+		/** 先比较长度, 长度不同时不读取任何字符 (B 可以是不以 0 结尾的 FStringView) */
+		constexpr bool CharsEqual(const TCHAR* A, int32 ALen, const TCHAR* B, int32 BLen)
+		{
+			if (ALen != BLen)
+			{
+				return false;
+			}
+			for (int32 i = 0; i < BLen; ++i)
+			{
+				if (A[i] != B[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr uint32 RoundUpToPowerOfTwo(uint32 Value)
+		{
+			uint32 Result = 1;
+			while (Result < Value)
+			{
+				Result <<= 1;
+			}
+			return Result;
+		}
+	}
+
+	/** 编译期挑选种子时尝试的个数 */
+	inline constexpr uint32 MaxSeedAttempts = 64;
+
+	template<uint32 N>
+	class TStaticNameTable
+	{
+		static_assert(N > 0, "TStaticNameTable needs at least one name");
+		static_assert(N < 0xFFFF, "TStaticNameTable stores indices as uint16");
+
+	public:
+		static constexpr uint32 NumSlots = Private::RoundUpToPowerOfTwo(N * 2);
+
+		static constexpr uint32 Num()
+		{
+			return N;
+		}
+
+		/** 名称互不重复 */
+		constexpr bool IsValid() const
+		{
+			return !bHasDuplicates;
+		}
+
+		/** 每个名称都在其首选槽位, 查找只比较一次字符串 */
+		constexpr bool IsPerfect() const
+		{
+			return MaxProbe == 0;
+		}
+
+		constexpr uint32 GetMaxProbe() const
+		{
+			return MaxProbe;
+		}
+
+		constexpr uint32 GetSeed() const
+		{
+			return Seed;
+		}
+
+		/** 名称 → 下标, 未找到返回 INDEX_NONE */
+		constexpr int32 Find(const TCHAR* Data, int32 Len) const
+		{
+			const uint32 Mask = NumSlots - 1;
+			uint32 Slot = Private::HashChars(Data, Len, Seed) & Mask;
+			for (uint32 Probe = 0; Probe <= MaxProbe; ++Probe, Slot = (Slot + 1) & Mask)
+			{
+				const uint16 Entry = Slots[Slot];
+				if (Entry == 0)
+				{
+					return INDEX_NONE;
+				}
+				if (Private::CharsEqual(Names[Entry - 1], NameLens[Entry - 1], Data, Len))
+				{
+					return int32(Entry - 1);
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		constexpr int32 Find(const TCHAR* Name) const
+		{
+			return Find(Name, Private::StrLen(Name));
+		}
+
+		int32 Find(FStringView Name) const
+		{
+			return Find(Name.GetData(), Name.Len());
+		}
+
+		/** 下标 → 名称, 越界返回 nullptr */
+		constexpr const TCHAR* GetName(int32 Index) const
+		{
+			return Index >= 0 && uint32(Index) < N ? Names[Index] : nullptr;
+		}
+
+	private:
+		template<uint32 M, typename GetNameType>
+		friend constexpr TStaticNameTable<M> BuildStaticNameTable(GetNameType GetName);
+
+		/** 以 InSeed 放入所有名称, 返回最长探测距离 */
+		constexpr uint32 Place(uint32 InSeed)
+		{
+			for (uint32 i = 0; i < NumSlots; ++i)
+			{
+				Slots[i] = 0;
+			}
+
+			const uint32 Mask = NumSlots - 1;
+			uint32 LongestProbe = 0;
+			for (uint32 Index = 0; Index < N; ++Index)
+			{
+				uint32 Slot = Private::HashChars(Names[Index], NameLens[Index], InSeed) & Mask;
+				uint32 Probe = 0;
+				while (Slots[Slot] != 0)
+				{
+					Slot = (Slot + 1) & Mask;
+					++Probe;
+				}
+				Slots[Slot] = uint16(Index + 1);
+				LongestProbe = Probe > LongestProbe ? Probe : LongestProbe;
+			}
+			return LongestProbe;
+		}
+
+		const TCHAR* Names[N] = {};
+
+		/** 名称长度在构建时计算, 查找时不再扫描结尾的 0 */
+		int32 NameLens[N] = {};
+		uint16 Slots[NumSlots] = {};
+		uint32 Seed = 0;
+		uint32 MaxProbe = 0;
+		bool bHasDuplicates = false;
+	};
+
+	/** 由 GetName(Index) 取得第 Index 个名称构建表; 通常经由 MakeStaticNameTable 调用 */
+	template<uint32 N, typename GetNameType>
+	constexpr TStaticNameTable<N> BuildStaticNameTable(GetNameType GetName)
+	{
+		TStaticNameTable<N> Table;
+		for (uint32 Index = 0; Index < N; ++Index)
+		{
+			Table.Names[Index] = GetName(Index);
+			Table.NameLens[Index] = Private::StrLen(Table.Names[Index]);
+		}
+
+		for (uint32 A = 0; A < N; ++A)
+		{
+			for (uint32 B = A + 1; B < N; ++B)
+			{
+				if (Private::CharsEqual(Table.Names[A], Table.NameLens[A], Table.Names[B], Table.NameLens[B]))
+				{
+					Table.bHasDuplicates = true;
+				}
+			}
+		}
+
+		// 挑选最长探测距离最小的种子, 找到完美哈希即停止
+		uint32 BestSeed = 0;
+		uint32 BestProbe = ~0u;
+		for (uint32 Seed = 0; Seed < MaxSeedAttempts && BestProbe != 0; ++Seed)
+		{
+			const uint32 Probe = Table.Place(Seed);
+			if (Probe < BestProbe)
+			{
+				BestProbe = Probe;
+				BestSeed = Seed;
+			}
+		}
+
+		Table.Seed = BestSeed;
+		Table.MaxProbe = Table.Place(BestSeed);
+		return Table;
+	}
+
+	/** 名称数组 → 表 (WeaponTypeNames 这类 枚举→字符串 表) */
+	template<uint32 N>
+	constexpr TStaticNameTable<N> MakeStaticNameTable(const TCHAR* const (&Names)[N])
+	{
+		return BuildStaticNameTable<N>([&Names](uint32 Index) { return Names[Index]; });
+	}
+
+	/** 结构体数组 + 名称成员 → 表 (TestStruct 这类配置表), 如 MakeStaticNameTable(TestStruct, &FTestStruct::NamePostFix) */
+	template<typename RowType, uint32 N>
+	constexpr TStaticNameTable<N> MakeStaticNameTable(const RowType (&Rows)[N], const TCHAR* RowType::* NameMember)
+	{
+		return BuildStaticNameTable<N>([&Rows, NameMember](uint32 Index) { return Rows[Index].*NameMember; });
+	}
+
+	/** 值 → 下标, 编译期排序, 运行时二分查找 */
+	template<typename T, uint32 N>
+	class TStaticSortedIndex
+	{
+		static_assert(N > 0, "TStaticSortedIndex needs at least one value");
+
+	public:
+		static constexpr uint32 Num()
+		{
+			return N;
+		}
+
+		/** 值互不重复 */
+		constexpr bool IsValid() const
+		{
+			return !bHasDuplicates;
+		}
+
+		/** 值 → 原数组中的下标, 未找到返回 INDEX_NONE */
+		constexpr int32 Find(const T& Value) const
+		{
+			uint32 Low = 0;
+			uint32 High = N;
+			while (Low < High)
+			{
+				const uint32 Mid = Low + (High - Low) / 2;
+				if (Keys[Mid] < Value)
+				{
+					Low = Mid + 1;
+				}
+				else
+				{
+					High = Mid;
+				}
+			}
+			return Low < N && !(Value < Keys[Low]) ? Indices[Low] : INDEX_NONE;
+		}
+
+		/** 按值升序的第 Rank 个值 */
+		constexpr const T& GetSorted(uint32 Rank) const
+		{
+			return Keys[Rank];
+		}
+
+	private:
+		template<typename U, uint32 M>
+		friend constexpr TStaticSortedIndex<U, M> MakeStaticSortedIndex(const U (&Values)[M]);
+
+		T Keys[N] = {};
+		int32 Indices[N] = {};
+		bool bHasDuplicates = false;
+	};
+
+	template<typename T, uint32 N>
+	constexpr TStaticSortedIndex<T, N> MakeStaticSortedIndex(const T (&Values)[N])
+	{
+		TStaticSortedIndex<T, N> Table;
+
+		// 插入排序: 编译期的表通常很小, 且是稳定排序
+		for (uint32 i = 0; i < N; ++i)
+		{
+			uint32 Pos = i;
+			while (Pos > 0 && Values[i] < Table.Keys[Pos - 1])
+			{
+				Table.Keys[Pos] = Table.Keys[Pos - 1];
+				Table.Indices[Pos] = Table.Indices[Pos - 1];
+				--Pos;
+			}
+			Table.Keys[Pos] = Values[i];
+			Table.Indices[Pos] = int32(i);
+		}
+
+		for (uint32 i = 1; i < N; ++i)
+		{
+			if (!(Table.Keys[i - 1] < Table.Keys[i]))
+			{
+				Table.bHasDuplicates = true;
+			}
+		}
+		return Table;
+	}
+}
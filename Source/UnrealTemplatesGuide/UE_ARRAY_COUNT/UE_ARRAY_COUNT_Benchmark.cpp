@@ -0,0 +1,263 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+// ============================================================================
+// UE_ARRAY_COUNT 基准用例
+//
+// 名称 → 下标的两种查法:
+//   - LinearScan        逐个 FCString::Strcmp, 即编译期查找表出现之前的写法
+//   - StaticNameTable   TStaticNameTable::Find, 编译期构建的开放寻址哈希表
+// 分别在 4 个名称 (示例中的 WeaponTypeNames) 与 64 个名称上测量, 查询中约 1/8 为不存在的名称
+//
+// 静态 float 数组的 Sum / MinMax / Scale, 逐个循环与 StaticArray 对比:
+//   - Kernels           4096 个元素, StaticArray 走 SIMD 内核
+//   - ParallelKernels   1M 个元素 (>= ParallelThreshold), StaticArray 走分块并行, 随工作线程数变化
+//
+// 运行: TemplatesGuide.Benchmark Filter=ArrayCount. Iterations=100
+// ============================================================================
+
+#include "Benchmark/TemplatesBenchmark.h"
+#include "StaticLookupTable.h"
+#include "StaticArrayOps.h"
+
+using namespace UE::TemplatesGuide::Benchmark;
+namespace StaticArray = UE::TemplatesGuide::StaticArray;
+
+namespace ArrayCountBenchmark
+{
+	// 只在本文件的命名空间内引入, Unity 构建时不泄漏到同一编译单元的其他文件
+	using namespace UE::TemplatesGuide::StaticLookup;
+
+	static constexpr const TCHAR* SmallNames[] =
+	{
+		TEXT("Sword"),
+		TEXT("Bow"),
+		TEXT("Staff"),
+		TEXT("Dagger"),
+	};
+
+	static constexpr const TCHAR* LargeNames[] =
+	{
+		TEXT("Sword"),
+		TEXT("Bow"),
+		TEXT("Staff"),
+		TEXT("Dagger"),
+		TEXT("Axe"),
+		TEXT("Mace"),
+		TEXT("Spear"),
+		TEXT("Halberd"),
+		TEXT("Crossbow"),
+		TEXT("Sling"),
+		TEXT("Wand"),
+		TEXT("Scepter"),
+		TEXT("Katana"),
+		TEXT("Rapier"),
+		TEXT("Scimitar"),
+		TEXT("Flail"),
+		TEXT("Glaive"),
+		TEXT("Trident"),
+		TEXT("Longbow"),
+		TEXT("Shortbow"),
+		TEXT("Javelin"),
+		TEXT("Chakram"),
+		TEXT("Shuriken"),
+		TEXT("Kunai"),
+		TEXT("Claymore"),
+		TEXT("Warhammer"),
+		TEXT("Maul"),
+		TEXT("Pike"),
+		TEXT("Lance"),
+		TEXT("Sabre"),
+		TEXT("Cutlass"),
+		TEXT("Falchion"),
+		TEXT("Estoc"),
+		TEXT("Zweihander"),
+		TEXT("Morningstar"),
+		TEXT("Quarterstaff"),
+		TEXT("Scythe"),
+		TEXT("Sickle"),
+		TEXT("Whip"),
+		TEXT("Nunchaku"),
+		TEXT("Tonfa"),
+		TEXT("Sai"),
+		TEXT("Kama"),
+		TEXT("Naginata"),
+		TEXT("Bardiche"),
+		TEXT("Partisan"),
+		TEXT("Ranseur"),
+		TEXT("Voulge"),
+		TEXT("Blowgun"),
+		TEXT("Boomerang"),
+		TEXT("Bolas"),
+		TEXT("Dart"),
+		TEXT("Harpoon"),
+		TEXT("Musket"),
+		TEXT("Pistol"),
+		TEXT("Rifle"),
+		TEXT("Shotgun"),
+		TEXT("Cannon"),
+		TEXT("Grenade"),
+		TEXT("Tome"),
+		TEXT("Orb"),
+		TEXT("Totem"),
+		TEXT("Rod"),
+		TEXT("Fist"),
+	};
+
+	static constexpr auto SmallTable = MakeStaticNameTable(SmallNames);
+	static constexpr auto LargeTable = MakeStaticNameTable(LargeNames);
+
+	static_assert(SmallTable.Num() == UE_ARRAY_COUNT(SmallNames) && SmallTable.IsValid(), "SmallTable is invalid!");
+	static_assert(LargeTable.Num() == UE_ARRAY_COUNT(LargeNames) && LargeTable.IsValid(), "LargeTable is invalid!");
+
+	template<uint32 N>
+	static int32 LinearFind(const TCHAR* const (&Names)[N], FStringView Name)
+	{
+		for (uint32 Index = 0; Index < N; ++Index)
+		{
+			if (FCString::Strlen(Names[Index]) == Name.Len() && FCString::Strncmp(Names[Index], Name.GetData(), Name.Len()) == 0)
+			{
+				return int32(Index);
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/** 查询放在运行时的 FString 中, 编译器无法把查找常量折叠掉 */
+	template<uint32 N>
+	static TArray<FString> MakeQueries(const TCHAR* const (&Names)[N], int32 NumQueries)
+	{
+		TArray<FString> Queries;
+		Queries.Reserve(NumQueries);
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			Queries.Emplace(i % 8 == 7 ? FString::Printf(TEXT("Missing%d"), i) : FString(Names[(i * 7) % N]));
+		}
+		return Queries;
+	}
+
+	template<uint32 N>
+	static void RunLookups(FBenchmarkContext& Context, const TCHAR* SizeName, const TCHAR* const (&Names)[N], const TStaticNameTable<N>& Table)
+	{
+		constexpr int32 NumQueries = 4096;
+		const TArray<FString> Queries = MakeQueries(Names, NumQueries);
+		const int32 NumLookups = NumQueries * Context.GetIterations();
+
+		const auto RunCase = [&Context, &Queries, NumLookups, SizeName](const TCHAR* CaseName, auto&& Find)
+		{
+			int64 Checksum = 0;
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Context.GetIterations(); ++Iteration)
+			{
+				for (const FString& Query : Queries)
+				{
+					Checksum += Find(FStringView(Query));
+				}
+			}
+			const double Seconds = Timer.GetSeconds();
+
+			Context.Report(*FString::Printf(TEXT("%s/%s"), CaseName, SizeName), NumLookups, Seconds)
+				.Metrics.Emplace(TEXT("NsPerLookup"), Seconds * 1e9 / NumLookups);
+			return Checksum;
+		};
+
+		const int64 LinearChecksum = RunCase(TEXT("LinearScan"), [&Names](FStringView Name) { return LinearFind(Names, Name); });
+		const int64 TableChecksum = RunCase(TEXT("StaticNameTable"), [&Table](FStringView Name) { return Table.Find(Name); });
+		check(LinearChecksum == TableChecksum);
+	}
+
+	static float MediumValues[4096];
+	static float MediumScaled[4096];
+	static float LargeValues[1024 * 1024];
+	static float LargeScaled[1024 * 1024];
+
+	/** 小整数值: 任意加法顺序下部分和都能被 float 精确表示, 两种实现的结果可以直接比较 */
+	template<uint32 N>
+	static void FillValues(float (&Values)[N])
+	{
+		for (uint32 Index = 0; Index < N; ++Index)
+		{
+			Values[Index] = float((Index * 7) % 17);
+		}
+	}
+
+	template<uint32 N>
+	static void RunKernels(FBenchmarkContext& Context, const TCHAR* SizeName, float (&Values)[N], float (&Scaled)[N])
+	{
+		FillValues(Values);
+		const int64 NumElements = int64(N) * Context.GetIterations();
+
+		const auto RunCase = [&Context, NumElements, SizeName](const TCHAR* CaseName, auto&& Body)
+		{
+			FBenchmarkTimer Timer;
+			for (int32 Iteration = 0; Iteration < Context.GetIterations(); ++Iteration)
+			{
+				Body();
+			}
+			const double Seconds = Timer.GetSeconds();
+
+			Context.Report(*FString::Printf(TEXT("%s/%s"), CaseName, SizeName), NumElements, Seconds)
+				.Metrics.Emplace(TEXT("NsPerElement"), Seconds * 1e9 / NumElements);
+		};
+
+		float ScalarSum = 0.0f;
+		float StaticSum = 0.0f;
+		RunCase(TEXT("Scalar/Sum"), [&Values, &ScalarSum]
+		{
+			float Sum = 0.0f;
+			for (const float Value : Values)
+			{
+				Sum += Value;
+			}
+			ScalarSum = Sum;
+		});
+		RunCase(TEXT("StaticArray/Sum"), [&Values, &StaticSum] { StaticSum = StaticArray::Sum(Values); });
+		check(ScalarSum == StaticSum);
+
+		StaticArray::TMinMax<float> ScalarRange{0.0f, 0.0f};
+		StaticArray::TMinMax<float> StaticRange{0.0f, 0.0f};
+		RunCase(TEXT("Scalar/MinMax"), [&Values, &ScalarRange]
+		{
+			StaticArray::TMinMax<float> Range{Values[0], Values[0]};
+			for (const float Value : Values)
+			{
+				Range.Min = FMath::Min(Range.Min, Value);
+				Range.Max = FMath::Max(Range.Max, Value);
+			}
+			ScalarRange = Range;
+		});
+		RunCase(TEXT("StaticArray/MinMax"), [&Values, &StaticRange] { StaticRange = StaticArray::MinMax(Values); });
+		check(ScalarRange.Min == StaticRange.Min && ScalarRange.Max == StaticRange.Max);
+
+		RunCase(TEXT("Scalar/Scale"), [&Values, &Scaled]
+		{
+			for (uint32 Index = 0; Index < N; ++Index)
+			{
+				Scaled[Index] = Values[Index] * 2.0f;
+			}
+		});
+		RunCase(TEXT("StaticArray/Scale"), [&Values, &Scaled] { StaticArray::Scale(Values, 2.0f, Scaled); });
+		check(Scaled[N - 1] == Values[N - 1] * 2.0f);
+	}
+}
+
+UE_TEMPLATESGUIDE_BENCHMARK(ArrayCount, NameLookup, EBenchmarkFlags::None)
+{
+	using namespace ArrayCountBenchmark;
+
+	RunLookups(Context, TEXT("4"), SmallNames, SmallTable);
+	RunLookups(Context, TEXT("64"), LargeNames, LargeTable);
+}
+
+UE_TEMPLATESGUIDE_BENCHMARK(ArrayCount, Kernels, EBenchmarkFlags::None)
+{
+	using namespace ArrayCountBenchmark;
+
+	RunKernels(Context, TEXT("4096"), MediumValues, MediumScaled);
+}
+
+UE_TEMPLATESGUIDE_BENCHMARK(ArrayCount, ParallelKernels, EBenchmarkFlags::ScalesWithWorkers)
+{
+	using namespace ArrayCountBenchmark;
+
+	RunKernels(Context, TEXT("1M"), LargeValues, LargeScaled);
+}
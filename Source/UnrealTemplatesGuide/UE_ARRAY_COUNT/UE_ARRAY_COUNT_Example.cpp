@@ -1,6 +1,8 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "UE_ARRAY_COUNT_Example.h"
+#include "StaticLookupTable.h"
+#include "StaticArrayOps.h"
 
 //=============================================================================
 // 示例数据：结构体数组 - 常用于配置表
@@ -21,12 +23,13 @@ static constexpr FTestStruct TestStruct[] =
 //=============================================================================
 // 示例数据：基础类型数组
 //=============================================================================
-static const int32 DamageMultipliers[] = { 1, 2, 4, 8, 16 };
+static constexpr int32 DamageMultipliers[] = { 1, 2, 4, 8, 16 };
 
 //=============================================================================
 // 示例数据：字符串数组 - 常用于枚举转字符串
+// constexpr: 编译期查找表需要在编译期读取这些字符串
 //=============================================================================
-static const TCHAR* WeaponTypeNames[] = 
+static constexpr const TCHAR* WeaponTypeNames[] = 
 {
 	TEXT("Sword"),
 	TEXT("Bow"),
@@ -34,6 +37,29 @@ static const TCHAR* WeaponTypeNames[] =
 	TEXT("Dagger"),
 };
 
+//=============================================================================
+// 编译期查找表 - 由上面的数组在编译期构建, 没有运行时初始化
+//=============================================================================
+// 完整限定, 不在文件作用域 using namespace: Unity 构建中会泄漏到同一编译单元的其他文件
+static constexpr auto TestStructTable = UE::TemplatesGuide::StaticLookup::MakeStaticNameTable(TestStruct, &FTestStruct::NamePostFix);
+static constexpr auto WeaponTypeTable = UE::TemplatesGuide::StaticLookup::MakeStaticNameTable(WeaponTypeNames);
+static constexpr auto DamageMultiplierIndex = UE::TemplatesGuide::StaticLookup::MakeStaticSortedIndex(DamageMultipliers);
+
+// 与用法4相同的静态断言方式: 表与源数组的元素个数一致, 且没有重复的键
+static_assert(TestStructTable.Num() == UE_ARRAY_COUNT(TestStruct), "TestStructTable count mismatch!");
+static_assert(WeaponTypeTable.Num() == UE_ARRAY_COUNT(WeaponTypeNames), "WeaponTypeTable count mismatch!");
+static_assert(DamageMultiplierIndex.Num() == UE_ARRAY_COUNT(DamageMultipliers), "DamageMultiplierIndex count mismatch!");
+static_assert(TestStructTable.IsValid() && WeaponTypeTable.IsValid() && DamageMultiplierIndex.IsValid(), "Duplicate keys in lookup table!");
+
+// 查找本身也可以在编译期执行
+static_assert(WeaponTypeTable.Find(TEXT("Staff")) == 2, "WeaponTypeTable lookup mismatch!");
+static_assert(WeaponTypeTable.Find(TEXT("Staffs"), 5) == 2 && WeaponTypeTable.Find(TEXT("Staffs"), 6) == INDEX_NONE, "WeaponTypeTable must compare lengths!");
+static_assert(DamageMultiplierIndex.Find(8) == 3, "DamageMultiplierIndex lookup mismatch!");
+
+// StaticArray 的展开路径同样可以在编译期求值
+static_assert(UE::TemplatesGuide::StaticArray::Sum(DamageMultipliers) == 31, "DamageMultipliers sum mismatch!");
+static_assert(UE::TemplatesGuide::StaticArray::Max(DamageMultipliers) == 16, "DamageMultipliers max mismatch!");
+
 AUE_ARRAY_COUNT_Example::AUE_ARRAY_COUNT_Example()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -84,14 +110,54 @@ void AUE_ARRAY_COUNT_Example::BeginPlay()
 	static_assert(UE_ARRAY_COUNT(WeaponTypeNames) == ExpectedCount, "WeaponTypeNames count mismatch!");
 	UE_LOG(LogTemp, Log, TEXT("[静态断言] 编译期验证通过，数组元素个数符合预期"));
 	
+	//=========================================================================
+	// 用法5: 编译期查找表 - 名称→下标 O(1), 越界由表处理
+	//=========================================================================
+	UE_LOG(LogTemp, Log, TEXT("[查找表]"));
+	const FString RequestedWeapon = TEXT("Dagger");
+	const int32 DaggerIndex = WeaponTypeTable.Find(FStringView(RequestedWeapon));
+	UE_LOG(LogTemp, Log, TEXT("  %s → 下标 %d (种子 %u, 最长探测 %u)"), *RequestedWeapon, DaggerIndex, WeaponTypeTable.GetSeed(), WeaponTypeTable.GetMaxProbe());
+	
+	// GetName 替代用法3中手写的范围检查, 越界返回 nullptr
+	for (const int32 Index : { 1, 7 })
+	{
+		const TCHAR* WeaponName = WeaponTypeTable.GetName(Index);
+		UE_LOG(LogTemp, Log, TEXT("  武器类型[%d]: %s"), Index, WeaponName ? WeaponName : TEXT("(越界)"));
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("  后缀 _State → 下标 %d"), TestStructTable.Find(TEXT("_State")));
+	UE_LOG(LogTemp, Log, TEXT("  伤害倍率 16 → 等级 %d, 倍率 3 → %d"), DamageMultiplierIndex.Find(16), DamageMultiplierIndex.Find(3));
+	
+	//=========================================================================
+	// 用法6: 静态数组遍历与数值运算 - 按 N 在编译期选择展开 / SIMD / 并行
+	//=========================================================================
+	UE_LOG(LogTemp, Log, TEXT("[数组运算]"));
+	namespace StaticArray = UE::TemplatesGuide::StaticArray;
+	
+	// 用法2的下标循环, 改为编译期展开的 ForEach (N = 4 <= UnrollThreshold)
+	StaticArray::ForEach(TestStruct, [](const FTestStruct& Entry)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  后缀: %s"), Entry.NamePostFix);
+	});
+	
+	const StaticArray::TMinMax<int32> MultiplierRange = StaticArray::MinMax(DamageMultipliers);
+	UE_LOG(LogTemp, Log, TEXT("  伤害倍率 总和 %d, 范围 [%d, %d]"), StaticArray::Sum(DamageMultipliers), MultiplierRange.Min, MultiplierRange.Max);
+	
+	// 输出数组的长度由类型保证与输入一致
+	int32 ScaledMultipliers[UE_ARRAY_COUNT(DamageMultipliers)];
+	StaticArray::Scale(DamageMultipliers, 3, ScaledMultipliers);
+	UE_LOG(LogTemp, Log, TEXT("  伤害倍率 x3: 最大 %d"), StaticArray::Max(ScaledMultipliers));
+	
 	//=========================================================================
 	// 错误示例（取消注释会编译失败 - 这正是 UE_ARRAY_COUNT 的安全之处）
 	//=========================================================================
-	// const TCHAR** PointerToArray = WeaponTypeNames;
+	// const TCHAR* const* PointerToArray = WeaponTypeNames;
 	// uint32 WrongCount = UE_ARRAY_COUNT(PointerToArray);  // 编译错误！指针不是数组
+	// auto WrongTable = MakeStaticNameTable(PointerToArray);  // 同样编译错误, 只接受数组引用
+	// StaticArray::ForEach(PointerToArray, [](const TCHAR*) {});  // 同样编译错误
 	
 	// 对比：sizeof 方式对指针会给出错误结果（能编译但结果错误）
-	// const TCHAR** Ptr = WeaponTypeNames;
+	// const TCHAR* const* Ptr = WeaponTypeNames;
 	// size_t WrongResult = sizeof(Ptr) / sizeof(Ptr[0]);  // 结果是 1，而非 4
 	
 	UE_LOG(LogTemp, Log, TEXT("============================================"));
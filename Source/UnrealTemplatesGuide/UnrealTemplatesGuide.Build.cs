@@ -7,6 +7,9 @@ public class UnrealTemplatesGuide : ModuleRules
 	public UnrealTemplatesGuide(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// 各示例目录之间互相引用 (如 "Benchmark/TemplatesBenchmark.h")
+		PublicIncludePaths.Add(ModuleDirectory);
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
 
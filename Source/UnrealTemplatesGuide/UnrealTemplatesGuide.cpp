@@ -2,5 +2,25 @@
 
 #include "UnrealTemplatesGuide.h"
 #include "Modules/ModuleManager.h"
+#include "Tasks_System/TaskTimer.h"
+#include "TFuture_TPromise/GameThreadCompletionSink.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, UnrealTemplatesGuide, "UnrealTemplatesGuide" );
+class FUnrealTemplatesGuideModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// FTickableGameObject 要求在 GameThread 上构造, 不在工作线程首次使用时创建
+		UE::TemplatesGuide::FGameThreadCompletionSink::Startup();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		// 模块持有的专用线程在这里停止, 不留到静态析构 (那时任务调度器已经销毁)
+		// 计时线程的剩余回调可能 Post 到完成队列, 先停计时线程
+		UE::TemplatesGuide::Private::ShutdownTaskTimer();
+		UE::TemplatesGuide::FGameThreadCompletionSink::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FUnrealTemplatesGuideModule, UnrealTemplatesGuide, "UnrealTemplatesGuide" );